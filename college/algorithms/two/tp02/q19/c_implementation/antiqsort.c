@@ -0,0 +1,141 @@
+/**
+ * antiqsort.c
+ * Adversário de McIlroy e registro dos alvos
+ */
+
+#include "antiqsort.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Estado do ataque em andamento
+ */
+static int *adversary_values = NULL;  // Valor de cada identidade
+static size_t adversary_n = 0;        // Elementos do ataque
+static int adversary_gas = 0;         // Valor do gás (maior que os sólidos)
+static int adversary_solid = 0;       // Próximo valor sólido
+static int adversary_candidate = 0;   // Gás que provavelmente é o pivô
+
+/**
+ * Congela uma identidade com o próximo valor sólido
+ */
+static void freeze(int x) {
+    adversary_values[x] = adversary_solid++;
+}
+
+/**
+ * Comparação do adversário entre duas identidades
+ */
+int antiqsort_less(int a, int b) {
+    int *values = adversary_values;
+
+    if ((size_t)a >= adversary_n || (size_t)b >= adversary_n) {
+        // O alvo comparou algo que não é uma identidade (sentinela, cópia
+        // aritmética): não há resposta consistente
+        fprintf(stderr, "Erro: comparação fora das identidades do ataque "
+                        "(%d, %d)\n",
+                a, b);
+        abort();
+    }
+
+    // Dois gases: o candidato a pivô fica sólido (pequeno), o outro continua
+    if (values[a] == adversary_gas && values[b] == adversary_gas) {
+        freeze(a == adversary_candidate ? a : b);
+    }
+    if (values[a] == adversary_gas) {
+        adversary_candidate = a;
+    } else if (values[b] == adversary_gas) {
+        adversary_candidate = b;
+    }
+    return values[a] < values[b];
+}
+
+/**
+ * Gera a entrada adversária de n chaves para um alvo
+ */
+int antiqsort_generate(const AdversaryTarget *target, int *keys, size_t n,
+                       SortResult *attack) {
+    size_t i;
+
+    if (n > ADVERSARY_MAX_SIZE) {
+        fprintf(stderr, "Entrada adversária grande demais: %zu\n", n);
+        return -1;
+    }
+
+    adversary_values = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+    int *identities = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (adversary_values == NULL || identities == NULL) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        free(adversary_values);
+        free(identities);
+        adversary_values = NULL;
+        return -1;
+    }
+
+    // Tudo começa como gás; o elemento da posição i tem identidade i
+    adversary_n = n;
+    adversary_gas = n > 0 ? (int)n - 1 : 0;
+    adversary_solid = 0;
+    adversary_candidate = 0;
+    for (i = 0; i < n; i++) {
+        adversary_values[i] = adversary_gas;
+        identities[i] = (int)i;
+    }
+
+    *attack = target->attack(identities, n);
+
+    // A ordem produzida tem de ser consistente com as respostas dadas
+    int status = 0;
+    for (i = 1; i < n; i++) {
+        if (adversary_values[identities[i]] <
+            adversary_values[identities[i - 1]]) {
+            fprintf(stderr, "ERRO: %s não ordenou a entrada adversária\n",
+                    target->name);
+            status = -1;
+            break;
+        }
+    }
+
+    // Entrada adversária: o valor congelado de cada posição original
+    for (i = 0; i < n; i++) {
+        keys[i] = adversary_values[i];
+    }
+
+    free(identities);
+    free(adversary_values);
+    adversary_values = NULL;
+    adversary_n = 0;
+    return status;
+}
+
+/**
+ * Registro dos alvos
+ */
+const AdversaryTarget adversary_targets[] = {
+    {"quick_sort", quick_sort_adversary},
+    {"block_quick_sort", block_quick_sort_adversary},
+    {"intro_sort", intro_sort_adversary},
+    {"power_sort", power_sort_adversary},
+    {"pdq_sort", pdq_sort_adversary},
+    {"libc_qsort", libc_qsort_adversary},
+    {"std_sort", std_sort_adversary},
+    {"std_stable_sort", std_stable_sort_adversary},
+};
+
+const int num_adversary_targets =
+    (int)(sizeof(adversary_targets) / sizeof(adversary_targets[0]));
+
+/**
+ * Procura um alvo pelo nome
+ */
+const AdversaryTarget *find_adversary_target(const char *name) {
+    int i;
+    for (i = 0; i < num_adversary_targets; i++) {
+        if (strcmp(adversary_targets[i].name, name) == 0) {
+            return &adversary_targets[i];
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,96 @@
+/**
+ * antiqsort.h
+ * Gerador de entradas adversárias de McIlroy ("A Killer Adversary for
+ * Quicksort"): o adversário decide o valor de cada chave durante a própria
+ * ordenação, congelando-as só quando uma comparação obriga, de modo que o
+ * pivô escolhido pelo alvo seja sempre ruim. A entrada resultante pode ser
+ * repetida em qualquer algoritmo do registro.
+ */
+
+#ifndef ANTIQSORT_H
+#define ANTIQSORT_H
+
+#include <stddef.h>
+
+#include "sorting_algorithms.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Maior entrada do modo adversário (os alvos degradados são quadráticos)
+#define ADVERSARY_MAX_SIZE 20000
+
+// Tamanhos do modo adversário quando --sizes não é informado
+#define ADVERSARY_DEFAULT_SIZES "1000,2000,4000,8000"
+
+// Expoente de crescimento das comparações a partir do qual um algoritmo é
+// considerado quadrático (n log n fica perto de 1,1 nesses tamanhos)
+#define ADVERSARY_QUADRATIC_EXPONENT 1.5
+
+/**
+ * Algoritmo que pode ser atacado: variante compilada com SORT_ADVERSARY=1,
+ * cujas comparações passam pelo adversário
+ */
+typedef struct {
+    const char *name;     // Nome no registro de algoritmos
+    SortFunction attack;  // Variante atacada (sufixo _adversary)
+} AdversaryTarget;
+
+/**
+ * Registro dos alvos (ordenações por comparação de um único fluxo; os
+ * paralelos, vetorizados e radix só são repetidos sobre as entradas)
+ */
+extern const AdversaryTarget adversary_targets[];
+extern const int num_adversary_targets;
+
+/**
+ * Procura um alvo pelo nome
+ *
+ * @param name Nome do algoritmo
+ * @return Alvo ou NULL se o algoritmo não puder ser atacado
+ */
+const AdversaryTarget *find_adversary_target(const char *name);
+
+/**
+ * Comparação do adversário entre duas identidades de elementos: se ambas
+ * ainda são "gás" (valor indefinido), congela uma delas com o próximo valor
+ * sólido; gás é sempre maior que qualquer sólido
+ *
+ * @param a Identidade do primeiro elemento
+ * @param b Identidade do segundo elemento
+ * @return 1 se a < b na entrada sendo construída
+ */
+int antiqsort_less(int a, int b);
+
+/**
+ * Gera a entrada adversária de n chaves para um alvo, ordenando com ele um
+ * array de identidades (não reentrante: um ataque por vez)
+ *
+ * @param target Alvo
+ * @param keys Destino das n chaves adversárias (permutação de 0 .. n - 1,
+ *             com gás restante empatado no maior valor)
+ * @param n Número de chaves (até ADVERSARY_MAX_SIZE)
+ * @param attack Resultado do alvo durante o ataque (comparações contadas)
+ * @return 0 em caso de sucesso, -1 em caso de erro (mensagem em stderr)
+ */
+int antiqsort_generate(const AdversaryTarget *target, int *keys, size_t n,
+                       SortResult *attack);
+
+/**
+ * Variantes atacadas (SORT_ADVERSARY=1)
+ */
+SortResult quick_sort_adversary(int *arr, size_t n);
+SortResult block_quick_sort_adversary(int *arr, size_t n);
+SortResult intro_sort_adversary(int *arr, size_t n);
+SortResult power_sort_adversary(int *arr, size_t n);
+SortResult pdq_sort_adversary(int *arr, size_t n);
+SortResult libc_qsort_adversary(int *arr, size_t n);
+SortResult std_sort_adversary(int *arr, size_t n);
+SortResult std_stable_sort_adversary(int *arr, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ANTIQSORT_H */
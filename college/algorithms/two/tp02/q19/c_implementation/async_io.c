@@ -0,0 +1,483 @@
+/**
+ * async_io.c
+ * Implementação da fila de E/S (io_uring ou pread/pwrite)
+ */
+
+#define _GNU_SOURCE
+
+#include "async_io.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "benchmark.h"
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+// IORING_OP_READ/WRITE chegaram junto com IORING_FEAT_RW_CUR_POS (5.6)
+#if defined(__linux__) && defined(__NR_io_uring_setup) && \
+    defined(IORING_FEAT_RW_CUR_POS)
+#define HAVE_IO_URING 1
+#else
+#define HAVE_IO_URING 0
+#endif
+
+// Maior transferência por entrada da fila (o campo len tem 32 bits)
+#define MAX_TRANSFER ((size_t)1 << 30)
+
+static const char *io_backend_names[] = {"auto", "io_uring", "sync"};
+
+struct AsyncIo {
+    IoBackend backend;
+    unsigned long long bytes_read;
+    unsigned long long bytes_written;
+    uint64_t read_ns;      // Tempo enviando ou esperando leituras
+    uint64_t write_ns;     // Tempo enviando ou esperando escritas
+#if HAVE_IO_URING
+    int ring_fd;
+    unsigned entries;      // Tamanho da fila de envio
+    unsigned in_flight;    // Entradas enviadas e ainda sem conclusão
+    void *sq_ring;         // Anel de envio (e de conclusão, se único)
+    size_t sq_ring_bytes;
+    void *cq_ring;
+    size_t cq_ring_bytes;
+    struct io_uring_sqe *sqes;
+    size_t sqes_bytes;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_cqe *cqes;
+#endif
+};
+
+/**
+ * Nome do mecanismo
+ */
+const char *io_backend_name(IoBackend backend) {
+    if (backend < IO_AUTO || backend > IO_SYNC) {
+        return "unknown";
+    }
+    return io_backend_names[backend];
+}
+
+/**
+ * Procura um mecanismo pelo nome
+ */
+int io_backend_from_name(const char *name, IoBackend *backend) {
+    int i;
+    for (i = IO_AUTO; i <= IO_SYNC; i++) {
+        if (strcmp(name, io_backend_names[i]) == 0) {
+            *backend = (IoBackend)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Soma uma transferência concluída às estatísticas da fila
+ */
+static void account(AsyncIo *io, const IoRequest *request, size_t bytes) {
+    if (request->write) {
+        io->bytes_written += bytes;
+    } else {
+        io->bytes_read += bytes;
+    }
+}
+
+/**
+ * Soma ao tempo de E/S da fila o intervalo desde start, pelo tipo da operação
+ * que o chamador enviava ou esperava
+ */
+static void account_time(AsyncIo *io, const IoRequest *request,
+                         uint64_t start) {
+    uint64_t elapsed = bench_now_ns() - start;
+    if (request->write) {
+        io->write_ns += elapsed;
+    } else {
+        io->read_ns += elapsed;
+    }
+}
+
+/**
+ * Executa a operação inteira com pread/pwrite
+ */
+static void sync_transfer(AsyncIo *io, IoRequest *request) {
+    while (request->done < request->bytes) {
+        char *buffer = request->buffer + request->done;
+        size_t bytes = request->bytes - request->done;
+        off_t offset = (off_t)(request->offset + request->done);
+        ssize_t n = request->write ? pwrite(request->fd, buffer, bytes, offset)
+                                   : pread(request->fd, buffer, bytes, offset);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            request->error = errno;
+            break;
+        }
+        if (n == 0) {
+            // Fim do arquivo na leitura; na escrita é uma falha
+            if (request->write) {
+                request->error = EIO;
+            }
+            break;
+        }
+        request->done += (size_t)n;
+        account(io, request, (size_t)n);
+    }
+    request->in_flight = 0;
+}
+
+#if HAVE_IO_URING
+
+/**
+ * Chamada io_uring_enter repetida quando interrompida por sinal
+ */
+static int uring_enter(AsyncIo *io, unsigned to_submit, unsigned min_complete) {
+    for (;;) {
+        long ret = syscall(__NR_io_uring_enter, io->ring_fd, to_submit,
+                           min_complete,
+                           min_complete > 0 ? IORING_ENTER_GETEVENTS : 0,
+                           NULL, 0);
+        if (ret >= 0) {
+            return (int)ret;
+        }
+        if (errno != EINTR) {
+            return -1;
+        }
+    }
+}
+
+static void uring_push(AsyncIo *io, IoRequest *request);
+
+/**
+ * Trata uma conclusão: transferências parciais são reenviadas com o restante
+ */
+static void uring_complete(AsyncIo *io, IoRequest *request, int res) {
+    if (res == -EINTR || res == -EAGAIN) {
+        uring_push(io, request);
+        return;
+    }
+    if (res < 0) {
+        request->error = -res;
+        request->in_flight = 0;
+        return;
+    }
+
+    request->done += (size_t)res;
+    account(io, request, (size_t)res);
+
+    if (res == 0 || request->done == request->bytes) {
+        if (res == 0 && request->write) {
+            request->error = EIO;
+        }
+        request->in_flight = 0;
+    } else {
+        uring_push(io, request);
+    }
+}
+
+/**
+ * Consome as conclusões disponíveis; com wait, bloqueia até haver uma
+ */
+static void uring_reap(AsyncIo *io, int wait) {
+    if (wait &&
+        *io->cq_head == __atomic_load_n(io->cq_tail, __ATOMIC_ACQUIRE)) {
+        if (uring_enter(io, 0, 1) < 0) {
+            perror("io_uring_enter");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // A cabeça é relida a cada volta: uring_complete pode reenviar e consumir
+    for (;;) {
+        unsigned head = *io->cq_head;
+        if (head == __atomic_load_n(io->cq_tail, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+        const struct io_uring_cqe *cqe = &io->cqes[head & *io->cq_mask];
+        IoRequest *request = (IoRequest *)(uintptr_t)cqe->user_data;
+        int res = cqe->res;
+
+        __atomic_store_n(io->cq_head, head + 1, __ATOMIC_RELEASE);
+        io->in_flight--;
+        uring_complete(io, request, res);
+    }
+}
+
+/**
+ * Coloca o restante da operação na fila de envio e a envia ao kernel
+ */
+static void uring_push(AsyncIo *io, IoRequest *request) {
+    while (io->in_flight >= io->entries) {
+        uring_reap(io, 1);
+    }
+
+    size_t bytes = request->bytes - request->done;
+    if (bytes > MAX_TRANSFER) {
+        bytes = MAX_TRANSFER;
+    }
+
+    unsigned tail = *io->sq_tail;
+    unsigned index = tail & *io->sq_mask;
+    struct io_uring_sqe *sqe = &io->sqes[index];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = request->write ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe->fd = request->fd;
+    sqe->addr = (uint64_t)(uintptr_t)(request->buffer + request->done);
+    sqe->len = (uint32_t)bytes;
+    sqe->off = request->offset + request->done;
+    sqe->user_data = (uint64_t)(uintptr_t)request;
+    io->sq_array[index] = index;
+    __atomic_store_n(io->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    io->in_flight++;
+
+    // A entrada já está no anel: uma falha aqui deixaria a fila incoerente
+    while (uring_enter(io, 1, 0) < 0) {
+        if (errno != EAGAIN && errno != EBUSY) {
+            perror("io_uring_enter");
+            exit(EXIT_FAILURE);
+        }
+        uring_reap(io, 1);
+    }
+}
+
+/**
+ * Cria o anel e mapeia as filas de envio e de conclusão
+ *
+ * @return 0 em caso de sucesso, -1 se o io_uring estiver indisponível
+ */
+static int uring_setup(AsyncIo *io, unsigned depth) {
+    struct io_uring_params params;
+
+    memset(&params, 0, sizeof(params));
+    io->ring_fd = (int)syscall(__NR_io_uring_setup, depth, &params);
+    if (io->ring_fd < 0) {
+        return -1;  // ENOSYS, ou bloqueado por seccomp/sysctl
+    }
+    if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+        close(io->ring_fd);
+        return -1;  // Kernel sem IORING_OP_READ/WRITE
+    }
+
+    io->entries = params.sq_entries;
+    io->sq_ring_bytes =
+        params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    io->cq_ring_bytes = params.cq_off.cqes +
+                        params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (io->cq_ring_bytes > io->sq_ring_bytes) {
+            io->sq_ring_bytes = io->cq_ring_bytes;
+        }
+        io->cq_ring_bytes = 0;
+    }
+
+    io->sq_ring = mmap(NULL, io->sq_ring_bytes, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, io->ring_fd,
+                       IORING_OFF_SQ_RING);
+    if (io->sq_ring == MAP_FAILED) {
+        close(io->ring_fd);
+        return -1;
+    }
+    io->cq_ring = io->sq_ring;
+    if (io->cq_ring_bytes > 0) {
+        io->cq_ring = mmap(NULL, io->cq_ring_bytes, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, io->ring_fd,
+                           IORING_OFF_CQ_RING);
+        if (io->cq_ring == MAP_FAILED) {
+            munmap(io->sq_ring, io->sq_ring_bytes);
+            close(io->ring_fd);
+            return -1;
+        }
+    }
+    io->sqes_bytes = params.sq_entries * sizeof(struct io_uring_sqe);
+    io->sqes = (struct io_uring_sqe *)mmap(
+        NULL, io->sqes_bytes, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, io->ring_fd, IORING_OFF_SQES);
+    if (io->sqes == MAP_FAILED) {
+        if (io->cq_ring_bytes > 0) {
+            munmap(io->cq_ring, io->cq_ring_bytes);
+        }
+        munmap(io->sq_ring, io->sq_ring_bytes);
+        close(io->ring_fd);
+        return -1;
+    }
+
+    char *sq = (char *)io->sq_ring;
+    char *cq = (char *)io->cq_ring;
+    io->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    io->sq_mask = (unsigned *)(sq + params.sq_off.ring_mask);
+    io->sq_array = (unsigned *)(sq + params.sq_off.array);
+    io->cq_head = (unsigned *)(cq + params.cq_off.head);
+    io->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    io->cq_mask = (unsigned *)(cq + params.cq_off.ring_mask);
+    io->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    io->in_flight = 0;
+    return 0;
+}
+
+/**
+ * Desfaz os mapeamentos e fecha o anel
+ */
+static void uring_teardown(AsyncIo *io) {
+    munmap(io->sqes, io->sqes_bytes);
+    if (io->cq_ring_bytes > 0) {
+        munmap(io->cq_ring, io->cq_ring_bytes);
+    }
+    munmap(io->sq_ring, io->sq_ring_bytes);
+    close(io->ring_fd);
+}
+
+#endif /* HAVE_IO_URING */
+
+/**
+ * Cria uma fila de E/S
+ */
+AsyncIo *async_io_create(IoBackend backend, unsigned depth) {
+    AsyncIo *io = (AsyncIo *)calloc(1, sizeof(AsyncIo));
+    if (io == NULL) {
+        return NULL;
+    }
+
+    io->backend = IO_SYNC;
+    if (backend != IO_SYNC) {
+#if HAVE_IO_URING
+        if (uring_setup(io, depth > 0 ? depth : 1) == 0) {
+            io->backend = IO_URING;
+            return io;
+        }
+#else
+        (void)depth;
+#endif
+        if (backend == IO_URING) {
+            free(io);
+            return NULL;
+        }
+    }
+    return io;
+}
+
+/**
+ * Libera a fila
+ */
+void async_io_destroy(AsyncIo *io) {
+    if (io == NULL) {
+        return;
+    }
+#if HAVE_IO_URING
+    if (io->backend == IO_URING) {
+        uring_teardown(io);
+    }
+#endif
+    free(io);
+}
+
+/**
+ * Mecanismo efetivamente usado pela fila
+ */
+IoBackend async_io_backend(const AsyncIo *io) {
+    return io->backend;
+}
+
+/**
+ * Preenche e envia uma operação
+ */
+static void submit(AsyncIo *io, IoRequest *request, int fd, int is_write,
+                   void *buffer, size_t bytes, uint64_t offset) {
+    request->fd = fd;
+    request->write = is_write;
+    request->buffer = (char *)buffer;
+    request->bytes = bytes;
+    request->offset = offset;
+    request->done = 0;
+    request->error = 0;
+    request->in_flight = bytes > 0;
+
+    if (!request->in_flight) {
+        return;
+    }
+    uint64_t start = bench_now_ns();
+#if HAVE_IO_URING
+    if (io->backend == IO_URING) {
+        uring_push(io, request);
+        account_time(io, request, start);
+        return;
+    }
+#endif
+    sync_transfer(io, request);
+    account_time(io, request, start);
+}
+
+/**
+ * Envia uma leitura
+ */
+void async_io_read(AsyncIo *io, IoRequest *request, int fd, void *buffer,
+                   size_t bytes, uint64_t offset) {
+    submit(io, request, fd, 0, buffer, bytes, offset);
+}
+
+/**
+ * Envia uma escrita
+ */
+void async_io_write(AsyncIo *io, IoRequest *request, int fd,
+                    const void *buffer, size_t bytes, uint64_t offset) {
+    submit(io, request, fd, 1, (void *)buffer, bytes, offset);
+}
+
+/**
+ * Aguarda o fim de uma operação
+ */
+int async_io_wait(AsyncIo *io, IoRequest *request) {
+#if HAVE_IO_URING
+    if (request->in_flight) {
+        uint64_t start = bench_now_ns();
+        while (request->in_flight) {
+            uring_reap(io, 1);
+        }
+        account_time(io, request, start);
+    }
+#else
+    (void)io;
+#endif
+    return request->error != 0 ? -1 : 0;
+}
+
+/**
+ * Bytes lidos pelas operações concluídas
+ */
+unsigned long long async_io_bytes_read(const AsyncIo *io) {
+    return io->bytes_read;
+}
+
+/**
+ * Bytes escritos pelas operações concluídas
+ */
+unsigned long long async_io_bytes_written(const AsyncIo *io) {
+    return io->bytes_written;
+}
+
+/**
+ * Tempo enviando ou esperando leituras
+ */
+double async_io_read_time(const AsyncIo *io) {
+    return (double)io->read_ns * 1e-9;
+}
+
+/**
+ * Tempo enviando ou esperando escritas
+ */
+double async_io_write_time(const AsyncIo *io) {
+    return (double)io->write_ns * 1e-9;
+}
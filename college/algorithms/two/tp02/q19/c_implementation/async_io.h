@@ -0,0 +1,122 @@
+/**
+ * async_io.h
+ * Leituras e escritas assíncronas em arquivos: io_uring (chamadas de sistema
+ * diretas, sem liburing) com pread/pwrite síncronos como alternativa
+ */
+
+#ifndef ASYNC_IO_H
+#define ASYNC_IO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Mecanismo de E/S
+ */
+typedef enum {
+    IO_AUTO = 0,  // io_uring se o kernel permitir, senão pread/pwrite
+    IO_URING,     // io_uring (erro se indisponível)
+    IO_SYNC       // pread/pwrite na própria chamada de envio
+} IoBackend;
+
+/**
+ * Uma operação de leitura ou escrita; deve permanecer válida até
+ * async_io_wait retornar
+ */
+typedef struct {
+    int fd;
+    int write;           // 1 para escrita
+    char *buffer;
+    size_t bytes;        // Bytes pedidos
+    uint64_t offset;     // Posição no arquivo
+    size_t done;         // Bytes transferidos (menor que bytes no fim do
+                         // arquivo)
+    int in_flight;       // 1 enquanto a operação não terminou
+    int error;           // errno da falha (0 se não houve)
+} IoRequest;
+
+/**
+ * Fila de E/S (estrutura opaca)
+ */
+typedef struct AsyncIo AsyncIo;
+
+/**
+ * Cria uma fila de E/S
+ *
+ * @param backend Mecanismo pedido (IO_AUTO recorre a IO_SYNC)
+ * @param depth Máximo de operações simultâneas
+ * @return Fila criada ou NULL se o mecanismo pedido não estiver disponível
+ */
+AsyncIo *async_io_create(IoBackend backend, unsigned depth);
+
+/**
+ * Libera a fila (não deve haver operações pendentes)
+ *
+ * @param io Fila de E/S
+ */
+void async_io_destroy(AsyncIo *io);
+
+/**
+ * Mecanismo efetivamente usado pela fila
+ */
+IoBackend async_io_backend(const AsyncIo *io);
+
+/**
+ * Envia uma leitura de bytes bytes a partir de offset
+ *
+ * @param io Fila de E/S
+ * @param request Operação (preenchida aqui)
+ * @param fd Arquivo
+ * @param buffer Destino
+ * @param bytes Bytes a ler
+ * @param offset Posição no arquivo
+ */
+void async_io_read(AsyncIo *io, IoRequest *request, int fd, void *buffer,
+                   size_t bytes, uint64_t offset);
+
+/**
+ * Envia uma escrita de bytes bytes a partir de offset
+ */
+void async_io_write(AsyncIo *io, IoRequest *request, int fd,
+                    const void *buffer, size_t bytes, uint64_t offset);
+
+/**
+ * Aguarda o fim de uma operação (retorna imediatamente se ela não estiver
+ * em andamento); transferências parciais são completadas antes de retornar
+ *
+ * @param io Fila de E/S
+ * @param request Operação
+ * @return 0 em caso de sucesso, -1 em caso de erro (errno em request->error)
+ */
+int async_io_wait(AsyncIo *io, IoRequest *request);
+
+/**
+ * Bytes lidos e escritos pelas operações concluídas
+ */
+unsigned long long async_io_bytes_read(const AsyncIo *io);
+unsigned long long async_io_bytes_written(const AsyncIo *io);
+
+/**
+ * Tempo, em segundos, em que o chamador ficou enviando ou esperando
+ * leituras (ou escritas): com pread/pwrite, a transferência inteira; com
+ * io_uring, o envio e a espera em async_io_wait, sem o tempo em que a
+ * operação correu sobreposta à CPU
+ */
+double async_io_read_time(const AsyncIo *io);
+double async_io_write_time(const AsyncIo *io);
+
+/**
+ * Nome do mecanismo ("auto", "io_uring", "sync")
+ */
+const char *io_backend_name(IoBackend backend);
+
+/**
+ * Procura um mecanismo pelo nome
+ *
+ * @param name Nome do mecanismo
+ * @param backend Destino
+ * @return 1 se encontrado, 0 caso contrário
+ */
+int io_backend_from_name(const char *name, IoBackend *backend);
+
+#endif /* ASYNC_IO_H */
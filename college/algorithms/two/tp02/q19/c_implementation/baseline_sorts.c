@@ -0,0 +1,486 @@
+/**
+ * baseline_sorts.c
+ * Implementação das referências em C: qsort da libc e pdqsort
+ *
+ * Compilado duas vezes, como sorting_algorithms.c (ver
+ * sort_instrumentation.h), e uma terceira para os alvos do antiqsort. O
+ * pdqsort segue a versão sem desvios da implementação original em C++
+ * (pdqsort_branchless), especializada para int; as referências do C++ ficam
+ * em std_sorts.cpp.
+ */
+
+#include "baseline_sorts.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "benchmark.h"
+#include "sort_helpers.h"
+#include "sort_instrumentation.h"
+
+/**
+ * Parâmetros do pdqsort (os da implementação original)
+ */
+#define PDQ_INSERTION_THRESHOLD 24       // Abaixo disso, inserção
+#define PDQ_NINTHER_THRESHOLD 128        // Acima disso, pivô pelo ninther
+#define PDQ_PARTIAL_INSERTION_LIMIT 8    // Movimentos da inserção parcial
+#define PDQ_BLOCK_SIZE 64                // Elementos por bloco da partição
+
+#if SORT_COUNTED || SORT_ADVERSARY
+/**
+ * Contadores da chamada atual de qsort (o comparador não recebe contexto)
+ */
+static __thread SortCounters *qsort_counters = NULL;
+#endif
+
+/**
+ * Comparador de int para o qsort
+ */
+static int compare_ints(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+#if SORT_COUNTED || SORT_ADVERSARY
+    COUNT_COMPARISON(qsort_counters);
+#endif
+    return SORT_LESS(y, x) - SORT_LESS(x, y);
+}
+
+/**
+ * qsort da libc
+ */
+SortResult SORT_KERNEL(libc_qsort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+
+#if SORT_COUNTED || SORT_ADVERSARY
+    qsort_counters = &counters;
+#endif
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    qsort(arr, n, sizeof(int), compare_ints);
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Troca dois elementos contando uma movimentação
+ */
+static void swap_ints(int *a, int *b, SortCounters *counters) {
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+    COUNT_MOVEMENT(counters);
+}
+
+/**
+ * Ordena *a e *b
+ */
+static void sort2(int *a, int *b, SortCounters *counters) {
+    COUNT_COMPARISON(counters);
+    if (SORT_LESS(*b, *a)) {
+        swap_ints(a, b, counters);
+    }
+}
+
+/**
+ * Ordena *a, *b e *c
+ */
+static void sort3(int *a, int *b, int *c, SortCounters *counters) {
+    sort2(a, b, counters);
+    sort2(b, c, counters);
+    sort2(a, b, counters);
+}
+
+/**
+ * Inserção em [begin, end) sem testar o início: *(begin - 1) não é maior
+ * que nenhum elemento do trecho e serve de sentinela
+ */
+static void unguarded_insertion_sort_range(int *begin, int *end,
+                                           SortCounters *counters) {
+    int *cur;
+
+    if (begin == end) {
+        return;
+    }
+    for (cur = begin + 1; cur != end; cur++) {
+        int *sift = cur;
+        int *sift_1 = cur - 1;
+
+        COUNT_COMPARISON(counters);
+        if (SORT_LESS(*sift, *sift_1)) {
+            int temp = *sift;
+            do {
+                *sift-- = *sift_1;
+                COUNT_MOVEMENT(counters);
+            } while (
+                (COUNT_COMPARISON(counters), SORT_LESS(temp, *--sift_1)));
+            *sift = temp;
+            COUNT_MOVEMENT(counters);
+        }
+    }
+}
+
+/**
+ * Inserção que desiste depois de PDQ_PARTIAL_INSERTION_LIMIT movimentos
+ *
+ * @return 1 se o trecho ficou ordenado, 0 se desistiu
+ */
+static int partial_insertion_sort(int *begin, int *end,
+                                  SortCounters *counters) {
+    size_t limit = 0;
+    int *cur;
+
+    if (begin == end) {
+        return 1;
+    }
+    for (cur = begin + 1; cur != end; cur++) {
+        int *sift = cur;
+        int *sift_1 = cur - 1;
+
+        if (limit > PDQ_PARTIAL_INSERTION_LIMIT) {
+            return 0;
+        }
+        COUNT_COMPARISON(counters);
+        if (SORT_LESS(*sift, *sift_1)) {
+            int temp = *sift;
+            do {
+                *sift-- = *sift_1;
+                COUNT_MOVEMENT(counters);
+            } while (sift != begin && (COUNT_COMPARISON(counters),
+                                       SORT_LESS(temp, *--sift_1)));
+            *sift = temp;
+            COUNT_MOVEMENT(counters);
+            limit += (size_t)(cur - sift);
+        }
+    }
+    return 1;
+}
+
+/**
+ * Troca os elementos fora do lugar indicados pelos offsets dos dois blocos.
+ * Com use_swaps, troca par a par (necessário na entrada decrescente para o
+ * pdqsort continuar O(n log n)); senão, faz um ciclo com uma única cópia
+ * temporária
+ */
+static void swap_offsets(int *first, int *last,
+                         const unsigned char *offsets_l,
+                         const unsigned char *offsets_r, size_t num,
+                         int use_swaps, SortCounters *counters) {
+    size_t i;
+
+    if (use_swaps) {
+        for (i = 0; i < num; i++) {
+            swap_ints(first + offsets_l[i], last - offsets_r[i], counters);
+        }
+    } else if (num > 0) {
+        int *l = first + offsets_l[0];
+        int *r = last - offsets_r[0];
+        int temp = *l;
+
+        *l = *r;
+        for (i = 1; i < num; i++) {
+            l = first + offsets_l[i];
+            *r = *l;
+            r = last - offsets_r[i];
+            *l = *r;
+        }
+        *r = temp;
+        COUNT_MOVEMENTS(counters, 2 * num);
+    }
+}
+
+/**
+ * Partição em torno de *begin com os iguais ao pivô à direita, sem desvios
+ * condicionais nos blocos: cada bloco grava os offsets dos elementos do lado
+ * errado e as trocas são feitas em lote
+ *
+ * @param already_partitioned Destino: 1 se nenhuma troca foi necessária
+ * @return Posição final do pivô
+ */
+static int *partition_right_branchless(int *begin, int *end,
+                                       int *already_partitioned,
+                                       SortCounters *counters) {
+    int pivot = *begin;
+    int *first = begin;
+    int *last = end;
+    size_t i;
+
+    // Primeiro elemento >= pivô (a mediana de três garante que existe)
+    while ((COUNT_COMPARISON(counters), SORT_LESS(*++first, pivot))) {
+    }
+
+    // Último elemento < pivô; sem sentinela se nada ficou à esquerda
+    if (first - 1 == begin) {
+        while (first < last &&
+               (COUNT_COMPARISON(counters), !SORT_LESS(*--last, pivot))) {
+        }
+    } else {
+        while ((COUNT_COMPARISON(counters), !SORT_LESS(*--last, pivot))) {
+        }
+    }
+
+    *already_partitioned = first >= last;
+    if (!*already_partitioned) {
+        unsigned char offsets_l[PDQ_BLOCK_SIZE];
+        unsigned char offsets_r[PDQ_BLOCK_SIZE];
+        int *offsets_l_base, *offsets_r_base;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        swap_ints(first, last, counters);
+        first++;
+        offsets_l_base = first;
+        offsets_r_base = last;
+
+        while (first < last) {
+            // Quantos elementos cada bloco examina nesta rodada
+            size_t num_unknown = (size_t)(last - first);
+            size_t left_split =
+                num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+            size_t right_split = num_r == 0 ? num_unknown - left_split : 0;
+
+            if (left_split >= PDQ_BLOCK_SIZE) {
+                left_split = PDQ_BLOCK_SIZE;
+            }
+            for (i = 0; i < left_split; i++) {
+                offsets_l[num_l] = (unsigned char)i;
+                num_l += !SORT_LESS(*first, pivot);
+                first++;
+            }
+            COUNT_COMPARISONS(counters, left_split);
+
+            if (right_split >= PDQ_BLOCK_SIZE) {
+                right_split = PDQ_BLOCK_SIZE;
+            }
+            for (i = 0; i < right_split; i++) {
+                offsets_r[num_r] = (unsigned char)(i + 1);
+                num_r += SORT_LESS(*--last, pivot);
+            }
+            COUNT_COMPARISONS(counters, right_split);
+
+            // Trocar os pares e esvaziar o bloco que acabou
+            size_t num = num_l < num_r ? num_l : num_r;
+            swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+                         offsets_r + start_r, num, num_l == num_r, counters);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+
+            if (num_l == 0) {
+                start_l = 0;
+                offsets_l_base = first;
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                offsets_r_base = last;
+            }
+        }
+
+        // Sobras de um dos blocos vão para a fronteira
+        if (num_l > 0) {
+            while (num_l-- > 0) {
+                swap_ints(offsets_l_base + offsets_l[start_l + num_l], --last,
+                          counters);
+            }
+            first = last;
+        }
+        if (num_r > 0) {
+            while (num_r-- > 0) {
+                swap_ints(offsets_r_base - offsets_r[start_r + num_r], first,
+                          counters);
+                first++;
+            }
+            last = first;
+        }
+    }
+
+    // Pivô na posição final
+    int *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    COUNT_MOVEMENTS(counters, 2);
+
+    return pivot_pos;
+}
+
+/**
+ * Partição em torno de *begin com os iguais ao pivô à esquerda. Usada quando
+ * o pivô é igual ao elemento anterior ao trecho: todos os iguais já estão no
+ * lugar e só o lado direito continua
+ *
+ * @return Posição final do pivô
+ */
+static int *partition_left(int *begin, int *end, SortCounters *counters) {
+    int pivot = *begin;
+    int *first = begin;
+    int *last = end;
+
+    while ((COUNT_COMPARISON(counters), SORT_LESS(pivot, *--last))) {
+    }
+    if (last + 1 == end) {
+        while (first < last &&
+               (COUNT_COMPARISON(counters), !SORT_LESS(pivot, *++first))) {
+        }
+    } else {
+        while ((COUNT_COMPARISON(counters), !SORT_LESS(pivot, *++first))) {
+        }
+    }
+
+    while (first < last) {
+        swap_ints(first, last, counters);
+        while ((COUNT_COMPARISON(counters), SORT_LESS(pivot, *--last))) {
+        }
+        while ((COUNT_COMPARISON(counters), !SORT_LESS(pivot, *++first))) {
+        }
+    }
+
+    int *pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    COUNT_MOVEMENTS(counters, 2);
+
+    return pivot_pos;
+}
+
+/**
+ * Laço principal do pdqsort: recursão no lado esquerdo, iteração no direito
+ *
+ * @param bad_allowed Partições desbalanceadas toleradas antes do HeapSort
+ * @param leftmost 1 se não há elemento anterior servindo de sentinela
+ */
+static void pdq_loop(int *begin, int *end, int bad_allowed, int leftmost,
+                     SortCounters *counters) {
+    for (;;) {
+        ptrdiff_t size = end - begin;
+
+        if (size < PDQ_INSERTION_THRESHOLD) {
+            if (leftmost) {
+                insertion_sort_range(begin, 0, end - begin - 1, counters);
+            } else {
+                unguarded_insertion_sort_range(begin, end, counters);
+            }
+            return;
+        }
+
+        // Pivô: mediana de três ou ninther, levado para *begin
+        ptrdiff_t s2 = size / 2;
+        if (size > PDQ_NINTHER_THRESHOLD) {
+            sort3(begin, begin + s2, end - 1, counters);
+            sort3(begin + 1, begin + (s2 - 1), end - 2, counters);
+            sort3(begin + 2, begin + (s2 + 1), end - 3, counters);
+            sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), counters);
+            swap_ints(begin, begin + s2, counters);
+        } else {
+            sort3(begin + s2, begin, end - 1, counters);
+        }
+
+        // Pivô igual ao elemento anterior: só há iguais a ele à esquerda
+        if (!leftmost) {
+            COUNT_COMPARISON(counters);
+            if (!SORT_LESS(*(begin - 1), *begin)) {
+                begin = partition_left(begin, end, counters) + 1;
+                continue;
+            }
+        }
+
+        int already_partitioned;
+        int *pivot_pos = partition_right_branchless(
+            begin, end, &already_partitioned, counters);
+
+        ptrdiff_t l_size = pivot_pos - begin;
+        ptrdiff_t r_size = end - (pivot_pos + 1);
+        int highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+        if (highly_unbalanced) {
+            // Partições ruins demais: a entrada é adversária
+            if (--bad_allowed == 0) {
+                heap_sort_range(begin, 0, end - begin - 1, counters);
+                return;
+            }
+
+            // Embaralhar alguns elementos para quebrar o padrão
+            if (l_size >= PDQ_INSERTION_THRESHOLD) {
+                swap_ints(begin, begin + l_size / 4, counters);
+                swap_ints(pivot_pos - 1, pivot_pos - l_size / 4, counters);
+                if (l_size > PDQ_NINTHER_THRESHOLD) {
+                    swap_ints(begin + 1, begin + (l_size / 4 + 1), counters);
+                    swap_ints(begin + 2, begin + (l_size / 4 + 2), counters);
+                    swap_ints(pivot_pos - 2, pivot_pos - (l_size / 4 + 1),
+                              counters);
+                    swap_ints(pivot_pos - 3, pivot_pos - (l_size / 4 + 2),
+                              counters);
+                }
+            }
+            if (r_size >= PDQ_INSERTION_THRESHOLD) {
+                swap_ints(pivot_pos + 1, pivot_pos + (1 + r_size / 4),
+                          counters);
+                swap_ints(end - 1, end - r_size / 4, counters);
+                if (r_size > PDQ_NINTHER_THRESHOLD) {
+                    swap_ints(pivot_pos + 2, pivot_pos + (2 + r_size / 4),
+                              counters);
+                    swap_ints(pivot_pos + 3, pivot_pos + (3 + r_size / 4),
+                              counters);
+                    swap_ints(end - 2, end - (1 + r_size / 4), counters);
+                    swap_ints(end - 3, end - (2 + r_size / 4), counters);
+                }
+            }
+        } else if (already_partitioned &&
+                   partial_insertion_sort(begin, pivot_pos, counters) &&
+                   partial_insertion_sort(pivot_pos + 1, end, counters)) {
+            // Partição sem trocas e lados quase ordenados: terminado
+            return;
+        }
+
+        pdq_loop(begin, pivot_pos, bad_allowed, leftmost, counters);
+        begin = pivot_pos + 1;
+        leftmost = 0;
+    }
+}
+
+/**
+ * Pattern-defeating QuickSort
+ */
+SortResult SORT_KERNEL(pdq_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    int bad_allowed = 0;
+    size_t m;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    if (n > 1) {
+        for (m = n; m > 1; m >>= 1) {
+            bad_allowed++;
+        }
+        pdq_loop(arr, arr + n, bad_allowed, 1, &counters);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+#if SORT_COUNTED
+
+/**
+ * Indica se um algoritmo do registro é uma das referências
+ */
+int is_baseline_algorithm(const SortAlgorithm *algorithm) {
+    return algorithm != NULL &&
+           (algorithm->function == libc_qsort ||
+            algorithm->function == pdq_sort ||
+            algorithm->function == std_sort ||
+            algorithm->function == std_stable_sort ||
+            algorithm->function == std_sort_par_unseq);
+}
+
+#endif /* SORT_COUNTED */
@@ -0,0 +1,97 @@
+/**
+ * baseline_sorts.h
+ * Ordenações de referência: o que o código de produção realmente chama
+ * (qsort da libc, std::sort, std::stable_sort e std::sort paralelo do C++) e
+ * o pdqsort, padrão de fato das bibliotecas recentes. Todo algoritmo próprio
+ * deve vencê-las nas distribuições do projeto.
+ */
+
+#ifndef BASELINE_SORTS_H
+#define BASELINE_SORTS_H
+
+#include <stddef.h>
+
+#include "sorting_algorithms.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * qsort da libc com um comparador de int (chamada indireta por comparação);
+ * as movimentações não são observáveis e ficam em zero
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult libc_qsort(int *arr, size_t n);
+
+/**
+ * Pattern-defeating QuickSort (Orson Peters): partição em blocos sem desvios,
+ * pivô ninther, partição à esquerda para chaves iguais ao pivô anterior,
+ * detecção de trechos já ordenados por inserção parcial, embaralhamento
+ * após partições desbalanceadas e HeapSort ao esgotar log2(n) delas
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult pdq_sort(int *arr, size_t n);
+
+/**
+ * std::sort (std_sorts.cpp); só as comparações são contadas
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult std_sort(int *arr, size_t n);
+
+/**
+ * std::stable_sort (std_sorts.cpp); só as comparações são contadas, e o
+ * buffer auxiliar vem do operator new da libstdc++, fora do memory_tracker
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult std_stable_sort(int *arr, size_t n);
+
+/**
+ * std::sort(std::execution::par_unseq) (std_sorts.cpp). As threads são as
+ * do backend da libstdc++ (TBB, se disponível na compilação; senão serial),
+ * não as do pool do projeto, mas o TBB é limitado por tbb::global_control ao
+ * número de --threads, o que permite o speedup e o --scaling;
+ * result.variant indica o backend. A variante
+ * instrumentada usa std::execution::par, pois o contador atômico não é
+ * permitido em par_unseq.
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult std_sort_par_unseq(int *arr, size_t n);
+
+/**
+ * Variantes sem instrumentação
+ */
+SortResult libc_qsort_fast(int *arr, size_t n);
+SortResult pdq_sort_fast(int *arr, size_t n);
+SortResult std_sort_fast(int *arr, size_t n);
+SortResult std_stable_sort_fast(int *arr, size_t n);
+SortResult std_sort_par_unseq_fast(int *arr, size_t n);
+
+/**
+ * Indica se um algoritmo do registro é uma das referências
+ *
+ * @param algorithm Entrada do registro (NULL devolve 0)
+ * @return 1 se for uma referência, 0 caso contrário
+ */
+int is_baseline_algorithm(const SortAlgorithm *algorithm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BASELINE_SORTS_H */
@@ -0,0 +1,317 @@
+/**
+ * benchmark.c
+ * Implementação do motor de medição estatística
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "benchmark.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * Configuração padrão do motor de medição
+ */
+BenchConfig bench_default_config(void) {
+    BenchConfig config;
+
+    config.warmup = 1;
+    config.repetitions = 10;
+    config.min_repetitions = 3;
+    config.min_batch_time_s = 0.001;  // Lotes de pelo menos 1 ms
+    config.max_inner_loops = 10000;
+    config.max_batch_bytes = 64u * 1024u * 1024u;
+    config.cell_time_budget_s = 2.0;
+    config.bootstrap_resamples = 1000;
+    config.max_cv = 0.05;  // Desvio padrão de até 5% da média
+    config.noise_reruns = 2;
+
+    return config;
+}
+
+/**
+ * Lê o relógio monotônico
+ */
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+
+#ifdef CLOCK_MONOTONIC_RAW
+    // Relógio não ajustado pelo NTP, quando disponível
+    if (clock_gettime(CLOCK_MONOTONIC_RAW, &ts) != 0)
+#endif
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Lê o tempo de CPU consumido pelo processo
+ */
+uint64_t bench_process_cpu_ns(void) {
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Converte uma diferença de instantes em segundos
+ */
+double bench_elapsed_s(uint64_t start_ns, uint64_t end_ns) {
+    return (double)(end_ns - start_ns) / 1e9;
+}
+
+/**
+ * Comparador de doubles para qsort
+ */
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Percentil por interpolação linear sobre um array ordenado
+ */
+static double percentile(const double *sorted, int count, double p) {
+    if (count == 1) {
+        return sorted[0];
+    }
+
+    double rank = p * (count - 1);
+    int lower = (int)rank;
+    if (lower >= count - 1) {
+        return sorted[count - 1];
+    }
+
+    double fraction = rank - lower;
+    return sorted[lower] + fraction * (sorted[lower + 1] - sorted[lower]);
+}
+
+/**
+ * Gerador xorshift64* local, usado apenas pelo bootstrap
+ */
+static uint64_t bootstrap_next(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+/**
+ * Calcula mediana, p95, média, desvio padrão e IC bootstrap da mediana
+ */
+BenchStats bench_compute_stats(const double *samples, int count,
+                               int resamples) {
+    BenchStats stats = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    int i, r;
+
+    if (count <= 0) {
+        return stats;
+    }
+
+    double *sorted = (double *)malloc(count * sizeof(double));
+    double *resample = (double *)malloc(count * sizeof(double));
+    if (sorted == NULL || resample == NULL) {
+        free(sorted);
+        free(resample);
+        return stats;
+    }
+
+    memcpy(sorted, samples, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), compare_doubles);
+
+    stats.median = percentile(sorted, count, 0.5);
+    stats.p95 = percentile(sorted, count, 0.95);
+
+    // Média e desvio padrão amostral
+    double sum = 0.0;
+    for (i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    stats.mean = sum / count;
+
+    if (count > 1) {
+        double squares = 0.0;
+        for (i = 0; i < count; i++) {
+            double diff = samples[i] - stats.mean;
+            squares += diff * diff;
+        }
+        stats.stddev = sqrt(squares / (count - 1));
+    }
+
+    // Intervalo de confiança de 95% da mediana por bootstrap de percentis
+    if (count > 1 && resamples > 0) {
+        double *medians = (double *)malloc(resamples * sizeof(double));
+        if (medians != NULL) {
+            uint64_t state = 0x9E3779B97F4A7C15ull;  // Semente fixa
+
+            for (r = 0; r < resamples; r++) {
+                for (i = 0; i < count; i++) {
+                    resample[i] = sorted[bootstrap_next(&state) % count];
+                }
+                qsort(resample, count, sizeof(double), compare_doubles);
+                medians[r] = percentile(resample, count, 0.5);
+            }
+
+            qsort(medians, resamples, sizeof(double), compare_doubles);
+            stats.ci_low = percentile(medians, resamples, 0.025);
+            stats.ci_high = percentile(medians, resamples, 0.975);
+            free(medians);
+        }
+    } else {
+        stats.ci_low = stats.median;
+        stats.ci_high = stats.median;
+    }
+
+    free(sorted);
+    free(resample);
+    return stats;
+}
+
+/**
+ * Coeficiente de variação de uma amostra
+ */
+double bench_cv(const BenchStats *stats) {
+    return stats->mean > 0.0 ? stats->stddev / stats->mean : 0.0;
+}
+
+/**
+ * Laço de trabalho fixo da calibração: gerador congruencial linear, cuja
+ * dependência entre iterações impede a vetorização e a eliminação do laço
+ */
+static uint64_t spin_loop(uint64_t iterations, uint64_t seed) {
+    uint64_t x = seed;
+    uint64_t i;
+
+    for (i = 0; i < iterations; i++) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    return x;
+}
+
+/**
+ * Mede rodadas de um laço de trabalho fixo para estimar a estabilidade do
+ * relógio
+ */
+BenchCalibration bench_calibrate_clock(int rounds, double round_time_s) {
+    BenchCalibration calibration = {0.0, 0.0, 0, 0};
+    volatile uint64_t sink = 0;
+    uint64_t iterations = 1u << 12;
+    int r;
+
+    if (rounds < 2) {
+        rounds = 2;
+    }
+    double *times = (double *)malloc(rounds * sizeof(double));
+    if (times == NULL) {
+        return calibration;
+    }
+
+    // Dobrar o trabalho até uma rodada durar round_time_s (o próprio ajuste
+    // serve de aquecimento)
+    for (;;) {
+        uint64_t start_time = bench_now_ns();
+        sink += spin_loop(iterations, sink);
+        double elapsed = bench_elapsed_s(start_time, bench_now_ns());
+        if (elapsed >= round_time_s || iterations >= (1ull << 40)) {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    for (r = 0; r < rounds; r++) {
+        uint64_t start_time = bench_now_ns();
+        sink += spin_loop(iterations, sink);
+        times[r] = bench_elapsed_s(start_time, bench_now_ns());
+    }
+
+    BenchStats stats = bench_compute_stats(times, rounds, 0);
+    calibration.cv = bench_cv(&stats);
+    calibration.round_time = stats.mean;
+    calibration.iterations = iterations;
+    calibration.rounds = rounds;
+
+    free(times);
+    return calibration;
+}
+
+/**
+ * Amostra rotulada com o grupo de origem (teste de Mann-Whitney)
+ */
+typedef struct {
+    double value;
+    int group;
+} RankedSample;
+
+static int compare_ranked(const void *a, const void *b) {
+    return compare_doubles(&((const RankedSample *)a)->value,
+                           &((const RankedSample *)b)->value);
+}
+
+/**
+ * Teste U de Mann-Whitney bicaudal
+ */
+double bench_mann_whitney(const double *a, int count_a, const double *b,
+                          int count_b) {
+    int total = count_a + count_b;
+    int i, j;
+
+    if (count_a <= 0 || count_b <= 0) {
+        return 1.0;
+    }
+
+    RankedSample *all = (RankedSample *)malloc(total * sizeof(RankedSample));
+    if (all == NULL) {
+        return 1.0;
+    }
+    for (i = 0; i < count_a; i++) {
+        all[i].value = a[i];
+        all[i].group = 0;
+    }
+    for (i = 0; i < count_b; i++) {
+        all[count_a + i].value = b[i];
+        all[count_a + i].group = 1;
+    }
+    qsort(all, total, sizeof(RankedSample), compare_ranked);
+
+    // Soma dos postos de a (empates recebem o posto médio)
+    double rank_sum = 0.0;
+    double ties = 0.0;
+    for (i = 0; i < total; i = j) {
+        for (j = i + 1; j < total && all[j].value == all[i].value; j++) {
+        }
+        double average_rank = (i + 1 + j) / 2.0;
+        double tied = j - i;
+        int k;
+        for (k = i; k < j; k++) {
+            if (all[k].group == 0) {
+                rank_sum += average_rank;
+            }
+        }
+        ties += tied * tied * tied - tied;
+    }
+    free(all);
+
+    // Aproximação normal com correções de empates e de continuidade
+    double u = rank_sum - count_a * (count_a + 1.0) / 2.0;
+    double mean = count_a * (double)count_b / 2.0;
+    double variance = count_a * (double)count_b / 12.0 *
+                      ((total + 1.0) - ties / ((double)total * (total - 1.0)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+
+    double z = (fabs(u - mean) - 0.5) / sqrt(variance);
+    if (z <= 0.0) {
+        return 1.0;
+    }
+    return erfc(z / sqrt(2.0));
+}
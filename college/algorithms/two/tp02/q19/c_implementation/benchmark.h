@@ -0,0 +1,134 @@
+/**
+ * benchmark.h
+ * Motor de medição estatística: relógio monotônico em nanossegundos,
+ * aquecimento, repetições e estatísticas por célula (algoritmo x tamanho)
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Também usado por std_sorts.cpp
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Configuração do motor de medição
+ */
+typedef struct {
+    int warmup;                // Execuções de aquecimento (não medidas)
+    int repetitions;           // Número máximo de repetições medidas
+    int min_repetitions;       // Mínimo de repetições, mesmo sem orçamento
+    double min_batch_time_s;   // Tempo mínimo de um lote (escala o laço interno)
+    int max_inner_loops;       // Limite de ordenações por lote
+    size_t max_batch_bytes;    // Memória máxima para as cópias de um lote
+    double cell_time_budget_s; // Orçamento de tempo medido por célula
+    int bootstrap_resamples;   // Reamostragens do intervalo de confiança
+    double max_cv;             // Coeficiente de variação tolerado (0 = sem
+                               // remedição)
+    int noise_reruns;          // Remedições de uma célula acima de max_cv
+} BenchConfig;
+
+/**
+ * Estatísticas de uma amostra de tempos (em segundos)
+ */
+typedef struct {
+    double median;   // Mediana
+    double p95;      // Percentil 95
+    double mean;     // Média
+    double stddev;   // Desvio padrão amostral
+    double ci_low;   // Limite inferior do IC 95% da mediana (bootstrap)
+    double ci_high;  // Limite superior do IC 95% da mediana (bootstrap)
+} BenchStats;
+
+/**
+ * Resultado do laço de calibração do relógio
+ */
+typedef struct {
+    double cv;            // Coeficiente de variação das rodadas
+    double round_time;    // Duração média de uma rodada (s)
+    uint64_t iterations;  // Iterações do laço por rodada
+    int rounds;           // Rodadas medidas
+} BenchCalibration;
+
+/**
+ * Configuração padrão do motor de medição
+ *
+ * @return Configuração com valores padrão
+ */
+BenchConfig bench_default_config(void);
+
+/**
+ * Lê o relógio monotônico
+ *
+ * @return Instante atual em nanossegundos
+ */
+uint64_t bench_now_ns(void);
+
+/**
+ * Lê o tempo de CPU consumido pelo processo (todas as threads)
+ *
+ * @return Tempo de CPU em nanossegundos
+ */
+uint64_t bench_process_cpu_ns(void);
+
+/**
+ * Converte uma diferença de instantes em segundos
+ *
+ * @param start_ns Instante inicial (bench_now_ns)
+ * @param end_ns Instante final (bench_now_ns)
+ * @return Intervalo em segundos
+ */
+double bench_elapsed_s(uint64_t start_ns, uint64_t end_ns);
+
+/**
+ * Calcula mediana, p95, média, desvio padrão e IC bootstrap da mediana
+ *
+ * @param samples Tempos medidos em segundos
+ * @param count Quantidade de amostras
+ * @param resamples Número de reamostragens do bootstrap
+ * @return Estatísticas da amostra
+ */
+BenchStats bench_compute_stats(const double *samples, int count,
+                               int resamples);
+
+/**
+ * Coeficiente de variação (desvio padrão / média) de uma amostra
+ *
+ * @param stats Estatísticas da amostra
+ * @return Coeficiente de variação (0 se a média não for positiva)
+ */
+double bench_cv(const BenchStats *stats);
+
+/**
+ * Mede rodadas de um laço de trabalho fixo (só aritmética em registradores)
+ * para estimar a estabilidade do relógio: frequência variável, turbo e
+ * outros processos aparecem como variação entre as rodadas
+ *
+ * @param rounds Rodadas medidas
+ * @param round_time_s Duração aproximada de cada rodada
+ * @return Coeficiente de variação e duração das rodadas
+ */
+BenchCalibration bench_calibrate_clock(int rounds, double round_time_s);
+
+/**
+ * Teste U de Mann-Whitney bicaudal entre duas amostras de tempos, pela
+ * aproximação normal com correções de empates e de continuidade
+ *
+ * @param a Primeira amostra
+ * @param count_a Tamanho da primeira amostra
+ * @param b Segunda amostra
+ * @param count_b Tamanho da segunda amostra
+ * @return p-valor (1 se alguma amostra estiver vazia)
+ */
+double bench_mann_whitney(const double *a, int count_a, const double *b,
+                          int count_b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCHMARK_H */
@@ -0,0 +1,63 @@
+/**
+ * checksum.c
+ * Soma de verificação de multiconjuntos
+ */
+
+#include "checksum.h"
+
+#include <string.h>
+
+/**
+ * Finalizador do SplitMix64
+ */
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * Acrescenta n elementos à soma
+ */
+void multiset_checksum_add(MultisetChecksum *checksum, const void *arr,
+                           size_t n, size_t element_size) {
+    const unsigned char *bytes = (const unsigned char *)arr;
+    size_t i, offset;
+
+    for (i = 0; i < n; i++) {
+        const unsigned char *element = bytes + i * element_size;
+        uint64_t hash = 0x9E3779B97F4A7C15ull ^ element_size;
+
+        for (offset = 0; offset < element_size; offset += 8) {
+            uint64_t chunk = 0;
+            size_t length =
+                element_size - offset < 8 ? element_size - offset : 8;
+            memcpy(&chunk, element + offset, length);
+            hash = mix64(hash ^ chunk);
+        }
+        checksum->sum += hash;
+        checksum->sum_mixed += mix64(hash + 0x632BE59BD9B4E019ull);
+    }
+}
+
+/**
+ * Soma de verificação de um array inteiro
+ */
+MultisetChecksum multiset_checksum(const void *arr, size_t n,
+                                   size_t element_size) {
+    MultisetChecksum checksum = {0, 0};
+
+    multiset_checksum_add(&checksum, arr, n, element_size);
+    return checksum;
+}
+
+/**
+ * Compara duas somas
+ */
+int multiset_checksum_equal(const MultisetChecksum *a,
+                            const MultisetChecksum *b) {
+    return a->sum == b->sum && a->sum_mixed == b->sum_mixed;
+}
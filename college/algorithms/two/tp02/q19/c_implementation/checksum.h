@@ -0,0 +1,50 @@
+/**
+ * checksum.h
+ * Soma de verificação do multiconjunto de elementos de um array: não
+ * depende da ordem, então só muda se um elemento foi perdido, duplicado ou
+ * alterado. Pode ser acumulada por partes (arquivos lidos em blocos)
+ */
+
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Soma de verificação de um multiconjunto
+ */
+typedef struct {
+    uint64_t sum;        // Soma dos hashes dos elementos
+    uint64_t sum_mixed;  // Soma de um segundo hash (colisões independentes)
+} MultisetChecksum;
+
+/**
+ * Acrescenta n elementos de element_size bytes à soma
+ *
+ * @param checksum Soma acumulada (começa zerada)
+ * @param arr Array
+ * @param n Número de elementos
+ * @param element_size Bytes por elemento (chave ou registro)
+ */
+void multiset_checksum_add(MultisetChecksum *checksum, const void *arr,
+                           size_t n, size_t element_size);
+
+/**
+ * Calcula a soma de verificação dos n elementos de element_size bytes
+ *
+ * @param arr Array
+ * @param n Número de elementos
+ * @param element_size Bytes por elemento (chave ou registro)
+ * @return Soma de verificação
+ */
+MultisetChecksum multiset_checksum(const void *arr, size_t n,
+                                   size_t element_size);
+
+/**
+ * @return 1 se as duas somas são iguais, 0 caso contrário
+ */
+int multiset_checksum_equal(const MultisetChecksum *a,
+                            const MultisetChecksum *b);
+
+#endif /* CHECKSUM_H */
@@ -0,0 +1,1173 @@
+/**
+ * cli.c
+ * Implementação da interpretação da linha de comando
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "cli.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "antiqsort.h"
+#include "segmented_sorts.h"
+#include "selection_sorts.h"
+#include "wide_sorts.h"
+
+// Limite de tamanhos gerados por uma faixa (evita listas acidentais enormes)
+#define MAX_SIZES 4096
+
+// Maior tamanho de entrada aceito (2^40 elementos)
+#define MAX_ARRAY_SIZE (1LL << 40)
+
+// Maior expoente aceito por --zipf
+#define ZIPF_MAX_EXPONENT 100
+
+// Algoritmo das corridas da ordenação externa quando --algorithms não é dado
+#define EXTERNAL_DEFAULT_ALGORITHM "lsd_radix_sort_11"
+
+/**
+ * Exibe as opções disponíveis
+ */
+void print_usage(FILE *out, const char *program) {
+    int i;
+
+    fprintf(out, "Uso: %s [opções] [diretório_de_resultados]\n\n", program);
+    fprintf(out,
+            "Opções:\n"
+            "  --algorithms LISTA     Algoritmos separados por vírgula "
+            "(padrão: all)\n"
+            "  --sizes LISTA          Tamanhos: N, A-B:PASSO (aritmética) ou "
+            "A-B*FATOR\n"
+            "                         (geométrica); ex.: 100,1000-5000:1000,"
+            "1e4-1e6*10\n"
+            "  --distributions LISTA  Distribuições separadas por vírgula "
+            "(padrão: random)\n"
+            "  --swaps K              Trocas do nearly_sorted "
+            "(padrão: n/100)\n"
+            "  --unique N             Valores distintos do few_unique "
+            "(padrão: 16)\n"
+            "  --sawtooth-period P    Período do sawtooth, mínimo 2 "
+            "(padrão: raiz de n)\n"
+            "  --zipf S               Expoente da lei de Zipf, entre 0 e "
+            "%d (padrão: 1)\n"
+            "  --repetitions N        Repetições medidas por célula "
+            "(padrão: 10)\n"
+            "  --warmup N             Execuções de aquecimento (padrão: 1)\n"
+            "  --seed N               Semente do gerador de entradas "
+            "(padrão: 42)\n"
+            "  --threads N            Threads (padrão: 0 = todas as CPUs)\n"
+            "  --k N                  Elementos ordenados pelos algoritmos de "
+            "seleção (padrão:\n"
+            "                         %d); com \"all\", inclui a seleção na "
+            "matriz\n"
+            "  --time-budget SEG      Tempo medido máximo por célula "
+            "(padrão: 2)\n"
+            "  --max-cv PCT           Coeficiente de variação tolerado; "
+            "células acima dele\n"
+            "                         são medidas de novo e, se persistir, "
+            "marcadas como\n"
+            "                         instáveis (padrão: 5; 0 desliga)\n"
+            "  --noise-reruns N       Remedições de uma célula ruidosa "
+            "(padrão: 2)\n"
+            "  --no-pin               Não fixa a thread de medição em uma "
+            "CPU\n"
+            "  --simd NÍVEL           Vetorização: auto, avx512, avx2 ou "
+            "scalar (padrão: auto)\n"
+            "  --key-type TIPO        Chaves: int32, int64 ou uint64 "
+            "(padrão: int32)\n"
+            "  --layout FORMA         Dados: keys, records (registros por "
+            "valor), argsort\n"
+            "                         (índices) ou pointers (ponteiros); "
+            "padrão: keys\n"
+            "  --payload BYTES        Carga de cada registro: 8, 16, 64 ou "
+            "256 (padrão: %d)\n"
+            "  --pages POLÍTICA       Páginas dos buffers: auto, hugetlb, "
+            "thp ou small\n"
+            "                         (padrão: auto)\n"
+            "  --output DIR           Diretório dos resultados "
+            "(padrão: ../results)\n"
+            "  --json ARQUIVO         Arquivo JSON Lines "
+            "(padrão: DIR/results.jsonl)\n"
+            "  --history ARQUIVO      Histórico acrescentado a cada execução "
+            "(padrão:\n"
+            "                         DIR/history.jsonl)\n"
+            "  --branch-misses        Imprime os desvios mal previstos de "
+            "cada célula\n"
+            "                         (por elemento e em relação ao primeiro "
+            "algoritmo)\n"
+            "  --segmented            Cada tamanho é um número de segmentos "
+            "ordenados de uma\n"
+            "                         vez por segmented_sort; os algoritmos "
+            "são chamados em\n"
+            "                         cada segmento (padrão:\n"
+            "                         " SEGMENT_BASELINE_ALGORITHMS ")\n"
+            "  --segment-length N     Maior tamanho de segmento "
+            "(padrão: %d)\n"
+            "  --scaling MAX          Estudo de escalonamento: cada célula "
+            "com 1, 2, 4, ...,\n"
+            "                         MAX threads (0 = todas as CPUs), "
+            "fixadas em CPUs\n"
+            "                         distintas; só algoritmos paralelos\n"
+            "  --weak-scaling         Escalonamento fraco: --sizes é o "
+            "tamanho por thread\n"
+            "                         (implica --scaling 0 se ausente)\n"
+            "  --help                 Exibe esta ajuda\n"
+            "\nOrdenação externa (arquivo de chaves int maior que a "
+            "memória):\n"
+            "  --external ARQUIVO     Ordena ARQUIVO em vez da matriz; "
+            "--algorithms escolhe\n"
+            "                         o algoritmo das corridas (padrão: "
+            EXTERNAL_DEFAULT_ALGORITHM ")\n"
+            "  --external-output ARQ  Arquivo ordenado "
+            "(padrão: ARQUIVO.sorted)\n"
+            "  --generate N           Gera N chaves em ARQUIVO antes de "
+            "ordenar (primeira\n"
+            "                         distribuição e semente do plano)\n"
+            "  --memory MB            Memória de trabalho (padrão: 256)\n"
+            "  --io-block KB          Bloco de E/S por corrida na "
+            "intercalação (padrão: 1024)\n"
+            "  --io MECANISMO         E/S: auto, io_uring ou sync "
+            "(padrão: auto)\n"
+            "  --temp-dir DIR         Diretório das corridas "
+            "(padrão: $TMPDIR ou /tmp)\n"
+            "\nSample sort distribuído (nós simulados por processos e "
+            "memória compartilhada):\n"
+            "  --distributed LISTA    Números de nós, ex.: 1,2,4,8; cada "
+            "tamanho e distribuição\n"
+            "                         é ordenado com cada um; "
+            "--algorithms escolhe a\n"
+            "                         ordenação local (padrão: "
+            DISTRIBUTED_DEFAULT_ALGORITHM ")\n"
+            "  --latency US           Latência injetada por mensagem, em "
+            "microssegundos\n"
+            "                         (padrão: 0)\n"
+            "  --bandwidth MB/S       Banda de cada nó (padrão: 0 = sem "
+            "limite)\n"
+            "\nEntradas adversárias (antiqsort de McIlroy):\n"
+            "  --adversary            Gera, para cada algoritmo atacável "
+            "de --algorithms, a\n"
+            "                         entrada que o leva ao pior caso e a "
+            "repete em todos\n"
+            "                         eles, comparando com a entrada "
+            "random (padrão de\n"
+            "                         --sizes: " ADVERSARY_DEFAULT_SIZES
+            "; máximo: %d)\n",
+            ZIPF_MAX_EXPONENT, SELECTION_DEFAULT_K, RECORD_DEFAULT_PAYLOAD,
+            SEGMENT_DEFAULT_MAX_LENGTH, ADVERSARY_MAX_SIZE);
+    fprintf(out,
+            "\nComparação de revisões no histórico:\n"
+            "  %s compare [opções] BASE NOVA\n"
+            "  BASE e NOVA são revisões de git describe (ou prefixos de uma "
+            "única revisão)\n"
+            "  --history ARQUIVO      Histórico (padrão: "
+            "../results/history.jsonl)\n"
+            "  --threshold PCT        Piora da mediana tolerada "
+            "(padrão: 5)\n"
+            "  --alpha A              Nível de significância do teste de "
+            "Mann-Whitney\n"
+            "                         (padrão: 0.05)\n"
+            "  Saída: 0 sem regressões, 1 com regressão, 2 em caso de erro\n",
+            program);
+
+    fprintf(out, "\nAlgoritmos:");
+    for (i = 0; i < num_sort_algorithms; i++) {
+        fprintf(out, " %s", sort_algorithms[i].name);
+    }
+    fprintf(out, "\nAlgoritmos de seleção (top-k):");
+    for (i = 0; i < num_selection_algorithms; i++) {
+        fprintf(out, " %s", selection_algorithms[i].name);
+    }
+    fprintf(out, "\nAlgoritmos com chaves de 64 bits:");
+    for (i = 0; i < num_wide_sort_algorithms; i++) {
+        fprintf(out, " %s", wide_sort_algorithms[i].name);
+    }
+    fprintf(out, "\nAlgoritmos com registros:");
+    for (i = 0; i < num_record_sort_algorithms; i++) {
+        fprintf(out, " %s", record_sort_algorithms[i].name);
+    }
+    fprintf(out, "\nDistribuições:");
+    for (i = 0; i < DIST_COUNT; i++) {
+        fprintf(out, " %s", distribution_name((Distribution)i));
+    }
+    fprintf(out, "\n");
+}
+
+/**
+ * Lê um número real (aceita notação científica, como 1e6)
+ */
+static int parse_double(const char *text, double *value) {
+    char *end;
+    errno = 0;
+    *value = strtod(text, &end);
+    return errno == 0 && end != text && *end == '\0';
+}
+
+/**
+ * Lê um inteiro não negativo
+ */
+static int parse_count(const char *text, long long max, long long *value) {
+    double parsed;
+    if (!parse_double(text, &parsed) || parsed < 0 || parsed > (double)max ||
+        parsed != (double)(long long)parsed) {
+        return 0;
+    }
+    *value = (long long)parsed;
+    return 1;
+}
+
+/**
+ * Acrescenta um tamanho à lista do plano
+ */
+static int append_size(TestPlan *plan, long long size) {
+    if (size < 1 || size > MAX_ARRAY_SIZE) {
+        fprintf(stderr, "Tamanho fora do intervalo: %lld\n", size);
+        return 0;
+    }
+    if (plan->num_sizes >= MAX_SIZES) {
+        fprintf(stderr, "Tamanhos demais (máximo %d)\n", MAX_SIZES);
+        return 0;
+    }
+    plan->sizes[plan->num_sizes++] = (size_t)size;
+    return 1;
+}
+
+/**
+ * Interpreta um item da lista de tamanhos: N, A-B:PASSO ou A-B*FATOR
+ */
+static int parse_size_item(TestPlan *plan, char *item) {
+    char *dash = strchr(item + 1, '-');  // Ignora um sinal no início
+    double first, last, step;
+    long long count;
+
+    if (dash == NULL) {
+        if (!parse_count(item, MAX_ARRAY_SIZE, &count)) {
+            fprintf(stderr, "Tamanho inválido: %s\n", item);
+            return 0;
+        }
+        return append_size(plan, count);
+    }
+
+    *dash = '\0';
+    char *rest = dash + 1;
+    char *step_mark = strpbrk(rest, ":*");
+    char kind = ':';
+    step = 0.0;
+
+    if (step_mark != NULL) {
+        kind = *step_mark;
+        *step_mark = '\0';
+        if (!parse_double(step_mark + 1, &step)) {
+            fprintf(stderr, "Passo inválido: %s\n", step_mark + 1);
+            return 0;
+        }
+    }
+    if (!parse_double(item, &first) || !parse_double(rest, &last) ||
+        first < 1 || last < first) {
+        fprintf(stderr, "Faixa de tamanhos inválida: %s-%s\n", item, rest);
+        return 0;
+    }
+
+    if (step_mark == NULL) {
+        // Sem passo: apenas os extremos
+        return append_size(plan, (long long)first) &&
+               (last == first || append_size(plan, (long long)last));
+    }
+
+    if (kind == ':') {
+        if (step < 1) {
+            fprintf(stderr, "O passo aritmético deve ser >= 1\n");
+            return 0;
+        }
+        double value;
+        for (value = first; value <= last; value += step) {
+            if (!append_size(plan, (long long)value)) {
+                return 0;
+            }
+        }
+    } else {
+        if (step <= 1.0) {
+            fprintf(stderr, "O fator geométrico deve ser > 1\n");
+            return 0;
+        }
+        double value;
+        // Tolerância para erros de arredondamento no último termo
+        for (value = first; value <= last * (1.0 + 1e-9); value *= step) {
+            long long size = (long long)(value + 0.5);
+            if (plan->num_sizes > 0 &&
+                plan->sizes[plan->num_sizes - 1] == (size_t)size) {
+                continue;  // Fatores pequenos podem repetir o tamanho
+            }
+            if (!append_size(plan, size)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * Interpreta a lista de tamanhos
+ */
+static int parse_sizes(TestPlan *plan, const char *spec) {
+    char *copy = strdup(spec);
+    char *save = NULL;
+    char *item;
+    int ok = 1;
+
+    if (copy == NULL) {
+        return 0;
+    }
+
+    plan->num_sizes = 0;
+    for (item = strtok_r(copy, ",", &save); item != NULL && ok;
+         item = strtok_r(NULL, ",", &save)) {
+        ok = parse_size_item(plan, item);
+    }
+    free(copy);
+
+    if (ok && plan->num_sizes == 0) {
+        fprintf(stderr, "Nenhum tamanho informado\n");
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * Número máximo de algoritmos em um plano (ordenação e seleção)
+ */
+static int max_plan_algorithms(void) {
+    return num_sort_algorithms + num_selection_algorithms;
+}
+
+/**
+ * Interpreta a lista de algoritmos ("all" seleciona todos os de ordenação
+ * completa; os de seleção entram só pelo nome ou com --k)
+ *
+ * @param all Destino: 1 se a lista foi "all"
+ */
+static int parse_algorithms(TestPlan *plan, const char *spec, int *all) {
+    char *copy = strdup(spec);
+    char *save = NULL;
+    char *item;
+    int i, ok = 1;
+
+    if (copy == NULL) {
+        return 0;
+    }
+
+    plan->num_algorithms = 0;
+    *all = 0;
+    for (item = strtok_r(copy, ",", &save); item != NULL && ok;
+         item = strtok_r(NULL, ",", &save)) {
+        if (strcmp(item, "all") == 0) {
+            plan->num_algorithms = 0;
+            for (i = 0; i < num_sort_algorithms; i++) {
+                plan->algorithms[plan->num_algorithms++] = &sort_algorithms[i];
+            }
+            *all = 1;
+            break;
+        }
+
+        const SortAlgorithm *algorithm = find_sort_algorithm(item);
+        if (algorithm == NULL) {
+            algorithm = find_selection_algorithm(item);
+        }
+        if (algorithm == NULL) {
+            fprintf(stderr, "Algoritmo desconhecido: %s\n", item);
+            ok = 0;
+        } else if (plan->num_algorithms >= max_plan_algorithms()) {
+            fprintf(stderr, "Algoritmos repetidos demais\n");
+            ok = 0;
+        } else {
+            plan->algorithms[plan->num_algorithms++] = algorithm;
+        }
+    }
+    free(copy);
+
+    if (ok && plan->num_algorithms == 0) {
+        fprintf(stderr, "Nenhum algoritmo informado\n");
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * Interpreta a lista de distribuições ("all" seleciona todas)
+ */
+static int parse_distributions(TestPlan *plan, const char *spec) {
+    char *copy = strdup(spec);
+    char *save = NULL;
+    char *item;
+    int i, ok = 1;
+
+    if (copy == NULL) {
+        return 0;
+    }
+
+    plan->num_distributions = 0;
+    for (item = strtok_r(copy, ",", &save); item != NULL && ok;
+         item = strtok_r(NULL, ",", &save)) {
+        if (strcmp(item, "all") == 0) {
+            plan->num_distributions = 0;
+            for (i = 0; i < DIST_COUNT; i++) {
+                plan->distributions[plan->num_distributions++] =
+                    (Distribution)i;
+            }
+            break;
+        }
+
+        Distribution kind;
+        if (!distribution_from_name(item, &kind)) {
+            fprintf(stderr, "Distribuição desconhecida: %s\n", item);
+            ok = 0;
+        } else if (plan->num_distributions >= DIST_COUNT) {
+            fprintf(stderr, "Distribuições repetidas demais\n");
+            ok = 0;
+        } else {
+            plan->distributions[plan->num_distributions++] = kind;
+        }
+    }
+    free(copy);
+
+    if (ok && plan->num_distributions == 0) {
+        fprintf(stderr, "Nenhuma distribuição informada\n");
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * Mantém apenas os algoritmos com variante para chaves de 64 bits; um
+ * algoritmo pedido pelo nome sem essa variante é um erro
+ */
+static int filter_wide_algorithms(TestPlan *plan, int all) {
+    int i, kept = 0;
+
+    for (i = 0; i < plan->num_algorithms; i++) {
+        const SortAlgorithm *algorithm = plan->algorithms[i];
+        if (find_wide_sort_algorithm(algorithm->name) != NULL) {
+            plan->algorithms[kept++] = algorithm;
+        } else if (!all) {
+            fprintf(stderr, "%s não tem variante para chaves %s\n",
+                    algorithm->name, key_type_name(plan->key_type));
+            return 0;
+        }
+    }
+    plan->num_algorithms = kept;
+    return 1;
+}
+
+/**
+ * Valida o plano com registros: chaves int32, carga suportada e apenas os
+ * algoritmos com variante para registros (pedir pelo nome um sem ela é um
+ * erro)
+ */
+static int check_record_plan(TestPlan *plan, int all) {
+    int i, kept = 0;
+
+    if (plan->layout == LAYOUT_KEYS) {
+        return 1;
+    }
+    if (plan->key_type != KEY_INT32) {
+        fprintf(stderr, "Os registros usam chaves int32\n");
+        return 0;
+    }
+    if (!record_payload_supported(plan->payload)) {
+        fprintf(stderr, "Carga sem registro correspondente: %zu bytes\n",
+                plan->payload);
+        return 0;
+    }
+    for (i = 0; i < plan->num_sizes; i++) {
+        if (plan->layout == LAYOUT_ARGSORT && plan->sizes[i] > UINT32_MAX) {
+            fprintf(stderr, "O argsort usa índices de 32 bits\n");
+            return 0;
+        }
+    }
+
+    for (i = 0; i < plan->num_algorithms; i++) {
+        const SortAlgorithm *algorithm = plan->algorithms[i];
+        if (find_record_sort_algorithm(algorithm->name) != NULL) {
+            plan->algorithms[kept++] = algorithm;
+        } else if (!all) {
+            fprintf(stderr, "%s não tem variante para registros\n",
+                    algorithm->name);
+            return 0;
+        }
+    }
+    plan->num_algorithms = kept;
+    return 1;
+}
+
+/**
+ * Valida o plano segmentado: chaves int32 sem registros e apenas algoritmos
+ * de ordenação completa; "all" vira os algoritmos chamados em cada segmento
+ * em SEGMENT_BASELINE_ALGORITHMS
+ */
+static int check_segmented_plan(TestPlan *plan, int all) {
+    int i;
+
+    if (!plan->segmented) {
+        return 1;
+    }
+    if (plan->key_type != KEY_INT32 || plan->layout != LAYOUT_KEYS ||
+        plan->external_input != NULL) {
+        fprintf(stderr, "O modo segmentado usa apenas chaves int32 em "
+                        "memória\n");
+        return 0;
+    }
+    if (all) {
+        int ignored;
+        return parse_algorithms(plan, SEGMENT_BASELINE_ALGORITHMS, &ignored);
+    }
+    for (i = 0; i < plan->num_algorithms; i++) {
+        if (find_selection_algorithm(plan->algorithms[i]->name) != NULL) {
+            fprintf(stderr, "%s não ordena os segmentos inteiros\n",
+                    plan->algorithms[i]->name);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Preenche as contagens de threads do estudo de escalonamento: potências de
+ * dois até max_threads, que entra no fim se não for uma delas
+ */
+static void set_scaling_threads(TestPlan *plan, int max_threads) {
+    int threads;
+
+    if (max_threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        max_threads = cpus > 0 ? (int)cpus : 1;
+    }
+    plan->num_scaling_threads = 0;
+    for (threads = 1; threads < max_threads &&
+                      plan->num_scaling_threads < SCALING_MAX_STEPS - 1;
+         threads *= 2) {
+        plan->scaling_threads[plan->num_scaling_threads++] = threads;
+    }
+    plan->scaling_threads[plan->num_scaling_threads++] = max_threads;
+}
+
+/**
+ * Valida o estudo de escalonamento: chaves int32 em memória e apenas
+ * algoritmos paralelos (pedir pelo nome um serial é um erro)
+ */
+static int check_scaling_plan(TestPlan *plan, int all) {
+    int i, kept = 0;
+
+    if (plan->num_scaling_threads == 0) {
+        return 1;
+    }
+    if (plan->key_type != KEY_INT32 || plan->layout != LAYOUT_KEYS ||
+        plan->segmented || plan->external_input != NULL ||
+        plan->num_distributed_workers > 0) {
+        fprintf(stderr, "O estudo de escalonamento usa apenas a matriz com "
+                        "chaves int32\n");
+        return 0;
+    }
+
+    for (i = 0; i < plan->num_algorithms; i++) {
+        const SortAlgorithm *algorithm = plan->algorithms[i];
+        if (algorithm->parallel) {
+            plan->algorithms[kept++] = algorithm;
+        } else if (!all) {
+            fprintf(stderr, "%s não é paralelo\n", algorithm->name);
+            return 0;
+        }
+    }
+    plan->num_algorithms = kept;
+    return 1;
+}
+
+/**
+ * Valida o plano da ordenação externa e escolhe o algoritmo das corridas
+ */
+static int check_external_plan(TestPlan *plan, int all) {
+    if (plan->key_type != KEY_INT32 || plan->layout != LAYOUT_KEYS) {
+        fprintf(stderr, "A ordenação externa usa apenas chaves int32\n");
+        return 0;
+    }
+    if (all) {
+        plan->algorithms[0] = find_sort_algorithm(EXTERNAL_DEFAULT_ALGORITHM);
+        plan->num_algorithms = 1;
+    } else if (plan->num_algorithms != 1) {
+        fprintf(stderr, "A ordenação externa usa um único algoritmo para "
+                        "as corridas\n");
+        return 0;
+    } else if (find_selection_algorithm(plan->algorithms[0]->name) != NULL) {
+        fprintf(stderr, "%s não ordena o array inteiro\n",
+                plan->algorithms[0]->name);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Interpreta a lista de números de nós do sample sort distribuído
+ */
+static int parse_workers(TestPlan *plan, const char *spec) {
+    char *copy = strdup(spec);
+    char *save = NULL;
+    char *item;
+    int ok = 1;
+
+    if (copy == NULL) {
+        return 0;
+    }
+
+    plan->num_distributed_workers = 0;
+    for (item = strtok_r(copy, ",", &save); item != NULL && ok;
+         item = strtok_r(NULL, ",", &save)) {
+        long long count;
+        ok = parse_count(item, DISTRIBUTED_MAX_WORKERS, &count) &&
+             count >= 1 &&
+             plan->num_distributed_workers < DISTRIBUTED_MAX_WORKERS;
+        if (ok) {
+            plan->distributed_workers[plan->num_distributed_workers++] =
+                (int)count;
+        }
+    }
+    free(copy);
+
+    if (ok && plan->num_distributed_workers == 0) {
+        fprintf(stderr, "Nenhum número de nós informado\n");
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * Valida o plano do sample sort distribuído e escolhe a ordenação local:
+ * os nós são processos criados com fork, que não herdam as threads do pool,
+ * então algoritmos paralelos não são aceitos
+ */
+static int check_distributed_plan(TestPlan *plan, int all) {
+    if (plan->key_type != KEY_INT32 || plan->layout != LAYOUT_KEYS ||
+        plan->segmented || plan->external_input != NULL) {
+        fprintf(stderr, "O sample sort distribuído usa apenas chaves int32 "
+                        "em memória\n");
+        return 0;
+    }
+    if (all) {
+        plan->algorithms[0] =
+            find_sort_algorithm(DISTRIBUTED_DEFAULT_ALGORITHM);
+        plan->num_algorithms = 1;
+    } else if (plan->num_algorithms != 1) {
+        fprintf(stderr, "O sample sort distribuído usa um único algoritmo "
+                        "local\n");
+        return 0;
+    } else if (plan->algorithms[0]->parallel ||
+               find_selection_algorithm(plan->algorithms[0]->name) != NULL) {
+        fprintf(stderr, "%s não serve como ordenação local de um nó\n",
+                plan->algorithms[0]->name);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Valida o plano adversário: chaves int32 em memória, algoritmos de
+ * ordenação completa (os atacáveis geram entradas, todos as repetem) e
+ * tamanhos até ADVERSARY_MAX_SIZE
+ */
+static int check_adversary_plan(TestPlan *plan) {
+    int i, targets = 0;
+
+    if (plan->key_type != KEY_INT32 || plan->layout != LAYOUT_KEYS ||
+        plan->segmented || plan->num_scaling_threads > 0 ||
+        plan->external_input != NULL || plan->num_distributed_workers > 0) {
+        fprintf(stderr, "O modo adversário usa apenas a matriz com chaves "
+                        "int32\n");
+        return 0;
+    }
+    for (i = 0; i < plan->num_algorithms; i++) {
+        if (find_selection_algorithm(plan->algorithms[i]->name) != NULL) {
+            fprintf(stderr, "%s não ordena o array inteiro\n",
+                    plan->algorithms[i]->name);
+            return 0;
+        }
+        if (find_adversary_target(plan->algorithms[i]->name) != NULL) {
+            targets++;
+        }
+    }
+    if (targets == 0) {
+        fprintf(stderr, "Nenhum algoritmo atacável pelo antiqsort em "
+                        "--algorithms\n");
+        return 0;
+    }
+    for (i = 0; i < plan->num_sizes; i++) {
+        if (plan->sizes[i] > ADVERSARY_MAX_SIZE) {
+            fprintf(stderr, "Tamanho %zu acima do máximo do modo "
+                            "adversário (%d)\n",
+                    plan->sizes[i], ADVERSARY_MAX_SIZE);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Indica se o plano gera entradas com a distribuição (a ordenação externa
+ * só gera com --generate, e o modo adversário só usa random)
+ */
+static int plan_generates(const TestPlan *plan, Distribution kind) {
+    int i;
+
+    if (plan->external_input != NULL) {
+        return plan->external_generate > 0 && plan->distributions[0] == kind;
+    }
+    if (plan->adversary) {
+        return kind == DIST_RANDOM;
+    }
+    for (i = 0; i < plan->num_distributions; i++) {
+        if (plan->distributions[i] == kind) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Rejeita parâmetros de distribuição que seriam ignorados
+ */
+static int check_distribution_params(const TestPlan *plan) {
+    const struct {
+        const char *option;
+        Distribution kind;
+        int given;
+    } params[] = {
+        {"--swaps", DIST_NEARLY_SORTED, plan->swaps > 0},
+        {"--unique", DIST_FEW_UNIQUE, plan->unique_values > 0},
+        {"--sawtooth-period", DIST_SAWTOOTH, plan->sawtooth_period > 0},
+        {"--zipf", DIST_ZIPF, plan->zipf_exponent > 0.0},
+    };
+    size_t i;
+
+    for (i = 0; i < sizeof(params) / sizeof(params[0]); i++) {
+        if (params[i].given && !plan_generates(plan, params[i].kind)) {
+            fprintf(stderr, "%s exige a distribuição %s\n", params[i].option,
+                    distribution_name(params[i].kind));
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Libera a memória alocada por parse_command_line
+ */
+void free_test_plan(TestPlan *plan) {
+    free(plan->algorithms);
+    free(plan->sizes);
+    free(plan->distributions);
+    plan->algorithms = NULL;
+    plan->sizes = NULL;
+    plan->distributions = NULL;
+}
+
+/**
+ * Interpreta a linha de comando e preenche o plano de execução
+ */
+int parse_command_line(int argc, char *argv[], TestPlan *plan) {
+    int i;
+    int ok = 1;
+    int all_algorithms;
+    int sizes_given = 0;
+    long long count;
+    double seconds;
+
+    // Valores padrão: mesma matriz do programa original
+    memset(plan, 0, sizeof(*plan));
+    plan->algorithms = (const SortAlgorithm **)malloc(
+        max_plan_algorithms() * sizeof(SortAlgorithm *));
+    plan->sizes = (size_t *)malloc(MAX_SIZES * sizeof(size_t));
+    plan->distributions = (Distribution *)malloc(DIST_COUNT *
+                                                 sizeof(Distribution));
+    if (plan->algorithms == NULL || plan->sizes == NULL ||
+        plan->distributions == NULL) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        free_test_plan(plan);
+        return -1;
+    }
+
+    parse_algorithms(plan, "all", &all_algorithms);
+    parse_sizes(plan, "100,1000,10000,100000");
+    parse_distributions(plan, "random");
+    plan->key_type = KEY_INT32;
+    plan->layout = LAYOUT_KEYS;
+    plan->payload = RECORD_DEFAULT_PAYLOAD;
+    plan->seed = 42;
+    plan->swaps = 0;
+    plan->unique_values = 0;
+    plan->sawtooth_period = 0;
+    plan->zipf_exponent = 0.0;
+    plan->threads = 0;
+    plan->k = 0;
+    plan->simd = SIMD_AUTO;
+    plan->pages = PAGES_AUTO;
+    plan->bench = bench_default_config();
+    plan->pin = 1;
+    plan->branch_report = 0;
+    plan->segmented = 0;
+    plan->segment_max_length = SEGMENT_DEFAULT_MAX_LENGTH;
+    plan->num_scaling_threads = 0;
+    plan->weak_scaling = 0;
+    plan->results_dir = "../results";
+    plan->json_path = NULL;
+    plan->history_path = NULL;
+    plan->external_input = NULL;
+    plan->external_output = NULL;
+    plan->temp_dir = NULL;
+    plan->external_generate = 0;
+    plan->memory_bytes = (size_t)256 << 20;
+    plan->io_block_bytes = (size_t)1024 << 10;
+    plan->io = IO_AUTO;
+    plan->num_distributed_workers = 0;
+    plan->latency_us = 0.0;
+    plan->bandwidth_mb_s = 0.0;
+    plan->adversary = 0;
+
+    for (i = 1; i < argc && ok; i++) {
+        const char *arg = argv[i];
+        const char *value = NULL;
+        char name[64];
+
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            print_usage(stdout, argv[0]);
+            free_test_plan(plan);
+            return 1;
+        }
+
+        // Opções sem valor
+        if (strcmp(arg, "--branch-misses") == 0) {
+            plan->branch_report = 1;
+            continue;
+        }
+        if (strcmp(arg, "--segmented") == 0) {
+            plan->segmented = 1;
+            continue;
+        }
+        if (strcmp(arg, "--weak-scaling") == 0) {
+            plan->weak_scaling = 1;
+            continue;
+        }
+        if (strcmp(arg, "--no-pin") == 0) {
+            plan->pin = 0;
+            continue;
+        }
+        if (strcmp(arg, "--adversary") == 0) {
+            plan->adversary = 1;
+            continue;
+        }
+
+        // Argumento posicional: diretório de resultados (compatibilidade)
+        if (strncmp(arg, "--", 2) != 0) {
+            plan->results_dir = arg;
+            continue;
+        }
+
+        // Aceita "--opção valor" e "--opção=valor"
+        const char *equals = strchr(arg, '=');
+        if (equals != NULL) {
+            size_t length = (size_t)(equals - arg);
+            if (length >= sizeof(name)) {
+                length = sizeof(name) - 1;
+            }
+            memcpy(name, arg, length);
+            name[length] = '\0';
+            value = equals + 1;
+        } else {
+            snprintf(name, sizeof(name), "%s", arg);
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Valor ausente para %s\n", name);
+                ok = 0;
+                break;
+            }
+            value = argv[++i];
+        }
+
+        if (strcmp(name, "--algorithms") == 0) {
+            ok = parse_algorithms(plan, value, &all_algorithms);
+        } else if (strcmp(name, "--sizes") == 0) {
+            ok = parse_sizes(plan, value);
+            sizes_given = 1;
+        } else if (strcmp(name, "--distributions") == 0) {
+            ok = parse_distributions(plan, value);
+        } else if (strcmp(name, "--swaps") == 0) {
+            ok = parse_count(value, INT_MAX, &count) && count >= 1;
+            if (ok) {
+                plan->swaps = (int)count;
+            }
+        } else if (strcmp(name, "--unique") == 0) {
+            ok = parse_count(value, DISTRIBUTION_MAX_VALUE, &count) &&
+                 count >= 1;
+            if (ok) {
+                plan->unique_values = (int)count;
+            }
+        } else if (strcmp(name, "--sawtooth-period") == 0) {
+            ok = parse_count(value, INT_MAX, &count) && count >= 2;
+            if (ok) {
+                plan->sawtooth_period = (int)count;
+            }
+        } else if (strcmp(name, "--zipf") == 0) {
+            ok = parse_double(value, &plan->zipf_exponent) &&
+                 plan->zipf_exponent > 0.0 &&
+                 plan->zipf_exponent <= ZIPF_MAX_EXPONENT;
+        } else if (strcmp(name, "--repetitions") == 0) {
+            ok = parse_count(value, INT_MAX, &count) && count >= 1;
+            if (ok) {
+                plan->bench.repetitions = (int)count;
+            }
+        } else if (strcmp(name, "--warmup") == 0) {
+            ok = parse_count(value, INT_MAX, &count);
+            if (ok) {
+                plan->bench.warmup = (int)count;
+            }
+        } else if (strcmp(name, "--seed") == 0) {
+            char *end;
+            errno = 0;
+            plan->seed = strtoull(value, &end, 0);
+            ok = errno == 0 && end != value && *end == '\0';
+        } else if (strcmp(name, "--threads") == 0) {
+            ok = parse_count(value, 4096, &count);
+            if (ok) {
+                plan->threads = (int)count;
+            }
+        } else if (strcmp(name, "--k") == 0) {
+            ok = parse_count(value, MAX_ARRAY_SIZE, &count) && count >= 1;
+            if (ok) {
+                plan->k = (size_t)count;
+            }
+        } else if (strcmp(name, "--time-budget") == 0) {
+            ok = parse_double(value, &seconds) && seconds > 0.0;
+            if (ok) {
+                plan->bench.cell_time_budget_s = seconds;
+            }
+        } else if (strcmp(name, "--max-cv") == 0) {
+            double percent;
+            ok = parse_double(value, &percent) && percent >= 0.0 &&
+                 percent <= 100.0;
+            if (ok) {
+                plan->bench.max_cv = percent / 100.0;
+            }
+        } else if (strcmp(name, "--noise-reruns") == 0) {
+            ok = parse_count(value, 100, &count);
+            if (ok) {
+                plan->bench.noise_reruns = (int)count;
+            }
+        } else if (strcmp(name, "--simd") == 0) {
+            ok = simd_level_from_name(value, &plan->simd);
+        } else if (strcmp(name, "--key-type") == 0) {
+            ok = key_type_from_name(value, &plan->key_type);
+        } else if (strcmp(name, "--layout") == 0) {
+            ok = record_layout_from_name(value, &plan->layout);
+        } else if (strcmp(name, "--payload") == 0) {
+            ok = parse_count(value, RECORD_MAX_PAYLOAD, &count);
+            if (ok) {
+                plan->payload = (size_t)count;
+            }
+        } else if (strcmp(name, "--segment-length") == 0) {
+            ok = parse_count(value, SEGMENT_MAX_LENGTH, &count) && count >= 1;
+            if (ok) {
+                plan->segment_max_length = (size_t)count;
+            }
+        } else if (strcmp(name, "--scaling") == 0) {
+            ok = parse_count(value, 4096, &count);
+            if (ok) {
+                set_scaling_threads(plan, (int)count);
+            }
+        } else if (strcmp(name, "--pages") == 0) {
+            ok = page_policy_from_name(value, &plan->pages);
+        } else if (strcmp(name, "--output") == 0) {
+            plan->results_dir = value;
+        } else if (strcmp(name, "--json") == 0) {
+            plan->json_path = value;
+        } else if (strcmp(name, "--history") == 0) {
+            plan->history_path = value;
+        } else if (strcmp(name, "--external") == 0) {
+            plan->external_input = value;
+        } else if (strcmp(name, "--external-output") == 0) {
+            plan->external_output = value;
+        } else if (strcmp(name, "--generate") == 0) {
+            ok = parse_count(value, MAX_ARRAY_SIZE, &count) && count >= 1;
+            if (ok) {
+                plan->external_generate = (size_t)count;
+            }
+        } else if (strcmp(name, "--memory") == 0) {
+            ok = parse_count(value, 1LL << 20, &count) && count >= 1;
+            if (ok) {
+                plan->memory_bytes = (size_t)count << 20;
+            }
+        } else if (strcmp(name, "--io-block") == 0) {
+            ok = parse_count(value, 1LL << 20, &count) && count >= 4;
+            if (ok) {
+                plan->io_block_bytes = (size_t)count << 10;
+            }
+        } else if (strcmp(name, "--io") == 0) {
+            ok = io_backend_from_name(value, &plan->io);
+        } else if (strcmp(name, "--temp-dir") == 0) {
+            plan->temp_dir = value;
+        } else if (strcmp(name, "--distributed") == 0) {
+            ok = parse_workers(plan, value);
+        } else if (strcmp(name, "--latency") == 0) {
+            ok = parse_double(value, &plan->latency_us) &&
+                 plan->latency_us >= 0.0;
+        } else if (strcmp(name, "--bandwidth") == 0) {
+            ok = parse_double(value, &plan->bandwidth_mb_s) &&
+                 plan->bandwidth_mb_s >= 0.0;
+        } else {
+            fprintf(stderr, "Opção desconhecida: %s\n", name);
+            ok = 0;
+            break;
+        }
+
+        if (!ok) {
+            fprintf(stderr, "Valor inválido para %s: %s\n", name, value);
+        }
+    }
+
+    // Parâmetros de distribuição: só com a distribuição que os usa
+    if (ok) {
+        ok = check_distribution_params(plan);
+    }
+
+    // "all" com --k: a seleção entra na matriz, ao lado da ordenação
+    // completa com que é comparada
+    if (ok && all_algorithms && plan->k > 0) {
+        for (i = 0; i < num_selection_algorithms; i++) {
+            plan->algorithms[plan->num_algorithms++] =
+                &selection_algorithms[i];
+        }
+    }
+
+    // Chaves de 64 bits: só os algoritmos com essa variante
+    if (ok && plan->key_type != KEY_INT32) {
+        ok = filter_wide_algorithms(plan, all_algorithms);
+    }
+
+    // Registros: só os algoritmos com essa variante
+    if (ok) {
+        ok = check_record_plan(plan, all_algorithms);
+    }
+
+    // Segmentos: algoritmos chamados em cada segmento, chaves int
+    if (ok) {
+        ok = check_segmented_plan(plan, all_algorithms);
+    }
+
+    // Escalonamento: só algoritmos paralelos, de 1 thread até o máximo
+    if (ok && plan->weak_scaling && plan->num_scaling_threads == 0) {
+        set_scaling_threads(plan, 0);
+    }
+    if (ok) {
+        ok = check_scaling_plan(plan, all_algorithms);
+    }
+
+    // Ordenação externa: um único algoritmo para as corridas, chaves int
+    if (ok && plan->external_input != NULL) {
+        ok = check_external_plan(plan, all_algorithms);
+    } else if (ok && plan->external_generate > 0) {
+        fprintf(stderr, "--generate exige --external\n");
+        ok = 0;
+    }
+
+    // Sample sort distribuído: um algoritmo local, chaves int
+    if (ok && plan->num_distributed_workers > 0) {
+        ok = check_distributed_plan(plan, all_algorithms);
+    }
+
+    // Adversário: tamanhos pequenos, pois os alvos degradados são
+    // quadráticos
+    if (ok && plan->adversary) {
+        if (!sizes_given) {
+            parse_sizes(plan, ADVERSARY_DEFAULT_SIZES);
+        }
+        ok = check_adversary_plan(plan);
+    }
+
+    if (!ok) {
+        fprintf(stderr, "Use --help para ver as opções disponíveis.\n");
+        free_test_plan(plan);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Interpreta a linha de comando de "sort_analyzer compare"
+ */
+int parse_compare_command(int argc, char *argv[], CompareOptions *options) {
+    const char *revisions[2] = {NULL, NULL};
+    int num_revisions = 0;
+    int ok = 1;
+    int i;
+    double number;
+
+    options->history_path = "../results/history.jsonl";
+    options->threshold = 0.05;
+    options->alpha = 0.05;
+
+    for (i = 2; i < argc && ok; i++) {
+        const char *arg = argv[i];
+        const char *value;
+
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            print_usage(stdout, argv[0]);
+            return 1;
+        }
+        if (strncmp(arg, "--", 2) != 0) {
+            if (num_revisions == 2) {
+                fprintf(stderr, "Revisão a mais: %s\n", arg);
+                ok = 0;
+            } else {
+                revisions[num_revisions++] = arg;
+            }
+            continue;
+        }
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Valor ausente para %s\n", arg);
+            ok = 0;
+            break;
+        }
+        value = argv[++i];
+
+        if (strcmp(arg, "--history") == 0) {
+            options->history_path = value;
+        } else if (strcmp(arg, "--threshold") == 0) {
+            ok = parse_double(value, &number) && number >= 0.0;
+            options->threshold = number / 100.0;
+        } else if (strcmp(arg, "--alpha") == 0) {
+            ok = parse_double(value, &number) && number > 0.0 &&
+                 number < 1.0;
+            options->alpha = number;
+        } else {
+            fprintf(stderr, "Opção desconhecida: %s\n", arg);
+            ok = 0;
+            break;
+        }
+
+        if (!ok) {
+            fprintf(stderr, "Valor inválido para %s: %s\n", arg, value);
+        }
+    }
+
+    if (ok && num_revisions != 2) {
+        fprintf(stderr, "compare exige as revisões BASE e NOVA\n");
+        ok = 0;
+    }
+    if (!ok) {
+        fprintf(stderr, "Use --help para ver as opções disponíveis.\n");
+        return -1;
+    }
+
+    options->base = revisions[0];
+    options->candidate = revisions[1];
+    return 0;
+}
@@ -0,0 +1,49 @@
+/**
+ * cli.h
+ * Interpretação da linha de comando do sort_analyzer
+ */
+
+#ifndef CLI_H
+#define CLI_H
+
+#include <stdio.h>
+
+#include "performance_test.h"
+#include "results_history.h"
+
+/**
+ * Interpreta a linha de comando e preenche o plano de execução
+ *
+ * @param argc Número de argumentos
+ * @param argv Argumentos
+ * @param plan Plano a preencher (liberar com free_test_plan)
+ * @return 0 se válido, 1 se a ajuda foi exibida, -1 em caso de erro
+ */
+int parse_command_line(int argc, char *argv[], TestPlan *plan);
+
+/**
+ * Interpreta a linha de comando de "sort_analyzer compare"
+ *
+ * @param argc Número de argumentos
+ * @param argv Argumentos (argv[1] é "compare")
+ * @param options Parâmetros a preencher
+ * @return 0 se válido, 1 se a ajuda foi exibida, -1 em caso de erro
+ */
+int parse_compare_command(int argc, char *argv[], CompareOptions *options);
+
+/**
+ * Libera a memória alocada por parse_command_line
+ *
+ * @param plan Plano de execução
+ */
+void free_test_plan(TestPlan *plan);
+
+/**
+ * Exibe as opções disponíveis
+ *
+ * @param out Arquivo de saída
+ * @param program Nome do executável
+ */
+void print_usage(FILE *out, const char *program);
+
+#endif /* CLI_H */
@@ -0,0 +1,532 @@
+/**
+ * distributed_sort.c
+ * Implementação do sample sort distribuído
+ *
+ * Cada nó é um processo filho criado com fork; os nós só se comunicam por
+ * um segmento de memória compartilhada (shm_open/mmap) e se sincronizam por
+ * uma barreira compartilhada entre processos. As fases são:
+ *
+ * 1. Ordenação local: o nó i ordena o bloco data[n*i/P .. n*(i+1)/P).
+ * 2. Separadores: cada nó envia ao nó 0 até DISTRIBUTED_SAMPLES amostras
+ *    regulares do seu bloco ordenado; o nó 0 ordena as amostras, escolhe
+ *    P - 1 separadores e os envia a todos. Amostras e separadores são
+ *    triplas (chave, nó de origem, posição), uma ordem total em que chaves
+ *    iguais diferem: com muitas repetições (até todas iguais) as chaves
+ *    ainda se dividem entre os nós.
+ * 3. Troca: cada nó divide o bloco pelos separadores (busca binária),
+ *    publica quantas chaves vão para cada nó e copia as partições que
+ *    recebe de todos os outros (de todos para todos).
+ * 4. Intercalação: cada nó intercala as P partições recebidas, já
+ *    ordenadas, na sua faixa da saída.
+ *
+ * Cada mensagem custa latency + bytes / bandwidth: quem recebe espera com
+ * nanosleep até esse prazo depois da cópia, como se os dados chegassem pela
+ * rede. A resolução do nanosleep (dezenas de microssegundos) limita as
+ * latências que fazem sentido simular.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "distributed_sort.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "benchmark.h"
+#include "sort_instrumentation.h"
+
+// Alinhamento das áreas do segmento compartilhado (linha de cache)
+#define DISTRIBUTED_ALIGN 64
+
+/**
+ * Fases, na ordem de execução
+ */
+enum {
+    PHASE_LOCAL_SORT = 0,
+    PHASE_SPLITTERS,
+    PHASE_EXCHANGE,
+    PHASE_MERGE,
+    PHASE_COUNT
+};
+
+/**
+ * Cabeçalho do segmento compartilhado
+ */
+typedef struct {
+    pthread_barrier_t barrier;
+    uint64_t phase_ns[PHASE_COUNT + 1];  // Fim de cada barreira (nó 0)
+} SharedHeader;
+
+/**
+ * Contadores de um nó, escritos só por ele
+ */
+typedef struct {
+    SortCounters counters;
+    unsigned long long messages;
+    unsigned long long bytes;
+    size_t num_samples;
+    size_t received;
+} WorkerSlot;
+
+/**
+ * Chave com o desempate pela origem: (chave, nó, posição no bloco local)
+ */
+typedef struct {
+    int key;
+    int node;
+    size_t index;
+} SplitKey;
+
+/**
+ * Áreas do segmento compartilhado (herdadas pelos filhos no fork)
+ */
+typedef struct {
+    const DistributedSortConfig *config;
+    size_t n;
+    int workers;
+    SharedHeader *header;
+    WorkerSlot *slots;
+    SplitKey *samples;    // workers * DISTRIBUTED_SAMPLES
+    SplitKey *splitters;  // workers - 1
+    size_t *counts;    // counts[i * workers + j]: chaves de i para j
+    int *input;        // Blocos locais; no fim, a saída
+    int *received;     // Partições recebidas
+} DistributedContext;
+
+/**
+ * Arredonda para o alinhamento das áreas
+ */
+static size_t align_up(size_t bytes) {
+    return (bytes + DISTRIBUTED_ALIGN - 1) &
+           ~(size_t)(DISTRIBUTED_ALIGN - 1);
+}
+
+/**
+ * Compara (chave, nó, posição) em ordem lexicográfica
+ */
+static int compare_split_keys(const SplitKey *a, const SplitKey *b) {
+    if (a->key != b->key) {
+        return (a->key > b->key) - (a->key < b->key);
+    }
+    if (a->node != b->node) {
+        return (a->node > b->node) - (a->node < b->node);
+    }
+    return (a->index > b->index) - (a->index < b->index);
+}
+
+/**
+ * Adaptador de compare_split_keys para o qsort das amostras
+ */
+static int compare_samples(const void *a, const void *b) {
+    return compare_split_keys((const SplitKey *)a, (const SplitKey *)b);
+}
+
+/**
+ * Espera na barreira; o nó 0 registra o fim da fase
+ */
+static void barrier_phase(DistributedContext *ctx, int id, int phase) {
+    pthread_barrier_wait(&ctx->header->barrier);
+    if (id == 0) {
+        ctx->header->phase_ns[phase] = bench_now_ns();
+    }
+}
+
+/**
+ * Conta uma mensagem de bytes bytes e espera até que ela "chegue":
+ * start_ns + latência + bytes / banda
+ */
+static void network_wait(DistributedContext *ctx, WorkerSlot *slot,
+                         uint64_t start_ns, size_t bytes) {
+    const DistributedSortConfig *config = ctx->config;
+    double seconds = config->latency;
+    if (config->bandwidth > 0.0) {
+        seconds += (double)bytes / config->bandwidth;
+    }
+    uint64_t deadline = start_ns + (uint64_t)(seconds * 1e9);
+
+    slot->messages++;
+    slot->bytes += bytes;
+
+    for (;;) {
+        uint64_t now = bench_now_ns();
+        if (now >= deadline) {
+            break;
+        }
+        uint64_t remaining = deadline - now;
+        struct timespec pause;
+        pause.tv_sec = (time_t)(remaining / 1000000000u);
+        pause.tv_nsec = (long)(remaining % 1000000000u);
+        nanosleep(&pause, NULL);
+    }
+}
+
+/**
+ * Primeira posição de arr[0..n) (bloco ordenado do nó node) cuja tripla
+ * (chave, node, posição) é maior que splitter
+ */
+static size_t upper_bound(const int *arr, size_t n, int node,
+                          const SplitKey *splitter) {
+    size_t low = 0, high = n;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        SplitKey key = {arr[mid], node, mid};
+        if (compare_split_keys(&key, splitter) <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * Intercala a[0..na) e b[0..nb) em out (empates ficam com a)
+ */
+static void merge_runs(const int *a, size_t na, const int *b, size_t nb,
+                       int *out, SortCounters *counters) {
+    size_t ia = 0, ib = 0, io = 0;
+
+    while (ia < na && ib < nb) {
+        COUNT_COMPARISON(counters);
+        out[io++] = b[ib] < a[ia] ? b[ib++] : a[ia++];
+    }
+    memcpy(out + io, a + ia, (na - ia) * sizeof(int));
+    io += na - ia;
+    memcpy(out + io, b + ib, (nb - ib) * sizeof(int));
+    COUNT_MOVEMENTS(counters, na + nb);
+}
+
+/**
+ * Escolha dos separadores no nó 0: junta as amostras, ordena e pega P - 1
+ * posições igualmente espaçadas
+ */
+static void choose_splitters(DistributedContext *ctx) {
+    int workers = ctx->workers;
+    size_t total = 0;
+    int i;
+
+    // Amostras contíguas no início da área
+    for (i = 0; i < workers; i++) {
+        memmove(ctx->samples + total,
+                ctx->samples + (size_t)i * DISTRIBUTED_SAMPLES,
+                ctx->slots[i].num_samples * sizeof(SplitKey));
+        total += ctx->slots[i].num_samples;
+    }
+    qsort(ctx->samples, total, sizeof(SplitKey), compare_samples);
+
+    for (i = 1; i < workers; i++) {
+        if (total > 0) {
+            ctx->splitters[i - 1] = ctx->samples[(size_t)i * total / workers];
+        } else {
+            ctx->splitters[i - 1].key = INT_MAX;
+            ctx->splitters[i - 1].node = INT_MAX;
+            ctx->splitters[i - 1].index = SIZE_MAX;
+        }
+    }
+}
+
+/**
+ * Trabalho do nó id (processo filho)
+ */
+static void worker_run(DistributedContext *ctx, int id) {
+    const DistributedSortConfig *config = ctx->config;
+    WorkerSlot *slot = &ctx->slots[id];
+    int workers = ctx->workers;
+    size_t bounds[DISTRIBUTED_MAX_WORKERS + 1];
+    size_t runs[DISTRIBUTED_MAX_WORKERS + 1];
+    size_t begin = ctx->n * (size_t)id / workers;
+    size_t end = ctx->n * (size_t)(id + 1) / workers;
+    size_t len = end - begin;
+    int *local = ctx->input + begin;
+    int i, j;
+
+    barrier_phase(ctx, id, 0);
+
+    // 1. Ordenação local
+    SortResult sorted = config->algorithm->function(local, len);
+    slot->counters.comparisons += sorted.comparisons;
+    slot->counters.movements += sorted.movements;
+    barrier_phase(ctx, id, PHASE_LOCAL_SORT + 1);
+
+    // 2. Amostras regulares (meio de cada fatia) para o nó 0
+    size_t num_samples = len < DISTRIBUTED_SAMPLES ? len : DISTRIBUTED_SAMPLES;
+    uint64_t start = bench_now_ns();
+    for (i = 0; i < (int)num_samples; i++) {
+        SplitKey *sample = &ctx->samples[(size_t)id * DISTRIBUTED_SAMPLES + i];
+        sample->index = (2 * (size_t)i + 1) * len / (2 * num_samples);
+        sample->key = local[sample->index];
+        sample->node = id;
+    }
+    slot->num_samples = num_samples;
+    if (id != 0) {
+        network_wait(ctx, slot, start, num_samples * sizeof(SplitKey));
+    }
+    pthread_barrier_wait(&ctx->header->barrier);
+
+    // Separadores escolhidos pelo nó 0 e enviados a cada outro nó
+    if (id == 0) {
+        choose_splitters(ctx);
+        for (j = 1; j < workers; j++) {
+            network_wait(ctx, slot, bench_now_ns(),
+                         (size_t)(workers - 1) * sizeof(SplitKey));
+        }
+    }
+    barrier_phase(ctx, id, PHASE_SPLITTERS + 1);
+
+    // 3. Partições do bloco local; a linha de contagens vai para todos
+    bounds[0] = 0;
+    for (j = 1; j < workers; j++) {
+        bounds[j] = upper_bound(local, len, id, &ctx->splitters[j - 1]);
+    }
+    bounds[workers] = len;
+    start = bench_now_ns();
+    for (j = 0; j < workers; j++) {
+        ctx->counts[(size_t)id * workers + j] = bounds[j + 1] - bounds[j];
+    }
+    for (j = 0; j < workers; j++) {
+        if (j != id) {
+            network_wait(ctx, slot, start, (size_t)workers * sizeof(size_t));
+            start = bench_now_ns();
+        }
+    }
+    pthread_barrier_wait(&ctx->header->barrier);
+
+    // Faixa de saída do nó: tudo o que vai para os nós anteriores vem antes
+    size_t position = 0;
+    for (i = 0; i < workers; i++) {
+        for (j = 0; j < id; j++) {
+            position += ctx->counts[(size_t)i * workers + j];
+        }
+    }
+
+    // Cópia das partições destinadas a este nó, uma mensagem por origem
+    for (i = 0; i < workers; i++) {
+        size_t source = ctx->n * (size_t)i / workers;
+        size_t count = ctx->counts[(size_t)i * workers + id];
+        for (j = 0; j < id; j++) {
+            source += ctx->counts[(size_t)i * workers + j];
+        }
+
+        runs[i] = position;
+        start = bench_now_ns();
+        memcpy(ctx->received + position, ctx->input + source,
+               count * sizeof(int));
+        if (i != id) {
+            network_wait(ctx, slot, start, count * sizeof(int));
+        }
+        position += count;
+    }
+    runs[workers] = position;
+    slot->received = position - runs[0];
+    barrier_phase(ctx, id, PHASE_EXCHANGE + 1);
+
+    // 4. Intercalação das partições em rodadas de pares; os blocos locais
+    // já foram lidos por todos, então input serve de área auxiliar
+    int *src = ctx->received, *dst = ctx->input;
+    int num_runs = workers;
+    while (num_runs > 1) {
+        int merged = 0;
+        for (i = 0; i < num_runs; i += 2) {
+            if (i + 1 < num_runs) {
+                merge_runs(src + runs[i], runs[i + 1] - runs[i],
+                           src + runs[i + 1], runs[i + 2] - runs[i + 1],
+                           dst + runs[i], &slot->counters);
+            } else {
+                memcpy(dst + runs[i], src + runs[i],
+                       (runs[i + 1] - runs[i]) * sizeof(int));
+            }
+            runs[merged++] = runs[i];
+        }
+        runs[merged] = runs[num_runs];
+        num_runs = merged;
+        int *temp = src;
+        src = dst;
+        dst = temp;
+    }
+    if (src != ctx->input) {
+        memcpy(ctx->input + runs[0], src + runs[0],
+               (runs[1] - runs[0]) * sizeof(int));
+    }
+    barrier_phase(ctx, id, PHASE_MERGE + 1);
+}
+
+/**
+ * Espera todos os nós; se um terminar com erro, encerra os demais (que
+ * ficariam presos na barreira)
+ */
+static int wait_workers(const pid_t *pids, int workers) {
+    int remaining = workers;
+    int status = 0;
+    int i;
+
+    while (remaining > 0) {
+        int child_status;
+        pid_t pid = waitpid(-1, &child_status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (i = 0; i < workers; i++) {
+            if (pids[i] == pid) {
+                remaining--;
+                break;
+            }
+        }
+        if (i == workers) {
+            continue;
+        }
+        if (!WIFEXITED(child_status) || WEXITSTATUS(child_status) != 0) {
+            if (status == 0) {
+                fprintf(stderr, "O nó %d terminou com erro\n", i);
+                for (i = 0; i < workers; i++) {
+                    kill(pids[i], SIGKILL);
+                }
+            }
+            status = -1;
+        }
+    }
+    return status;
+}
+
+/**
+ * Sample sort distribuído
+ */
+int distributed_sort(int *data, size_t n, const DistributedSortConfig *config,
+                     DistributedSortStats *stats) {
+    DistributedContext ctx;
+    pid_t pids[DISTRIBUTED_MAX_WORKERS];
+    pthread_barrierattr_t attr;
+    char name[64];
+    int workers = config->workers;
+    int status = 0;
+    int i;
+
+    memset(stats, 0, sizeof(*stats));
+    if (workers < 1 || workers > DISTRIBUTED_MAX_WORKERS) {
+        fprintf(stderr, "Número de nós inválido: %d\n", workers);
+        return -1;
+    }
+
+    // Áreas do segmento compartilhado
+    size_t header_bytes = align_up(sizeof(SharedHeader));
+    size_t slots_bytes = align_up((size_t)workers * sizeof(WorkerSlot));
+    size_t samples_bytes =
+        align_up((size_t)workers * DISTRIBUTED_SAMPLES * sizeof(SplitKey));
+    size_t splitters_bytes = align_up((size_t)workers * sizeof(SplitKey));
+    size_t counts_bytes =
+        align_up((size_t)workers * workers * sizeof(size_t));
+    size_t data_bytes = align_up(n * sizeof(int));
+    size_t total_bytes = header_bytes + slots_bytes + samples_bytes +
+                         splitters_bytes + counts_bytes + 2 * data_bytes;
+
+    // O nome é removido logo após o mapeamento: o segmento vive enquanto
+    // houver processos com ele mapeado
+    snprintf(name, sizeof(name), "/sort_analyzer_%ld", (long)getpid());
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        fprintf(stderr, "Erro em shm_open(%s): %s\n", name, strerror(errno));
+        return -1;
+    }
+    shm_unlink(name);
+    if (ftruncate(fd, (off_t)total_bytes) != 0) {
+        fprintf(stderr, "Erro ao dimensionar a memória compartilhada: %s\n",
+                strerror(errno));
+        close(fd);
+        return -1;
+    }
+    unsigned char *base = (unsigned char *)mmap(
+        NULL, total_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Erro ao mapear a memória compartilhada: %s\n",
+                strerror(errno));
+        return -1;
+    }
+
+    ctx.config = config;
+    ctx.n = n;
+    ctx.workers = workers;
+    ctx.header = (SharedHeader *)base;
+    ctx.slots = (WorkerSlot *)(base + header_bytes);
+    ctx.samples = (SplitKey *)(base + header_bytes + slots_bytes);
+    ctx.splitters =
+        (SplitKey *)(base + header_bytes + slots_bytes + samples_bytes);
+    ctx.counts = (size_t *)(base + header_bytes + slots_bytes +
+                            samples_bytes + splitters_bytes);
+    ctx.input = (int *)((unsigned char *)ctx.counts + counts_bytes);
+    ctx.received = (int *)((unsigned char *)ctx.input + data_bytes);
+
+    // A entrada é distribuída aos nós antes da medição
+    memcpy(ctx.input, data, n * sizeof(int));
+
+    pthread_barrierattr_init(&attr);
+    pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_barrier_init(&ctx.header->barrier, &attr, (unsigned)workers);
+    pthread_barrierattr_destroy(&attr);
+
+    // Saídas pendentes seriam repetidas pelos filhos
+    fflush(NULL);
+    for (i = 0; i < workers; i++) {
+        pids[i] = fork();
+        if (pids[i] == 0) {
+            worker_run(&ctx, i);
+            _exit(0);
+        }
+        if (pids[i] < 0) {
+            fprintf(stderr, "Erro ao criar o nó %d: %s\n", i,
+                    strerror(errno));
+            // Os nós já criados esperam na barreira para sempre
+            int k;
+            for (k = 0; k < i; k++) {
+                kill(pids[k], SIGKILL);
+                waitpid(pids[k], NULL, 0);
+            }
+            status = -1;
+            break;
+        }
+    }
+    if (status == 0) {
+        status = wait_workers(pids, workers);
+    }
+
+    if (status == 0) {
+        const uint64_t *t = ctx.header->phase_ns;
+        memcpy(data, ctx.input, n * sizeof(int));
+
+        stats->elements = n;
+        stats->workers = workers;
+        stats->local_sort_time = bench_elapsed_s(t[0], t[1]);
+        stats->splitter_time = bench_elapsed_s(t[1], t[2]);
+        stats->exchange_time = bench_elapsed_s(t[2], t[3]);
+        stats->merge_time = bench_elapsed_s(t[3], t[4]);
+        stats->result.execution_time = bench_elapsed_s(t[0], t[4]);
+        stats->result.threads = workers;
+        for (i = 0; i < workers; i++) {
+            const WorkerSlot *slot = &ctx.slots[i];
+            stats->result.comparisons += slot->counters.comparisons;
+            stats->result.movements += slot->counters.movements;
+            stats->messages += slot->messages;
+            stats->bytes_sent += slot->bytes;
+            if (slot->received > stats->max_partition) {
+                stats->max_partition = slot->received;
+            }
+        }
+    }
+
+    pthread_barrier_destroy(&ctx.header->barrier);
+    munmap(base, total_bytes);
+    return status;
+}
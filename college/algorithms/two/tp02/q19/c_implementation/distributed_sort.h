@@ -0,0 +1,67 @@
+/**
+ * distributed_sort.h
+ * Sample sort distribuído simulado em uma máquina: cada nó é um processo e
+ * a rede é memória compartilhada (shm_open/mmap), com latência e largura de
+ * banda injetadas em cada mensagem
+ */
+
+#ifndef DISTRIBUTED_SORT_H
+#define DISTRIBUTED_SORT_H
+
+#include <stddef.h>
+
+#include "sorting_algorithms.h"
+
+// Maior número de processos (nós)
+#define DISTRIBUTED_MAX_WORKERS 64
+
+// Amostras enviadas por nó na escolha dos separadores
+#define DISTRIBUTED_SAMPLES 64
+
+// Algoritmo da ordenação local quando --algorithms é "all"
+#define DISTRIBUTED_DEFAULT_ALGORITHM "intro_sort"
+
+/**
+ * Parâmetros do sample sort distribuído
+ */
+typedef struct {
+    const SortAlgorithm *algorithm;  // Ordenação local (não paralela)
+    int workers;                     // Processos (nós)
+    double latency;                  // Latência por mensagem (s)
+    double bandwidth;                // Banda de cada nó (bytes/s, 0 = sem
+                                     // limite)
+} DistributedSortConfig;
+
+/**
+ * Resultado do sample sort distribuído. As fases são separadas por
+ * barreiras, então cada tempo é o do nó mais lento (caminho crítico).
+ */
+typedef struct {
+    SortResult result;                // Comparações e movimentações das
+                                      // ordenações locais; tempo total
+    size_t elements;                  // Chaves ordenadas
+    int workers;                      // Processos
+    double local_sort_time;           // Ordenação local (s)
+    double splitter_time;             // Amostras e separadores (s)
+    double exchange_time;             // Troca de todos para todos (s)
+    double merge_time;                // Intercalação final (s)
+    unsigned long long messages;      // Mensagens entre nós
+    unsigned long long bytes_sent;    // Bytes das mensagens
+    size_t max_partition;             // Maior partição recebida por um nó
+} DistributedSortStats;
+
+/**
+ * Ordena data com config->workers processos: ordenação local de um bloco
+ * por nó, escolha dos separadores por amostragem regular no nó 0, troca de
+ * todos para todos das partições e intercalação das partições recebidas
+ *
+ * @param data Chaves (ordenadas no lugar)
+ * @param n Número de chaves
+ * @param config Parâmetros
+ * @param stats Resultado
+ * @return 0 em caso de sucesso, -1 em caso de erro (mensagem em stderr)
+ */
+int distributed_sort(int *data, size_t n, const DistributedSortConfig *config,
+                     DistributedSortStats *stats);
+
+#endif /* DISTRIBUTED_SORT_H */
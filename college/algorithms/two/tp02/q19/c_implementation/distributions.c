@@ -0,0 +1,420 @@
+/**
+ * distributions.c
+ * Implementação dos geradores de entradas
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "distributions.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+// Abaixo deste tamanho o custo de criar threads supera o ganho
+#define PARALLEL_FILL_THRESHOLD (1 << 16)
+#define MAX_FILL_THREADS 256
+
+static const char *distribution_names[DIST_COUNT] = {
+    "random",      "sorted",   "reverse", "nearly_sorted", "few_unique",
+    "organ_pipe",  "sawtooth", "zipf",    "all_equal",     "random_dups"};
+
+static const char *key_type_names[KEY_TYPE_COUNT] = {"int32", "int64",
+                                                     "uint64"};
+
+/**
+ * Parâmetros padrão para uma distribuição
+ */
+DistributionParams distribution_default_params(Distribution kind,
+                                               uint64_t seed) {
+    DistributionParams params;
+
+    params.kind = kind;
+    params.seed = seed;
+    params.threads = 0;
+    params.max_value = DISTRIBUTION_MAX_VALUE;
+    params.swaps = 0;
+    params.unique_values = 16;
+    params.sawtooth_period = 0;
+    params.zipf_exponent = 1.0;
+
+    return params;
+}
+
+/**
+ * Nome da distribuição
+ */
+const char *distribution_name(Distribution kind) {
+    if (kind < 0 || kind >= DIST_COUNT) {
+        return "unknown";
+    }
+    return distribution_names[kind];
+}
+
+/**
+ * Procura uma distribuição pelo nome
+ */
+int distribution_from_name(const char *name, Distribution *kind) {
+    int i;
+    for (i = 0; i < DIST_COUNT; i++) {
+        if (strcmp(name, distribution_names[i]) == 0) {
+            *kind = (Distribution)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Nome do tipo de chave
+ */
+const char *key_type_name(KeyType key_type) {
+    if (key_type < 0 || key_type >= KEY_TYPE_COUNT) {
+        return "unknown";
+    }
+    return key_type_names[key_type];
+}
+
+/**
+ * Procura um tipo de chave pelo nome
+ */
+int key_type_from_name(const char *name, KeyType *key_type) {
+    int i;
+    for (i = 0; i < KEY_TYPE_COUNT; i++) {
+        if (strcmp(name, key_type_names[i]) == 0) {
+            *key_type = (KeyType)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Tamanho de uma chave em bytes
+ */
+size_t key_type_size(KeyType key_type) {
+    switch (key_type) {
+        case KEY_INT64:
+            return sizeof(int64_t);
+        case KEY_UINT64:
+            return sizeof(uint64_t);
+        case KEY_INT32:
+        default:
+            return sizeof(int);
+    }
+}
+
+/**
+ * Gerador por contador (SplitMix64)
+ */
+uint64_t prng_at(uint64_t seed, uint64_t counter) {
+    uint64_t z = seed + (counter + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Reduz um valor de 64 bits ao intervalo [0, range)
+ */
+uint32_t prng_bounded(uint64_t value, uint32_t range) {
+    // Parte alta de (32 bits altos) * range: viés de no máximo range / 2^32
+    return (uint32_t)(((value >> 32) * (uint64_t)range) >> 32);
+}
+
+/**
+ * Posição uniforme em [0, n): redução por multiplicação até 2^32 elementos
+ * (mesma sequência de sempre) e módulo acima disso
+ */
+static size_t prng_index(uint64_t value, size_t n) {
+    if (n <= UINT32_MAX) {
+        return prng_bounded(value, (uint32_t)n);
+    }
+    return (size_t)(value % n);
+}
+
+/**
+ * Converte um valor de 64 bits em um double uniforme em [0, 1)
+ */
+static double prng_unit(uint64_t value) {
+    return (double)(value >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Parâmetros com os padrões já resolvidos para o tamanho n
+ */
+typedef struct {
+    DistributionParams params;
+    size_t n;
+    size_t begin;      // Posição de arr[0] na entrada de n chaves
+    void *arr;
+    KeyType key_type;
+    double zipf_norm;  // Termo pré-calculado da inversa da CDF de Zipf
+} FillJob;
+
+/**
+ * Valor da posição i (todas as distribuições exceto as trocas do quase
+ * ordenado, aplicadas depois)
+ */
+static int value_at(const FillJob *job, size_t i) {
+    const DistributionParams *p = &job->params;
+    size_t n = job->n;
+    uint64_t r;
+
+    switch (p->kind) {
+        case DIST_SORTED:
+        case DIST_NEARLY_SORTED:
+            return (int)(i + 1);
+        case DIST_REVERSE:
+            return (int)(n - i);
+        case DIST_FEW_UNIQUE:
+            r = prng_at(p->seed, i);
+            return ((int)prng_bounded(r, p->unique_values) + 1) *
+                   (p->max_value / p->unique_values);
+        case DIST_ORGAN_PIPE:
+            return (int)(i < n / 2 ? i + 1 : n - i);
+        case DIST_SAWTOOTH:
+            return (int)(i % (size_t)p->sawtooth_period) + 1;
+        case DIST_ZIPF: {
+            // Inversa da CDF contínua de Zipf em [1, max_value + 1)
+            double u = prng_unit(prng_at(p->seed, i));
+            double x;
+            if (fabs(p->zipf_exponent - 1.0) < 1e-9) {
+                x = exp(u * job->zipf_norm);
+            } else {
+                double a = 1.0 - p->zipf_exponent;
+                x = pow(u * job->zipf_norm + 1.0, 1.0 / a);
+            }
+            int rank = (int)x;
+            if (rank < 1) {
+                rank = 1;
+            } else if (rank > p->max_value) {
+                rank = p->max_value;
+            }
+            return rank;
+        }
+        case DIST_ALL_EQUAL:
+            return 1;
+        case DIST_RANDOM_DUPLICATES: {
+            // Cerca de 10 cópias de cada valor
+            uint32_t range = n / 10 > 0 ? (uint32_t)(n / 10) : 1u;
+            return (int)prng_bounded(prng_at(p->seed, i), range) + 1;
+        }
+        case DIST_RANDOM:
+        default:
+            r = prng_at(p->seed, i);
+            return (int)prng_bounded(r, (uint32_t)p->max_value) + 1;
+    }
+}
+
+/**
+ * Valor de 64 bits da posição i: a distribuição uniforme usa o gerador
+ * inteiro, as demais repetem os valores das chaves int
+ */
+static int64_t wide_value_at(const FillJob *job, size_t i) {
+    if (job->params.kind == DIST_RANDOM) {
+        return (int64_t)prng_at(job->params.seed, i);
+    }
+    return value_at(job, i);
+}
+
+/**
+ * Fatia do array preenchida por uma thread
+ */
+typedef struct {
+    const FillJob *job;
+    size_t begin;
+    size_t end;
+} FillSlice;
+
+static void *fill_slice(void *arg) {
+    const FillSlice *slice = (const FillSlice *)arg;
+    const FillJob *job = slice->job;
+    size_t i;
+
+    switch (job->key_type) {
+        case KEY_INT64: {
+            int64_t *out = (int64_t *)job->arr;
+            for (i = slice->begin; i < slice->end; i++) {
+                out[i - job->begin] = wide_value_at(job, i);
+            }
+            break;
+        }
+        case KEY_UINT64: {
+            uint64_t *out = (uint64_t *)job->arr;
+            for (i = slice->begin; i < slice->end; i++) {
+                out[i - job->begin] = (uint64_t)wide_value_at(job, i);
+            }
+            break;
+        }
+        case KEY_INT32:
+        default: {
+            int *out = (int *)job->arr;
+            for (i = slice->begin; i < slice->end; i++) {
+                out[i - job->begin] = value_at(job, i);
+            }
+            break;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Troca duas chaves de key_size bytes
+ */
+static void swap_keys(void *arr, size_t key_size, size_t a, size_t b) {
+    unsigned char *base = (unsigned char *)arr;
+    unsigned char temp[sizeof(uint64_t)];
+
+    memcpy(temp, base + a * key_size, key_size);
+    memcpy(base + a * key_size, base + b * key_size, key_size);
+    memcpy(base + b * key_size, temp, key_size);
+}
+
+/**
+ * Número de threads efetivo para o preenchimento
+ */
+static int fill_threads(int requested, size_t n) {
+    if (n < PARALLEL_FILL_THRESHOLD) {
+        return 1;
+    }
+
+    int threads = requested;
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (threads > MAX_FILL_THREADS) {
+        threads = MAX_FILL_THREADS;
+    }
+    if ((size_t)threads > n / (PARALLEL_FILL_THRESHOLD / 4)) {
+        threads = (int)(n / (PARALLEL_FILL_THRESHOLD / 4));
+    }
+    return threads > 0 ? threads : 1;
+}
+
+/**
+ * Preenche um array segundo a distribuição
+ */
+void generate_distribution(int *arr, size_t n,
+                           const DistributionParams *params) {
+    generate_keys(arr, n, KEY_INT32, params);
+}
+
+/**
+ * Preenche um array de chaves do tipo indicado
+ */
+void generate_keys(void *arr, size_t n, KeyType key_type,
+                   const DistributionParams *params) {
+    generate_keys_range(arr, 0, n, n, key_type, params);
+}
+
+/**
+ * Substitui os campos com valor 0 pelos padrões derivados de n
+ */
+void distribution_resolve_params(DistributionParams *params, size_t n) {
+    if (params->max_value <= 0) {
+        params->max_value = DISTRIBUTION_MAX_VALUE;
+    }
+    if (params->unique_values <= 0) {
+        params->unique_values = 16;
+    }
+    if (params->unique_values > params->max_value) {
+        params->unique_values = params->max_value;
+    }
+    if (params->sawtooth_period <= 0) {
+        params->sawtooth_period = (int)sqrt((double)n);
+        if (params->sawtooth_period < 2) {
+            params->sawtooth_period = 2;
+        }
+    }
+    if (params->swaps <= 0) {
+        params->swaps = n / 100 > 0 ? (int)(n / 100) : 1;
+    }
+    if (params->zipf_exponent <= 0.0) {
+        params->zipf_exponent = 1.0;
+    }
+}
+
+/**
+ * Preenche count chaves a partir da posição begin de uma entrada de n chaves
+ */
+void generate_keys_range(void *arr, size_t begin, size_t count, size_t n,
+                         KeyType key_type, const DistributionParams *params) {
+    FillJob job;
+    int i;
+
+    if (count == 0) {
+        return;
+    }
+
+    job.params = *params;
+    job.n = n;
+    job.begin = begin;
+    job.arr = arr;
+    job.key_type = key_type;
+    job.zipf_norm = 0.0;
+
+    // Resolver os padrões que dependem de n; gerada por partes, cada
+    // trecho recebe as trocas na proporção do seu tamanho
+    distribution_resolve_params(&job.params, n);
+    if (count < n) {
+        if (params->swaps > 0) {
+            job.params.swaps =
+                (int)((unsigned long long)params->swaps * count / n);
+        } else {
+            job.params.swaps = count / 100 > 0 ? (int)(count / 100) : 1;
+        }
+    }
+    if (job.params.kind == DIST_ZIPF) {
+        double limit = (double)job.params.max_value + 1.0;
+        if (fabs(job.params.zipf_exponent - 1.0) < 1e-9) {
+            job.zipf_norm = log(limit);
+        } else {
+            job.zipf_norm = pow(limit, 1.0 - job.params.zipf_exponent) - 1.0;
+        }
+    }
+
+    // Preenchimento paralelo: cada posição depende só de (semente, índice)
+    int threads = fill_threads(job.params.threads, count);
+    FillSlice slices[MAX_FILL_THREADS];
+    pthread_t tids[MAX_FILL_THREADS];
+    int started = 0;
+
+    for (i = 0; i < threads; i++) {
+        slices[i].job = &job;
+        slices[i].begin =
+            begin + (size_t)((unsigned long long)count * i / threads);
+        slices[i].end =
+            begin + (size_t)((unsigned long long)count * (i + 1) / threads);
+    }
+    for (i = 1; i < threads; i++) {
+        if (pthread_create(&tids[i], NULL, fill_slice, &slices[i]) != 0) {
+            break;
+        }
+        started = i;
+    }
+    fill_slice(&slices[0]);
+    for (i = 1; i <= started; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    // Fatias cujas threads não puderam ser criadas
+    for (i = started + 1; i < threads; i++) {
+        fill_slice(&slices[i]);
+    }
+
+    // Quase ordenado: k trocas entre posições aleatórias (do trecho, quando
+    // a entrada é gerada por partes)
+    if (job.params.kind == DIST_NEARLY_SORTED) {
+        uint64_t swap_seed = prng_at(job.params.seed, (uint64_t)-1 - begin);
+        size_t key_size = key_type_size(key_type);
+        for (i = 0; i < job.params.swaps; i++) {
+            size_t a =
+                prng_index(prng_at(swap_seed, 2 * (uint64_t)i), count);
+            size_t b =
+                prng_index(prng_at(swap_seed, 2 * (uint64_t)i + 1), count);
+            swap_keys(arr, key_size, a, b);
+        }
+    }
+}
@@ -0,0 +1,177 @@
+/**
+ * distributions.h
+ * Geradores de entradas com distribuições variadas, baseados em um gerador
+ * pseudoaleatório por contador (reprodutível e paralelizável)
+ */
+
+#ifndef DISTRIBUTIONS_H
+#define DISTRIBUTIONS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Maior valor gerado (mesmo intervalo do gerador original)
+#define DISTRIBUTION_MAX_VALUE 1000000
+
+/**
+ * Tipos de chave das entradas
+ */
+typedef enum {
+    KEY_INT32 = 0,  // int (todos os algoritmos)
+    KEY_INT64,      // int64_t
+    KEY_UINT64,     // uint64_t
+    KEY_TYPE_COUNT
+} KeyType;
+
+/**
+ * Distribuições de entrada disponíveis
+ */
+typedef enum {
+    DIST_RANDOM = 0,         // Uniforme entre 1 e max_value
+    DIST_SORTED,             // Já ordenado
+    DIST_REVERSE,            // Ordem inversa
+    DIST_NEARLY_SORTED,      // Ordenado com k trocas aleatórias
+    DIST_FEW_UNIQUE,         // Poucos valores distintos
+    DIST_ORGAN_PIPE,         // Crescente até o meio e depois decrescente
+    DIST_SAWTOOTH,           // Dente de serra com período fixo
+    DIST_ZIPF,               // Frequências com lei de Zipf
+    DIST_ALL_EQUAL,          // Todos os elementos iguais
+    DIST_RANDOM_DUPLICATES,  // Uniforme com muitas repetições
+    DIST_COUNT
+} Distribution;
+
+/**
+ * Parâmetros de geração (campos com valor 0 usam um padrão derivado de n)
+ */
+typedef struct {
+    Distribution kind;     // Distribuição
+    uint64_t seed;         // Semente do gerador
+    int threads;           // Threads de preenchimento (0 = todas as CPUs)
+    int max_value;         // Maior valor gerado (uniforme)
+    int swaps;             // Trocas do quase ordenado (0 = n / 100)
+    int unique_values;     // Valores distintos do few_unique (0 = 16)
+    int sawtooth_period;   // Período do dente de serra (0 = raiz de n)
+    double zipf_exponent;  // Expoente s da lei de Zipf (0 = 1)
+} DistributionParams;
+
+/**
+ * Parâmetros padrão para uma distribuição
+ *
+ * @param kind Distribuição
+ * @param seed Semente do gerador
+ * @return Parâmetros com valores padrão
+ */
+DistributionParams distribution_default_params(Distribution kind,
+                                               uint64_t seed);
+
+/**
+ * Substitui os campos com valor 0 pelos padrões derivados de n (os valores
+ * com que a entrada é de fato gerada)
+ *
+ * @param params Parâmetros a completar
+ * @param n Tamanho da entrada
+ */
+void distribution_resolve_params(DistributionParams *params, size_t n);
+
+/**
+ * Nome da distribuição (usado na linha de comando e nos CSVs)
+ *
+ * @param kind Distribuição
+ * @return Nome da distribuição
+ */
+const char *distribution_name(Distribution kind);
+
+/**
+ * Procura uma distribuição pelo nome
+ *
+ * @param name Nome da distribuição
+ * @param kind Destino da distribuição encontrada
+ * @return 1 se encontrada, 0 caso contrário
+ */
+int distribution_from_name(const char *name, Distribution *kind);
+
+/**
+ * Nome do tipo de chave (usado na linha de comando e nos resultados)
+ *
+ * @param key_type Tipo de chave
+ * @return Nome do tipo
+ */
+const char *key_type_name(KeyType key_type);
+
+/**
+ * Procura um tipo de chave pelo nome
+ *
+ * @param name Nome do tipo
+ * @param key_type Destino do tipo encontrado
+ * @return 1 se encontrado, 0 caso contrário
+ */
+int key_type_from_name(const char *name, KeyType *key_type);
+
+/**
+ * Tamanho de uma chave em bytes
+ *
+ * @param key_type Tipo de chave
+ * @return sizeof do tipo
+ */
+size_t key_type_size(KeyType key_type);
+
+/**
+ * Gerador por contador (SplitMix64): o valor depende apenas da semente e da
+ * posição, então qualquer divisão entre threads produz a mesma sequência
+ *
+ * @param seed Semente
+ * @param counter Posição na sequência
+ * @return Valor pseudoaleatório de 64 bits
+ */
+uint64_t prng_at(uint64_t seed, uint64_t counter);
+
+/**
+ * Reduz um valor de 64 bits ao intervalo [0, range) por multiplicação
+ * (sem o viés do operador módulo para intervalos de até 32 bits)
+ *
+ * @param value Valor pseudoaleatório de 64 bits
+ * @param range Tamanho do intervalo
+ * @return Valor no intervalo
+ */
+uint32_t prng_bounded(uint64_t value, uint32_t range);
+
+/**
+ * Preenche um array segundo a distribuição, em paralelo quando grande
+ *
+ * @param arr Array de destino
+ * @param n Tamanho do array
+ * @param params Parâmetros de geração
+ */
+void generate_distribution(int *arr, size_t n,
+                           const DistributionParams *params);
+
+/**
+ * Preenche um array de chaves do tipo indicado. Com chaves de 64 bits, a
+ * distribuição uniforme usa todos os 64 bits (e valores negativos em
+ * int64); as demais geram os mesmos valores das chaves int.
+ *
+ * @param arr Array de destino (n chaves de key_type_size(key_type) bytes)
+ * @param n Tamanho do array
+ * @param key_type Tipo de chave
+ * @param params Parâmetros de geração
+ */
+void generate_keys(void *arr, size_t n, KeyType key_type,
+                   const DistributionParams *params);
+
+/**
+ * Preenche as posições [begin, begin + count) de uma entrada de n chaves,
+ * para gerar por partes entradas maiores que a memória. As trocas do quase
+ * ordenado ficam dentro de cada parte; com begin = 0 e count = n o
+ * resultado é o de generate_keys.
+ *
+ * @param arr Destino (count chaves)
+ * @param begin Posição da primeira chave gerada
+ * @param count Número de chaves geradas
+ * @param n Tamanho da entrada completa
+ * @param key_type Tipo de chave
+ * @param params Parâmetros de geração
+ */
+void generate_keys_range(void *arr, size_t begin, size_t count, size_t n,
+                         KeyType key_type, const DistributionParams *params);
+
+#endif /* DISTRIBUTIONS_H */
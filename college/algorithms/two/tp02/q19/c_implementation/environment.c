@@ -0,0 +1,194 @@
+/**
+ * environment.c
+ * Coleta dos metadados do ambiente de execução
+ */
+
+#define _GNU_SOURCE
+
+#include "environment.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/utsname.h>
+#include <time.h>
+#include <unistd.h>
+
+// Definida pelo Makefile com as flags usadas na compilação
+#ifndef BUILD_CFLAGS
+#define BUILD_CFLAGS "unknown"
+#endif
+
+// Definida pelo Makefile com "git describe --always --dirty"
+#ifndef BUILD_REVISION
+#define BUILD_REVISION "unknown"
+#endif
+
+/**
+ * Copia uma string truncando no tamanho do destino
+ */
+static void copy_field(char *dest, size_t size, const char *src) {
+    snprintf(dest, size, "%s", src);
+}
+
+/**
+ * Lê o modelo do processador de /proc/cpuinfo
+ */
+static void read_cpu_model(char *dest, size_t size) {
+    char line[512];
+    FILE *file = fopen("/proc/cpuinfo", "r");
+
+    copy_field(dest, size, "unknown");
+    if (file == NULL) {
+        return;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (strncmp(line, "model name", 10) == 0) {
+            char *value = strchr(line, ':');
+            if (value != NULL) {
+                value++;
+                while (*value == ' ' || *value == '\t') {
+                    value++;
+                }
+                value[strcspn(value, "\n")] = '\0';
+                copy_field(dest, size, value);
+            }
+            break;
+        }
+    }
+
+    fclose(file);
+}
+
+/**
+ * Lê a primeira linha de um arquivo (sem a quebra de linha)
+ *
+ * @return 1 se a linha foi lida, 0 caso contrário
+ */
+static int read_first_line(const char *path, char *dest, size_t size) {
+    FILE *file = fopen(path, "r");
+    int ok;
+
+    if (file == NULL) {
+        return 0;
+    }
+    ok = fgets(dest, (int)size, file) != NULL;
+    fclose(file);
+    if (ok) {
+        dest[strcspn(dest, "\n")] = '\0';
+    }
+    return ok;
+}
+
+/**
+ * Lê um inteiro de um arquivo do sysfs
+ *
+ * @return Valor lido ou -1 se o arquivo não existir
+ */
+static int read_sysfs_int(const char *path) {
+    char line[32];
+    char *end;
+    long value;
+
+    if (!read_first_line(path, line, sizeof(line))) {
+        return -1;
+    }
+    value = strtol(line, &end, 10);
+    return end != line ? (int)value : -1;
+}
+
+/**
+ * Estado do turbo: intel_pstate expõe no_turbo (invertido), acpi-cpufreq
+ * e amd-pstate expõem boost
+ */
+static int read_turbo_state(void) {
+    int no_turbo =
+        read_sysfs_int("/sys/devices/system/cpu/intel_pstate/no_turbo");
+
+    if (no_turbo >= 0) {
+        return !no_turbo;
+    }
+    return read_sysfs_int("/sys/devices/system/cpu/cpufreq/boost");
+}
+
+/**
+ * Hash FNV-1a de 64 bits de uma string, continuando de hash
+ */
+static unsigned long long fnv1a(unsigned long long hash, const char *text) {
+    const unsigned char *p;
+
+    for (p = (const unsigned char *)text; *p != '\0'; p++) {
+        hash ^= *p;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+/**
+ * Coleta os metadados do ambiente atual
+ */
+void environment_collect(EnvironmentInfo *env) {
+    struct utsname uts;
+    time_t now = time(NULL);
+    struct tm utc;
+
+    memset(env, 0, sizeof(*env));
+
+#if defined(__clang__)
+    snprintf(env->compiler, sizeof(env->compiler), "clang %s",
+             __clang_version__);
+#elif defined(__GNUC__)
+    snprintf(env->compiler, sizeof(env->compiler), "gcc %s", __VERSION__);
+#else
+    copy_field(env->compiler, sizeof(env->compiler), "unknown");
+#endif
+    copy_field(env->cflags, sizeof(env->cflags), BUILD_CFLAGS);
+    copy_field(env->revision, sizeof(env->revision), BUILD_REVISION);
+
+    read_cpu_model(env->cpu_model, sizeof(env->cpu_model));
+
+    if (uname(&uts) == 0) {
+        snprintf(env->kernel, sizeof(env->kernel), "%s %s %s", uts.sysname,
+                 uts.release, uts.machine);
+        copy_field(env->hostname, sizeof(env->hostname), uts.nodename);
+    } else {
+        copy_field(env->kernel, sizeof(env->kernel), "unknown");
+        copy_field(env->hostname, sizeof(env->hostname), "unknown");
+    }
+
+    gmtime_r(&now, &utc);
+    strftime(env->timestamp, sizeof(env->timestamp), "%Y-%m-%dT%H:%M:%SZ",
+             &utc);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    env->online_cpus = cpus > 0 ? (int)cpus : 1;
+
+    // Frequência variável, turbo, SMT e carga da máquina
+    if (!read_first_line(
+            "/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor",
+            env->governor, sizeof(env->governor))) {
+        copy_field(env->governor, sizeof(env->governor), "unknown");
+    }
+    env->turbo = read_turbo_state();
+    env->smt = read_sysfs_int("/sys/devices/system/cpu/smt/active");
+    if (getloadavg(env->load_average, 3) != 3) {
+        env->load_average[0] = NAN;
+        env->load_average[1] = NAN;
+        env->load_average[2] = NAN;
+    }
+    env->pinned_cpu = -1;
+    env->clock_cv = NAN;
+
+    // Resultados só são comparáveis entre execuções na mesma máquina
+    char cpus_text[16];
+    unsigned long long hash = 0xCBF29CE484222325ull;
+    snprintf(cpus_text, sizeof(cpus_text), "%d", env->online_cpus);
+    hash = fnv1a(hash, env->cpu_model);
+    hash = fnv1a(hash, "|");
+    hash = fnv1a(hash, env->hostname);
+    hash = fnv1a(hash, "|");
+    hash = fnv1a(hash, cpus_text);
+    snprintf(env->host_id, sizeof(env->host_id), "%016llx", hash);
+}
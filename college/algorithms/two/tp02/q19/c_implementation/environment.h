@@ -0,0 +1,43 @@
+/**
+ * environment.h
+ * Metadados do ambiente de execução (compilador, flags, CPU, kernel)
+ * registrados junto com os resultados
+ */
+
+#ifndef ENVIRONMENT_H
+#define ENVIRONMENT_H
+
+/**
+ * Descrição do ambiente em que os testes foram executados
+ */
+typedef struct {
+    char revision[64];    // Revisão git do código compilado
+    char compiler[128];   // Compilador e versão
+    char cflags[256];     // Flags de compilação
+    char cpu_model[256];  // Modelo do processador
+    char kernel[256];     // Sistema operacional, versão do kernel e arquitetura
+    char hostname[128];   // Nome da máquina
+    char host_id[17];     // Impressão digital da máquina (hash hexadecimal
+                          // do processador, nome e número de CPUs)
+    char timestamp[32];   // Início da execução (UTC, ISO 8601)
+    int online_cpus;      // CPUs disponíveis
+
+    // Fontes de ruído nas medições
+    char governor[32];    // Governador de frequência da CPU 0 (cpufreq)
+    int turbo;            // Turbo/boost: 1 ligado, 0 desligado, -1 desconhecido
+    int smt;              // SMT: 1 ligado, 0 desligado, -1 desconhecido
+    double load_average[3];  // Carga média de 1, 5 e 15 minutos
+    int pinned_cpu;       // CPU da thread de medição (-1 = livre)
+    double clock_cv;      // Coeficiente de variação do laço de calibração
+                          // (NAN = não medido)
+} EnvironmentInfo;
+
+/**
+ * Coleta os metadados do ambiente atual (pinned_cpu e clock_cv ficam para
+ * quem fixa a thread e calibra o relógio)
+ *
+ * @param env Estrutura a preencher
+ */
+void environment_collect(EnvironmentInfo *env);
+
+#endif /* ENVIRONMENT_H */
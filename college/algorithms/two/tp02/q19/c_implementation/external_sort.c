@@ -0,0 +1,654 @@
+/**
+ * external_sort.c
+ * Implementação da ordenação externa
+ *
+ * 1. Formação das corridas: a entrada é lida em partes de até um terço da
+ *    memória de trabalho (o outro terço recebe a leitura da parte seguinte
+ *    e o último fica para a área auxiliar do algoritmo), cada parte é
+ *    ordenada em memória e gravada enquanto a próxima é lida.
+ * 2. Intercalação: grupos de até fan_in corridas são intercalados por uma
+ *    árvore de perdedores. Cada corrida tem dois blocos (um consumido, outro
+ *    sendo lido) e a saída também (um sendo preenchido, outro sendo
+ *    gravado). Se houver mais corridas que fan_in, a intercalação é feita em
+ *    várias passadas, alternando entre dois arquivos temporários.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "external_sort.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "benchmark.h"
+#include "sort_instrumentation.h"
+
+// Máximo de corridas intercaladas de uma vez (folhas da árvore de perdedores)
+#define EXTERNAL_MAX_FAN_IN 1024
+
+// Menor bloco de E/S aceito (bytes)
+#define EXTERNAL_MIN_BLOCK 4096
+
+// Chaves lidas por vez na verificação da saída
+#define EXTERNAL_VERIFY_CHUNK (1 << 16)
+
+/**
+ * Estado compartilhado de uma ordenação externa
+ */
+typedef struct {
+    AsyncIo *io;
+    size_t block;  // Chaves por bloco de E/S
+    int failed;    // 1 depois do primeiro erro de E/S
+} ExternalContext;
+
+/**
+ * Trecho de um arquivo temporário com uma corrida ordenada (em chaves)
+ */
+typedef struct {
+    uint64_t begin;
+    uint64_t count;
+} RunInfo;
+
+/**
+ * Leitor de uma corrida com dois blocos
+ */
+typedef struct {
+    int fd;
+    uint64_t next;          // Próxima chave a pedir ao disco
+    uint64_t end;           // Fim da corrida
+    int *blocks[2];
+    IoRequest requests[2];
+    int current;            // Bloco sendo consumido
+    const int *pos;         // Próxima chave do bloco atual
+    const int *limit;       // Fim do bloco atual (pos == limit: esgotada)
+} RunReader;
+
+/**
+ * Escritor de uma corrida com dois blocos
+ */
+typedef struct {
+    int fd;
+    uint64_t offset;        // Posição da próxima escrita (em chaves)
+    int *blocks[2];
+    IoRequest requests[2];
+    int current;            // Bloco sendo preenchido
+    size_t fill;            // Chaves no bloco atual
+} RunWriter;
+
+/**
+ * Registra uma falha de E/S (apenas a primeira é exibida)
+ */
+static void io_failed(ExternalContext *ctx, const IoRequest *request,
+                      const char *what) {
+    if (!ctx->failed) {
+        fprintf(stderr, "Erro de E/S (%s): %s\n", what,
+                request->error != 0 ? strerror(request->error)
+                                    : "arquivo truncado");
+    }
+    ctx->failed = 1;
+}
+
+/**
+ * Pede ao disco o próximo bloco da corrida no buffer b (nada se acabou)
+ */
+static void reader_issue(ExternalContext *ctx, RunReader *reader, int b) {
+    size_t count = 0;
+
+    if (reader->next < reader->end) {
+        uint64_t left = reader->end - reader->next;
+        count = left < ctx->block ? (size_t)left : ctx->block;
+    }
+    async_io_read(ctx->io, &reader->requests[b], reader->fd,
+                  reader->blocks[b], count * sizeof(int),
+                  reader->next * sizeof(int));
+    reader->next += count;
+}
+
+/**
+ * Aguarda o bloco atual e passa a consumi-lo
+ */
+static void reader_load(ExternalContext *ctx, RunReader *reader) {
+    IoRequest *request = &reader->requests[reader->current];
+
+    if (async_io_wait(ctx->io, request) != 0 ||
+        request->done != request->bytes) {
+        io_failed(ctx, request, "leitura de corrida");
+        reader->pos = reader->limit = NULL;
+        return;
+    }
+    reader->pos = reader->blocks[reader->current];
+    reader->limit = reader->pos + request->done / sizeof(int);
+}
+
+/**
+ * Começa a ler uma corrida: pede os dois primeiros blocos
+ */
+static void reader_start(ExternalContext *ctx, RunReader *reader, int fd,
+                         const RunInfo *run, int *blocks) {
+    memset(reader, 0, sizeof(*reader));
+    reader->fd = fd;
+    reader->next = run->begin;
+    reader->end = run->begin + run->count;
+    reader->blocks[0] = blocks;
+    reader->blocks[1] = blocks + ctx->block;
+
+    reader_issue(ctx, reader, 0);
+    reader_issue(ctx, reader, 1);
+    reader->current = 0;
+    reader_load(ctx, reader);
+}
+
+/**
+ * Bloco atual consumido: ele recebe o pedido do bloco depois do que já está
+ * a caminho no outro buffer, que passa a ser o atual
+ */
+static void reader_advance(ExternalContext *ctx, RunReader *reader) {
+    reader_issue(ctx, reader, reader->current);
+    reader->current ^= 1;
+    reader_load(ctx, reader);
+}
+
+/**
+ * Aguarda as leituras pendentes (antes de reutilizar os buffers)
+ */
+static void reader_drain(ExternalContext *ctx, RunReader *reader) {
+    async_io_wait(ctx->io, &reader->requests[0]);
+    async_io_wait(ctx->io, &reader->requests[1]);
+}
+
+/**
+ * Começa a gravar uma corrida a partir da posição offset (em chaves)
+ */
+static void writer_start(ExternalContext *ctx, RunWriter *writer, int fd,
+                         uint64_t offset, int *blocks) {
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = fd;
+    writer->offset = offset;
+    writer->blocks[0] = blocks;
+    writer->blocks[1] = blocks + ctx->block;
+}
+
+/**
+ * Aguarda a escrita do buffer b
+ */
+static void writer_wait(ExternalContext *ctx, RunWriter *writer, int b) {
+    if (async_io_wait(ctx->io, &writer->requests[b]) != 0) {
+        io_failed(ctx, &writer->requests[b], "escrita de corrida");
+    }
+}
+
+/**
+ * Envia o bloco atual e passa para o outro, depois que a escrita anterior
+ * dele terminar
+ */
+static void writer_flush(ExternalContext *ctx, RunWriter *writer) {
+    if (writer->fill == 0) {
+        return;
+    }
+    async_io_write(ctx->io, &writer->requests[writer->current], writer->fd,
+                   writer->blocks[writer->current],
+                   writer->fill * sizeof(int), writer->offset * sizeof(int));
+    writer->offset += writer->fill;
+    writer->fill = 0;
+    writer->current ^= 1;
+    writer_wait(ctx, writer, writer->current);
+}
+
+/**
+ * Acrescenta uma chave à corrida
+ */
+static void writer_put(ExternalContext *ctx, RunWriter *writer, int value) {
+    writer->blocks[writer->current][writer->fill++] = value;
+    if (writer->fill == ctx->block) {
+        writer_flush(ctx, writer);
+    }
+}
+
+/**
+ * Grava o bloco parcial e aguarda todas as escritas
+ */
+static void writer_finish(ExternalContext *ctx, RunWriter *writer) {
+    writer_flush(ctx, writer);
+    writer_wait(ctx, writer, 0);
+    writer_wait(ctx, writer, 1);
+}
+
+/**
+ * Verdadeiro se a corrida a vence a corrida b (mesma regra de
+ * source_wins em parallel_sorts.c: corridas esgotadas perdem)
+ */
+static int reader_wins(const RunReader *readers, int a, int b,
+                       SortCounters *counters) {
+    int a_done = readers[a].pos == readers[a].limit;
+    int b_done = readers[b].pos == readers[b].limit;
+
+    if (a_done || b_done) {
+        return b_done && (!a_done || a < b);
+    }
+    COUNT_COMPARISON(counters);
+    return *readers[a].pos < *readers[b].pos ||
+           (*readers[a].pos == *readers[b].pos && a < b);
+}
+
+/**
+ * Intercala k corridas com uma árvore de perdedores; um bloco esgotado é
+ * substituído pelo que já estava sendo lido antes de reprisar as disputas
+ */
+static void merge_readers(ExternalContext *ctx, RunReader *readers, int k,
+                          RunWriter *writer, SortCounters *counters) {
+    int tree[EXTERNAL_MAX_FAN_IN];
+    int winners[2 * EXTERNAL_MAX_FAN_IN];
+    int leaves = 1;
+    int node, s;
+    unsigned long long emitted = 0;
+
+    while (leaves < k) {
+        leaves *= 2;
+    }
+
+    // Folhas sem corrida ficam esgotadas
+    for (s = k; s < leaves; s++) {
+        memset(&readers[s], 0, sizeof(readers[s]));
+    }
+
+    for (s = 0; s < leaves; s++) {
+        winners[leaves + s] = s;
+    }
+    for (node = leaves - 1; node >= 1; node--) {
+        int a = winners[2 * node], b = winners[2 * node + 1];
+        if (reader_wins(readers, a, b, counters)) {
+            winners[node] = a;
+            tree[node] = b;
+        } else {
+            winners[node] = b;
+            tree[node] = a;
+        }
+    }
+    int winner = winners[1];
+
+    while (readers[winner].pos != readers[winner].limit) {
+        RunReader *reader = &readers[winner];
+        writer_put(ctx, writer, *reader->pos++);
+        emitted++;
+        if (reader->pos == reader->limit) {
+            reader_advance(ctx, reader);
+        }
+
+        for (node = (leaves + winner) / 2; node >= 1; node /= 2) {
+            if (reader_wins(readers, tree[node], winner, counters)) {
+                int temp = tree[node];
+                tree[node] = winner;
+                winner = temp;
+            }
+        }
+    }
+    COUNT_MOVEMENTS(counters, emitted);
+}
+
+/**
+ * Cria um arquivo temporário já removido do diretório (some ao fechar)
+ */
+static int open_temp(const char *dir) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/sort_analyzer_runs_XXXXXX", dir);
+
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "Erro ao criar arquivo temporário em %s: %s\n", dir,
+                strerror(errno));
+        return -1;
+    }
+    unlink(path);
+    return fd;
+}
+
+/**
+ * Formação das corridas: lê a parte seguinte e grava a anterior enquanto
+ * ordena a atual
+ *
+ * @param chunk Chaves por corrida
+ * @return Número de corridas gravadas
+ */
+static size_t form_runs(ExternalContext *ctx, int in_fd, int out_fd,
+                        uint64_t n, size_t chunk,
+                        const SortAlgorithm *algorithm,
+                        SortCounters *counters, ExternalSortStats *stats) {
+    LargeBuffer buffers[2];
+    IoRequest reads[2], writes[2];
+    size_t first = n < chunk ? (size_t)n : chunk;
+    uint64_t next = first;
+    size_t runs = 0;
+    int current = 0, b;
+
+    memset(reads, 0, sizeof(reads));
+    memset(writes, 0, sizeof(writes));
+    large_buffer_alloc(&buffers[0], first * sizeof(int));
+    large_buffer_alloc(&buffers[1], n > chunk ? first * sizeof(int) : 0);
+    stats->pages = buffers[0].pages;
+
+    async_io_read(ctx->io, &reads[0], in_fd, buffers[0].data,
+                  first * sizeof(int), 0);
+
+    while (!ctx->failed) {
+        IoRequest *request = &reads[current];
+        int other = current ^ 1;
+
+        if (async_io_wait(ctx->io, request) != 0 ||
+            request->done != request->bytes) {
+            io_failed(ctx, request, "leitura da entrada");
+            break;
+        }
+        size_t count = request->done / sizeof(int);
+        if (count == 0) {
+            break;
+        }
+        // Soma da entrada como foi lida, conferida com a saída no fim
+        multiset_checksum_add(&stats->input_checksum, buffers[current].data,
+                              count, sizeof(int));
+
+        // Parte seguinte no outro buffer, depois que a gravação dele terminar
+        if (async_io_wait(ctx->io, &writes[other]) != 0) {
+            io_failed(ctx, &writes[other], "escrita de corrida");
+            break;
+        }
+        size_t ahead = n - next < chunk ? (size_t)(n - next) : chunk;
+        async_io_read(ctx->io, &reads[other], in_fd, buffers[other].data,
+                      ahead * sizeof(int), next * sizeof(int));
+        next += ahead;
+
+        // Ordenar em memória enquanto o disco trabalha
+        uint64_t start = bench_now_ns();
+        SortResult sorted = algorithm->function((int *)buffers[current].data,
+                                                count);
+        stats->sort_time += bench_elapsed_s(start, bench_now_ns());
+        COUNT_COMPARISONS(counters, sorted.comparisons);
+        COUNT_MOVEMENTS(counters, sorted.movements);
+
+        // A corrida fica na mesma posição que a parte ocupava na entrada
+        async_io_write(ctx->io, &writes[current], out_fd,
+                       buffers[current].data, count * sizeof(int),
+                       request->offset);
+        runs++;
+        current = other;
+    }
+
+    for (b = 0; b < 2; b++) {
+        async_io_wait(ctx->io, &reads[b]);
+        if (async_io_wait(ctx->io, &writes[b]) != 0) {
+            io_failed(ctx, &writes[b], "escrita de corrida");
+        }
+        large_buffer_free(&buffers[b]);
+    }
+    return runs;
+}
+
+/**
+ * Uma passada de intercalação: grupos de até fan_in corridas consecutivas
+ * de src viram uma corrida cada em dst, na mesma posição
+ *
+ * @param runs Corridas de src (substituídas pelas de dst)
+ * @param num_runs Número de corridas (atualizado)
+ * @param blocks Blocos de E/S: 2 por corrida e 2 para a saída
+ */
+static void merge_pass(ExternalContext *ctx, int src, int dst, RunInfo *runs,
+                       size_t *num_runs, int fan_in, RunReader *readers,
+                       int *blocks, SortCounters *counters) {
+    size_t g, merged = 0;
+    int i;
+
+    for (g = 0; g < *num_runs && !ctx->failed; g += (size_t)fan_in) {
+        size_t left = *num_runs - g;
+        int k = left < (size_t)fan_in ? (int)left : fan_in;
+        RunWriter writer;
+        RunInfo out = {runs[g].begin, 0};
+
+        for (i = 0; i < k; i++) {
+            reader_start(ctx, &readers[i], src, &runs[g + i],
+                         blocks + 2 * (size_t)i * ctx->block);
+            out.count += runs[g + i].count;
+        }
+        writer_start(ctx, &writer, dst, out.begin,
+                     blocks + 2 * (size_t)fan_in * ctx->block);
+
+        merge_readers(ctx, readers, k, &writer, counters);
+
+        writer_finish(ctx, &writer);
+        for (i = 0; i < k; i++) {
+            reader_drain(ctx, &readers[i]);
+        }
+        runs[merged++] = out;
+    }
+    *num_runs = merged;
+}
+
+/**
+ * Ordena um arquivo de chaves int
+ */
+int external_sort_file(const char *input_path, const char *output_path,
+                       const ExternalSortConfig *config,
+                       ExternalSortStats *stats) {
+    ExternalContext ctx;
+    SortCounters counters = {0, 0};
+    struct stat info;
+    int temp[2] = {-1, -1};
+    int status = -1;
+    size_t i;
+
+    memset(stats, 0, sizeof(*stats));
+    memset(&ctx, 0, sizeof(ctx));
+
+    int in_fd = open(input_path, O_RDONLY);
+    if (in_fd < 0 || fstat(in_fd, &info) != 0) {
+        fprintf(stderr, "Erro ao abrir %s: %s\n", input_path,
+                strerror(errno));
+        if (in_fd >= 0) {
+            close(in_fd);
+        }
+        return -1;
+    }
+    if (info.st_size % (off_t)sizeof(int) != 0) {
+        fprintf(stderr, "%s não contém um número inteiro de chaves\n",
+                input_path);
+        close(in_fd);
+        return -1;
+    }
+    uint64_t n = (uint64_t)info.st_size / sizeof(int);
+
+    int out_fd = open(output_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0) {
+        fprintf(stderr, "Erro ao abrir %s para escrita: %s\n", output_path,
+                strerror(errno));
+        close(in_fd);
+        return -1;
+    }
+
+    // Blocos da intercalação: ao menos 2 corridas + saída cabem na memória
+    size_t block_bytes = config->block_bytes;
+    if (block_bytes > config->memory_bytes / 6) {
+        block_bytes = config->memory_bytes / 6;
+    }
+    if (block_bytes < EXTERNAL_MIN_BLOCK) {
+        block_bytes = EXTERNAL_MIN_BLOCK;
+    }
+    ctx.block = block_bytes / sizeof(int);
+
+    size_t chunk = config->memory_bytes / (3 * sizeof(int));
+    if (chunk < ctx.block) {
+        chunk = ctx.block;
+    }
+    uint64_t expected_runs = (n + chunk - 1) / chunk;
+
+    // Vias da intercalação: o que couber na memória, sem passar do número
+    // de corridas (uma passada basta quando todas cabem)
+    size_t fan_in = config->memory_bytes / (2 * block_bytes);
+    fan_in = fan_in > 2 ? fan_in - 1 : 2;
+    if (fan_in > EXTERNAL_MAX_FAN_IN) {
+        fan_in = EXTERNAL_MAX_FAN_IN;
+    }
+    if (fan_in > expected_runs) {
+        fan_in = expected_runs >= 2 ? (size_t)expected_runs : 2;
+    }
+
+    // Profundidade da fila: os dois blocos de cada corrida e da saída
+    ctx.io = async_io_create(config->io, 2 * (unsigned)fan_in + 2);
+    if (ctx.io == NULL) {
+        fprintf(stderr, "Mecanismo de E/S %s indisponível\n",
+                io_backend_name(config->io));
+        close(out_fd);
+        close(in_fd);
+        return -1;
+    }
+    stats->io = async_io_backend(ctx.io);
+    stats->elements = (size_t)n;
+    stats->fan_in = (int)fan_in;
+
+    uint64_t start_time = bench_now_ns();
+
+    // Uma única corrida vai direto para a saída
+    int run_fd = out_fd;
+    if (expected_runs > 1) {
+        temp[0] = open_temp(config->temp_dir);
+        run_fd = temp[0];
+    }
+
+    if (run_fd >= 0) {
+        stats->runs = form_runs(&ctx, in_fd, run_fd, n, chunk,
+                                config->algorithm, &counters, stats);
+        stats->passes = 1;
+        stats->run_time = bench_elapsed_s(start_time, bench_now_ns());
+        sort_scratch_release();
+    } else {
+        ctx.failed = 1;
+    }
+
+    if (!ctx.failed && stats->runs > 1) {
+        uint64_t merge_start = bench_now_ns();
+        size_t num_runs = stats->runs;
+        RunInfo *runs = (RunInfo *)malloc(num_runs * sizeof(RunInfo));
+        RunReader *readers =
+            (RunReader *)malloc(EXTERNAL_MAX_FAN_IN * sizeof(RunReader));
+        LargeBuffer blocks;
+
+        if (runs == NULL || readers == NULL) {
+            fprintf(stderr, "Erro na alocação de memória\n");
+            exit(EXIT_FAILURE);
+        }
+        for (i = 0; i < num_runs; i++) {
+            runs[i].begin = (uint64_t)i * chunk;
+            runs[i].count = n - runs[i].begin < chunk ? n - runs[i].begin
+                                                      : chunk;
+        }
+        large_buffer_alloc(&blocks, (2 * (size_t)fan_in + 2) * block_bytes);
+
+        while (num_runs > 1 && !ctx.failed) {
+            int final = num_runs <= fan_in;
+            if (!final && temp[1] < 0) {
+                temp[1] = open_temp(config->temp_dir);
+                if (temp[1] < 0) {
+                    ctx.failed = 1;
+                    break;
+                }
+            }
+
+            merge_pass(&ctx, temp[0], final ? out_fd : temp[1], runs,
+                       &num_runs, (int)fan_in, readers, (int *)blocks.data,
+                       &counters);
+            stats->passes++;
+
+            // As corridas de origem não são mais necessárias
+            if (ftruncate(temp[0], 0) != 0) {
+                perror("ftruncate");
+            }
+            if (!final) {
+                int swap = temp[0];
+                temp[0] = temp[1];
+                temp[1] = swap;
+            }
+        }
+
+        large_buffer_free(&blocks);
+        free(readers);
+        free(runs);
+        stats->merge_time = bench_elapsed_s(merge_start, bench_now_ns());
+    }
+
+    if (!ctx.failed) {
+        status = 0;
+    }
+
+    stats->result.execution_time =
+        bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(stats->result, &counters);
+    stats->bytes_read = async_io_bytes_read(ctx.io);
+    stats->bytes_written = async_io_bytes_written(ctx.io);
+
+    // Banda do disco: bytes pelo tempo de E/S de cada sentido; a vazão
+    // fim a fim inclui a ordenação e a intercalação na CPU
+    stats->read_io_time = async_io_read_time(ctx.io);
+    stats->write_io_time = async_io_write_time(ctx.io);
+    if (stats->read_io_time > 0.0) {
+        stats->read_bandwidth =
+            (double)stats->bytes_read / stats->read_io_time;
+    }
+    if (stats->write_io_time > 0.0) {
+        stats->write_bandwidth =
+            (double)stats->bytes_written / stats->write_io_time;
+    }
+    if (stats->result.execution_time > 0.0) {
+        stats->throughput = (double)(stats->elements * sizeof(int)) /
+                            stats->result.execution_time;
+    }
+
+    async_io_destroy(ctx.io);
+    for (i = 0; i < 2; i++) {
+        if (temp[i] >= 0) {
+            close(temp[i]);
+        }
+    }
+    close(out_fd);
+    close(in_fd);
+    return status;
+}
+
+/**
+ * Verifica se um arquivo tem n chaves int em ordem não decrescente e soma
+ * as chaves lidas
+ */
+int external_is_sorted(const char *path, size_t n, MultisetChecksum *checksum) {
+    FILE *file = fopen(path, "rb");
+    int *buffer = (int *)malloc(EXTERNAL_VERIFY_CHUNK * sizeof(int));
+    size_t total = 0, got, i;
+    int have_last = 0, last = 0, ok = 1;
+
+    memset(checksum, 0, sizeof(*checksum));
+    if (file == NULL || buffer == NULL) {
+        if (file != NULL) {
+            fclose(file);
+        }
+        free(buffer);
+        return 0;
+    }
+
+    while (ok && (got = fread(buffer, sizeof(int), EXTERNAL_VERIFY_CHUNK, file)) > 0) {
+        for (i = 0; i < got; i++) {
+            if (have_last && buffer[i] < last) {
+                ok = 0;
+                break;
+            }
+            last = buffer[i];
+            have_last = 1;
+        }
+        multiset_checksum_add(checksum, buffer, got, sizeof(int));
+        total += got;
+    }
+
+    fclose(file);
+    free(buffer);
+    return ok && total == n;
+}
@@ -0,0 +1,80 @@
+/**
+ * external_sort.h
+ * Ordenação externa de arquivos binários de int maiores que a memória:
+ * corridas ordenadas em memória, gravadas em disco e intercaladas em k vias
+ * com leituras e escritas assíncronas em buffer duplo
+ */
+
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <stddef.h>
+
+#include "async_io.h"
+#include "checksum.h"
+#include "large_memory.h"
+#include "sorting_algorithms.h"
+
+/**
+ * Parâmetros da ordenação externa
+ */
+typedef struct {
+    const SortAlgorithm *algorithm;  // Ordenação das corridas em memória
+    size_t memory_bytes;             // Memória de trabalho
+    size_t block_bytes;              // Bloco de E/S por corrida na
+                                     // intercalação
+    const char *temp_dir;            // Diretório dos arquivos temporários
+    IoBackend io;                    // Mecanismo de E/S pedido
+} ExternalSortConfig;
+
+/**
+ * Resultado da ordenação externa
+ */
+typedef struct {
+    SortResult result;                // Comparações, movimentações e tempo
+                                      // total (corridas + intercalação)
+    size_t elements;                  // Chaves do arquivo
+    size_t runs;                      // Corridas iniciais
+    int passes;                       // Passadas completas sobre os dados
+    int fan_in;                       // Máximo de corridas por intercalação
+    unsigned long long bytes_read;    // Bytes lidos do disco
+    unsigned long long bytes_written; // Bytes escritos no disco
+    double run_time;                  // Formação das corridas (s)
+    double sort_time;                 // Ordenação em memória das corridas (s)
+    double merge_time;                // Intercalações (s)
+    double read_io_time;              // Envio e espera das leituras (s)
+    double write_io_time;             // Envio e espera das escritas (s)
+    double read_bandwidth;            // bytes_read / read_io_time (bytes/s)
+    double write_bandwidth;           // bytes_written / write_io_time
+    double throughput;                // Bytes da entrada / tempo total
+    IoBackend io;                     // Mecanismo de E/S usado
+    PagePolicy pages;                 // Páginas obtidas para os buffers
+    MultisetChecksum input_checksum;  // Chaves lidas da entrada
+} ExternalSortStats;
+
+/**
+ * Ordena o arquivo input_path (chaves int em formato nativo) e grava o
+ * resultado em output_path
+ *
+ * @param input_path Arquivo de entrada
+ * @param output_path Arquivo de saída (criado ou truncado)
+ * @param config Parâmetros
+ * @param stats Resultado
+ * @return 0 em caso de sucesso, -1 em caso de erro (mensagem em stderr)
+ */
+int external_sort_file(const char *input_path, const char *output_path,
+                       const ExternalSortConfig *config,
+                       ExternalSortStats *stats);
+
+/**
+ * Verifica se um arquivo tem n chaves int em ordem não decrescente e
+ * calcula a soma de verificação delas, para comparar com a da entrada
+ *
+ * @param path Arquivo
+ * @param n Número de chaves esperado
+ * @param checksum Soma de verificação das chaves do arquivo (saída)
+ * @return 1 se ordenado e completo, 0 caso contrário
+ */
+int external_is_sorted(const char *path, size_t n, MultisetChecksum *checksum);
+
+#endif /* EXTERNAL_SORT_H */
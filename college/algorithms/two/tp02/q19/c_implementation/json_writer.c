@@ -0,0 +1,116 @@
+/**
+ * json_writer.c
+ * Implementação das funções auxiliares de JSON
+ */
+
+#include "json_writer.h"
+
+#include <math.h>
+
+/**
+ * Escreve um número real (null se não for finito)
+ */
+static void write_double(FILE *file, double value) {
+    if (isfinite(value)) {
+        fprintf(file, "%.9g", value);
+    } else {
+        fputs("null", file);
+    }
+}
+
+/**
+ * Escreve uma string JSON entre aspas
+ */
+void json_write_string(FILE *file, const char *value) {
+    const unsigned char *p;
+
+    if (value == NULL) {
+        fputs("null", file);
+        return;
+    }
+
+    fputc('"', file);
+    for (p = (const unsigned char *)value; *p != '\0'; p++) {
+        switch (*p) {
+            case '"':
+                fputs("\\\"", file);
+                break;
+            case '\\':
+                fputs("\\\\", file);
+                break;
+            case '\n':
+                fputs("\\n", file);
+                break;
+            case '\r':
+                fputs("\\r", file);
+                break;
+            case '\t':
+                fputs("\\t", file);
+                break;
+            default:
+                if (*p < 0x20) {
+                    fprintf(file, "\\u%04x", *p);
+                } else {
+                    fputc(*p, file);
+                }
+        }
+    }
+    fputc('"', file);
+}
+
+/**
+ * Escreve a chave de um campo
+ */
+void json_write_key(FILE *file, int *first, const char *key) {
+    if (!*first) {
+        fputc(',', file);
+    }
+    *first = 0;
+    json_write_string(file, key);
+    fputc(':', file);
+}
+
+/**
+ * Escreve um par "chave": "valor"
+ */
+void json_write_string_field(FILE *file, int *first, const char *key,
+                             const char *value) {
+    json_write_key(file, first, key);
+    json_write_string(file, value);
+}
+
+/**
+ * Escreve um par "chave": número inteiro sem sinal
+ */
+void json_write_uint_field(FILE *file, int *first, const char *key,
+                           unsigned long long value) {
+    json_write_key(file, first, key);
+    fprintf(file, "%llu", value);
+}
+
+/**
+ * Escreve um par "chave": número real
+ */
+void json_write_double_field(FILE *file, int *first, const char *key,
+                             double value) {
+    json_write_key(file, first, key);
+    write_double(file, value);
+}
+
+/**
+ * Escreve um par "chave": [números reais]
+ */
+void json_write_double_array_field(FILE *file, int *first, const char *key,
+                                   const double *values, int count) {
+    int i;
+
+    json_write_key(file, first, key);
+    fputc('[', file);
+    for (i = 0; i < count; i++) {
+        if (i > 0) {
+            fputc(',', file);
+        }
+        write_double(file, values[i]);
+    }
+    fputc(']', file);
+}
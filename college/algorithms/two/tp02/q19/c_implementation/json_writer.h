@@ -0,0 +1,53 @@
+/**
+ * json_writer.h
+ * Funções auxiliares para escrever registros JSON Lines
+ */
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stdio.h>
+
+/**
+ * Escreve uma string JSON entre aspas, escapando caracteres especiais
+ *
+ * @param file Arquivo de saída
+ * @param value String a escrever (NULL é escrito como null)
+ */
+void json_write_string(FILE *file, const char *value);
+
+/**
+ * Escreve um par "chave": "valor" precedido de vírgula se não for o primeiro
+ *
+ * @param file Arquivo de saída
+ * @param first Ponteiro para o indicador de primeiro campo do objeto
+ * @param key Chave
+ * @param value Valor
+ */
+void json_write_string_field(FILE *file, int *first, const char *key,
+                             const char *value);
+
+/**
+ * Escreve um par "chave": número inteiro sem sinal
+ */
+void json_write_uint_field(FILE *file, int *first, const char *key,
+                           unsigned long long value);
+
+/**
+ * Escreve um par "chave": número real (null se não for finito)
+ */
+void json_write_double_field(FILE *file, int *first, const char *key,
+                             double value);
+
+/**
+ * Escreve um par "chave": [números reais] (null nos não finitos)
+ */
+void json_write_double_array_field(FILE *file, int *first, const char *key,
+                                   const double *values, int count);
+
+/**
+ * Escreve a chave de um campo cujo valor será escrito pelo chamador
+ */
+void json_write_key(FILE *file, int *first, const char *key);
+
+#endif /* JSON_WRITER_H */
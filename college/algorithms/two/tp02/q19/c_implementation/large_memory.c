@@ -0,0 +1,299 @@
+/**
+ * large_memory.c
+ * Implementação dos buffers grandes mapeados com mmap
+ */
+
+#define _GNU_SOURCE
+
+#include "large_memory.h"
+#include "memory_tracker.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Tamanho da página enorme usada no alinhamento (x86-64 e AArch64)
+#define HUGE_PAGE_SIZE ((size_t)2 << 20)
+
+static const char *page_policy_names[] = {"auto", "hugetlb", "thp", "small"};
+
+static PagePolicy current_policy = PAGES_AUTO;
+
+/**
+ * Área auxiliar mantida entre chamadas: emprestada a uma única chamada por
+ * vez (busy) e devolvida por sort_scratch_done
+ */
+typedef struct {
+    LargeBuffer buffer;  // Mapeamento (data NULL enquanto é criado)
+    ScratchSlot slot;    // Tipo de área
+    int busy;            // 1 enquanto emprestada
+} ScratchEntry;
+
+// Áreas auxiliares dos algoritmos; chamadas concorrentes ou aninhadas
+// recebem áreas distintas
+static pthread_mutex_t scratch_lock = PTHREAD_MUTEX_INITIALIZER;
+static ScratchEntry *scratch_entries = NULL;
+static size_t num_scratch_entries = 0;
+static size_t scratch_capacity = 0;
+
+/**
+ * Define a política de páginas das próximas alocações
+ */
+void large_memory_set_policy(PagePolicy policy) {
+    current_policy = policy;
+}
+
+/**
+ * Política de páginas atual
+ */
+PagePolicy large_memory_policy(void) {
+    return current_policy;
+}
+
+/**
+ * Nome da política
+ */
+const char *page_policy_name(PagePolicy policy) {
+    if (policy < PAGES_AUTO || policy > PAGES_SMALL) {
+        return "unknown";
+    }
+    return page_policy_names[policy];
+}
+
+/**
+ * Procura uma política pelo nome
+ */
+int page_policy_from_name(const char *name, PagePolicy *policy) {
+    int i;
+    for (i = PAGES_AUTO; i <= PAGES_SMALL; i++) {
+        if (strcmp(name, page_policy_names[i]) == 0) {
+            *policy = (PagePolicy)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Arredonda bytes para um múltiplo de page
+ */
+static size_t round_up(size_t bytes, size_t page) {
+    return (bytes + page - 1) / page * page;
+}
+
+/**
+ * Mapeamento anônimo (NULL em caso de falha)
+ */
+static void *map_anonymous(size_t bytes, int extra_flags) {
+    void *ptr = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+    return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+/**
+ * Mapeamento de páginas normais alinhado a HUGE_PAGE_SIZE, para que o THP
+ * possa usar páginas enormes desde o início do buffer: mapeia uma página
+ * enorme a mais e devolve as sobras das pontas
+ */
+static void *map_aligned(size_t bytes) {
+    size_t padded = bytes + HUGE_PAGE_SIZE;
+    char *raw = (char *)map_anonymous(padded, 0);
+    if (raw == NULL) {
+        return NULL;
+    }
+
+    uintptr_t start = ((uintptr_t)raw + HUGE_PAGE_SIZE - 1) &
+                      ~(uintptr_t)(HUGE_PAGE_SIZE - 1);
+    char *aligned = (char *)start;
+    size_t head = (size_t)(aligned - raw);
+    size_t tail = padded - head - bytes;
+
+    if (head > 0) {
+        munmap(raw, head);
+    }
+    if (tail > 0) {
+        munmap(aligned + bytes, tail);
+    }
+    return aligned;
+}
+
+/**
+ * Mapeia um buffer e toca todas as páginas
+ */
+void large_buffer_alloc(LargeBuffer *buffer, size_t bytes) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    PagePolicy policy = current_policy;
+    size_t offset;
+
+    memset(buffer, 0, sizeof(*buffer));
+    buffer->bytes = bytes;
+    if (bytes == 0) {
+        return;
+    }
+
+#ifdef MAP_HUGETLB
+    // Páginas reservadas em /proc/sys/vm/nr_hugepages, se houver
+    if (policy == PAGES_AUTO || policy == PAGES_HUGETLB) {
+        buffer->mapped = round_up(bytes, HUGE_PAGE_SIZE);
+        buffer->data = map_anonymous(buffer->mapped, MAP_HUGETLB);
+        if (buffer->data != NULL) {
+            buffer->pages = PAGES_HUGETLB;
+        }
+    }
+#endif
+
+    if (buffer->data == NULL && policy != PAGES_SMALL) {
+        buffer->mapped = round_up(bytes, HUGE_PAGE_SIZE);
+        buffer->data = map_aligned(buffer->mapped);
+        buffer->pages = PAGES_THP;
+#ifdef MADV_HUGEPAGE
+        if (buffer->data != NULL) {
+            madvise(buffer->data, buffer->mapped, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    if (buffer->data == NULL) {
+        buffer->mapped = round_up(bytes, page);
+        buffer->data = map_anonymous(buffer->mapped, 0);
+        buffer->pages = PAGES_SMALL;
+#ifdef MADV_NOHUGEPAGE
+        // Com THP em "always" o kernel usaria páginas enormes mesmo assim
+        if (buffer->data != NULL && policy == PAGES_SMALL) {
+            madvise(buffer->data, buffer->mapped, MADV_NOHUGEPAGE);
+        }
+#endif
+    }
+
+    if (buffer->data == NULL) {
+        fprintf(stderr, "Erro na alocação de memória (%zu bytes)\n", bytes);
+        exit(EXIT_FAILURE);
+    }
+
+    // Pré-falta: uma escrita por página (a leitura mapearia a página zero)
+    volatile char *bytes_ptr = (volatile char *)buffer->data;
+    for (offset = 0; offset < buffer->mapped; offset += page) {
+        bytes_ptr[offset] = 0;
+    }
+    memory_tracker_note_alloc(bytes, buffer->mapped);
+}
+
+/**
+ * Desfaz o mapeamento de um buffer
+ */
+void large_buffer_free(LargeBuffer *buffer) {
+    if (buffer->data != NULL) {
+        munmap(buffer->data, buffer->mapped);
+        memory_tracker_note_free(buffer->mapped);
+    }
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+/**
+ * Área auxiliar de uma chamada de ordenação
+ */
+void *sort_scratch(ScratchSlot slot, size_t bytes) {
+    size_t i, chosen = SIZE_MAX;
+    LargeBuffer grown;
+
+    if (bytes == 0) {
+        bytes = 1;
+    }
+
+    // Área livre do mesmo tipo, de preferência já grande o bastante
+    pthread_mutex_lock(&scratch_lock);
+    for (i = 0; i < num_scratch_entries; i++) {
+        ScratchEntry *entry = &scratch_entries[i];
+        if (entry->busy || entry->slot != slot) {
+            continue;
+        }
+        if (entry->buffer.mapped >= bytes) {
+            chosen = i;
+            break;
+        }
+        if (chosen == SIZE_MAX) {
+            chosen = i;
+        }
+    }
+    if (chosen == SIZE_MAX) {
+        if (num_scratch_entries == scratch_capacity) {
+            size_t capacity = scratch_capacity > 0 ? 2 * scratch_capacity
+                                                   : 2 * SCRATCH_SLOTS;
+            ScratchEntry *entries = (ScratchEntry *)realloc(
+                scratch_entries, capacity * sizeof(ScratchEntry));
+            if (entries == NULL) {
+                fprintf(stderr, "Erro na alocação de memória\n");
+                exit(EXIT_FAILURE);
+            }
+            scratch_entries = entries;
+            scratch_capacity = capacity;
+        }
+        chosen = num_scratch_entries++;
+        memset(&scratch_entries[chosen], 0, sizeof(ScratchEntry));
+        scratch_entries[chosen].slot = slot;
+    }
+    scratch_entries[chosen].busy = 1;
+    if (scratch_entries[chosen].buffer.mapped >= bytes) {
+        void *data = scratch_entries[chosen].buffer.data;
+        pthread_mutex_unlock(&scratch_lock);
+        return data;
+    }
+
+    // Crescer fora da trava: tocar as páginas pode levar milissegundos
+    grown = scratch_entries[chosen].buffer;
+    memset(&scratch_entries[chosen].buffer, 0, sizeof(LargeBuffer));
+    pthread_mutex_unlock(&scratch_lock);
+
+    large_buffer_free(&grown);
+    large_buffer_alloc(&grown, bytes);
+
+    pthread_mutex_lock(&scratch_lock);
+    scratch_entries[chosen].buffer = grown;
+    pthread_mutex_unlock(&scratch_lock);
+    return grown.data;
+}
+
+/**
+ * Devolve uma área auxiliar emprestada por sort_scratch
+ */
+void sort_scratch_done(void *data) {
+    size_t i;
+
+    if (data == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&scratch_lock);
+    for (i = 0; i < num_scratch_entries; i++) {
+        if (scratch_entries[i].busy &&
+            scratch_entries[i].buffer.data == data) {
+            scratch_entries[i].busy = 0;
+            pthread_mutex_unlock(&scratch_lock);
+            return;
+        }
+    }
+    pthread_mutex_unlock(&scratch_lock);
+    fprintf(stderr, "Erro: área auxiliar %p não está emprestada\n", data);
+    abort();
+}
+
+/**
+ * Libera as áreas auxiliares que não estão emprestadas
+ */
+void sort_scratch_release(void) {
+    size_t i, kept = 0;
+
+    pthread_mutex_lock(&scratch_lock);
+    for (i = 0; i < num_scratch_entries; i++) {
+        if (scratch_entries[i].busy) {
+            scratch_entries[kept++] = scratch_entries[i];
+        } else {
+            large_buffer_free(&scratch_entries[i].buffer);
+        }
+    }
+    num_scratch_entries = kept;
+    pthread_mutex_unlock(&scratch_lock);
+}
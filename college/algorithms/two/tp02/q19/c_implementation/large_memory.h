@@ -0,0 +1,115 @@
+/**
+ * large_memory.h
+ * Buffers grandes mapeados com mmap: páginas enormes (MAP_HUGETLB ou THP) e
+ * pré-falta das páginas, para que as faltas de página e de TLB não entrem
+ * na região medida
+ */
+
+#ifndef LARGE_MEMORY_H
+#define LARGE_MEMORY_H
+
+#include <stddef.h>
+
+/**
+ * Política de páginas dos buffers grandes
+ */
+typedef enum {
+    PAGES_AUTO = 0,  // MAP_HUGETLB se houver páginas reservadas, senão THP
+    PAGES_HUGETLB,   // Páginas enormes reservadas (cai para THP se faltar)
+    PAGES_THP,       // Páginas enormes transparentes (madvise)
+    PAGES_SMALL      // Apenas páginas normais
+} PagePolicy;
+
+/**
+ * Buffer mapeado
+ */
+typedef struct {
+    void *data;       // Início do buffer (NULL se vazio)
+    size_t bytes;     // Tamanho pedido
+    size_t mapped;    // Tamanho do mapeamento (múltiplo da página usada)
+    PagePolicy pages; // Páginas obtidas (HUGETLB, THP ou SMALL)
+} LargeBuffer;
+
+/**
+ * Áreas auxiliares reutilizadas pelos algoritmos (ver sort_scratch)
+ */
+typedef enum {
+    SCRATCH_DATA = 0,  // Cópia do tamanho da entrada (buffers de distribuição)
+    SCRATCH_AUX,       // Metadados por elemento (ex.: balde de cada elemento)
+    SCRATCH_SLOTS
+} ScratchSlot;
+
+/**
+ * Define a política de páginas das próximas alocações
+ *
+ * @param policy Política de páginas
+ */
+void large_memory_set_policy(PagePolicy policy);
+
+/**
+ * Política de páginas atual
+ *
+ * @return Política definida por large_memory_set_policy
+ */
+PagePolicy large_memory_policy(void);
+
+/**
+ * Nome da política (usado na linha de comando e nos resultados)
+ *
+ * @param policy Política de páginas
+ * @return Nome da política
+ */
+const char *page_policy_name(PagePolicy policy);
+
+/**
+ * Procura uma política pelo nome
+ *
+ * @param name Nome da política
+ * @param policy Destino da política encontrada
+ * @return 1 se encontrada, 0 caso contrário
+ */
+int page_policy_from_name(const char *name, PagePolicy *policy);
+
+/**
+ * Mapeia um buffer segundo a política atual e toca todas as páginas
+ * (encerra o programa se não houver memória)
+ *
+ * @param buffer Buffer a preencher
+ * @param bytes Tamanho em bytes
+ */
+void large_buffer_alloc(LargeBuffer *buffer, size_t bytes);
+
+/**
+ * Desfaz o mapeamento de um buffer (buffers vazios são ignorados)
+ *
+ * @param buffer Buffer
+ */
+void large_buffer_free(LargeBuffer *buffer);
+
+/**
+ * Empresta uma área auxiliar a uma chamada de ordenação: os mapeamentos são
+ * mantidos entre chamadas e só crescem, então apenas a primeira chamada de
+ * cada tamanho paga as faltas de página (fora da região medida, na execução
+ * instrumentada). A área fica com a chamada até sort_scratch_done; chamadas
+ * concorrentes (outras threads) ou aninhadas recebem áreas distintas.
+ *
+ * @param slot Tipo de área (as áreas de um tipo são reaproveitadas entre si)
+ * @param bytes Tamanho mínimo em bytes
+ * @return Início da área, alinhado à página
+ */
+void *sort_scratch(ScratchSlot slot, size_t bytes);
+
+/**
+ * Devolve uma área emprestada por sort_scratch (NULL é ignorado)
+ *
+ * @param data Início da área
+ */
+void sort_scratch_done(void *data);
+
+/**
+ * Libera as áreas auxiliares que não estão emprestadas (entre células da
+ * matriz, quando nenhuma ordenação está em andamento)
+ */
+void sort_scratch_release(void);
+
+#endif /* LARGE_MEMORY_H */
@@ -1,58 +1,133 @@
-/**
- * main.c
- * Programa principal para executar os testes de ordenação
- */
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <time.h>
-
-#include "sorting_algorithms.h"
-
-// Declaração de função definida em performance_test.c
-void run_performance_tests(int *sizes, int num_sizes, const char *results_dir);
-
-int main(int argc, char *argv[]) {
-    // Inicializar o gerador de números aleatórios
-    srand(42);  // Usar uma semente fixa para reprodutibilidade
-
-    // Definir os tamanhos dos arrays a serem testados
-    int sizes[] = {100, 1000, 10000, 100000};
-    int num_sizes = 4;
-
-    // Diretório para salvar os resultados (padrão: "../results")
-    const char *results_dir = "../results";
-
-    // Verificar se foi fornecido um diretório de saída como argumento
-    if (argc > 1) {
-        results_dir = argv[1];
-    }
-
-    printf("===========================================================\n");
-    printf("ANÁLISE COMPARATIVA DE ALGORITMOS DE ORDENAÇÃO\n");
-    printf("===========================================================\n");
-
-    printf("\nExecutando testes para os seguintes tamanhos: ");
-    int i;
-    for (i = 0; i < num_sizes; i++) {
-        printf("%d ", sizes[i]);
-    }
-    printf("\n");
-
-    printf("\nOs resultados serão salvos em: %s\n", results_dir);
-
-    // Medir o tempo total de execução
-    clock_t start_time = clock();
-
-    // Executar os testes
-    run_performance_tests(sizes, num_sizes, results_dir);
-
-    // Calcular o tempo total
-    double total_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
-
-    printf("\nTestes concluídos em %.2f segundos.\n", total_time);
-    printf("===========================================================\n");
-
-    return 0;
-}
\ No newline at end of file
+/**
+ * main.c
+ * Programa principal para executar os testes de ordenação
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "cli.h"
+#include "performance_test.h"
+
+int main(int argc, char *argv[]) {
+    TestPlan plan;
+    int i;
+
+    // Subcomando de comparação entre revisões do histórico
+    if (argc > 1 && strcmp(argv[1], "compare") == 0) {
+        CompareOptions options;
+        int status = parse_compare_command(argc, argv, &options);
+        if (status != 0) {
+            return status > 0 ? EXIT_SUCCESS : 2;
+        }
+        return history_compare(&options);
+    }
+
+    // Interpretar a linha de comando (sem argumentos: matriz original)
+    int status = parse_command_line(argc, argv, &plan);
+    if (status != 0) {
+        return status > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    printf("===========================================================\n");
+    printf("ANÁLISE COMPARATIVA DE ALGORITMOS DE ORDENAÇÃO\n");
+    printf("===========================================================\n");
+
+    // Ordenação externa: um arquivo em vez da matriz
+    if (plan.external_input != NULL) {
+        uint64_t start_time = bench_now_ns();
+        status = run_external_test(&plan);
+        printf("\nConcluído em %.2f segundos.\n",
+               bench_elapsed_s(start_time, bench_now_ns()));
+        printf("===========================================================\n");
+        free_test_plan(&plan);
+        return status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Sample sort distribuído: escalonamento com o número de nós
+    if (plan.num_distributed_workers > 0) {
+        uint64_t start_time = bench_now_ns();
+        status = run_distributed_test(&plan);
+        printf("\nConcluído em %.2f segundos.\n",
+               bench_elapsed_s(start_time, bench_now_ns()));
+        printf("===========================================================\n");
+        free_test_plan(&plan);
+        return status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Entradas adversárias: pior caso de cada algoritmo atacável
+    if (plan.adversary) {
+        uint64_t start_time = bench_now_ns();
+        status = run_adversary_test(&plan);
+        printf("\nConcluído em %.2f segundos.\n",
+               bench_elapsed_s(start_time, bench_now_ns()));
+        printf("===========================================================\n");
+        free_test_plan(&plan);
+        return status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    printf("\nExecutando testes para os seguintes tamanhos: ");
+    for (i = 0; i < plan.num_sizes; i++) {
+        printf("%zu ", plan.sizes[i]);
+    }
+    printf("\n");
+
+    printf("Algoritmos: ");
+    for (i = 0; i < plan.num_algorithms; i++) {
+        printf("%s ", plan.algorithms[i]->name);
+    }
+    printf("\n");
+
+    printf("Distribuições das entradas: ");
+    for (i = 0; i < plan.num_distributions; i++) {
+        printf("%s ", distribution_name(plan.distributions[i]));
+    }
+    printf("(semente %llu)\n", (unsigned long long)plan.seed);
+
+    printf("Vetorização: %s (detectado: %s)\n", simd_level_name(plan.simd),
+           simd_level_name(simd_detect_level()));
+
+    printf("Chaves: %s, páginas dos buffers: %s\n",
+           key_type_name(plan.key_type), page_policy_name(plan.pages));
+    if (plan.layout != LAYOUT_KEYS) {
+        printf("Registros: %s, %zu bytes de carga (%zu por registro)\n",
+               record_layout_name(plan.layout), plan.payload,
+               record_size(plan.payload));
+    }
+    if (plan.num_scaling_threads > 0) {
+        printf("Escalonamento %s com threads:",
+               plan.weak_scaling ? "fraco (tamanhos por thread)" : "forte");
+        for (i = 0; i < plan.num_scaling_threads; i++) {
+            printf(" %d", plan.scaling_threads[i]);
+        }
+        printf(" (fixadas em CPUs)\n");
+    }
+    if (plan.segmented) {
+        printf("Segmentos: tamanhos contam segmentos de 0 a %zu elementos\n",
+               plan.segment_max_length);
+    }
+
+    printf("\nOs resultados serão salvos em: %s\n", plan.results_dir);
+
+    printf("Aquecimento: %d, repetições: %d (mínimo %d), orçamento por "
+           "célula: %.2f s\n",
+           plan.bench.warmup, plan.bench.repetitions,
+           plan.bench.min_repetitions, plan.bench.cell_time_budget_s);
+
+    // Medir o tempo total de execução
+    uint64_t start_time = bench_now_ns();
+
+    // Executar os testes
+    status = run_performance_tests(&plan);
+
+    // Calcular o tempo total
+    double total_time = bench_elapsed_s(start_time, bench_now_ns());
+
+    printf("\nTestes concluídos em %.2f segundos.\n", total_time);
+    printf("===========================================================\n");
+
+    free_test_plan(&plan);
+    return status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,213 @@
+/**
+ * memory_tracker.c
+ * Contagem de alocações e leitura do pico de RSS
+ *
+ * O executável é ligado com -Wl,--wrap=malloc (e calloc, realloc,
+ * posix_memalign e free): o ligador troca as chamadas do programa por
+ * __wrap_malloc, que conta e repassa para __real_malloc. Fora de uma região
+ * medida o custo é uma leitura atômica. Sem o --wrap as funções abaixo
+ * ficam sem uso e só os mapeamentos de large_memory são contados
+ */
+
+#define _GNU_SOURCE
+
+#include "memory_tracker.h"
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+static int tracking = 0;
+static unsigned long long bytes_allocated = 0;
+static unsigned long long allocations = 0;
+static long long live_bytes = 0;
+static long long peak_bytes = 0;
+
+// Pico de RSS no início da região
+static unsigned long long rss_start = 0;
+static int rss_from_proc = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+int __real_posix_memalign(void **ptr, size_t alignment, size_t size);
+void __real_free(void *ptr);
+
+/**
+ * Soma delta à memória viva e atualiza o pico
+ */
+static void add_live(long long delta) {
+    long long live = __atomic_add_fetch(&live_bytes, delta, __ATOMIC_RELAXED);
+    long long peak = __atomic_load_n(&peak_bytes, __ATOMIC_RELAXED);
+
+    while (live > peak &&
+           !__atomic_compare_exchange_n(&peak_bytes, &peak, live, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static int is_tracking(void) {
+    return __atomic_load_n(&tracking, __ATOMIC_RELAXED);
+}
+
+/**
+ * Registra uma alocação feita fora do malloc
+ */
+void memory_tracker_note_alloc(size_t requested, size_t footprint) {
+    if (!is_tracking()) {
+        return;
+    }
+    __atomic_add_fetch(&bytes_allocated, requested, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&allocations, 1, __ATOMIC_RELAXED);
+    add_live((long long)footprint);
+}
+
+/**
+ * Registra uma liberação
+ */
+void memory_tracker_note_free(size_t footprint) {
+    if (is_tracking()) {
+        add_live(-(long long)footprint);
+    }
+}
+
+void *__wrap_malloc(size_t size) {
+    void *ptr = __real_malloc(size);
+
+    if (ptr != NULL) {
+        memory_tracker_note_alloc(size, malloc_usable_size(ptr));
+    }
+    return ptr;
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    void *ptr = __real_calloc(count, size);
+
+    if (ptr != NULL) {
+        memory_tracker_note_alloc(count * size, malloc_usable_size(ptr));
+    }
+    return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    size_t old_footprint = ptr != NULL ? malloc_usable_size(ptr) : 0;
+    void *result = __real_realloc(ptr, size);
+
+    // Uma realocação conta como alocação nova do tamanho pedido
+    if (result != NULL) {
+        memory_tracker_note_free(old_footprint);
+        memory_tracker_note_alloc(size, malloc_usable_size(result));
+    }
+    return result;
+}
+
+int __wrap_posix_memalign(void **ptr, size_t alignment, size_t size) {
+    int status = __real_posix_memalign(ptr, alignment, size);
+
+    if (status == 0) {
+        memory_tracker_note_alloc(size, malloc_usable_size(*ptr));
+    }
+    return status;
+}
+
+void __wrap_free(void *ptr) {
+    if (ptr != NULL && is_tracking()) {
+        memory_tracker_note_free(malloc_usable_size(ptr));
+    }
+    __real_free(ptr);
+}
+
+/**
+ * Lê um campo em kB de /proc/self/status
+ *
+ * @return Valor em bytes ou 0 se o campo não existir
+ */
+static unsigned long long read_status_kb(const char *field) {
+    FILE *file = fopen("/proc/self/status", "r");
+    char line[256];
+    size_t length = strlen(field);
+    unsigned long long value = 0;
+
+    if (file == NULL) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (strncmp(line, field, length) == 0 && line[length] == ':') {
+            value = strtoull(line + length + 1, NULL, 10) * 1024ull;
+            break;
+        }
+    }
+    fclose(file);
+    return value;
+}
+
+/**
+ * Pico de RSS do processo segundo getrusage (kB no Linux)
+ */
+static unsigned long long rusage_peak(void) {
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return (unsigned long long)usage.ru_maxrss * 1024ull;
+}
+
+/**
+ * Zera o VmHWM para o RSS atual (Linux 4.0+)
+ *
+ * @return 1 se conseguiu
+ */
+static int reset_peak_rss(void) {
+    FILE *file = fopen("/proc/self/clear_refs", "w");
+    int ok;
+
+    if (file == NULL) {
+        return 0;
+    }
+    ok = fputs("5", file) >= 0;
+    ok = (fclose(file) == 0) && ok;
+    return ok;
+}
+
+/**
+ * Começa a contar
+ */
+void memory_tracker_begin(void) {
+    __atomic_store_n(&bytes_allocated, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&allocations, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&live_bytes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&peak_bytes, 0, __ATOMIC_RELAXED);
+
+    // Com o VmHWM zerado o pico da região é medido a partir do RSS atual;
+    // sem isso o ru_maxrss só cresce quando a região passa do pico anterior
+    rss_from_proc = reset_peak_rss();
+    rss_start = rss_from_proc ? read_status_kb("VmRSS") : rusage_peak();
+    if (rss_from_proc && rss_start == 0) {
+        rss_from_proc = 0;
+        rss_start = rusage_peak();
+    }
+
+    __atomic_store_n(&tracking, 1, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * Para de contar e preenche usage
+ */
+void memory_tracker_end(MemoryUsage *usage) {
+    unsigned long long rss_peak;
+    long long peak;
+
+    __atomic_store_n(&tracking, 0, __ATOMIC_SEQ_CST);
+
+    rss_peak = rss_from_proc ? read_status_kb("VmHWM") : rusage_peak();
+    peak = __atomic_load_n(&peak_bytes, __ATOMIC_RELAXED);
+
+    usage->peak_rss_delta = rss_peak > rss_start ? rss_peak - rss_start : 0;
+    usage->bytes_allocated = __atomic_load_n(&bytes_allocated,
+                                             __ATOMIC_RELAXED);
+    usage->allocations = __atomic_load_n(&allocations, __ATOMIC_RELAXED);
+    usage->peak_extra_bytes = peak > 0 ? (unsigned long long)peak : 0;
+}
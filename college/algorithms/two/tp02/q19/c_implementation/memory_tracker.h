@@ -0,0 +1,50 @@
+/**
+ * memory_tracker.h
+ * Memória usada por uma execução: alocações interceptadas (malloc, calloc,
+ * realloc, posix_memalign e free via -Wl,--wrap, mais os mapeamentos de
+ * large_memory) e pico de RSS lido de /proc/self/status (ou getrusage)
+ */
+
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <stddef.h>
+
+/**
+ * Memória de uma região medida
+ */
+typedef struct {
+    unsigned long long peak_rss_delta;    // Pico de RSS acima do início
+                                          // (bytes)
+    unsigned long long bytes_allocated;   // Bytes pedidos ao alocador
+    unsigned long long allocations;       // Número de alocações
+    unsigned long long peak_extra_bytes;  // Pico da memória viva alocada na
+                                          // região (bytes)
+} MemoryUsage;
+
+/**
+ * Começa a contar alocações e zera o pico de RSS (não reentrante)
+ */
+void memory_tracker_begin(void);
+
+/**
+ * Para de contar e lê o uso de memória desde memory_tracker_begin
+ *
+ * @param usage Destino
+ */
+void memory_tracker_end(MemoryUsage *usage);
+
+/**
+ * Registra uma alocação feita fora do malloc (ex.: mmap)
+ *
+ * @param requested Bytes pedidos
+ * @param footprint Bytes reservados de fato (ex.: múltiplo da página)
+ */
+void memory_tracker_note_alloc(size_t requested, size_t footprint);
+
+/**
+ * Registra a liberação de footprint bytes
+ */
+void memory_tracker_note_free(size_t footprint);
+
+#endif /* MEMORY_TRACKER_H */
@@ -0,0 +1,813 @@
+/**
+ * parallel_sorts.c
+ * Implementação dos algoritmos de ordenação paralelos
+ *
+ * Compilado duas vezes, como sorting_algorithms.c (ver
+ * sort_instrumentation.h). Cada tarefa conta em uma estrutura local e soma
+ * ao total da chamada de forma atômica ao terminar.
+ */
+
+#include "parallel_sorts.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "distributions.h"
+#include "large_memory.h"
+#include "sort_instrumentation.h"
+#include "thread_pool.h"
+
+// Abaixo deste tamanho uma partição é ordenada sequencialmente
+#define PARALLEL_SORT_CUTOFF (1 << 14)
+
+// Baldes por thread no Sample Sort (mais baldes equilibram melhor a carga)
+#define SAMPLE_SORT_BUCKETS_PER_THREAD 4
+
+// Amostras por balde na escolha dos divisores
+#define SAMPLE_SORT_OVERSAMPLING 32
+
+// Sequências iniciais por thread no MergeSort paralelo
+#define MERGE_SORT_RUNS_PER_THREAD 4
+
+// Bloco ordenado por inserção antes das intercalações
+#define MERGE_SORT_BLOCK 32
+
+// Máximo de sequências na intercalação final (folhas da árvore)
+#define LOSER_TREE_WAYS 8
+
+/**
+ * Aloca memória ou encerra o programa
+ */
+static void *checked_malloc(size_t bytes) {
+    void *ptr = malloc(bytes > 0 ? bytes : 1);
+    if (ptr == NULL) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+    return ptr;
+}
+
+/**
+ * Ordena sequencialmente um trecho com o IntroSort, somando os contadores
+ */
+static void sequential_sort(int *arr, size_t n, SortCounters *counters) {
+    SortResult partial = SORT_KERNEL(intro_sort)(arr, n);
+    COUNT_COMPARISONS(counters, partial.comparisons);
+    COUNT_MOVEMENTS(counters, partial.movements);
+}
+
+/**
+ * Tarefa do QuickSort paralelo
+ */
+typedef struct {
+    ThreadPool *pool;
+    TaskGroup *group;
+    SortCounters *total;
+    int *arr;
+    size_t n;
+} QuickTask;
+
+/**
+ * Partição de Hoare com pivô pela mediana de três (movido para arr[0])
+ *
+ * @return k tal que arr[0 .. k-1] <= pivô <= arr[k .. n-1], com 0 < k < n
+ */
+static size_t hoare_partition(int *arr, size_t n, SortCounters *counters) {
+    size_t mid = n / 2;
+    int a = arr[0], b = arr[mid], c = arr[n - 1];
+    size_t pivot_idx;
+
+    COUNT_COMPARISONS(counters, 3);
+    if ((a < b) == (b < c)) {
+        pivot_idx = mid;
+    } else if ((b < a) == (a < c)) {
+        pivot_idx = 0;
+    } else {
+        pivot_idx = n - 1;
+    }
+
+    int pivot = arr[pivot_idx];
+    arr[pivot_idx] = arr[0];
+    arr[0] = pivot;
+    COUNT_MOVEMENT(counters);
+
+    ptrdiff_t i = -1, j = (ptrdiff_t)n;
+    for (;;) {
+        do {
+            i++;
+            COUNT_COMPARISON(counters);
+        } while (arr[i] < pivot);
+        do {
+            j--;
+            COUNT_COMPARISON(counters);
+        } while (arr[j] > pivot);
+
+        if (i >= j) {
+            return (size_t)j + 1;
+        }
+
+        int temp = arr[i];
+        arr[i] = arr[j];
+        arr[j] = temp;
+        COUNT_MOVEMENT(counters);
+    }
+}
+
+static void parallel_quick_task(void *arg) {
+    QuickTask *task = (QuickTask *)arg;
+    SortCounters counters = {0, 0};
+    int *arr = task->arr;
+    size_t n = task->n;
+
+    // Particionar, entregar o lado esquerdo a outra tarefa e seguir no direito
+    while (n > PARALLEL_SORT_CUTOFF) {
+        size_t split = hoare_partition(arr, n, &counters);
+
+        QuickTask *child = (QuickTask *)checked_malloc(sizeof(QuickTask));
+        *child = *task;
+        child->arr = arr;
+        child->n = split;
+        thread_pool_submit(task->pool, task->group, parallel_quick_task,
+                           child);
+
+        arr += split;
+        n -= split;
+    }
+
+    sequential_sort(arr, n, &counters);
+    COUNT_MERGE_ATOMIC(task->total, &counters);
+    free(task);
+}
+
+/**
+ * QuickSort paralelo
+ */
+SortResult SORT_KERNEL(parallel_quick_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    ThreadPool *pool = parallel_shared_pool();
+    TaskGroup group;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    QuickTask *root = (QuickTask *)checked_malloc(sizeof(QuickTask));
+    root->pool = pool;
+    root->group = &group;
+    root->total = &counters;
+    root->arr = arr;
+    root->n = n;
+
+    task_group_init(&group);
+    thread_pool_submit(pool, &group, parallel_quick_task, root);
+    thread_pool_wait(pool, &group);
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    result.threads = thread_pool_size(pool);
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Estado compartilhado de uma execução do Sample Sort
+ */
+typedef struct {
+    int *arr;
+    int *buffer;                // Destino da distribuição por baldes
+    unsigned short *bucket_of;  // Balde de cada elemento
+    size_t n;
+    int num_chunks;
+    int num_buckets;
+    const int *splitters;       // Divisores distintos, em ordem crescente
+    int num_splitters;
+    int equal_buckets;          // 1 se os baldes ímpares guardam as chaves
+                                // iguais a um divisor (já na posição final)
+    size_t *offsets;            // num_chunks x num_buckets
+    size_t *bucket_begin;       // num_buckets + 1
+    SortCounters *total;
+} SampleSortState;
+
+/**
+ * Tarefa de uma fase paralela: um índice (trecho, balde, segmento) sobre o
+ * estado compartilhado do algoritmo
+ */
+typedef struct {
+    void *state;
+    int index;
+} PhaseTask;
+
+/**
+ * Limites do trecho c entre num_chunks trechos
+ */
+static void chunk_range(const SampleSortState *state, int c, size_t *begin,
+                        size_t *end) {
+    *begin = (size_t)((unsigned long long)state->n * c / state->num_chunks);
+    *end = (size_t)((unsigned long long)state->n * (c + 1) /
+                    state->num_chunks);
+}
+
+/**
+ * Fase 1: classifica os elementos de um trecho e conta por balde. Com baldes
+ * de igualdade, o balde 2j recebe as chaves entre os divisores j - 1 e j e
+ * o balde 2j + 1 as iguais ao divisor j
+ */
+static void classify_chunk(void *arg) {
+    PhaseTask *task = (PhaseTask *)arg;
+    SampleSortState *state = (SampleSortState *)task->state;
+    SortCounters counters = {0, 0};
+    size_t *counts = state->offsets + (size_t)task->index * state->num_buckets;
+    int num_splitters = state->num_splitters;
+    size_t begin, end, i;
+
+    chunk_range(state, task->index, &begin, &end);
+    for (i = begin; i < end; i++) {
+        int value = state->arr[i];
+        int lo = 0, hi = num_splitters;
+
+        // Busca binária pelo primeiro divisor >= valor
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            COUNT_COMPARISON(&counters);
+            if (state->splitters[mid] < value) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        int bucket = lo;
+        if (state->equal_buckets) {
+            bucket = 2 * lo;
+            if (lo < num_splitters) {
+                COUNT_COMPARISON(&counters);
+                bucket += state->splitters[lo] == value;
+            }
+        }
+        state->bucket_of[i] = (unsigned short)bucket;
+        counts[bucket]++;
+    }
+
+    COUNT_MERGE_ATOMIC(state->total, &counters);
+}
+
+/**
+ * Fase 2: distribui os elementos de um trecho nos baldes
+ */
+static void scatter_chunk(void *arg) {
+    PhaseTask *task = (PhaseTask *)arg;
+    SampleSortState *state = (SampleSortState *)task->state;
+    SortCounters counters = {0, 0};
+    size_t *offsets =
+        state->offsets + (size_t)task->index * state->num_buckets;
+    size_t begin, end, i;
+
+    chunk_range(state, task->index, &begin, &end);
+    for (i = begin; i < end; i++) {
+        state->buffer[offsets[state->bucket_of[i]]++] = state->arr[i];
+        COUNT_MOVEMENT(&counters);
+    }
+
+    COUNT_MERGE_ATOMIC(state->total, &counters);
+}
+
+/**
+ * Fase 3: ordena um balde e o copia de volta (os baldes de igualdade só
+ * têm chaves iguais e não precisam de ordenação)
+ */
+static void sort_bucket(void *arg) {
+    PhaseTask *task = (PhaseTask *)arg;
+    SampleSortState *state = (SampleSortState *)task->state;
+    SortCounters counters = {0, 0};
+    size_t begin = state->bucket_begin[task->index];
+    size_t size = state->bucket_begin[task->index + 1] - begin;
+
+    if (!state->equal_buckets || task->index % 2 == 0) {
+        sequential_sort(state->buffer + begin, size, &counters);
+    }
+    memcpy(state->arr + begin, state->buffer + begin, size * sizeof(int));
+    COUNT_MOVEMENTS(&counters, size);
+
+    COUNT_MERGE_ATOMIC(state->total, &counters);
+}
+
+/**
+ * Executa count tarefas (uma por índice) e aguarda todas
+ */
+static void run_phase(ThreadPool *pool, void *state, int count,
+                      TaskFunction function) {
+    PhaseTask *tasks = (PhaseTask *)checked_malloc(count * sizeof(PhaseTask));
+    TaskGroup group;
+    int i;
+
+    task_group_init(&group);
+    for (i = 0; i < count; i++) {
+        tasks[i].state = state;
+        tasks[i].index = i;
+        thread_pool_submit(pool, &group, function, &tasks[i]);
+    }
+    thread_pool_wait(pool, &group);
+
+    free(tasks);
+}
+
+/**
+ * Sample Sort paralelo
+ */
+SortResult SORT_KERNEL(sample_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    ThreadPool *pool = parallel_shared_pool();
+    int threads = thread_pool_size(pool);
+    int b, c, i;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    int num_buckets = threads * SAMPLE_SORT_BUCKETS_PER_THREAD;
+    if ((size_t)num_buckets > n / PARALLEL_SORT_CUTOFF) {
+        num_buckets = (int)(n / PARALLEL_SORT_CUTOFF);
+    }
+    // Com baldes de igualdade são até 2 * num_buckets - 1 (unsigned short)
+    if (num_buckets > 32768) {
+        num_buckets = 32768;
+    }
+
+    if (threads == 1 || num_buckets < 2) {
+        // Entrada pequena ou execução serial: um único balde
+        sequential_sort(arr, n, &counters);
+    } else {
+        SampleSortState state;
+        int num_samples = num_buckets * SAMPLE_SORT_OVERSAMPLING;
+        int *samples = (int *)checked_malloc(num_samples * sizeof(int));
+        int *splitters = (int *)checked_malloc(num_buckets * sizeof(int));
+
+        // Amostras em posições pseudoaleatórias reprodutíveis (o módulo
+        // aceita n acima de 2^32; o viés é desprezível para a amostragem)
+        for (i = 0; i < num_samples; i++) {
+            samples[i] = arr[prng_at(n, i) % n];
+        }
+        sequential_sort(samples, num_samples, &counters);
+
+        // Divisores distintos: um divisor repetido indica uma chave
+        // frequente, que ganha um balde de igualdade (como no IPS4o) em vez
+        // de baldes vazios e um balde enorme ordenado à toa
+        int num_splitters = 0, repeated = 0;
+        for (b = 0; b < num_buckets - 1; b++) {
+            int splitter = samples[(b + 1) * SAMPLE_SORT_OVERSAMPLING];
+            if (num_splitters > 0 &&
+                splitters[num_splitters - 1] == splitter) {
+                repeated = 1;
+            } else {
+                splitters[num_splitters++] = splitter;
+            }
+        }
+        free(samples);
+        num_buckets = repeated ? 2 * num_splitters + 1 : num_splitters + 1;
+
+        state.arr = arr;
+        state.buffer = (int *)sort_scratch(SCRATCH_DATA, n * sizeof(int));
+        state.bucket_of = (unsigned short *)sort_scratch(
+            SCRATCH_AUX, n * sizeof(unsigned short));
+        state.n = n;
+        state.num_chunks = threads;
+        state.num_buckets = num_buckets;
+        state.splitters = splitters;
+        state.num_splitters = num_splitters;
+        state.equal_buckets = repeated;
+        state.offsets = (size_t *)calloc((size_t)threads * num_buckets,
+                                         sizeof(size_t));
+        state.bucket_begin =
+            (size_t *)checked_malloc((num_buckets + 1) * sizeof(size_t));
+        state.total = &counters;
+        if (state.offsets == NULL) {
+            fprintf(stderr, "Erro na alocação de memória\n");
+            exit(EXIT_FAILURE);
+        }
+
+        run_phase(pool, &state, state.num_chunks, classify_chunk);
+
+        // Prefixos: início de cada balde e posição de cada trecho nele
+        size_t position = 0;
+        for (b = 0; b < num_buckets; b++) {
+            state.bucket_begin[b] = position;
+            for (c = 0; c < state.num_chunks; c++) {
+                size_t *slot = &state.offsets[(size_t)c * num_buckets + b];
+                size_t count = *slot;
+                *slot = position;
+                position += count;
+            }
+        }
+        state.bucket_begin[num_buckets] = position;
+
+        run_phase(pool, &state, state.num_chunks, scatter_chunk);
+        run_phase(pool, &state, num_buckets, sort_bucket);
+
+        sort_scratch_done(state.bucket_of);
+        sort_scratch_done(state.buffer);
+        free(state.offsets);
+        free(state.bucket_begin);
+        free(splitters);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    result.threads = threads;
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Intercala de forma estável a[0..na) e b[0..nb) em out (empates ficam com
+ * o elemento de a, que vem antes no array)
+ */
+static void stable_merge(const int *a, size_t na, const int *b, size_t nb,
+                         int *out, SortCounters *counters) {
+    size_t ia = 0, ib = 0, io = 0;
+
+    while (ia < na && ib < nb) {
+        COUNT_COMPARISON(counters);
+        out[io++] = b[ib] < a[ia] ? b[ib++] : a[ia++];
+    }
+    memcpy(out + io, a + ia, (na - ia) * sizeof(int));
+    io += na - ia;
+    memcpy(out + io, b + ib, (nb - ib) * sizeof(int));
+    COUNT_MOVEMENTS(counters, na + nb);
+}
+
+/**
+ * MergeSort estável e sequencial de uma sequência: blocos ordenados por
+ * inserção e intercalações de baixo para cima usando scratch (mesmo
+ * tamanho); o resultado termina em arr
+ */
+static void stable_sort_run(int *arr, int *scratch, size_t n,
+                            SortCounters *counters) {
+    int *src = arr, *dst = scratch;
+    size_t begin, width, i, j;
+
+    for (begin = 0; begin < n; begin += MERGE_SORT_BLOCK) {
+        size_t end = begin + MERGE_SORT_BLOCK < n ? begin + MERGE_SORT_BLOCK
+                                                  : n;
+        for (i = begin + 1; i < end; i++) {
+            int key = arr[i];
+            for (j = i; j > begin; j--) {
+                COUNT_COMPARISON(counters);
+                if (arr[j - 1] <= key) {
+                    break;
+                }
+                arr[j] = arr[j - 1];
+                COUNT_MOVEMENT(counters);
+            }
+            arr[j] = key;
+            COUNT_MOVEMENT(counters);
+        }
+    }
+
+    for (width = MERGE_SORT_BLOCK; width < n; width *= 2) {
+        for (begin = 0; begin < n; begin += 2 * width) {
+            size_t mid = begin + width < n ? begin + width : n;
+            size_t end = mid + width < n ? mid + width : n;
+            stable_merge(src + begin, mid - begin, src + mid, end - mid,
+                         dst + begin, counters);
+        }
+        int *temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != arr) {
+        memcpy(arr, src, n * sizeof(int));
+        COUNT_MOVEMENTS(counters, n);
+    }
+}
+
+/**
+ * Estado compartilhado de uma execução do MergeSort paralelo
+ */
+typedef struct {
+    int *src;         // Sequências ordenadas da rodada atual
+    int *dst;         // Destino da rodada atual
+    size_t n;
+    int num_runs;     // Sequências da rodada atual (potência de 2)
+    int pieces;       // Segmentos de saída por intercalação
+    SortCounters *total;
+} MergeSortState;
+
+/**
+ * Limites da sequência r entre num_runs sequências
+ */
+static void run_range(const MergeSortState *state, int r, size_t *begin,
+                      size_t *end) {
+    *begin = (size_t)((unsigned long long)state->n * r / state->num_runs);
+    *end = (size_t)((unsigned long long)state->n * (r + 1) / state->num_runs);
+}
+
+/**
+ * Fase 1: ordena uma sequência (o destino serve de área auxiliar)
+ */
+static void sort_run(void *arg) {
+    PhaseTask *task = (PhaseTask *)arg;
+    MergeSortState *state = (MergeSortState *)task->state;
+    SortCounters counters = {0, 0};
+    size_t begin, end;
+
+    run_range(state, task->index, &begin, &end);
+    stable_sort_run(state->src + begin, state->dst + begin, end - begin,
+                    &counters);
+
+    COUNT_MERGE_ATOMIC(state->total, &counters);
+}
+
+/**
+ * Caminho de intercalação (co-ranking): quantos elementos de a estão entre
+ * os k primeiros da intercalação estável de a e b
+ */
+static size_t merge_path(const int *a, size_t na, const int *b, size_t nb,
+                         size_t k, SortCounters *counters) {
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = k < na ? k : na;
+
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        COUNT_COMPARISON(counters);
+        if (a[i] <= b[k - i - 1]) {
+            lo = i + 1;  // a[i] sai antes de b[k - i - 1]
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Fase 2: um segmento de saída de uma intercalação de duas sequências;
+ * cada intercalação é dividida em `pieces` segmentos de mesmo tamanho
+ */
+static void merge_piece(void *arg) {
+    PhaseTask *task = (PhaseTask *)arg;
+    MergeSortState *state = (MergeSortState *)task->state;
+    SortCounters counters = {0, 0};
+    int pair = task->index / state->pieces;
+    int piece = task->index % state->pieces;
+    size_t a_begin, mid, b_begin, end;
+
+    run_range(state, 2 * pair, &a_begin, &mid);
+    run_range(state, 2 * pair + 1, &b_begin, &end);
+
+    const int *a = state->src + a_begin;
+    const int *b = state->src + mid;
+    size_t na = mid - a_begin, nb = end - mid;
+    size_t total = na + nb;
+    size_t k0 = (size_t)((unsigned long long)total * piece / state->pieces);
+    size_t k1 =
+        (size_t)((unsigned long long)total * (piece + 1) / state->pieces);
+    size_t i0 = merge_path(a, na, b, nb, k0, &counters);
+    size_t i1 = merge_path(a, na, b, nb, k1, &counters);
+
+    stable_merge(a + i0, i1 - i0, b + (k0 - i0), (k1 - i1) - (k0 - i0),
+                 state->dst + a_begin + k0, &counters);
+
+    COUNT_MERGE_ATOMIC(state->total, &counters);
+}
+
+/**
+ * Fonte de uma árvore de perdedores
+ */
+typedef struct {
+    const int *cur;
+    const int *end;
+} MergeSource;
+
+/**
+ * Verdadeiro se a fonte a vence a fonte b (menor elemento; no empate vence
+ * a de menor índice, o que mantém a estabilidade; fontes esgotadas perdem)
+ */
+static int source_wins(const MergeSource *sources, int a, int b,
+                       SortCounters *counters) {
+    int a_done = sources[a].cur == sources[a].end;
+    int b_done = sources[b].cur == sources[b].end;
+
+    if (a_done || b_done) {
+        return b_done && (!a_done || a < b);
+    }
+    COUNT_COMPARISON(counters);
+    return *sources[a].cur < *sources[b].cur ||
+           (*sources[a].cur == *sources[b].cur && a < b);
+}
+
+/**
+ * Intercalação de k fontes com uma árvore de perdedores: cada nó interno
+ * guarda o perdedor da sua disputa, então cada elemento emitido custa
+ * log2(k) comparações ao longo de um único caminho folha-raiz
+ */
+static void loser_tree_merge(MergeSource *sources, int k, int *out,
+                             SortCounters *counters) {
+    int tree[LOSER_TREE_WAYS];
+    int winners[2 * LOSER_TREE_WAYS];
+    int leaves = 1;
+    int node, s;
+    size_t emitted = 0;
+
+    while (leaves < k) {
+        leaves *= 2;
+    }
+
+    // Folhas sem fonte ficam esgotadas
+    for (s = k; s < leaves; s++) {
+        sources[s].cur = sources[s].end = NULL;
+    }
+
+    for (s = 0; s < leaves; s++) {
+        winners[leaves + s] = s;
+    }
+    for (node = leaves - 1; node >= 1; node--) {
+        int a = winners[2 * node], b = winners[2 * node + 1];
+        if (source_wins(sources, a, b, counters)) {
+            winners[node] = a;
+            tree[node] = b;
+        } else {
+            winners[node] = b;
+            tree[node] = a;
+        }
+    }
+    int winner = winners[1];
+
+    while (sources[winner].cur != sources[winner].end) {
+        out[emitted++] = *sources[winner].cur++;
+
+        // Reprisa as disputas do caminho da folha do vencedor até a raiz
+        for (node = (leaves + winner) / 2; node >= 1; node /= 2) {
+            if (source_wins(sources, tree[node], winner, counters)) {
+                int temp = tree[node];
+                tree[node] = winner;
+                winner = temp;
+            }
+        }
+    }
+    COUNT_MOVEMENTS(counters, emitted);
+}
+
+/**
+ * Primeira posição de run[0..n) com elemento >= value (ou > value)
+ */
+static size_t run_bound(const int *run, size_t n, long long value, int upper,
+                        SortCounters *counters) {
+    size_t lo = 0, hi = n;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        COUNT_COMPARISON(counters);
+        if (upper ? run[mid] <= value : run[mid] < value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Co-ranking de várias sequências: posições split[r] tais que os rank
+ * primeiros elementos da intercalação estável são exatamente os prefixos
+ * run[r][0..split[r]). Busca o menor valor x com pelo menos rank elementos
+ * <= x; os empates com x são tomados das primeiras sequências.
+ */
+static void multiway_split(const MergeSortState *state, size_t rank,
+                           size_t *split, SortCounters *counters) {
+    long long lo = INT_MIN, hi = INT_MAX;
+    size_t begin, end;
+    int r;
+
+    while (lo < hi) {
+        long long x = lo + (hi - lo) / 2;
+        size_t at_most = 0;
+        for (r = 0; r < state->num_runs; r++) {
+            run_range(state, r, &begin, &end);
+            at_most += run_bound(state->src + begin, end - begin, x, 1,
+                                 counters);
+        }
+        if (at_most >= rank) {
+            hi = x;
+        } else {
+            lo = x + 1;
+        }
+    }
+
+    size_t taken = 0;
+    size_t upper[LOSER_TREE_WAYS];
+    for (r = 0; r < state->num_runs; r++) {
+        run_range(state, r, &begin, &end);
+        split[r] = run_bound(state->src + begin, end - begin, lo, 0,
+                             counters);
+        upper[r] = run_bound(state->src + begin, end - begin, lo, 1,
+                             counters);
+        taken += split[r];
+    }
+    for (r = 0; r < state->num_runs && taken < rank; r++) {
+        size_t equal = upper[r] - split[r];
+        size_t need = rank - taken;
+        size_t take = equal < need ? equal : need;
+        split[r] += take;
+        taken += take;
+    }
+}
+
+/**
+ * Fase 3: um segmento de saída da intercalação final de k vias
+ */
+static void multiway_merge_piece(void *arg) {
+    PhaseTask *task = (PhaseTask *)arg;
+    MergeSortState *state = (MergeSortState *)task->state;
+    SortCounters counters = {0, 0};
+    MergeSource sources[LOSER_TREE_WAYS];
+    size_t first[LOSER_TREE_WAYS], last[LOSER_TREE_WAYS];
+    size_t k0 = (size_t)((unsigned long long)state->n * task->index /
+                         state->pieces);
+    size_t k1 = (size_t)((unsigned long long)state->n * (task->index + 1) /
+                         state->pieces);
+    size_t begin, end;
+    int r;
+
+    multiway_split(state, k0, first, &counters);
+    multiway_split(state, k1, last, &counters);
+    for (r = 0; r < state->num_runs; r++) {
+        run_range(state, r, &begin, &end);
+        sources[r].cur = state->src + begin + first[r];
+        sources[r].end = state->src + begin + last[r];
+    }
+    loser_tree_merge(sources, state->num_runs, state->dst + k0, &counters);
+
+    COUNT_MERGE_ATOMIC(state->total, &counters);
+}
+
+/**
+ * MergeSort paralelo
+ */
+SortResult SORT_KERNEL(parallel_merge_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    ThreadPool *pool = parallel_shared_pool();
+    int threads = thread_pool_size(pool);
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    int *buffer = (int *)sort_scratch(SCRATCH_DATA, n * sizeof(int));
+
+    // Sequências: potência de 2 com MERGE_SORT_RUNS_PER_THREAD por thread
+    int num_runs = 1;
+    while (num_runs < threads * MERGE_SORT_RUNS_PER_THREAD &&
+           n / (num_runs * 2) >= PARALLEL_SORT_CUTOFF) {
+        num_runs *= 2;
+    }
+
+    if (threads == 1 || num_runs < 2) {
+        // Entrada pequena ou execução serial: MergeSort sequencial
+        stable_sort_run(arr, buffer, n, &counters);
+    } else {
+        MergeSortState state;
+        state.src = arr;
+        state.dst = buffer;
+        state.n = n;
+        state.num_runs = num_runs;
+        state.total = &counters;
+
+        run_phase(pool, &state, num_runs, sort_run);
+
+        // Rodadas de intercalação aos pares, cada uma dividida entre as
+        // threads pelo caminho de intercalação
+        while (state.num_runs > LOSER_TREE_WAYS) {
+            int pairs = state.num_runs / 2;
+            state.pieces = (threads + pairs - 1) / pairs;
+            run_phase(pool, &state, pairs * state.pieces, merge_piece);
+
+            int *temp = state.src;
+            state.src = state.dst;
+            state.dst = temp;
+            state.num_runs = pairs;
+        }
+
+        // Intercalação final de k vias, um segmento de saída por thread
+        state.pieces = threads;
+        run_phase(pool, &state, threads, multiway_merge_piece);
+
+        if (state.dst != arr) {
+            memcpy(arr, state.dst, n * sizeof(int));
+            COUNT_MOVEMENTS(&counters, n);
+        }
+    }
+    sort_scratch_done(buffer);
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    result.threads = threads;
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
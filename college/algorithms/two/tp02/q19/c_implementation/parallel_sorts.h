@@ -0,0 +1,53 @@
+/**
+ * parallel_sorts.h
+ * Algoritmos de ordenação paralelos sobre o pool de threads com roubo de
+ * tarefas (o número de threads vem de parallel_set_threads)
+ */
+
+#ifndef PARALLEL_SORTS_H
+#define PARALLEL_SORTS_H
+
+#include "sorting_algorithms.h"
+
+/**
+ * QuickSort paralelo: cada partição gera uma tarefa para o lado esquerdo e
+ * continua no direito; partições pequenas usam o IntroSort sequencial
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult parallel_quick_sort(int *arr, size_t n);
+
+/**
+ * Sample Sort paralelo: amostragem de divisores, contagem e distribuição
+ * dos elementos por balde em paralelo e ordenação de cada balde como tarefa.
+ * Divisores repetidos na amostra ganham baldes de igualdade, que não são
+ * ordenados
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult sample_sort(int *arr, size_t n);
+
+/**
+ * MergeSort paralelo e estável: sequências ordenadas em paralelo,
+ * intercalações aos pares divididas entre as threads pelo caminho de
+ * intercalação (co-ranking) e intercalação final de até 8 vias com árvore
+ * de perdedores, dividida pelo co-ranking de várias sequências
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult parallel_merge_sort(int *arr, size_t n);
+
+/**
+ * Variantes sem instrumentação
+ */
+SortResult parallel_quick_sort_fast(int *arr, size_t n);
+SortResult sample_sort_fast(int *arr, size_t n);
+SortResult parallel_merge_sort_fast(int *arr, size_t n);
+
+#endif /* PARALLEL_SORTS_H */
@@ -0,0 +1,199 @@
+/**
+ * perf_counters.c
+ * Implementação dos contadores de desempenho via perf_event_open
+ */
+
+#define _GNU_SOURCE
+
+#include "perf_counters.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+static const char *event_names[PERF_NUM_EVENTS] = {
+    "cycles",      "instructions", "branch_misses", "l1d_misses",
+    "llc_misses",  "dtlb_misses",  "task_clock_ns", "page_faults"};
+
+/**
+ * Nome curto do evento
+ */
+const char *perf_event_name(PerfEvent event) {
+    if (event < 0 || event >= PERF_NUM_EVENTS) {
+        return "unknown";
+    }
+    return event_names[event];
+}
+
+#ifdef __linux__
+
+/**
+ * Configuração de um evento de cache (leitura com falta)
+ */
+#define CACHE_READ_MISS(cache)                                      \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) |                 \
+     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+/**
+ * Tipo e configuração de cada evento, na ordem de PerfEvent
+ */
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} event_specs[PERF_NUM_EVENTS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_DTLB)},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+};
+
+static int warned_unavailable = 0;
+
+/**
+ * Abre um evento para a thread atual
+ */
+static int open_event(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;         // Inclui threads criadas durante a medição
+    attr.exclude_kernel = 1;  // Funciona com perf_event_paranoid = 2
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/**
+ * Abre os contadores para a thread atual
+ */
+int perf_counters_open(PerfCounters *pc) {
+    int i;
+    int opened = 0;
+    int hardware_missing = 0;
+
+    pc->open_mask = 0;
+    for (i = 0; i < PERF_NUM_EVENTS; i++) {
+        pc->fds[i] = open_event(event_specs[i].type, event_specs[i].config);
+        if (pc->fds[i] >= 0) {
+            pc->open_mask |= 1u << i;
+            opened++;
+        } else if (event_specs[i].type != PERF_TYPE_SOFTWARE) {
+            hardware_missing = 1;
+        }
+    }
+
+    if (hardware_missing && !warned_unavailable) {
+        fprintf(stderr,
+                "Aviso: contadores de hardware indisponíveis; apenas os "
+                "eventos abertos com sucesso serão registrados\n");
+        warned_unavailable = 1;
+    }
+
+    return opened;
+}
+
+/**
+ * Zera e habilita os contadores abertos
+ */
+void perf_counters_start(PerfCounters *pc) {
+    int i;
+    for (i = 0; i < PERF_NUM_EVENTS; i++) {
+        if (pc->fds[i] >= 0) {
+            ioctl(pc->fds[i], PERF_EVENT_IOC_RESET, 0);
+        }
+    }
+    for (i = 0; i < PERF_NUM_EVENTS; i++) {
+        if (pc->fds[i] >= 0) {
+            ioctl(pc->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+/**
+ * Desabilita os contadores e lê os valores
+ */
+void perf_counters_stop(PerfCounters *pc, PerfSample *sample) {
+    int i;
+
+    for (i = 0; i < PERF_NUM_EVENTS; i++) {
+        if (pc->fds[i] >= 0) {
+            ioctl(pc->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    sample->valid_mask = 0;
+    for (i = 0; i < PERF_NUM_EVENTS; i++) {
+        uint64_t data[3];  // valor, tempo habilitado, tempo em execução
+
+        sample->values[i] = 0;
+        if (pc->fds[i] < 0 ||
+            read(pc->fds[i], data, sizeof(data)) != (ssize_t)sizeof(data)) {
+            continue;
+        }
+        if (data[2] == 0) {
+            continue;  // Evento nunca foi escalonado no hardware
+        }
+
+        // Corrigir a multiplexação quando há mais eventos que contadores
+        if (data[2] < data[1]) {
+            sample->values[i] = (unsigned long long)((double)data[0] *
+                                                     data[1] / data[2]);
+        } else {
+            sample->values[i] = data[0];
+        }
+        sample->valid_mask |= 1u << i;
+    }
+}
+
+/**
+ * Fecha os descritores abertos
+ */
+void perf_counters_close(PerfCounters *pc) {
+    int i;
+    for (i = 0; i < PERF_NUM_EVENTS; i++) {
+        if (pc->fds[i] >= 0) {
+            close(pc->fds[i]);
+            pc->fds[i] = -1;
+        }
+    }
+    pc->open_mask = 0;
+}
+
+#else /* !__linux__ */
+
+int perf_counters_open(PerfCounters *pc) {
+    int i;
+    for (i = 0; i < PERF_NUM_EVENTS; i++) {
+        pc->fds[i] = -1;
+    }
+    pc->open_mask = 0;
+    return 0;
+}
+
+void perf_counters_start(PerfCounters *pc) { (void)pc; }
+
+void perf_counters_stop(PerfCounters *pc, PerfSample *sample) {
+    (void)pc;
+    memset(sample, 0, sizeof(*sample));
+}
+
+void perf_counters_close(PerfCounters *pc) { (void)pc; }
+
+#endif /* __linux__ */
@@ -0,0 +1,82 @@
+/**
+ * perf_counters.h
+ * Contadores de desempenho do processador (Linux perf_event_open) com
+ * recuo para eventos de software quando o hardware não está disponível
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+/**
+ * Eventos coletados em cada execução medida
+ */
+typedef enum {
+    PERF_EV_CYCLES = 0,     // Ciclos do processador
+    PERF_EV_INSTRUCTIONS,   // Instruções executadas
+    PERF_EV_BRANCH_MISSES,  // Desvios mal previstos
+    PERF_EV_L1D_MISSES,     // Faltas de leitura na cache L1 de dados
+    PERF_EV_LLC_MISSES,     // Faltas de leitura na cache de último nível
+    PERF_EV_DTLB_MISSES,    // Faltas de leitura na dTLB
+    PERF_EV_TASK_CLOCK,     // Tempo de CPU em ns (evento de software)
+    PERF_EV_PAGE_FAULTS,    // Faltas de página (evento de software)
+    PERF_NUM_EVENTS
+} PerfEvent;
+
+/**
+ * Conjunto de descritores abertos para os eventos
+ */
+typedef struct {
+    int fds[PERF_NUM_EVENTS];  // Descritor por evento (-1 se indisponível)
+    unsigned int open_mask;    // Bit i ligado se o evento i foi aberto
+} PerfCounters;
+
+/**
+ * Valores lidos ao final de uma execução
+ */
+typedef struct {
+    unsigned long long values[PERF_NUM_EVENTS];  // Valores (escalados)
+    unsigned int valid_mask;  // Bit i ligado se values[i] é válido
+} PerfSample;
+
+/**
+ * Abre os contadores para a thread atual (e threads criadas depois)
+ *
+ * Cada evento é aberto individualmente; os de hardware que falharem ficam
+ * indisponíveis e os eventos de software continuam sendo coletados.
+ *
+ * @param pc Conjunto de contadores a inicializar
+ * @return Número de eventos abertos
+ */
+int perf_counters_open(PerfCounters *pc);
+
+/**
+ * Zera e habilita os contadores abertos
+ *
+ * @param pc Conjunto de contadores
+ */
+void perf_counters_start(PerfCounters *pc);
+
+/**
+ * Desabilita os contadores e lê os valores
+ *
+ * @param pc Conjunto de contadores
+ * @param sample Destino dos valores lidos
+ */
+void perf_counters_stop(PerfCounters *pc, PerfSample *sample);
+
+/**
+ * Fecha os descritores abertos
+ *
+ * @param pc Conjunto de contadores
+ */
+void perf_counters_close(PerfCounters *pc);
+
+/**
+ * Nome curto do evento (usado nos cabeçalhos dos CSVs)
+ *
+ * @param event Evento
+ * @return Nome do evento
+ */
+const char *perf_event_name(PerfEvent event);
+
+#endif /* PERF_COUNTERS_H */
@@ -1,209 +1,2489 @@
-/**
- * performance_test.c
- * Funções para testar o desempenho dos algoritmos de ordenação
- */
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <time.h>
-
-#include "sorting_algorithms.h"
-
-/**
- * Gera um array de números aleatórios
- *
- * @param size Tamanho do array
- * @return Ponteiro para o array gerado
- */
-int *generate_random_array(int size) {
-    int *arr = (int *)malloc(size * sizeof(int));
-    if (arr == NULL) {
-        fprintf(stderr, "Erro na alocação de memória\n");
-        exit(EXIT_FAILURE);
-    }
-
-    int i;
-    for (i = 0; i < size; i++) {
-        arr[i] =
-            rand() % 1000000 + 1;  // Números aleatórios entre 1 e 1.000.000
-    }
-
-    return arr;
-}
-
-/**
- * Verifica se um array está ordenado
- *
- * @param arr Array a ser verificado
- * @param n Tamanho do array
- * @return 1 se ordenado, 0 caso contrário
- */
-int is_sorted(int *arr, int n) {
-    int i;
-    for (i = 0; i < n - 1; i++) {
-        if (arr[i] > arr[i + 1]) {
-            return 0;
-        }
-    }
-    return 1;
-}
-
-/**
- * Executa um algoritmo de ordenação e verifica o resultado
- *
- * @param algorithm Ponteiro para a função do algoritmo
- * @param arr Array a ser ordenado
- * @param n Tamanho do array
- * @param algorithm_name Nome do algoritmo (para depuração)
- * @return Estrutura com os resultados (comparações, movimentações, tempo)
- */
-SortResult run_algorithm(SortResult (*algorithm)(int *, int), int *arr, int n,
-                         const char *algorithm_name) {
-    int *test_arr = (int *)malloc(n * sizeof(int));
-    if (test_arr == NULL) {
-        fprintf(stderr, "Erro na alocação de memória\n");
-        exit(EXIT_FAILURE);
-    }
-
-    // Copia o array original para não modificá-lo
-    memcpy(test_arr, arr, n * sizeof(int));
-
-    // Executa o algoritmo
-    SortResult result = algorithm(test_arr, n);
-
-    // Verifica se o array está ordenado
-    if (!is_sorted(test_arr, n)) {
-        fprintf(stderr, "ERRO: %s falhou em ordenar o array corretamente!\n",
-                algorithm_name);
-    }
-
-    free(test_arr);
-    return result;
-}
-
-/**
- * Executa testes de desempenho para todos os algoritmos
- *
- * @param sizes Array com os tamanhos a serem testados
- * @param num_sizes Número de tamanhos diferentes
- * @param results_dir Diretório para salvar os resultados
- */
-void run_performance_tests(int *sizes, int num_sizes, const char *results_dir) {
-    // Definir os algoritmos e seus nomes
-    SortResult (*algorithms[])(int *, int) = {selection_sort, insertion_sort,
-                                              bubble_sort, quick_sort};
-    const char *algorithm_names[] = {"selection_sort", "insertion_sort",
-                                     "bubble_sort", "quick_sort"};
-    int num_algorithms = 4;
-
-    // Arrays para armazenar os resultados
-    SortResult ***results =
-        (SortResult ***)malloc(num_algorithms * sizeof(SortResult **));
-    int i, j;
-
-    // Inicializar a matriz de resultados
-    for (i = 0; i < num_algorithms; i++) {
-        results[i] = (SortResult **)malloc(num_sizes * sizeof(SortResult *));
-        for (j = 0; j < num_sizes; j++) {
-            results[i][j] = (SortResult *)malloc(sizeof(SortResult));
-        }
-    }
-
-    // Para cada tamanho de array
-    for (i = 0; i < num_sizes; i++) {
-        int size = sizes[i];
-        printf("\nTestando com array de tamanho %d...\n", size);
-
-        // Gerar array aleatório
-        int *arr = generate_random_array(size);
-
-        // Executar cada algoritmo
-        for (j = 0; j < num_algorithms; j++) {
-            printf("  Executando %s...\n", algorithm_names[j]);
-            *(results[j][i]) =
-                run_algorithm(algorithms[j], arr, size, algorithm_names[j]);
-            printf("  %s concluído em %.6f segundos\n", algorithm_names[j],
-                   results[j][i]->execution_time);
-        }
-
-        // Liberar memória do array
-        free(arr);
-    }
-
-    // Criar diretório para resultados se não existir
-    char command[256];
-    sprintf(command, "mkdir -p %s", results_dir);
-    system(command);
-
-    // Salvar resultados em arquivos CSV individuais para cada algoritmo
-    for (i = 0; i < num_algorithms; i++) {
-        char filename[256];
-        sprintf(filename, "%s/%s_results.csv", results_dir, algorithm_names[i]);
-
-        FILE *file = fopen(filename, "w");
-        if (file == NULL) {
-            fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n",
-                    filename);
-            continue;
-        }
-
-        // Escrever cabeçalho
-        fprintf(file, "size,execution_time_s,comparisons,movements\n");
-
-        // Escrever dados
-        for (j = 0; j < num_sizes; j++) {
-            fprintf(file, "%d,%f,%llu,%llu\n", sizes[j],
-                    results[i][j]->execution_time, results[i][j]->comparisons,
-                    results[i][j]->movements);
-        }
-
-        fclose(file);
-        printf("Resultados para %s salvos em %s\n", algorithm_names[i],
-               filename);
-    }
-
-    // Salvar resultados em um único arquivo CSV para todos os algoritmos
-    char combined_filename[256];
-    sprintf(combined_filename, "%s/combined_results.csv", results_dir);
-
-    FILE *combined_file = fopen(combined_filename, "w");
-    if (combined_file == NULL) {
-        fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n",
-                combined_filename);
-    } else {
-        // Escrever cabeçalho
-        fprintf(combined_file, "size");
-        for (i = 0; i < num_algorithms; i++) {
-            fprintf(combined_file,
-                    ",%s_execution_time_s,%s_comparisons,%s_movements",
-                    algorithm_names[i], algorithm_names[i], algorithm_names[i]);
-        }
-        fprintf(combined_file, "\n");
-
-        // Escrever dados
-        for (j = 0; j < num_sizes; j++) {
-            fprintf(combined_file, "%d", sizes[j]);
-
-            for (i = 0; i < num_algorithms; i++) {
-                fprintf(combined_file, ",%f,%llu,%llu",
-                        results[i][j]->execution_time,
-                        results[i][j]->comparisons, results[i][j]->movements);
-            }
-
-            fprintf(combined_file, "\n");
-        }
-
-        fclose(combined_file);
-        printf("Resultados combinados salvos em %s\n", combined_filename);
-    }
-
-    // Liberar memória dos resultados
-    for (i = 0; i < num_algorithms; i++) {
-        for (j = 0; j < num_sizes; j++) {
-            free(results[i][j]);
-        }
-        free(results[i]);
-    }
-    free(results);
-}
\ No newline at end of file
+/**
+ * performance_test.c
+ * Funções para testar o desempenho dos algoritmos de ordenação
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "antiqsort.h"
+#include "baseline_sorts.h"
+#include "checksum.h"
+#include "environment.h"
+#include "external_sort.h"
+#include "json_writer.h"
+#include "memory_tracker.h"
+#include "perf_counters.h"
+#include "performance_test.h"
+#include "results_history.h"
+#include "segmented_sorts.h"
+#include "selection_sorts.h"
+#include "thread_pool.h"
+#include "wide_sorts.h"
+
+// Laço de calibração do relógio: rodadas e duração de cada uma
+#define CALIBRATION_ROUNDS 20
+#define CALIBRATION_ROUND_TIME_S 0.005
+
+// Carga média por CPU acima da qual a máquina é considerada ocupada
+#define LOAD_WARNING 0.5
+
+/**
+ * Variantes de um algoritmo para o tipo de chave do plano
+ */
+typedef struct {
+    const char *name;
+    KeyType key_type;
+    const SortAlgorithm *algorithm;  // Chaves int
+    const WideSortAlgorithm *wide;   // Chaves de 64 bits (NULL com int)
+    const RecordSortAlgorithm *records;  // Registros (NULL com chaves)
+    RecordLayout layout;             // Forma dos dados
+    size_t payload;                  // Bytes de carga dos registros
+    int parallel;                    // 1 se usa o pool de threads
+    size_t k;                        // Top-k (0 = ordenação completa)
+    const size_t *offsets;           // Segmentos (NULL = um único array)
+    size_t num_segments;             // Número de segmentos
+    int serial_baseline;             // 1 = mede também com uma thread
+} SortKernel;
+
+/**
+ * Fração serial estimada de uma célula do estudo de escalonamento e a
+ * ajustada a todas as células do grupo
+ */
+typedef struct {
+    double karp_flatt;       // Métrica de Karp-Flatt (NAN com uma thread)
+    double serial_fraction;  // Ajuste de Amdahl (forte) ou Gustafson (fraco)
+} ScalingFit;
+
+/**
+ * Ordena os segmentos de um kernel: com o motor segmentado (algorithm
+ * NULL) ou chamando o algoritmo em cada segmento, como order_strings faz
+ * nos programas do tp02
+ *
+ * @param kernel Algoritmo (offsets definido)
+ * @param fast 1 para a variante limpa
+ * @param arr Buffer com todos os segmentos
+ * @return Resultado da chamada (contadores somados nos segmentos)
+ */
+static SortResult call_segmented(const SortKernel *kernel, int fast,
+                                 int *arr) {
+    if (kernel->algorithm == NULL) {
+        return (fast ? segmented_sort_fast : segmented_sort)(
+            arr, kernel->offsets, kernel->num_segments);
+    }
+
+    SortFunction function =
+        fast ? kernel->algorithm->fast : kernel->algorithm->function;
+    SortResult total = {0};
+    size_t s;
+
+    uint64_t start_time = bench_now_ns();
+    for (s = 0; s < kernel->num_segments; s++) {
+        size_t first = kernel->offsets[s];
+        SortResult r =
+            function(arr + first, kernel->offsets[s + 1] - first);
+        total.comparisons += r.comparisons;
+        total.movements += r.movements;
+        if (r.threads > total.threads) {
+            total.threads = r.threads;
+        }
+    }
+    total.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    return total;
+}
+
+/**
+ * Chama a variante instrumentada ou a limpa com o tipo de chave do kernel
+ *
+ * @param kernel Algoritmo
+ * @param fast 1 para a variante limpa
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Resultado da chamada
+ */
+static SortResult call_sort(const SortKernel *kernel, int fast, void *arr,
+                            size_t n) {
+    if (kernel->offsets != NULL) {
+        return call_segmented(kernel, fast, (int *)arr);
+    }
+    if (kernel->records != NULL) {
+        return (fast ? kernel->records->fast : kernel->records->function)(
+            arr, n, kernel->layout, kernel->payload);
+    }
+
+    switch (kernel->key_type) {
+        case KEY_INT64:
+            return (fast ? kernel->wide->fast_i64
+                         : kernel->wide->function_i64)((int64_t *)arr, n);
+        case KEY_UINT64:
+            return (fast ? kernel->wide->fast_u64
+                         : kernel->wide->function_u64)((uint64_t *)arr, n);
+        case KEY_INT32:
+        default:
+            return (fast ? kernel->algorithm->fast
+                         : kernel->algorithm->function)((int *)arr, n);
+    }
+}
+
+/**
+ * Bytes por elemento da entrada de um kernel (chave ou registro)
+ *
+ * @param kernel Algoritmo
+ * @return Tamanho do elemento
+ */
+static size_t kernel_element_size(const SortKernel *kernel) {
+    if (kernel->records != NULL) {
+        return record_size(kernel->payload);
+    }
+    return key_type_size(kernel->key_type);
+}
+
+/**
+ * Gera um array segundo a distribuição de entrada escolhida, em um buffer
+ * mapeado com a política de páginas atual e já pré-faltado
+ *
+ * @param buffer Buffer a preencher
+ * @param size Tamanho do array
+ * @param key_type Tipo das chaves
+ * @param distribution Parâmetros da distribuição
+ */
+void generate_input_array(LargeBuffer *buffer, size_t size, KeyType key_type,
+                          const DistributionParams *distribution) {
+    large_buffer_alloc(buffer, size * key_type_size(key_type));
+    generate_keys(buffer->data, size, key_type, distribution);
+}
+
+/**
+ * Parâmetros de geração de uma distribuição, com os valores dados na linha
+ * de comando no lugar dos padrões
+ *
+ * @param plan Plano de execução
+ * @param kind Distribuição
+ * @return Parâmetros (campos não dados continuam com o padrão)
+ */
+static DistributionParams plan_distribution_params(const TestPlan *plan,
+                                                   Distribution kind) {
+    DistributionParams params = distribution_default_params(kind, plan->seed);
+
+    params.threads = plan->threads;
+    if (plan->swaps > 0) {
+        params.swaps = plan->swaps;
+    }
+    if (plan->unique_values > 0) {
+        params.unique_values = plan->unique_values;
+    }
+    if (plan->sawtooth_period > 0) {
+        params.sawtooth_period = plan->sawtooth_period;
+    }
+    if (plan->zipf_exponent > 0.0) {
+        params.zipf_exponent = plan->zipf_exponent;
+    }
+    return params;
+}
+
+/**
+ * Nome da distribuição com o parâmetro dado na linha de comando, se houver
+ * (ex.: "nearly_sorted(swaps=50)"), para que o histórico não compare
+ * entradas geradas de formas diferentes
+ *
+ * @param plan Plano de execução
+ * @param kind Distribuição
+ * @param label Destino do nome
+ * @param size Tamanho do destino
+ */
+static void distribution_label(const TestPlan *plan, Distribution kind,
+                               char *label, size_t size) {
+    const char *name = distribution_name(kind);
+
+    if (kind == DIST_NEARLY_SORTED && plan->swaps > 0) {
+        snprintf(label, size, "%s(swaps=%d)", name, plan->swaps);
+    } else if (kind == DIST_FEW_UNIQUE && plan->unique_values > 0) {
+        snprintf(label, size, "%s(unique=%d)", name, plan->unique_values);
+    } else if (kind == DIST_SAWTOOTH && plan->sawtooth_period > 0) {
+        snprintf(label, size, "%s(period=%d)", name, plan->sawtooth_period);
+    } else if (kind == DIST_ZIPF && plan->zipf_exponent > 0.0) {
+        snprintf(label, size, "%s(s=%g)", name, plan->zipf_exponent);
+    } else {
+        snprintf(label, size, "%s", name);
+    }
+}
+
+/**
+ * Escreve os parâmetros com que a entrada foi de fato gerada (padrões já
+ * resolvidos para n), ou null se a distribuição não tem parâmetros
+ *
+ * @param file Arquivo de saída
+ * @param first Indica se é o primeiro campo do objeto
+ * @param plan Plano de execução
+ * @param kind Distribuição
+ * @param n Chaves geradas
+ */
+static void json_write_distribution_params(FILE *file, int *first,
+                                           const TestPlan *plan,
+                                           Distribution kind, size_t n) {
+    DistributionParams params = plan_distribution_params(plan, kind);
+    int first_param = 1;
+
+    distribution_resolve_params(&params, n);
+    json_write_key(file, first, "distribution_params");
+    switch (kind) {
+        case DIST_NEARLY_SORTED:
+            fputc('{', file);
+            json_write_uint_field(file, &first_param, "swaps",
+                                  (unsigned long long)params.swaps);
+            fputc('}', file);
+            break;
+        case DIST_FEW_UNIQUE:
+            fputc('{', file);
+            json_write_uint_field(file, &first_param, "unique_values",
+                                  (unsigned long long)params.unique_values);
+            fputc('}', file);
+            break;
+        case DIST_SAWTOOTH:
+            fputc('{', file);
+            json_write_uint_field(file, &first_param, "sawtooth_period",
+                                  (unsigned long long)params.sawtooth_period);
+            fputc('}', file);
+            break;
+        case DIST_ZIPF:
+            fputc('{', file);
+            json_write_double_field(file, &first_param, "zipf_exponent",
+                                    params.zipf_exponent);
+            fputc('}', file);
+            break;
+        default:
+            fputs("null", file);
+            break;
+    }
+}
+
+/**
+ * Verifica se um array está ordenado
+ *
+ * @param arr Array a ser verificado
+ * @param n Tamanho do array
+ * @param key_type Tipo das chaves
+ * @return 1 se ordenado, 0 caso contrário
+ */
+int is_sorted(const void *arr, size_t n, KeyType key_type) {
+    size_t i;
+
+    for (i = 1; i < n; i++) {
+        int ordered;
+        switch (key_type) {
+            case KEY_INT64:
+                ordered = ((const int64_t *)arr)[i - 1] <=
+                          ((const int64_t *)arr)[i];
+                break;
+            case KEY_UINT64:
+                ordered = ((const uint64_t *)arr)[i - 1] <=
+                          ((const uint64_t *)arr)[i];
+                break;
+            case KEY_INT32:
+            default:
+                ordered = ((const int *)arr)[i - 1] <= ((const int *)arr)[i];
+                break;
+        }
+        if (!ordered) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Verifica o resultado de um algoritmo de seleção: arr[0 .. k) ordenado e
+ * nenhum elemento depois dele menor que arr[k - 1]
+ *
+ * @param arr Array a ser verificado
+ * @param n Tamanho do array
+ * @param k Número de menores elementos (limitado a n)
+ * @return 1 se correto, 0 caso contrário
+ */
+static int is_top_k_sorted(const int *arr, size_t n, size_t k) {
+    size_t i;
+
+    if (k > n) {
+        k = n;
+    }
+    if (k == 0 || !is_sorted(arr, k, KEY_INT32)) {
+        return k == 0;
+    }
+    for (i = k; i < n; i++) {
+        if (arr[i] < arr[k - 1]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Verifica a saída de um kernel (ordenação completa ou top-k): a ordem e,
+ * pela soma de verificação, que ela é uma permutação da entrada
+ *
+ * @param kernel Algoritmo
+ * @param arr Array após a chamada
+ * @param n Tamanho do array
+ * @param input Soma de verificação da entrada
+ * @return 1 se correta, 0 caso contrário
+ */
+static int kernel_output_ok(const SortKernel *kernel, const void *arr,
+                            size_t n, const MultisetChecksum *input) {
+    MultisetChecksum output =
+        multiset_checksum(arr, n, kernel_element_size(kernel));
+
+    if (!multiset_checksum_equal(&output, input)) {
+        return 0;
+    }
+    if (kernel->k > 0) {
+        return is_top_k_sorted((const int *)arr, n, kernel->k);
+    }
+    if (kernel->records != NULL) {
+        return records_sorted(arr, n, kernel->payload);
+    }
+    if (kernel->offsets != NULL) {
+        return segments_sorted((const int *)arr, kernel->offsets,
+                               kernel->num_segments);
+    }
+    return is_sorted(arr, n, kernel->key_type);
+}
+
+/**
+ * Copia os contadores lidos para os campos do resultado
+ *
+ * @param sample Valores lidos dos contadores
+ * @param result Resultado a preencher
+ */
+static void store_counters(const PerfSample *sample, SortResult *result) {
+    result->cycles = sample->values[PERF_EV_CYCLES];
+    result->instructions = sample->values[PERF_EV_INSTRUCTIONS];
+    result->branch_misses = sample->values[PERF_EV_BRANCH_MISSES];
+    result->l1d_misses = sample->values[PERF_EV_L1D_MISSES];
+    result->llc_misses = sample->values[PERF_EV_LLC_MISSES];
+    result->dtlb_misses = sample->values[PERF_EV_DTLB_MISSES];
+    result->task_clock_ns = sample->values[PERF_EV_TASK_CLOCK];
+    result->page_faults = sample->values[PERF_EV_PAGE_FAULTS];
+    result->counters_valid = sample->valid_mask;
+}
+
+/**
+ * Escreve no CSV os nomes das colunas de contadores
+ *
+ * @param file Arquivo de saída
+ * @param prefix Prefixo das colunas (nome do algoritmo ou "")
+ */
+static void write_counters_header(FILE *file, const char *prefix) {
+    int e;
+    for (e = 0; e < PERF_NUM_EVENTS; e++) {
+        fprintf(file, ",%s%s", prefix, perf_event_name((PerfEvent)e));
+    }
+    fprintf(file, ",%sipc,%sbranch_mpki", prefix, prefix);
+}
+
+/**
+ * Escreve no CSV os contadores de um resultado (vazio se indisponível)
+ *
+ * @param file Arquivo de saída
+ * @param r Resultado
+ */
+static void write_counters(FILE *file, const SortResult *r) {
+    const unsigned long long values[PERF_NUM_EVENTS] = {
+        r->cycles,      r->instructions, r->branch_misses, r->l1d_misses,
+        r->llc_misses,  r->dtlb_misses,  r->task_clock_ns, r->page_faults};
+    unsigned int has_cycles = r->counters_valid & (1u << PERF_EV_CYCLES);
+    unsigned int has_instr = r->counters_valid & (1u << PERF_EV_INSTRUCTIONS);
+    int e;
+
+    for (e = 0; e < PERF_NUM_EVENTS; e++) {
+        if (r->counters_valid & (1u << e)) {
+            fprintf(file, ",%llu", values[e]);
+        } else {
+            fprintf(file, ",");
+        }
+    }
+
+    // Instruções por ciclo e desvios mal previstos por mil instruções
+    if (has_cycles && has_instr && r->cycles > 0) {
+        fprintf(file, ",%.3f", (double)r->instructions / r->cycles);
+    } else {
+        fprintf(file, ",");
+    }
+    if (has_instr && (r->counters_valid & (1u << PERF_EV_BRANCH_MISSES)) &&
+        r->instructions > 0) {
+        fprintf(file, ",%.3f",
+                1000.0 * (double)r->branch_misses / r->instructions);
+    } else {
+        fprintf(file, ",");
+    }
+}
+
+/**
+ * Escreve no CSV os nomes das colunas de um resultado
+ *
+ * @param file Arquivo de saída
+ * @param prefix Prefixo das colunas (nome do algoritmo ou "")
+ */
+static void write_result_header(FILE *file, const char *prefix) {
+    fprintf(file, ",%sexecution_time_s,%scomparisons,%smovements", prefix,
+            prefix, prefix);
+    fprintf(file,
+            ",%smedian_time_s,%sp95_time_s,%sstddev_time_s,%sci95_low_s"
+            ",%sci95_high_s,%srepetitions,%sinner_loops,%scv,%sreruns"
+            ",%sunstable,%sinvalid",
+            prefix, prefix, prefix, prefix, prefix, prefix, prefix, prefix,
+            prefix, prefix, prefix);
+    write_counters_header(file, prefix);
+    fprintf(file,
+            ",%sthreads,%scpu_time_s,%sserial_time_s,%sspeedup"
+            ",%sparallel_efficiency,%svariant",
+            prefix, prefix, prefix, prefix, prefix, prefix);
+    fprintf(file,
+            ",%speak_rss_delta_bytes,%sbytes_allocated,%sallocations"
+            ",%speak_extra_bytes",
+            prefix, prefix, prefix, prefix);
+}
+
+/**
+ * Escreve no CSV as colunas de um resultado
+ *
+ * @param file Arquivo de saída
+ * @param r Resultado
+ */
+static void write_result_fields(FILE *file, const SortResult *r) {
+    fprintf(file, ",%.9f,%llu,%llu", r->execution_time, r->comparisons,
+            r->movements);
+    fprintf(file, ",%.9f,%.9f,%.9f,%.9f,%.9f,%d,%d,%.6f,%d,%d,%d",
+            r->median_time, r->p95_time, r->stddev_time, r->ci_low_time,
+            r->ci_high_time, r->repetitions, r->inner_loops, r->cv_time,
+            r->reruns, r->unstable, r->invalid);
+    write_counters(file, r);
+    fprintf(file, ",%d,%.9f,%.9f,%.3f,%.3f,%s", r->threads, r->cpu_time,
+            r->serial_time, r->speedup, r->parallel_efficiency,
+            r->variant != NULL ? r->variant : "");
+    fprintf(file, ",%llu,%llu,%llu,%llu", r->peak_rss_delta,
+            r->bytes_allocated, r->allocations, r->peak_extra_bytes);
+}
+
+/**
+ * Escreve no CSV os nomes das colunas do estudo de escalonamento
+ *
+ * @param file Arquivo de saída
+ * @param prefix Prefixo das colunas (nome do algoritmo ou "")
+ */
+static void write_scaling_header(FILE *file, const char *prefix) {
+    fprintf(file, ",%skarp_flatt,%sserial_fraction_fit", prefix, prefix);
+}
+
+/**
+ * Escreve no CSV as colunas do estudo de escalonamento
+ *
+ * @param file Arquivo de saída
+ * @param fit Frações serial da célula
+ */
+static void write_scaling_fields(FILE *file, const ScalingFit *fit) {
+    fprintf(file, ",%.4f,%.4f", fit->karp_flatt, fit->serial_fraction);
+}
+
+/**
+ * Mede o tempo da variante limpa com repetições e lotes
+ *
+ * Entradas pequenas são ordenadas várias vezes por repetição, com cópias
+ * preparadas fora da região medida, para que o tempo medido fique muito acima
+ * da resolução do relógio. As cópias ficam no buffer de trabalho (já
+ * pré-faltado) sempre que cabem nele, então a região medida não tem faltas
+ * de página.
+ *
+ * @param kernel Algoritmo
+ * @param arr Array original (não é modificado)
+ * @param n Tamanho do array
+ * @param first_time Tempo de uma execução de calibração em segundos
+ * @param config Configuração do motor de medição
+ * @param work Buffer de trabalho (pelo menos uma cópia do array)
+ * @param repetitions Destino do número de repetições medidas
+ * @param inner_loops Destino do número de ordenações por repetição
+ * @param samples_out Destino dos tempos de cada repetição (liberar com
+ *                    free), ou NULL para descartá-los
+ * @return Estatísticas dos tempos por ordenação
+ */
+static BenchStats measure_kernel(const SortKernel *kernel, const void *arr,
+                                 size_t n, double first_time,
+                                 const BenchConfig *config, LargeBuffer *work,
+                                 int *repetitions, int *inner_loops,
+                                 double **samples_out) {
+    size_t bytes = n * kernel_element_size(kernel);
+    LargeBuffer extra = {0};
+    int k;
+
+    // Escalar o laço interno para entradas pequenas
+    int inner = 1;
+    if (first_time < config->min_batch_time_s) {
+        double wanted = first_time > 0.0
+                            ? ceil(config->min_batch_time_s / first_time)
+                            : (double)config->max_inner_loops;
+        inner = wanted > config->max_inner_loops ? config->max_inner_loops
+                                                 : (int)wanted;
+        if (bytes > 0 && (size_t)inner * bytes > config->max_batch_bytes) {
+            inner = (int)(config->max_batch_bytes / bytes);
+        }
+        if (inner < 1) {
+            inner = 1;
+        }
+    }
+
+    char *batch = (char *)work->data;
+    if (bytes * inner > work->mapped) {
+        large_buffer_alloc(&extra, bytes * inner);
+        batch = (char *)extra.data;
+    }
+
+    int max_reps = config->repetitions > 0 ? config->repetitions : 1;
+    int min_reps =
+        config->min_repetitions < max_reps ? config->min_repetitions : max_reps;
+    double *samples = (double *)malloc(max_reps * sizeof(double));
+    if (samples == NULL) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Repetições medidas, limitadas pelo orçamento de tempo da célula
+    double spent = 0.0;
+    int reps = 0;
+    while (reps < max_reps) {
+        for (k = 0; k < inner; k++) {
+            memcpy(batch + (size_t)k * bytes, arr, bytes);
+        }
+
+        uint64_t start_time = bench_now_ns();
+        for (k = 0; k < inner; k++) {
+            call_sort(kernel, 1, batch + (size_t)k * bytes, n);
+        }
+        double elapsed = bench_elapsed_s(start_time, bench_now_ns());
+
+        samples[reps++] = elapsed / inner;
+        spent += elapsed;
+        if (reps >= min_reps && spent >= config->cell_time_budget_s) {
+            break;
+        }
+    }
+
+    BenchStats stats =
+        bench_compute_stats(samples, reps, config->bootstrap_resamples);
+
+    *repetitions = reps;
+    *inner_loops = inner;
+    large_buffer_free(&extra);
+    if (samples_out != NULL) {
+        *samples_out = samples;
+    } else {
+        free(samples);
+    }
+    return stats;
+}
+
+/**
+ * Mede a mediana de um algoritmo paralelo executado com uma única thread
+ *
+ * @param kernel Algoritmo
+ * @param arr Array original (não é modificado)
+ * @param n Tamanho do array
+ * @param config Configuração do motor de medição
+ * @param work Buffer de trabalho (pelo menos uma cópia do array)
+ * @return Mediana dos tempos com uma thread em segundos
+ */
+static double measure_serial_baseline(const SortKernel *kernel,
+                                      const void *arr, size_t n,
+                                      const BenchConfig *config,
+                                      LargeBuffer *work) {
+    int threads = parallel_get_threads();
+    int reps, inner;
+
+    parallel_set_threads(1);
+
+    // Execução de calibração (também recria o pool com uma thread)
+    memcpy(work->data, arr, n * kernel_element_size(kernel));
+    uint64_t start_time = bench_now_ns();
+    call_sort(kernel, 1, work->data, n);
+    double first_time = bench_elapsed_s(start_time, bench_now_ns());
+
+    BenchStats stats = measure_kernel(kernel, arr, n, first_time, config,
+                                      work, &reps, &inner, NULL);
+
+    parallel_set_threads(threads);
+    return stats.median;
+}
+
+/**
+ * Executa um algoritmo de ordenação e verifica o resultado
+ *
+ * A variante instrumentada roda uma vez e fornece comparações e
+ * movimentações. Todo o resto usa a variante limpa: a primeira execução lê
+ * os contadores de desempenho do processador e o tempo de CPU e calibra o
+ * tamanho do lote; as seguintes são o aquecimento e as repetições. Para
+ * algoritmos paralelos, a mesma medição com uma thread fornece o speedup.
+ *
+ * A execução instrumentada também pré-falta as áreas auxiliares dos
+ * algoritmos (sort_scratch), e o array de trabalho é mapeado e tocado antes
+ * de qualquer medição: as faltas de página ficam fora da região medida.
+ *
+ * A memória é medida na execução instrumentada: as áreas auxiliares do
+ * algoritmo anterior são liberadas e o pool de threads é criado antes, para
+ * que o pico de RSS e as alocações sejam só do algoritmo.
+ *
+ * @param kernel Algoritmo (variantes instrumentada e limpa)
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @param config Configuração do motor de medição
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult run_algorithm(const SortKernel *kernel, const void *arr, size_t n,
+                         const BenchConfig *config) {
+    size_t bytes = n * kernel_element_size(kernel);
+    LargeBuffer work;
+    large_buffer_alloc(&work, bytes);
+    void *test_arr = work.data;
+
+    // Copia o array original para não modificá-lo
+    memcpy(test_arr, arr, bytes);
+
+    // Multiconjunto da entrada, que a saída tem de preservar
+    MultisetChecksum input =
+        multiset_checksum(arr, n, kernel_element_size(kernel));
+
+    sort_scratch_release();
+    if (kernel->parallel) {
+        parallel_shared_pool();
+    }
+
+    // Execução instrumentada: comparações, movimentações e memória
+    MemoryUsage memory;
+    memory_tracker_begin();
+    SortResult result = call_sort(kernel, 0, test_arr, n);
+    memory_tracker_end(&memory);
+    result.peak_rss_delta = memory.peak_rss_delta;
+    result.bytes_allocated = memory.bytes_allocated;
+    result.allocations = memory.allocations;
+    result.peak_extra_bytes = memory.peak_extra_bytes;
+
+    // Verifica se o array está ordenado e é uma permutação da entrada
+    result.invalid = 0;
+    if (!kernel_output_ok(kernel, test_arr, n, &input)) {
+        fprintf(stderr, "ERRO: %s falhou em ordenar o array corretamente!\n",
+                kernel->name);
+        result.invalid = 1;
+    }
+
+    // Primeira execução limpa: contadores de hardware e calibração
+    PerfCounters counters;
+    PerfSample sample;
+    perf_counters_open(&counters);
+
+    memcpy(test_arr, arr, bytes);
+    uint64_t cpu_start = bench_process_cpu_ns();
+    uint64_t start_time = bench_now_ns();
+    perf_counters_start(&counters);
+    SortResult clean = call_sort(kernel, 1, test_arr, n);
+    perf_counters_stop(&counters, &sample);
+    double first_time = bench_elapsed_s(start_time, bench_now_ns());
+    double cpu_time = bench_elapsed_s(cpu_start, bench_process_cpu_ns());
+
+    perf_counters_close(&counters);
+    store_counters(&sample, &result);
+
+    if (!kernel_output_ok(kernel, test_arr, n, &input)) {
+        fprintf(stderr,
+                "ERRO: %s (variante limpa) falhou em ordenar o array "
+                "corretamente!\n",
+                kernel->name);
+        result.invalid = 1;
+    }
+
+    // Aquecimento (a execução de calibração conta como a primeira)
+    int i;
+    for (i = 1; i < config->warmup; i++) {
+        memcpy(test_arr, arr, bytes);
+        call_sort(kernel, 1, test_arr, n);
+    }
+
+    BenchStats stats = measure_kernel(kernel, arr, n, first_time, config,
+                                      &work, &result.repetitions,
+                                      &result.inner_loops, &result.samples);
+
+    // Célula ruidosa: medir de novo e ficar com a medição de menor CV; se
+    // nenhuma ficar abaixo do limite, o resultado é marcado como instável
+    double cv = bench_cv(&stats);
+    result.reruns = 0;
+    while (config->max_cv > 0.0 && cv > config->max_cv &&
+           result.reruns < config->noise_reruns) {
+        int reps, inner;
+        double *samples;
+        BenchStats again = measure_kernel(kernel, arr, n, first_time, config,
+                                          &work, &reps, &inner, &samples);
+        double again_cv = bench_cv(&again);
+
+        result.reruns++;
+        if (again_cv < cv) {
+            free(result.samples);
+            result.samples = samples;
+            result.repetitions = reps;
+            result.inner_loops = inner;
+            stats = again;
+            cv = again_cv;
+        } else {
+            free(samples);
+        }
+    }
+    result.cv_time = cv;
+    result.unstable = config->max_cv > 0.0 && cv > config->max_cv;
+
+    result.execution_time = stats.median;
+    result.median_time = stats.median;
+    result.p95_time = stats.p95;
+    result.stddev_time = stats.stddev;
+    result.ci_low_time = stats.ci_low;
+    result.ci_high_time = stats.ci_high;
+    result.cpu_time = cpu_time;
+    result.threads = clean.threads > 0 ? clean.threads : 1;
+    result.variant = clean.variant;
+
+    // Speedup em relação à execução com uma thread
+    result.serial_time = stats.median;
+    result.speedup = 1.0;
+    if (kernel->parallel && kernel->serial_baseline && result.threads > 1) {
+        result.serial_time =
+            measure_serial_baseline(kernel, arr, n, config, &work);
+        if (stats.median > 0.0) {
+            result.speedup = result.serial_time / stats.median;
+        }
+    }
+    result.parallel_efficiency = result.speedup / result.threads;
+
+    large_buffer_free(&work);
+    return result;
+}
+
+/**
+ * Escreve um campo booleano que pode ser desconhecido (-1 vira null)
+ */
+static void write_json_tristate(FILE *file, int *first, const char *key,
+                                int value) {
+    json_write_key(file, first, key);
+    fputs(value < 0 ? "null" : value ? "true" : "false", file);
+}
+
+/**
+ * Escreve o objeto "environment" com os metadados do ambiente
+ *
+ * @param file Arquivo de saída
+ * @param first Indicador de primeiro campo do objeto externo
+ * @param env Metadados do ambiente
+ */
+static void write_json_environment(FILE *file, int *first,
+                                   const EnvironmentInfo *env) {
+    json_write_key(file, first, "environment");
+    fputc('{', file);
+    int first_env = 1;
+    json_write_string_field(file, &first_env, "revision", env->revision);
+    json_write_string_field(file, &first_env, "compiler", env->compiler);
+    json_write_string_field(file, &first_env, "cflags", env->cflags);
+    json_write_string_field(file, &first_env, "cpu_model", env->cpu_model);
+    json_write_string_field(file, &first_env, "kernel", env->kernel);
+    json_write_string_field(file, &first_env, "hostname", env->hostname);
+    json_write_string_field(file, &first_env, "host_id", env->host_id);
+    json_write_string_field(file, &first_env, "timestamp", env->timestamp);
+    json_write_uint_field(file, &first_env, "online_cpus",
+                          (unsigned long long)env->online_cpus);
+    json_write_string_field(file, &first_env, "governor", env->governor);
+    write_json_tristate(file, &first_env, "turbo", env->turbo);
+    write_json_tristate(file, &first_env, "smt", env->smt);
+    json_write_double_array_field(file, &first_env, "load_average",
+                                  env->load_average, 3);
+    json_write_key(file, &first_env, "pinned_cpu");
+    if (env->pinned_cpu >= 0) {
+        fprintf(file, "%d", env->pinned_cpu);
+    } else {
+        fputs("null", file);
+    }
+    json_write_double_field(file, &first_env, "clock_cv", env->clock_cv);
+    fputc('}', file);
+}
+
+/**
+ * Escreve um registro JSON Lines para uma célula da matriz
+ *
+ * @param file Arquivo de saída
+ * @param plan Plano de execução
+ * @param env Metadados do ambiente
+ * @param algorithm_name Nome do algoritmo
+ * @param k Top-k do algoritmo (0 = ordenação completa)
+ * @param kind Distribuição da entrada
+ * @param size Tamanho da entrada (segmentos no modo segmentado)
+ * @param elements Elementos ordenados
+ * @param pages Páginas obtidas para a entrada
+ * @param r Resultado
+ * @param fit Frações serial (NULL fora do estudo de escalonamento)
+ */
+static void write_json_record(FILE *file, const TestPlan *plan,
+                              const EnvironmentInfo *env,
+                              const char *algorithm_name, size_t k,
+                              Distribution kind, size_t size,
+                              size_t elements, PagePolicy pages,
+                              const SortResult *r, const ScalingFit *fit) {
+    const unsigned long long values[PERF_NUM_EVENTS] = {
+        r->cycles,      r->instructions, r->branch_misses, r->l1d_misses,
+        r->llc_misses,  r->dtlb_misses,  r->task_clock_ns, r->page_faults};
+    int first = 1;
+    int e;
+
+    fputc('{', file);
+    json_write_string_field(file, &first, "algorithm", algorithm_name);
+    json_write_string_field(file, &first, "distribution",
+                            distribution_name(kind));
+    json_write_distribution_params(file, &first, plan, kind, elements);
+    json_write_uint_field(file, &first, "size", (unsigned long long)size);
+    json_write_uint_field(file, &first, "elements",
+                          (unsigned long long)elements);
+    json_write_key(file, &first, "segment_max_length");
+    if (plan->segmented) {
+        fprintf(file, "%zu", plan->segment_max_length);
+    } else {
+        fputs("null", file);
+    }
+    json_write_key(file, &first, "k");
+    if (k > 0) {
+        fprintf(file, "%zu", k < size ? k : size);
+    } else {
+        fputs("null", file);
+    }
+    json_write_string_field(file, &first, "key_type",
+                            key_type_name(plan->key_type));
+    json_write_string_field(file, &first, "layout",
+                            record_layout_name(plan->layout));
+    json_write_key(file, &first, "payload_bytes");
+    if (plan->layout != LAYOUT_KEYS) {
+        fprintf(file, "%zu", plan->payload);
+    } else {
+        fputs("null", file);
+    }
+    json_write_string_field(file, &first, "pages", page_policy_name(pages));
+    json_write_uint_field(file, &first, "seed", plan->seed);
+    json_write_uint_field(file, &first, "threads",
+                          (unsigned long long)plan->threads);
+    json_write_double_field(file, &first, "execution_time_s",
+                            r->execution_time);
+    json_write_uint_field(file, &first, "comparisons", r->comparisons);
+    json_write_uint_field(file, &first, "movements", r->movements);
+    json_write_double_field(file, &first, "median_time_s", r->median_time);
+    json_write_double_field(file, &first, "p95_time_s", r->p95_time);
+    json_write_double_field(file, &first, "stddev_time_s", r->stddev_time);
+    json_write_double_field(file, &first, "ci95_low_s", r->ci_low_time);
+    json_write_double_field(file, &first, "ci95_high_s", r->ci_high_time);
+    json_write_uint_field(file, &first, "repetitions",
+                          (unsigned long long)r->repetitions);
+    json_write_uint_field(file, &first, "inner_loops",
+                          (unsigned long long)r->inner_loops);
+    json_write_double_field(file, &first, "cv", r->cv_time);
+    json_write_uint_field(file, &first, "reruns",
+                          (unsigned long long)r->reruns);
+    json_write_key(file, &first, "trusted");
+    fputs(r->unstable || r->invalid ? "false" : "true", file);
+    json_write_key(file, &first, "valid");
+    fputs(r->invalid ? "false" : "true", file);
+    json_write_uint_field(file, &first, "threads_used",
+                          (unsigned long long)r->threads);
+    json_write_double_field(file, &first, "cpu_time_s", r->cpu_time);
+    json_write_double_field(file, &first, "serial_time_s", r->serial_time);
+    json_write_double_field(file, &first, "speedup", r->speedup);
+    json_write_double_field(file, &first, "parallel_efficiency",
+                            r->parallel_efficiency);
+    json_write_key(file, &first, "variant");
+    if (r->variant != NULL) {
+        json_write_string(file, r->variant);
+    } else {
+        fputs("null", file);
+    }
+
+    // Estudo de escalonamento (null fora dele)
+    json_write_key(file, &first, "scaling");
+    if (fit != NULL) {
+        int first_scaling = 1;
+        fputc('{', file);
+        json_write_string_field(file, &first_scaling, "mode",
+                                plan->weak_scaling ? "weak" : "strong");
+        json_write_double_field(file, &first_scaling, "karp_flatt",
+                                fit->karp_flatt);
+        json_write_double_field(file, &first_scaling, "serial_fraction_fit",
+                                fit->serial_fraction);
+        fputc('}', file);
+    } else {
+        fputs("null", file);
+    }
+
+    // Contadores de desempenho (null se indisponível)
+    json_write_key(file, &first, "counters");
+    fputc('{', file);
+    int first_counter = 1;
+    for (e = 0; e < PERF_NUM_EVENTS; e++) {
+        const char *name = perf_event_name((PerfEvent)e);
+        if (r->counters_valid & (1u << e)) {
+            json_write_uint_field(file, &first_counter, name, values[e]);
+        } else {
+            json_write_key(file, &first_counter, name);
+            fputs("null", file);
+        }
+    }
+    fputc('}', file);
+
+    // Memória da execução instrumentada
+    json_write_key(file, &first, "memory");
+    fputc('{', file);
+    int first_memory = 1;
+    json_write_uint_field(file, &first_memory, "peak_rss_delta_bytes",
+                          r->peak_rss_delta);
+    json_write_uint_field(file, &first_memory, "bytes_allocated",
+                          r->bytes_allocated);
+    json_write_uint_field(file, &first_memory, "allocations",
+                          r->allocations);
+    json_write_uint_field(file, &first_memory, "peak_extra_bytes",
+                          r->peak_extra_bytes);
+    fputc('}', file);
+
+    write_json_environment(file, &first, env);
+
+    fputs("}\n", file);
+}
+
+/**
+ * Caminho do arquivo JSON Lines do plano
+ */
+static void json_results_path(const TestPlan *plan, char *path, size_t size) {
+    if (plan->json_path != NULL) {
+        snprintf(path, size, "%s", plan->json_path);
+    } else {
+        snprintf(path, size, "%s/results.jsonl", plan->results_dir);
+    }
+}
+
+/**
+ * Caminho do histórico de resultados do plano
+ */
+static void history_path(const TestPlan *plan, char *path, size_t size) {
+    if (plan->history_path != NULL) {
+        snprintf(path, size, "%s", plan->history_path);
+    } else {
+        snprintf(path, size, "%s/history.jsonl", plan->results_dir);
+    }
+}
+
+/**
+ * Número de contagens de threads por tamanho (1 sem estudo)
+ */
+static int plan_thread_steps(const TestPlan *plan) {
+    return plan->num_scaling_threads > 0 ? plan->num_scaling_threads : 1;
+}
+
+/**
+ * Distribuição da célula j. As células variam primeiro as threads, depois
+ * o tamanho e por fim a distribuição.
+ */
+static Distribution cell_distribution(const TestPlan *plan, int j) {
+    int per_distribution = plan->num_sizes * plan_thread_steps(plan);
+    return plan->distributions[j / per_distribution];
+}
+
+/**
+ * Threads da célula j (as do plano fora do estudo de escalonamento)
+ */
+static int cell_threads(const TestPlan *plan, int j) {
+    if (plan->num_scaling_threads == 0) {
+        return plan->threads;
+    }
+    return plan->scaling_threads[j % plan->num_scaling_threads];
+}
+
+/**
+ * Tamanho da célula j; no escalonamento fraco, --sizes é o tamanho por
+ * thread
+ */
+static size_t cell_size(const TestPlan *plan, int j) {
+    size_t size =
+        plan->sizes[(j / plan_thread_steps(plan)) % plan->num_sizes];
+    if (plan->weak_scaling) {
+        size *= (size_t)cell_threads(plan, j);
+    }
+    return size;
+}
+
+/**
+ * Calcula speedup, eficiência e fração serial das células first ..
+ * first + steps - 1 de um algoritmo em relação à primeira (uma thread).
+ *
+ * No escalonamento forte, speedup = T1 / Tp e a fração serial f ajusta
+ * Amdahl, Tp / T1 = f + (1 - f) / p, por mínimos quadrados. No fraco, o
+ * trabalho por thread é fixo: speedup escalonado = p * T1 / Tp e f ajusta
+ * Gustafson, speedup = p - f (p - 1). A métrica de Karp-Flatt é a mesma
+ * estimativa com um único p.
+ *
+ * @param plan Plano de execução
+ * @param results Resultados do algoritmo (todas as células)
+ * @param fits Frações do algoritmo (todas as células)
+ * @param first Célula com uma thread
+ * @param steps Contagens de threads
+ */
+static void compute_scaling(const TestPlan *plan, SortResult *results,
+                            ScalingFit *fits, int first, int steps) {
+    double t1 = results[first].median_time;
+    double numerator = 0.0, denominator = 0.0;
+    int t;
+
+    for (t = 0; t < steps; t++) {
+        SortResult *r = &results[first + t];
+        double p = (double)plan->scaling_threads[t];
+        double speedup = r->median_time > 0.0 ? t1 / r->median_time : 0.0;
+        if (plan->weak_scaling) {
+            speedup *= p;
+        }
+
+        r->serial_time = t1;
+        r->speedup = speedup;
+        r->parallel_efficiency = speedup / p;
+        fits[first + t].karp_flatt = NAN;
+
+        if (p > 1.0 && speedup > 0.0) {
+            if (plan->weak_scaling) {
+                fits[first + t].karp_flatt = (p - speedup) / (p - 1.0);
+                numerator += (p - 1.0) * (p - speedup);
+                denominator += (p - 1.0) * (p - 1.0);
+            } else {
+                double x = 1.0 / p, y = 1.0 / speedup;
+                fits[first + t].karp_flatt = (y - x) / (1.0 - x);
+                numerator += (1.0 - x) * (y - x);
+                denominator += (1.0 - x) * (1.0 - x);
+            }
+        }
+    }
+
+    for (t = 0; t < steps; t++) {
+        fits[first + t].serial_fraction =
+            denominator > 0.0 ? numerator / denominator : NAN;
+    }
+}
+
+/**
+ * Imprime o estudo de escalonamento de um grupo de células (mesma
+ * distribuição e tamanho base)
+ *
+ * @param plan Plano de execução
+ * @param kernels Algoritmos
+ * @param num_algorithms Número de algoritmos
+ * @param results Matriz de resultados
+ * @param fits Frações serial (algoritmo * num_cells + célula)
+ * @param num_cells Número de células
+ * @param first Célula com uma thread
+ */
+static void print_scaling_summary(const TestPlan *plan,
+                                  const SortKernel *kernels,
+                                  int num_algorithms, SortResult **results,
+                                  const ScalingFit *fits, int num_cells,
+                                  int first) {
+    int steps = plan->num_scaling_threads;
+    int i, t;
+
+    printf("  Escalonamento %s (%s):\n",
+           plan->weak_scaling ? "fraco" : "forte",
+           plan->weak_scaling ? "speedup escalonado, Gustafson"
+                              : "speedup, Amdahl");
+    for (i = 0; i < num_algorithms; i++) {
+        const ScalingFit *fit = &fits[i * num_cells + first];
+        for (t = 0; t < steps; t++) {
+            const SortResult *r = &results[i][first + t];
+            printf("    %-22s %3d threads: %.6f s, speedup %.2f, "
+                   "eficiência %.0f%%, Karp-Flatt %.3f\n",
+                   kernels[i].name, plan->scaling_threads[t], r->median_time,
+                   r->speedup, 100.0 * r->parallel_efficiency,
+                   fit[t].karp_flatt);
+        }
+        if (plan->weak_scaling || !(fit->serial_fraction > 0.0)) {
+            printf("    %-22s fração serial ajustada %.3f\n",
+                   kernels[i].name, fit->serial_fraction);
+        } else {
+            printf("    %-22s fração serial ajustada %.3f (speedup máximo "
+                   "%.1f)\n",
+                   kernels[i].name, fit->serial_fraction,
+                   1.0 / fit->serial_fraction);
+        }
+    }
+}
+
+/**
+ * Compara os algoritmos de seleção de uma célula com a ordenação completa
+ * mais rápida da mesma célula (nada é impresso sem as duas categorias)
+ *
+ * @param kernels Algoritmos do plano
+ * @param num_algorithms Número de algoritmos
+ * @param results Matriz de resultados
+ * @param cell Célula (distribuição, tamanho)
+ */
+static void print_selection_summary(const SortKernel *kernels,
+                                    int num_algorithms, SortResult **results,
+                                    int cell) {
+    int reference = -1;
+    int i;
+
+    for (i = 0; i < num_algorithms; i++) {
+        if (kernels[i].k == 0 &&
+            (reference < 0 || results[i][cell].median_time <
+                                  results[reference][cell].median_time)) {
+            reference = i;
+        }
+    }
+    if (reference < 0) {
+        return;
+    }
+
+    const SortResult *full = &results[reference][cell];
+    for (i = 0; i < num_algorithms; i++) {
+        const SortResult *r = &results[i][cell];
+        if (kernels[i].k == 0) {
+            continue;
+        }
+        printf("  %s (k=%zu) vs %s: tempo %.3fx, comparações %.3fx, "
+               "movimentações %.3fx\n",
+               kernels[i].name, kernels[i].k, kernels[reference].name,
+               full->median_time > 0.0 ? r->median_time / full->median_time
+                                       : 0.0,
+               full->comparisons > 0
+                   ? (double)r->comparisons / (double)full->comparisons
+                   : 0.0,
+               full->movements > 0
+                   ? (double)r->movements / (double)full->movements
+                   : 0.0);
+    }
+}
+
+/**
+ * Compara os algoritmos próprios de uma célula com a referência mais rápida
+ * (qsort, std::sort, pdqsort...) e lista os que perdem para ela; nada é
+ * impresso sem as duas categorias
+ *
+ * @param kernels Algoritmos do plano
+ * @param num_algorithms Número de algoritmos
+ * @param results Matriz de resultados
+ * @param cell Célula (distribuição, tamanho)
+ */
+static void print_baseline_summary(const SortKernel *kernels,
+                                   int num_algorithms, SortResult **results,
+                                   int cell) {
+    int reference = -1;
+    int candidates = 0, slower = 0;
+    int i;
+
+    for (i = 0; i < num_algorithms; i++) {
+        if (!is_baseline_algorithm(kernels[i].algorithm)) {
+            candidates += kernels[i].k == 0;
+        } else if (reference < 0 || results[i][cell].median_time <
+                                        results[reference][cell].median_time) {
+            reference = i;
+        }
+    }
+    if (reference < 0 || candidates == 0) {
+        return;
+    }
+
+    const SortResult *best = &results[reference][cell];
+    printf("  Referência mais rápida: %s (%.9f s)", kernels[reference].name,
+           best->median_time);
+    for (i = 0; i < num_algorithms; i++) {
+        const SortResult *r = &results[i][cell];
+        if (kernels[i].k > 0 || is_baseline_algorithm(kernels[i].algorithm) ||
+            r->median_time <= best->median_time) {
+            continue;
+        }
+        printf("%s %s %.3fx", slower == 0 ? "; mais lentos:" : ",",
+               kernels[i].name,
+               best->median_time > 0.0 ? r->median_time / best->median_time
+                                       : 0.0);
+        slower++;
+    }
+    fputs(slower == 0 ? "; todos os algoritmos a vencem\n" : "\n", stdout);
+}
+
+/**
+ * Imprime os desvios mal previstos de cada algoritmo em uma célula, por
+ * elemento e em relação ao primeiro algoritmo do plano (--branch-misses)
+ *
+ * @param kernels Algoritmos do plano
+ * @param num_algorithms Número de algoritmos
+ * @param results Matriz de resultados
+ * @param cell Célula (distribuição, tamanho)
+ * @param size Tamanho da entrada
+ */
+static void print_branch_report(const SortKernel *kernels,
+                                int num_algorithms, SortResult **results,
+                                int cell, size_t size) {
+    const unsigned int bit = 1u << PERF_EV_BRANCH_MISSES;
+    const SortResult *reference = &results[0][cell];
+    int i;
+
+    printf("  Desvios mal previstos (execução limpa):\n");
+    for (i = 0; i < num_algorithms; i++) {
+        const SortResult *r = &results[i][cell];
+        if (!(r->counters_valid & bit)) {
+            printf("    %-24s indisponível (sem contadores de hardware)\n",
+                   kernels[i].name);
+            continue;
+        }
+
+        printf("    %-24s %llu (%.3f por elemento", kernels[i].name,
+               r->branch_misses,
+               size > 0 ? (double)r->branch_misses / (double)size : 0.0);
+        if (r->counters_valid & (1u << PERF_EV_INSTRUCTIONS) &&
+            r->instructions > 0) {
+            printf(", %.3f por mil instruções",
+                   1000.0 * (double)r->branch_misses / r->instructions);
+        }
+        if (i > 0 && (reference->counters_valid & bit) &&
+            reference->branch_misses > 0) {
+            printf(", %.3fx %s",
+                   (double)r->branch_misses /
+                       (double)reference->branch_misses,
+                   kernels[0].name);
+        }
+        printf(")\n");
+    }
+}
+
+/**
+ * Controle de ruído antes da matriz: fixa a thread de medição em uma CPU
+ * (fora do estudo de escalonamento, que fixa o pool inteiro), mede a
+ * estabilidade do relógio com o laço de calibração e avisa sobre as fontes
+ * de ruído do ambiente
+ *
+ * @param plan Plano de execução
+ * @param env Metadados do ambiente (recebe pinned_cpu e clock_cv)
+ */
+static void prepare_noise_guard(const TestPlan *plan, EnvironmentInfo *env) {
+    if (plan->pin && plan->num_scaling_threads == 0) {
+        env->pinned_cpu = thread_pin_current(-1);
+    }
+
+    BenchCalibration calibration =
+        bench_calibrate_clock(CALIBRATION_ROUNDS, CALIBRATION_ROUND_TIME_S);
+    env->clock_cv = calibration.cv;
+
+    printf("Ambiente: governador %s, turbo %s, SMT %s, carga %.2f",
+           env->governor,
+           env->turbo < 0 ? "?" : env->turbo ? "ligado" : "desligado",
+           env->smt < 0 ? "?" : env->smt ? "ligado" : "desligado",
+           env->load_average[0]);
+    if (env->pinned_cpu >= 0) {
+        printf(", medição na CPU %d", env->pinned_cpu);
+    }
+    printf("\nCalibração: %d rodadas de %.2f ms, CV %.2f%%\n",
+           calibration.rounds, 1e3 * calibration.round_time,
+           100.0 * calibration.cv);
+
+    if (strcmp(env->governor, "unknown") != 0 &&
+        strcmp(env->governor, "performance") != 0) {
+        printf("Aviso: governador \"%s\"; a frequência varia com a carga "
+               "(use \"performance\")\n",
+               env->governor);
+    }
+    if (env->turbo > 0) {
+        printf("Aviso: turbo ligado; a frequência depende da temperatura e "
+               "das outras CPUs\n");
+    }
+    if (env->smt > 0 && plan->num_scaling_threads > 0) {
+        printf("Aviso: SMT ligado; threads irmãs dividem um núcleo no "
+               "estudo de escalonamento\n");
+    }
+    if (env->load_average[0] > LOAD_WARNING * env->online_cpus) {
+        printf("Aviso: carga média %.2f com %d CPUs; outros processos "
+               "disputam a máquina\n",
+               env->load_average[0], env->online_cpus);
+    }
+    if (plan->bench.max_cv > 0.0 && calibration.cv > plan->bench.max_cv) {
+        printf("Aviso: o relógio variou %.2f%% no laço de calibração "
+               "(limite %.1f%%); espere resultados instáveis\n",
+               100.0 * calibration.cv, 100.0 * plan->bench.max_cv);
+    }
+}
+
+/**
+ * Executa testes de desempenho para toda a matriz do plano
+ */
+int run_performance_tests(const TestPlan *plan) {
+    // No modo segmentado, o motor segmentado vem depois dos algoritmos
+    // chamados em cada segmento
+    int num_algorithms = plan->num_algorithms + (plan->segmented ? 1 : 0);
+    int steps = plan_thread_steps(plan);
+    int num_cells = plan->num_distributions * plan->num_sizes * steps;
+    int i, j;
+
+    EnvironmentInfo env;
+    environment_collect(&env);
+
+    // Threads dos algoritmos paralelos; no estudo de escalonamento, cada
+    // thread do pool fica em uma CPU e o número muda a cada célula
+    parallel_set_threads(plan->threads);
+    parallel_set_affinity(plan->num_scaling_threads > 0);
+
+    // Thread de medição fixada e estabilidade do relógio
+    prepare_noise_guard(plan, &env);
+
+    // Conjunto de instruções dos algoritmos vetorizados
+    simd_set_level(plan->simd);
+
+    // Páginas dos buffers das entradas e das áreas auxiliares
+    large_memory_set_policy(plan->pages);
+
+    // Elementos ordenados pelos algoritmos de seleção
+    size_t k = plan->k > 0 ? plan->k : SELECTION_DEFAULT_K;
+    selection_set_k(k);
+
+    // Variantes de cada algoritmo para o tipo de chave do plano
+    SortKernel *kernels =
+        (SortKernel *)malloc(num_algorithms * sizeof(SortKernel));
+    PagePolicy *cell_pages =
+        (PagePolicy *)malloc(num_cells * sizeof(PagePolicy));
+    size_t *cell_elements = (size_t *)malloc(num_cells * sizeof(size_t));
+    ScalingFit *fits = (ScalingFit *)calloc((size_t)num_algorithms * num_cells,
+                                            sizeof(ScalingFit));
+    if (kernels == NULL || cell_pages == NULL || cell_elements == NULL ||
+        fits == NULL) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < num_algorithms; i++) {
+        if (i == plan->num_algorithms) {
+            kernels[i] = kernels[0];
+            kernels[i].name = "segmented_sort";
+            kernels[i].algorithm = NULL;
+            kernels[i].parallel = 1;
+            continue;
+        }
+        kernels[i].name = plan->algorithms[i]->name;
+        kernels[i].key_type = plan->key_type;
+        kernels[i].algorithm = plan->algorithms[i];
+        kernels[i].wide = NULL;
+        kernels[i].records = NULL;
+        kernels[i].layout = plan->layout;
+        kernels[i].payload = plan->payload;
+        kernels[i].parallel = plan->algorithms[i]->parallel;
+        kernels[i].k =
+            find_selection_algorithm(kernels[i].name) != NULL ? k : 0;
+        kernels[i].offsets = NULL;
+        kernels[i].num_segments = 0;
+        kernels[i].serial_baseline = plan->num_scaling_threads == 0;
+        if (plan->key_type != KEY_INT32) {
+            // A linha de comando só aceita algoritmos com essa variante
+            kernels[i].wide = find_wide_sort_algorithm(kernels[i].name);
+            kernels[i].parallel = 0;
+        }
+        if (plan->layout != LAYOUT_KEYS) {
+            // Idem para os registros
+            kernels[i].records = find_record_sort_algorithm(kernels[i].name);
+            kernels[i].parallel = 0;
+        }
+    }
+
+    // Matriz de resultados: algoritmo x célula (distribuição, tamanho)
+    SortResult **results =
+        (SortResult **)malloc(num_algorithms * sizeof(SortResult *));
+    if (results == NULL) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < num_algorithms; i++) {
+        results[i] = (SortResult *)calloc(num_cells, sizeof(SortResult));
+        if (results[i] == NULL) {
+            fprintf(stderr, "Erro na alocação de memória\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Para cada distribuição e tamanho de array
+    for (j = 0; j < num_cells; j++) {
+        Distribution kind = cell_distribution(plan, j);
+        size_t size = cell_size(plan, j);
+        const char *dist_name = distribution_name(kind);
+
+        // Modo segmentado: size segmentos com tamanhos aleatórios
+        size_t *offsets = NULL;
+        size_t elements = size;
+        if (plan->segmented) {
+            offsets = (size_t *)malloc((size + 1) * sizeof(size_t));
+            if (offsets == NULL) {
+                fprintf(stderr, "Erro na alocação de memória\n");
+                exit(EXIT_FAILURE);
+            }
+            elements = generate_segment_offsets(
+                offsets, size, plan->segment_max_length, plan->seed);
+            for (i = 0; i < num_algorithms; i++) {
+                kernels[i].offsets = offsets;
+                kernels[i].num_segments = size;
+            }
+            printf("\nTestando com %zu segmentos de até %zu elementos "
+                   "(%zu no total, %s)...\n",
+                   size, plan->segment_max_length, elements, dist_name);
+        } else if (plan->num_scaling_threads > 0) {
+            parallel_set_threads(cell_threads(plan, j));
+            printf("\nTestando com array de tamanho %zu (%s, %d threads)...\n",
+                   size, dist_name, cell_threads(plan, j));
+        } else {
+            printf("\nTestando com array de tamanho %zu (%s, chaves %s)...\n",
+                   size, dist_name, key_type_name(plan->key_type));
+        }
+        cell_elements[j] = elements;
+
+        // Gerar a entrada
+        DistributionParams distribution =
+            plan_distribution_params(plan, kind);
+        LargeBuffer input;
+        if (plan->layout != LAYOUT_KEYS) {
+            large_buffer_alloc(&input, size * record_size(plan->payload));
+            generate_records(input.data, size, plan->payload, &distribution);
+        } else {
+            generate_input_array(&input, elements, plan->key_type,
+                                 &distribution);
+        }
+        cell_pages[j] = input.pages;
+
+        // Executar cada algoritmo
+        for (i = 0; i < num_algorithms; i++) {
+            const SortKernel *kernel = &kernels[i];
+            SortResult *r = &results[i][j];
+
+            printf("  Executando %s...\n", kernel->name);
+            *r = run_algorithm(kernel, input.data, elements, &plan->bench);
+            printf("  %s concluído em %.9f segundos (mediana; p95 %.9f, "
+                   "%d repetições x %d, CV %.1f%%)%s\n",
+                   kernel->name, r->median_time, r->p95_time,
+                   r->repetitions, r->inner_loops, 100.0 * r->cv_time,
+                   r->invalid    ? " [INVÁLIDO]"
+                   : r->unstable ? " [INSTÁVEL]"
+                                 : "");
+            if (r->reruns > 0) {
+                printf("    (medido de novo %d %s: CV acima de %.1f%%)\n",
+                       r->reruns, r->reruns > 1 ? "vezes" : "vez",
+                       100.0 * plan->bench.max_cv);
+            }
+        }
+
+        // Liberar a entrada e as áreas auxiliares dos algoritmos
+        large_buffer_free(&input);
+        sort_scratch_release();
+
+        print_selection_summary(kernels, num_algorithms, results, j);
+        print_baseline_summary(kernels, num_algorithms, results, j);
+        if (plan->branch_report) {
+            print_branch_report(kernels, num_algorithms, results, j,
+                                elements);
+        }
+
+        free(offsets);
+
+        // Última contagem de threads do grupo: speedup e frações serial
+        if (plan->num_scaling_threads > 0 && j % steps == steps - 1) {
+            int first = j - (steps - 1);
+            for (i = 0; i < num_algorithms; i++) {
+                compute_scaling(plan, results[i], fits + i * num_cells, first,
+                                steps);
+            }
+            print_scaling_summary(plan, kernels, num_algorithms, results,
+                                  fits, num_cells, first);
+        }
+    }
+    parallel_set_affinity(0);
+
+    int unstable = 0;
+    int invalid = 0;
+    for (i = 0; i < num_algorithms; i++) {
+        for (j = 0; j < num_cells; j++) {
+            unstable += results[i][j].unstable;
+            invalid += results[i][j].invalid;
+        }
+    }
+    if (invalid > 0) {
+        fprintf(stderr,
+                "\nERRO: %d de %d resultados com saída incorreta (não "
+                "ordenada ou não uma permutação da entrada); ficam marcados "
+                "nos CSVs e no JSON e fora do histórico\n",
+                invalid, num_algorithms * num_cells);
+    }
+    if (unstable > 0) {
+        printf("\nAviso: %d de %d resultados instáveis (CV acima de %.1f%% "
+               "após %d remedições); ficam marcados nos CSVs e no JSON e "
+               "fora do histórico\n",
+               unstable, num_algorithms * num_cells,
+               100.0 * plan->bench.max_cv, plan->bench.noise_reruns);
+    }
+
+    // Criar diretório para resultados se não existir
+    char command[512];
+    snprintf(command, sizeof(command), "mkdir -p '%s'", plan->results_dir);
+    if (system(command) != 0) {
+        fprintf(stderr, "Erro ao criar o diretório %s\n", plan->results_dir);
+    }
+
+    // Salvar resultados em arquivos CSV individuais para cada algoritmo
+    for (i = 0; i < num_algorithms; i++) {
+        const char *name = kernels[i].name;
+        char filename[512];
+        snprintf(filename, sizeof(filename), "%s/%s_results.csv",
+                 plan->results_dir, name);
+
+        FILE *file = fopen(filename, "w");
+        if (file == NULL) {
+            fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n",
+                    filename);
+            continue;
+        }
+
+        // Escrever cabeçalho
+        fprintf(file, "size,distribution");
+        if (plan->num_scaling_threads > 0) {
+            fprintf(file, ",requested_threads");
+        }
+        write_result_header(file, "");
+        if (plan->num_scaling_threads > 0) {
+            write_scaling_header(file, "");
+        }
+        fprintf(file, "\n");
+
+        // Escrever dados
+        for (j = 0; j < num_cells; j++) {
+            fprintf(file, "%zu,%s", cell_size(plan, j),
+                    distribution_name(cell_distribution(plan, j)));
+            if (plan->num_scaling_threads > 0) {
+                fprintf(file, ",%d", cell_threads(plan, j));
+            }
+            write_result_fields(file, &results[i][j]);
+            if (plan->num_scaling_threads > 0) {
+                write_scaling_fields(file, &fits[i * num_cells + j]);
+            }
+            fprintf(file, "\n");
+        }
+
+        fclose(file);
+        printf("Resultados para %s salvos em %s\n", name, filename);
+    }
+
+    // Salvar resultados em um único arquivo CSV para todos os algoritmos
+    char combined_filename[512];
+    snprintf(combined_filename, sizeof(combined_filename),
+             "%s/combined_results.csv", plan->results_dir);
+
+    FILE *combined_file = fopen(combined_filename, "w");
+    if (combined_file == NULL) {
+        fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n",
+                combined_filename);
+    } else {
+        // Escrever cabeçalho
+        fprintf(combined_file, "size,distribution");
+        if (plan->num_scaling_threads > 0) {
+            fprintf(combined_file, ",requested_threads");
+        }
+        for (i = 0; i < num_algorithms; i++) {
+            char prefix[128];
+            snprintf(prefix, sizeof(prefix), "%s_", kernels[i].name);
+            write_result_header(combined_file, prefix);
+            if (plan->num_scaling_threads > 0) {
+                write_scaling_header(combined_file, prefix);
+            }
+        }
+        fprintf(combined_file, "\n");
+
+        // Escrever dados
+        for (j = 0; j < num_cells; j++) {
+            fprintf(combined_file, "%zu,%s", cell_size(plan, j),
+                    distribution_name(cell_distribution(plan, j)));
+            if (plan->num_scaling_threads > 0) {
+                fprintf(combined_file, ",%d", cell_threads(plan, j));
+            }
+            for (i = 0; i < num_algorithms; i++) {
+                write_result_fields(combined_file, &results[i][j]);
+                if (plan->num_scaling_threads > 0) {
+                    write_scaling_fields(combined_file,
+                                         &fits[i * num_cells + j]);
+                }
+            }
+            fprintf(combined_file, "\n");
+        }
+
+        fclose(combined_file);
+        printf("Resultados combinados salvos em %s\n", combined_filename);
+    }
+
+    // Salvar um registro JSON Lines por célula, com metadados do ambiente
+    char json_filename[512];
+    json_results_path(plan, json_filename, sizeof(json_filename));
+
+    FILE *json_file = fopen(json_filename, "w");
+    if (json_file == NULL) {
+        fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n",
+                json_filename);
+    } else {
+        for (j = 0; j < num_cells; j++) {
+            for (i = 0; i < num_algorithms; i++) {
+                write_json_record(
+                    json_file, plan, &env, kernels[i].name, kernels[i].k,
+                    cell_distribution(plan, j), cell_size(plan, j),
+                    cell_elements[j], cell_pages[j], &results[i][j],
+                    plan->num_scaling_threads > 0 ? &fits[i * num_cells + j]
+                                                  : NULL);
+            }
+        }
+        fclose(json_file);
+        printf("Registros JSON Lines salvos em %s\n", json_filename);
+    }
+
+    // Acrescentar os tempos ao histórico (nunca sobrescrito)
+    char history_filename[512];
+    history_path(plan, history_filename, sizeof(history_filename));
+
+    FILE *history_file = fopen(history_filename, "a");
+    if (history_file == NULL) {
+        fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n",
+                history_filename);
+    } else {
+        HistoryRecord record;
+        history_record_init(&record, &env);
+        snprintf(record.key_type, sizeof(record.key_type), "%s",
+                 key_type_name(plan->key_type));
+        if (plan->layout != LAYOUT_KEYS) {
+            // Registros formam células separadas das chaves simples
+            snprintf(record.key_type, sizeof(record.key_type), "%s/%zu",
+                     record_layout_name(plan->layout), plan->payload);
+        }
+        if (plan->segmented) {
+            // Idem para os segmentos, pelo maior tamanho
+            snprintf(record.key_type, sizeof(record.key_type), "seg/%zu",
+                     plan->segment_max_length);
+        }
+        record.seed = plan->seed;
+
+        for (j = 0; j < num_cells; j++) {
+            char dist_label[sizeof(record.distribution)];
+            distribution_label(plan, cell_distribution(plan, j), dist_label,
+                               sizeof(dist_label));
+            for (i = 0; i < num_algorithms; i++) {
+                // Resultados instáveis criariam regressões fantasmas, e
+                // os inválidos não medem uma ordenação
+                if (results[i][j].unstable || results[i][j].invalid) {
+                    continue;
+                }
+
+                // O k faz parte da célula dos algoritmos de seleção
+                if (kernels[i].k > 0) {
+                    snprintf(record.algorithm, sizeof(record.algorithm),
+                             "%s(k=%zu)", kernels[i].name,
+                             kernels[i].k);
+                } else {
+                    snprintf(record.algorithm, sizeof(record.algorithm),
+                             "%s", kernels[i].name);
+                }
+                snprintf(record.distribution, sizeof(record.distribution),
+                         "%s", dist_label);
+                record.size = cell_size(plan, j);
+                record.threads = results[i][j].threads;
+                record.samples = results[i][j].samples;
+                record.count = results[i][j].repetitions;
+                history_write_record(history_file, &record);
+            }
+        }
+        fclose(history_file);
+        printf("Histórico (revisão %s) atualizado em %s\n", env.revision,
+               history_filename);
+    }
+
+    // Liberar memória dos resultados
+    for (i = 0; i < num_algorithms; i++) {
+        for (j = 0; j < num_cells; j++) {
+            free(results[i][j].samples);
+        }
+        free(results[i]);
+    }
+    free(results);
+    free(kernels);
+    free(cell_pages);
+    free(cell_elements);
+    free(fits);
+    return invalid > 0 ? -1 : 0;
+}
+
+/**
+ * Grava n chaves int da distribuição no arquivo, gerando uma parte de até
+ * memory_bytes por vez
+ *
+ * @return 0 em caso de sucesso, -1 em caso de erro
+ */
+static int generate_key_file(const char *path, size_t n,
+                             const DistributionParams *distribution,
+                             size_t memory_bytes) {
+    size_t chunk = memory_bytes / sizeof(int);
+    size_t begin;
+    int status = 0;
+
+    if (chunk > n) {
+        chunk = n;
+    }
+    FILE *file = fopen(path, "wb");
+    int *buffer = (int *)malloc((chunk > 0 ? chunk : 1) * sizeof(int));
+    if (file == NULL || buffer == NULL) {
+        fprintf(stderr, "Erro ao criar %s\n", path);
+        if (file != NULL) {
+            fclose(file);
+        }
+        free(buffer);
+        return -1;
+    }
+
+    for (begin = 0; begin < n && status == 0; begin += chunk) {
+        size_t count = n - begin < chunk ? n - begin : chunk;
+        generate_keys_range(buffer, begin, count, n, KEY_INT32, distribution);
+        if (fwrite(buffer, sizeof(int), count, file) != count) {
+            fprintf(stderr, "Erro ao gravar %s\n", path);
+            status = -1;
+        }
+    }
+
+    if (fclose(file) != 0) {
+        status = -1;
+    }
+    free(buffer);
+    return status;
+}
+
+/**
+ * Escreve o registro JSON Lines da ordenação externa
+ */
+static void write_external_json_record(FILE *file, const TestPlan *plan,
+                                       const EnvironmentInfo *env,
+                                       const char *dist_name,
+                                       const ExternalSortStats *stats,
+                                       int sorted, int valid) {
+    const SortResult *r = &stats->result;
+    int first = 1;
+
+    fputc('{', file);
+    json_write_string_field(file, &first, "algorithm", "external_merge_sort");
+    json_write_string_field(file, &first, "distribution", dist_name);
+    if (plan->external_generate > 0) {
+        json_write_distribution_params(file, &first, plan,
+                                       plan->distributions[0],
+                                       plan->external_generate);
+    } else {
+        json_write_key(file, &first, "distribution_params");
+        fputs("null", file);
+    }
+    json_write_uint_field(file, &first, "size",
+                          (unsigned long long)stats->elements);
+    json_write_string_field(file, &first, "key_type",
+                            key_type_name(KEY_INT32));
+    json_write_string_field(file, &first, "pages",
+                            page_policy_name(stats->pages));
+    json_write_uint_field(file, &first, "seed", plan->seed);
+    json_write_uint_field(file, &first, "threads",
+                          (unsigned long long)plan->threads);
+    json_write_double_field(file, &first, "execution_time_s",
+                            r->execution_time);
+    json_write_uint_field(file, &first, "comparisons", r->comparisons);
+    json_write_uint_field(file, &first, "movements", r->movements);
+    json_write_string_field(file, &first, "variant",
+                            io_backend_name(stats->io));
+    json_write_key(file, &first, "valid");
+    fputs(valid ? "true" : "false", file);
+
+    // Métricas de E/S
+    json_write_key(file, &first, "external");
+    fputc('{', file);
+    int first_ext = 1;
+    json_write_string_field(file, &first_ext, "run_algorithm",
+                            plan->algorithms[0]->name);
+    json_write_uint_field(file, &first_ext, "memory_bytes",
+                          (unsigned long long)plan->memory_bytes);
+    json_write_uint_field(file, &first_ext, "block_bytes",
+                          (unsigned long long)plan->io_block_bytes);
+    json_write_uint_field(file, &first_ext, "runs",
+                          (unsigned long long)stats->runs);
+    json_write_uint_field(file, &first_ext, "passes",
+                          (unsigned long long)stats->passes);
+    json_write_uint_field(file, &first_ext, "fan_in",
+                          (unsigned long long)stats->fan_in);
+    json_write_uint_field(file, &first_ext, "bytes_read", stats->bytes_read);
+    json_write_uint_field(file, &first_ext, "bytes_written",
+                          stats->bytes_written);
+    json_write_double_field(file, &first_ext, "run_time_s", stats->run_time);
+    json_write_double_field(file, &first_ext, "sort_time_s",
+                            stats->sort_time);
+    json_write_double_field(file, &first_ext, "merge_time_s",
+                            stats->merge_time);
+    json_write_double_field(file, &first_ext, "read_io_time_s",
+                            stats->read_io_time);
+    json_write_double_field(file, &first_ext, "write_io_time_s",
+                            stats->write_io_time);
+    json_write_double_field(file, &first_ext, "read_bandwidth_mb_s",
+                            stats->read_bandwidth / 1e6);
+    json_write_double_field(file, &first_ext, "write_bandwidth_mb_s",
+                            stats->write_bandwidth / 1e6);
+    json_write_double_field(file, &first_ext, "throughput_mb_s",
+                            stats->throughput / 1e6);
+    json_write_key(file, &first_ext, "sorted");
+    fputs(sorted ? "true" : "false", file);
+    fputc('}', file);
+
+    write_json_environment(file, &first, env);
+
+    fputs("}\n", file);
+}
+
+/**
+ * Ordena o arquivo do plano com a ordenação externa
+ */
+int run_external_test(const TestPlan *plan) {
+    const char *input = plan->external_input;
+    const char *dist_name = "file";
+    char output[4096];
+    char json_filename[512];
+
+    EnvironmentInfo env;
+    environment_collect(&env);
+
+    parallel_set_threads(plan->threads);
+    simd_set_level(plan->simd);
+    large_memory_set_policy(plan->pages);
+
+    if (plan->external_output != NULL) {
+        snprintf(output, sizeof(output), "%s", plan->external_output);
+    } else {
+        snprintf(output, sizeof(output), "%s.sorted", input);
+    }
+    const char *temp_dir = plan->temp_dir;
+    if (temp_dir == NULL) {
+        temp_dir = getenv("TMPDIR");
+        if (temp_dir == NULL || temp_dir[0] == '\0') {
+            temp_dir = "/tmp";
+        }
+    }
+
+    // Gerar a entrada por partes, fora da medição
+    if (plan->external_generate > 0) {
+        Distribution kind = plan->distributions[0];
+        DistributionParams distribution =
+            plan_distribution_params(plan, kind);
+        dist_name = distribution_name(kind);
+
+        printf("\nGerando %zu chaves (%s) em %s...\n",
+               plan->external_generate, dist_name, input);
+        if (generate_key_file(input, plan->external_generate, &distribution,
+                              plan->memory_bytes) != 0) {
+            return -1;
+        }
+    }
+
+    ExternalSortConfig config;
+    config.algorithm = plan->algorithms[0];
+    config.memory_bytes = plan->memory_bytes;
+    config.block_bytes = plan->io_block_bytes;
+    config.temp_dir = temp_dir;
+    config.io = plan->io;
+
+    printf("\nOrdenando %s em %s (corridas: %s, memória: %zu MB, E/S: %s)"
+           "...\n",
+           input, output, config.algorithm->name, plan->memory_bytes >> 20,
+           io_backend_name(plan->io));
+
+    ExternalSortStats stats;
+    if (external_sort_file(input, output, &config, &stats) != 0) {
+        return -1;
+    }
+    MultisetChecksum output_checksum;
+    int sorted = external_is_sorted(output, stats.elements, &output_checksum);
+    // Ordenada e com as mesmas chaves da entrada (nada perdido ou duplicado)
+    int valid = sorted && multiset_checksum_equal(&output_checksum,
+                                                  &stats.input_checksum);
+
+    printf("  %zu chaves, %zu corridas, %d passadas (até %d vias), E/S %s\n",
+           stats.elements, stats.runs, stats.passes, stats.fan_in,
+           io_backend_name(stats.io));
+    printf("  Tempo total %.6f s (corridas %.6f s, das quais ordenação "
+           "%.6f s; intercalação %.6f s)\n",
+           stats.result.execution_time, stats.run_time, stats.sort_time,
+           stats.merge_time);
+    printf("  Lidos %llu bytes em %.6f s de E/S (%.1f MB/s), escritos %llu "
+           "bytes em %.6f s (%.1f MB/s); vazão total %.1f MB/s\n",
+           stats.bytes_read, stats.read_io_time, stats.read_bandwidth / 1e6,
+           stats.bytes_written, stats.write_io_time,
+           stats.write_bandwidth / 1e6, stats.throughput / 1e6);
+    printf("  Comparações: %llu, movimentações: %llu, saída %s%s\n",
+           stats.result.comparisons, stats.result.movements,
+           sorted ? "ordenada" : "NÃO ORDENADA",
+           valid ? "" : " [INVÁLIDO]");
+
+    // Criar diretório para resultados se não existir
+    char command[512];
+    snprintf(command, sizeof(command), "mkdir -p '%s'", plan->results_dir);
+    if (system(command) != 0) {
+        fprintf(stderr, "Erro ao criar o diretório %s\n", plan->results_dir);
+    }
+
+    char filename[512];
+    snprintf(filename, sizeof(filename), "%s/external_results.csv",
+             plan->results_dir);
+    FILE *file = fopen(filename, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n", filename);
+    } else {
+        fprintf(file,
+                "size,distribution,run_algorithm,io,memory_bytes,"
+                "block_bytes,runs,passes,fan_in,bytes_read,bytes_written,"
+                "execution_time,run_time,sort_time,merge_time,"
+                "read_io_time,write_io_time,read_mb_s,write_mb_s,"
+                "throughput_mb_s,comparisons,movements,sorted,valid\n");
+        fprintf(file,
+                "%zu,%s,%s,%s,%zu,%zu,%zu,%d,%d,%llu,%llu,%.9f,%.9f,%.9f,"
+                "%.9f,%.9f,%.9f,%.3f,%.3f,%.3f,%llu,%llu,%d,%d\n",
+                stats.elements, dist_name, config.algorithm->name,
+                io_backend_name(stats.io), plan->memory_bytes,
+                plan->io_block_bytes, stats.runs, stats.passes, stats.fan_in,
+                stats.bytes_read, stats.bytes_written,
+                stats.result.execution_time, stats.run_time, stats.sort_time,
+                stats.merge_time, stats.read_io_time, stats.write_io_time,
+                stats.read_bandwidth / 1e6, stats.write_bandwidth / 1e6,
+                stats.throughput / 1e6, stats.result.comparisons,
+                stats.result.movements, sorted, valid);
+        fclose(file);
+        printf("Resultados salvos em %s\n", filename);
+    }
+
+    json_results_path(plan, json_filename, sizeof(json_filename));
+    FILE *json_file = fopen(json_filename, "w");
+    if (json_file == NULL) {
+        fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n",
+                json_filename);
+    } else {
+        write_external_json_record(json_file, plan, &env, dist_name, &stats,
+                                   sorted, valid);
+        fclose(json_file);
+        printf("Registros JSON Lines salvos em %s\n", json_filename);
+    }
+
+    if (!valid) {
+        fprintf(stderr,
+                "\nERRO: saída incorreta em %s (não ordenada ou não uma "
+                "permutação da entrada)\n",
+                output);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Escreve o registro JSON Lines de uma execução do sample sort distribuído
+ */
+static void write_distributed_json_record(FILE *file, const TestPlan *plan,
+                                          const EnvironmentInfo *env,
+                                          Distribution kind,
+                                          const DistributedSortStats *stats,
+                                          double speedup, int sorted,
+                                          int valid) {
+    const SortResult *r = &stats->result;
+    int first = 1;
+
+    fputc('{', file);
+    json_write_string_field(file, &first, "algorithm",
+                            "distributed_sample_sort");
+    json_write_string_field(file, &first, "distribution",
+                            distribution_name(kind));
+    json_write_distribution_params(file, &first, plan, kind,
+                                   stats->elements);
+    json_write_uint_field(file, &first, "size",
+                          (unsigned long long)stats->elements);
+    json_write_string_field(file, &first, "key_type",
+                            key_type_name(KEY_INT32));
+    json_write_uint_field(file, &first, "seed", plan->seed);
+    json_write_uint_field(file, &first, "threads",
+                          (unsigned long long)stats->workers);
+    json_write_double_field(file, &first, "execution_time_s",
+                            r->execution_time);
+    json_write_uint_field(file, &first, "comparisons", r->comparisons);
+    json_write_uint_field(file, &first, "movements", r->movements);
+    json_write_uint_field(file, &first, "repetitions",
+                          (unsigned long long)plan->bench.repetitions);
+    json_write_key(file, &first, "valid");
+    fputs(valid ? "true" : "false", file);
+
+    // Fases e rede simulada
+    json_write_key(file, &first, "distributed");
+    fputc('{', file);
+    int first_dist = 1;
+    json_write_string_field(file, &first_dist, "local_algorithm",
+                            plan->algorithms[0]->name);
+    json_write_uint_field(file, &first_dist, "workers",
+                          (unsigned long long)stats->workers);
+    json_write_double_field(file, &first_dist, "latency_us",
+                            plan->latency_us);
+    json_write_double_field(file, &first_dist, "bandwidth_mb_s",
+                            plan->bandwidth_mb_s);
+    json_write_double_field(file, &first_dist, "local_sort_time_s",
+                            stats->local_sort_time);
+    json_write_double_field(file, &first_dist, "splitter_time_s",
+                            stats->splitter_time);
+    json_write_double_field(file, &first_dist, "exchange_time_s",
+                            stats->exchange_time);
+    json_write_double_field(file, &first_dist, "merge_time_s",
+                            stats->merge_time);
+    json_write_uint_field(file, &first_dist, "messages", stats->messages);
+    json_write_uint_field(file, &first_dist, "bytes_sent", stats->bytes_sent);
+    json_write_uint_field(file, &first_dist, "max_partition",
+                          (unsigned long long)stats->max_partition);
+    json_write_double_field(file, &first_dist, "speedup", speedup);
+    json_write_key(file, &first_dist, "sorted");
+    fputs(sorted ? "true" : "false", file);
+    fputc('}', file);
+
+    write_json_environment(file, &first, env);
+
+    fputs("}\n", file);
+}
+
+/**
+ * Compara execuções pelo tempo total (qsort da mediana)
+ */
+static int compare_distributed_stats(const void *a, const void *b) {
+    double x = ((const DistributedSortStats *)a)->result.execution_time;
+    double y = ((const DistributedSortStats *)b)->result.execution_time;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Executa o sample sort distribuído para cada distribuição, tamanho e
+ * número de nós do plano
+ */
+int run_distributed_test(const TestPlan *plan) {
+    int repetitions = plan->bench.repetitions;
+    int status = 0;
+    int invalid = 0;
+    int d, s, w, r;
+    char filename[512];
+    char json_filename[512];
+
+    EnvironmentInfo env;
+    environment_collect(&env);
+
+    simd_set_level(plan->simd);
+    large_memory_set_policy(plan->pages);
+
+    DistributedSortConfig config;
+    config.algorithm = plan->algorithms[0];
+    config.latency = plan->latency_us * 1e-6;
+    config.bandwidth = plan->bandwidth_mb_s * 1e6;
+
+    DistributedSortStats *runs = (DistributedSortStats *)malloc(
+        (size_t)repetitions * sizeof(DistributedSortStats));
+    if (runs == NULL) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Criar diretório para resultados se não existir
+    char command[512];
+    snprintf(command, sizeof(command), "mkdir -p '%s'", plan->results_dir);
+    if (system(command) != 0) {
+        fprintf(stderr, "Erro ao criar o diretório %s\n", plan->results_dir);
+    }
+
+    snprintf(filename, sizeof(filename), "%s/distributed_results.csv",
+             plan->results_dir);
+    FILE *file = fopen(filename, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n", filename);
+    } else {
+        fprintf(file,
+                "size,distribution,local_algorithm,workers,latency_us,"
+                "bandwidth_mb_s,execution_time,local_sort_time,"
+                "splitter_time,exchange_time,merge_time,messages,"
+                "bytes_sent,max_partition,speedup,comparisons,movements,"
+                "sorted,valid\n");
+    }
+
+    json_results_path(plan, json_filename, sizeof(json_filename));
+    FILE *json_file = fopen(json_filename, "w");
+    if (json_file == NULL) {
+        fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n",
+                json_filename);
+    }
+
+    for (d = 0; d < plan->num_distributions && status == 0; d++) {
+        Distribution kind = plan->distributions[d];
+        const char *dist_name = distribution_name(kind);
+
+        for (s = 0; s < plan->num_sizes && status == 0; s++) {
+            size_t size = plan->sizes[s];
+            double base_time = 0.0;
+
+            DistributionParams distribution =
+                plan_distribution_params(plan, kind);
+            LargeBuffer input, work;
+            generate_input_array(&input, size, KEY_INT32, &distribution);
+            large_buffer_alloc(&work, size * sizeof(int));
+            MultisetChecksum expected =
+                multiset_checksum(input.data, size, sizeof(int));
+
+            printf("\nSample sort distribuído de %zu chaves (%s, local: %s, "
+                   "latência %.1f us, banda %s)...\n",
+                   size, dist_name, config.algorithm->name, plan->latency_us,
+                   plan->bandwidth_mb_s > 0.0 ? "limitada" : "sem limite");
+
+            for (w = 0; w < plan->num_distributed_workers && status == 0;
+                 w++) {
+                int sorted = 1, valid = 1;
+                config.workers = plan->distributed_workers[w];
+
+                // Cada repetição cria os nós de novo sobre a mesma entrada,
+                // e cada saída precisa ser uma permutação ordenada dela
+                for (r = 0; r < repetitions && status == 0; r++) {
+                    memcpy(work.data, input.data, size * sizeof(int));
+                    status = distributed_sort((int *)work.data, size, &config,
+                                              &runs[r]);
+                    if (status == 0) {
+                        MultisetChecksum output =
+                            multiset_checksum(work.data, size, sizeof(int));
+                        if (!is_sorted(work.data, size, KEY_INT32)) {
+                            sorted = 0;
+                        }
+                        if (!multiset_checksum_equal(&output, &expected)) {
+                            valid = 0;
+                        }
+                    }
+                }
+                valid = valid && sorted;
+                invalid += !valid;
+                if (status != 0) {
+                    break;
+                }
+
+                // Repetição com o tempo total mediano
+                qsort(runs, (size_t)repetitions, sizeof(DistributedSortStats),
+                      compare_distributed_stats);
+                const DistributedSortStats *stats = &runs[repetitions / 2];
+                const SortResult *result = &stats->result;
+                if (w == 0) {
+                    base_time = result->execution_time;
+                }
+                double speedup = result->execution_time > 0.0
+                                     ? base_time / result->execution_time
+                                     : 0.0;
+
+                printf("  %2d nós: %.6f s (local %.6f, separadores %.6f, "
+                       "troca %.6f, intercalação %.6f), speedup %.2f, "
+                       "maior partição %zu, %llu mensagens, saída %s%s\n",
+                       stats->workers, result->execution_time,
+                       stats->local_sort_time, stats->splitter_time,
+                       stats->exchange_time, stats->merge_time, speedup,
+                       stats->max_partition, stats->messages,
+                       sorted ? "ordenada" : "NÃO ORDENADA",
+                       valid ? "" : " [INVÁLIDO]");
+
+                if (file != NULL) {
+                    fprintf(file,
+                            "%zu,%s,%s,%d,%.3f,%.3f,%.9f,%.9f,%.9f,%.9f,"
+                            "%.9f,%llu,%llu,%zu,%.4f,%llu,%llu,%d,%d\n",
+                            size, dist_name, config.algorithm->name,
+                            stats->workers, plan->latency_us,
+                            plan->bandwidth_mb_s, result->execution_time,
+                            stats->local_sort_time, stats->splitter_time,
+                            stats->exchange_time, stats->merge_time,
+                            stats->messages, stats->bytes_sent,
+                            stats->max_partition, speedup,
+                            result->comparisons, result->movements, sorted,
+                            valid);
+                }
+                if (json_file != NULL) {
+                    write_distributed_json_record(json_file, plan, &env,
+                                                  kind, stats, speedup,
+                                                  sorted, valid);
+                }
+            }
+
+            large_buffer_free(&work);
+            large_buffer_free(&input);
+            sort_scratch_release();
+        }
+    }
+
+    if (file != NULL) {
+        fclose(file);
+        printf("Resultados salvos em %s\n", filename);
+    }
+    if (json_file != NULL) {
+        fclose(json_file);
+        printf("Registros JSON Lines salvos em %s\n", json_filename);
+    }
+    free(runs);
+
+    // Execuções com saída incorreta: registradas, mas falham a execução
+    if (invalid > 0) {
+        fprintf(stderr,
+                "\nERRO: %d execuções com saída incorreta (não ordenada ou "
+                "não uma permutação da entrada)\n",
+                invalid);
+        return -1;
+    }
+    return status;
+}
+
+/**
+ * Escreve um registro JSON Lines da repetição de uma entrada adversária
+ */
+static void write_adversary_json_record(FILE *file, const TestPlan *plan,
+                                        const EnvironmentInfo *env,
+                                        const char *target,
+                                        const SortAlgorithm *algorithm,
+                                        size_t size, const SortResult *r,
+                                        unsigned long long random_comparisons,
+                                        int sorted) {
+    int first = 1;
+
+    fputc('{', file);
+    json_write_string_field(file, &first, "algorithm", algorithm->name);
+    json_write_string_field(file, &first, "distribution", "antiqsort");
+    json_write_uint_field(file, &first, "size", (unsigned long long)size);
+    json_write_string_field(file, &first, "key_type",
+                            key_type_name(KEY_INT32));
+    json_write_uint_field(file, &first, "seed", plan->seed);
+    json_write_double_field(file, &first, "execution_time_s",
+                            r->execution_time);
+    json_write_uint_field(file, &first, "comparisons", r->comparisons);
+    json_write_uint_field(file, &first, "movements", r->movements);
+
+    // Entrada adversária e referência aleatória
+    json_write_key(file, &first, "adversary");
+    fputc('{', file);
+    int first_adv = 1;
+    json_write_string_field(file, &first_adv, "target", target);
+    json_write_uint_field(file, &first_adv, "random_comparisons",
+                          random_comparisons);
+    json_write_double_field(file, &first_adv, "comparison_ratio",
+                            random_comparisons > 0
+                                ? (double)r->comparisons /
+                                      (double)random_comparisons
+                                : 0.0);
+    json_write_key(file, &first_adv, "sorted");
+    fputs(sorted ? "true" : "false", file);
+    fputc('}', file);
+
+    write_json_environment(file, &first, env);
+
+    fputs("}\n", file);
+}
+
+/**
+ * Expoente de crescimento das comparações entre o menor e o maior tamanho
+ * (1 para n log n em escala grande, 2 para quadrático; NAN sem dados)
+ */
+static double growth_exponent(const unsigned long long *comparisons,
+                              const size_t *sizes, int num_sizes) {
+    if (num_sizes < 2 || comparisons[0] == 0 ||
+        sizes[num_sizes - 1] <= sizes[0]) {
+        return NAN;
+    }
+    return log((double)comparisons[num_sizes - 1] / (double)comparisons[0]) /
+           log((double)sizes[num_sizes - 1] / (double)sizes[0]);
+}
+
+/**
+ * Gera as entradas adversárias de cada alvo do plano e as repete em todos os
+ * algoritmos do plano
+ */
+int run_adversary_test(const TestPlan *plan) {
+    int num_algorithms = plan->num_algorithms;
+    int num_sizes = plan->num_sizes;
+    int status = 0;
+    int s, t, j;
+    char filename[512];
+    char json_filename[512];
+
+    EnvironmentInfo env;
+    environment_collect(&env);
+
+    parallel_set_threads(plan->threads);
+    simd_set_level(plan->simd);
+    large_memory_set_policy(plan->pages);
+
+    // Comparações por algoritmo e tamanho: referência aleatória e pior caso
+    size_t cells = (size_t)num_algorithms * (size_t)num_sizes;
+    unsigned long long *random_comparisons =
+        (unsigned long long *)calloc(cells, sizeof(unsigned long long));
+    unsigned long long *worst_comparisons =
+        (unsigned long long *)calloc(cells, sizeof(unsigned long long));
+    const char **worst_target = (const char **)calloc(cells, sizeof(char *));
+    int *keys = (int *)malloc(ADVERSARY_MAX_SIZE * sizeof(int));
+    if (random_comparisons == NULL || worst_comparisons == NULL ||
+        worst_target == NULL || keys == NULL) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Criar diretório para resultados se não existir
+    char command[512];
+    snprintf(command, sizeof(command), "mkdir -p '%s'", plan->results_dir);
+    if (system(command) != 0) {
+        fprintf(stderr, "Erro ao criar o diretório %s\n", plan->results_dir);
+    }
+
+    snprintf(filename, sizeof(filename), "%s/adversary_results.csv",
+             plan->results_dir);
+    FILE *file = fopen(filename, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n", filename);
+    } else {
+        fprintf(file,
+                "size,target,algorithm,execution_time,comparisons,movements,"
+                "random_comparisons,comparison_ratio,sorted\n");
+    }
+
+    json_results_path(plan, json_filename, sizeof(json_filename));
+    FILE *json_file = fopen(json_filename, "w");
+    if (json_file == NULL) {
+        fprintf(stderr, "Erro ao abrir arquivo %s para escrita\n",
+                json_filename);
+    }
+
+    for (s = 0; s < num_sizes && status == 0; s++) {
+        size_t size = plan->sizes[s];
+
+        // Referência: as mesmas chaves aleatórias para todos os algoritmos
+        DistributionParams distribution =
+            plan_distribution_params(plan, DIST_RANDOM);
+        LargeBuffer input, work;
+        generate_input_array(&input, size, KEY_INT32, &distribution);
+        large_buffer_alloc(&work, size * sizeof(int));
+
+        printf("\nEntradas adversárias de %zu chaves\n", size);
+        for (j = 0; j < num_algorithms; j++) {
+            memcpy(work.data, input.data, size * sizeof(int));
+            SortResult result = plan->algorithms[j]->function(work.data, size);
+            random_comparisons[(size_t)j * num_sizes + s] = result.comparisons;
+        }
+
+        for (t = 0; t < num_algorithms && status == 0; t++) {
+            const AdversaryTarget *target =
+                find_adversary_target(plan->algorithms[t]->name);
+            SortResult attack;
+
+            if (target == NULL) {
+                continue;
+            }
+            if (antiqsort_generate(target, keys, size, &attack) != 0) {
+                status = -1;
+                break;
+            }
+            printf("  Alvo %s: %llu comparações durante o ataque\n",
+                   target->name, attack.comparisons);
+
+            // A entrada gerada vale para qualquer algoritmo
+            for (j = 0; j < num_algorithms; j++) {
+                const SortAlgorithm *algorithm = plan->algorithms[j];
+                size_t cell = (size_t)j * num_sizes + s;
+                unsigned long long reference = random_comparisons[cell];
+
+                memcpy(work.data, keys, size * sizeof(int));
+                SortResult result = algorithm->function(work.data, size);
+                int sorted = is_sorted(work.data, size, KEY_INT32);
+                double ratio = reference > 0 ? (double)result.comparisons /
+                                                   (double)reference
+                                             : 0.0;
+
+                printf("    %-24s %12llu comparações (%.2fx a aleatória)%s\n",
+                       algorithm->name, result.comparisons, ratio,
+                       sorted ? "" : " NÃO ORDENADA");
+
+                if (worst_target[cell] == NULL ||
+                    result.comparisons > worst_comparisons[cell]) {
+                    worst_comparisons[cell] = result.comparisons;
+                    worst_target[cell] = target->name;
+                }
+                if (file != NULL) {
+                    fprintf(file, "%zu,%s,%s,%.9f,%llu,%llu,%llu,%.4f,%d\n",
+                            size, target->name, algorithm->name,
+                            result.execution_time, result.comparisons,
+                            result.movements, reference, ratio, sorted);
+                }
+                if (json_file != NULL) {
+                    write_adversary_json_record(json_file, plan, &env,
+                                                target->name, algorithm, size,
+                                                &result, reference, sorted);
+                }
+                if (!sorted) {
+                    status = -1;
+                }
+            }
+        }
+
+        large_buffer_free(&work);
+        large_buffer_free(&input);
+        sort_scratch_release();
+    }
+
+    // Resumo: pior caso encontrado e crescimento com o tamanho
+    if (status == 0) {
+        int degraded = 0;
+        size_t largest = plan->sizes[num_sizes - 1];
+
+        printf("\nPior caso encontrado (n = %zu; expoente entre n = %zu e "
+               "n = %zu):\n",
+               largest, plan->sizes[0], largest);
+        for (j = 0; j < num_algorithms; j++) {
+            const unsigned long long *worst =
+                &worst_comparisons[(size_t)j * num_sizes];
+            const unsigned long long *random =
+                &random_comparisons[(size_t)j * num_sizes];
+            double adversary_exp =
+                growth_exponent(worst, plan->sizes, num_sizes);
+            double random_exp =
+                growth_exponent(random, plan->sizes, num_sizes);
+            int quadratic = adversary_exp > ADVERSARY_QUADRATIC_EXPONENT &&
+                            !(random_exp > ADVERSARY_QUADRATIC_EXPONENT);
+
+            if (worst[num_sizes - 1] == 0) {
+                printf("  %-24s sem comparações (não é por comparação)\n",
+                       plan->algorithms[j]->name);
+                continue;
+            }
+            printf("  %-24s %12llu comparações (alvo %s), expoente %.2f "
+                   "(aleatória %.2f)%s\n",
+                   plan->algorithms[j]->name, worst[num_sizes - 1],
+                   worst_target[(size_t)j * num_sizes + num_sizes - 1],
+                   adversary_exp, random_exp,
+                   quadratic ? " DEGRADA PARA O(n²)" : "");
+            degraded += quadratic;
+        }
+        if (num_sizes < 2) {
+            printf("Use dois ou mais tamanhos para estimar o crescimento.\n");
+        } else if (degraded > 0) {
+            printf("%d algoritmo(s) degradam para O(n²) com entradas "
+                   "adversárias.\n",
+                   degraded);
+        } else {
+            printf("Nenhum algoritmo degrada para O(n²).\n");
+        }
+    }
+
+    if (file != NULL) {
+        fclose(file);
+        printf("Resultados salvos em %s\n", filename);
+    }
+    if (json_file != NULL) {
+        fclose(json_file);
+        printf("Registros JSON Lines salvos em %s\n", json_filename);
+    }
+    free(keys);
+    free(worst_target);
+    free(worst_comparisons);
+    free(random_comparisons);
+    return status;
+}
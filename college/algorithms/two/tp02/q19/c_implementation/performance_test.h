@@ -0,0 +1,116 @@
+/**
+ * performance_test.h
+ * Plano de execução dos testes de desempenho
+ */
+
+#ifndef PERFORMANCE_TEST_H
+#define PERFORMANCE_TEST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "async_io.h"
+#include "benchmark.h"
+#include "distributed_sort.h"
+#include "distributions.h"
+#include "large_memory.h"
+#include "record_sorts.h"
+#include "simd_sorts.h"
+#include "sorting_algorithms.h"
+
+// Maior número de contagens de threads do estudo de escalonamento
+#define SCALING_MAX_STEPS 16
+
+/**
+ * Matriz de testes: algoritmos x distribuições x tamanhos (x threads, no
+ * estudo de escalonamento)
+ */
+typedef struct {
+    const SortAlgorithm **algorithms;  // Algoritmos a executar
+    int num_algorithms;
+    size_t *sizes;                     // Tamanhos das entradas
+    int num_sizes;
+    Distribution *distributions;       // Distribuições das entradas
+    int num_distributions;
+    KeyType key_type;                  // Tipo das chaves
+    RecordLayout layout;               // Chaves, registros, argsort, ponteiros
+    size_t payload;                    // Bytes de carga dos registros
+    uint64_t seed;                     // Semente do gerador de entradas
+    int swaps;                         // Trocas do nearly_sorted (0 = n/100)
+    int unique_values;                 // Valores do few_unique (0 = 16)
+    int sawtooth_period;               // Período do sawtooth (0 = raiz de n)
+    double zipf_exponent;              // Expoente do zipf (0 = 1)
+    int threads;                       // Threads (0 = todas as CPUs)
+    size_t k;                          // Top-k da seleção (0 = padrão)
+    SimdLevel simd;                    // Conjunto de instruções vetoriais
+    PagePolicy pages;                  // Páginas dos buffers das entradas
+    BenchConfig bench;                 // Configuração do motor de medição
+    int pin;                           // Fixa a thread de medição em uma CPU
+    int branch_report;                 // Imprime os desvios mal previstos
+    int segmented;                     // Tamanhos contam segmentos
+    size_t segment_max_length;         // Maior tamanho de segmento
+    int scaling_threads[SCALING_MAX_STEPS];  // Threads do estudo (1, 2, 4..)
+    int num_scaling_threads;           // 0 = sem estudo de escalonamento
+    int weak_scaling;                  // Tamanhos por thread (escalonamento
+                                       // fraco)
+    const char *results_dir;           // Diretório dos CSVs
+    const char *json_path;             // Arquivo JSON Lines (NULL = padrão)
+    const char *history_path;          // Histórico (NULL = padrão)
+
+    // Ordenação externa (--external): um arquivo em vez da matriz
+    const char *external_input;        // Arquivo de entrada (NULL = matriz)
+    const char *external_output;       // Arquivo ordenado
+    const char *temp_dir;              // Diretório das corridas
+    size_t external_generate;          // Chaves a gerar antes (0 = nenhuma)
+    size_t memory_bytes;               // Memória de trabalho
+    size_t io_block_bytes;             // Bloco de E/S da intercalação
+    IoBackend io;                      // Mecanismo de E/S
+
+    // Sample sort distribuído (--distributed): nós simulados por processos
+    int distributed_workers[DISTRIBUTED_MAX_WORKERS];  // Números de nós
+    int num_distributed_workers;       // 0 = matriz normal
+    double latency_us;                 // Latência injetada por mensagem
+    double bandwidth_mb_s;             // Banda de cada nó (0 = sem limite)
+
+    // Entradas adversárias (--adversary): antiqsort em vez da matriz
+    int adversary;                     // 1 = modo adversário
+} TestPlan;
+
+/**
+ * Executa testes de desempenho para toda a matriz do plano, salva os
+ * resultados em CSV e JSON Lines e os acrescenta ao histórico
+ *
+ * @param plan Plano de execução
+ * @return 0 se todas as saídas estão corretas, -1 se alguma não está
+ */
+int run_performance_tests(const TestPlan *plan);
+
+/**
+ * Ordena o arquivo do plano com a ordenação externa (gerando-o antes, se
+ * pedido) e salva o resultado em CSV e JSON Lines
+ *
+ * @param plan Plano de execução (external_input definido)
+ * @return 0 em caso de sucesso, -1 em caso de erro
+ */
+int run_external_test(const TestPlan *plan);
+
+/**
+ * Executa o sample sort distribuído com cada número de nós do plano, para
+ * cada distribuição e tamanho, e salva o resultado em CSV e JSON Lines
+ *
+ * @param plan Plano de execução (num_distributed_workers > 0)
+ * @return 0 em caso de sucesso, -1 em caso de erro
+ */
+int run_distributed_test(const TestPlan *plan);
+
+/**
+ * Gera a entrada adversária (antiqsort) de cada algoritmo atacável do plano,
+ * para cada tamanho, e a repete em todos os algoritmos do plano; salva o
+ * resultado em CSV e JSON Lines e resume o pior caso encontrado
+ *
+ * @param plan Plano de execução (adversary definido)
+ * @return 0 em caso de sucesso, -1 em caso de erro
+ */
+int run_adversary_test(const TestPlan *plan);
+
+#endif /* PERFORMANCE_TEST_H */
@@ -0,0 +1,581 @@
+/**
+ * radix_sorts.c
+ * Implementação das ordenações por dígitos
+ *
+ * Compilado duas vezes, como sorting_algorithms.c (ver
+ * sort_instrumentation.h). As ordenações por dígitos não comparam chaves:
+ * as comparações contadas vêm apenas da inserção nos baldes pequenos do
+ * American flag sort, e cada escrita de um elemento conta uma movimentação.
+ * As chaves são tratadas como sem sinal depois de inverter o bit de sinal,
+ * o que preserva a ordem dos inteiros negativos.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "radix_sorts.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "large_memory.h"
+#include "sort_instrumentation.h"
+#include "thread_pool.h"
+
+// Dígito de `bits` bits a partir de `shift`, com o bit de sinal invertido
+#define RADIX_DIGIT(value, shift, mask) \
+    ((((unsigned)(value) ^ 0x80000000u) >> (shift)) & (mask))
+
+// Elementos por linha de cache nos buffers de combinação de escrita
+#define WC_LANES 16
+
+// Abaixo deste tamanho o LSD paralelo ordena sequencialmente
+#define PARALLEL_RADIX_CUTOFF (1 << 16)
+
+// Baldes do American flag sort ordenados por inserção
+#define FLAG_SORT_INSERTION_CUTOFF 32
+
+/**
+ * Aloca memória ou encerra o programa
+ */
+static void *checked_malloc(size_t bytes) {
+    void *ptr = malloc(bytes > 0 ? bytes : 1);
+    if (ptr == NULL) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+    return ptr;
+}
+
+/**
+ * Histogramas de todos os dígitos em uma única leitura do trecho
+ *
+ * @param hist passes x buckets contadores (somados aos existentes)
+ */
+static void count_digits(const int *arr, size_t begin, size_t end, int bits,
+                         int passes, size_t *hist) {
+    unsigned mask = (1u << bits) - 1;
+    size_t buckets = (size_t)1 << bits;
+    size_t i;
+    int p;
+
+    for (i = begin; i < end; i++) {
+        for (p = 0; p < passes; p++) {
+            hist[p * buckets + RADIX_DIGIT(arr[i], p * bits, mask)]++;
+        }
+    }
+}
+
+/**
+ * Buffers de combinação de escrita: uma linha de cache por balde
+ */
+typedef struct {
+    int *lines;       // buckets x WC_LANES elementos, alinhados a 64 bytes
+    size_t *flushed;  // Primeira posição de cada balde ainda não escrita
+} WriteBuffers;
+
+static void write_buffers_init(WriteBuffers *wc, size_t buckets) {
+    void *lines = NULL;
+    if (posix_memalign(&lines, 64, buckets * WC_LANES * sizeof(int)) != 0) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+    wc->lines = (int *)lines;
+    wc->flushed = (size_t *)checked_malloc(buckets * sizeof(size_t));
+}
+
+static void write_buffers_free(WriteBuffers *wc) {
+    free(wc->lines);
+    free(wc->flushed);
+}
+
+/**
+ * Distribui src[begin, end) em dst pelo dígito, avançando as posições de
+ * cada balde (distribuição estável)
+ */
+static void scatter(const int *src, int *dst, size_t begin, size_t end,
+                    int shift, unsigned mask, size_t *pos,
+                    SortCounters *counters) {
+    size_t i;
+
+    for (i = begin; i < end; i++) {
+        int value = src[i];
+        dst[pos[RADIX_DIGIT(value, shift, mask)]++] = value;
+    }
+    COUNT_MOVEMENTS(counters, end - begin);
+}
+
+/**
+ * Distribuição com combinação de escrita: os elementos de cada balde são
+ * acumulados na linha do buffer que espelha a linha de destino e só vão
+ * para o destino quando a linha fecha (ou no fim)
+ */
+static void scatter_combined(const int *src, int *dst, size_t begin,
+                             size_t end, int shift, unsigned mask,
+                             size_t *pos, WriteBuffers *wc,
+                             SortCounters *counters) {
+    size_t buckets = (size_t)mask + 1;
+    size_t b, i;
+
+    memcpy(wc->flushed, pos, buckets * sizeof(size_t));
+
+    for (i = begin; i < end; i++) {
+        int value = src[i];
+        unsigned digit = RADIX_DIGIT(value, shift, mask);
+        size_t p = pos[digit]++;
+        int *line = wc->lines + (size_t)digit * WC_LANES;
+
+        line[p & (WC_LANES - 1)] = value;
+        if (((p + 1) & (WC_LANES - 1)) == 0) {
+            size_t from = wc->flushed[digit];
+            if (p + 1 - from == WC_LANES) {
+                // Linha completa: cópia de tamanho fixo, sem chamar memcpy
+                memcpy(dst + from, line, WC_LANES * sizeof(int));
+            } else {
+                memcpy(dst + from, line + (from & (WC_LANES - 1)),
+                       (p + 1 - from) * sizeof(int));
+            }
+            wc->flushed[digit] = p + 1;
+        }
+    }
+
+    // Linhas incompletas
+    for (b = 0; b < buckets; b++) {
+        size_t from = wc->flushed[b];
+        if (pos[b] > from) {
+            const int *line = wc->lines + b * WC_LANES;
+            memcpy(dst + from, line + (from & (WC_LANES - 1)),
+                   (pos[b] - from) * sizeof(int));
+        }
+    }
+    COUNT_MOVEMENTS(counters, end - begin);
+}
+
+/**
+ * Radix Sort LSD sequencial
+ *
+ * @param bits Bits por dígito (8 ou 11)
+ * @param combine 1 para usar os buffers de combinação de escrita
+ */
+static void lsd_radix_sort(int *arr, size_t n, int bits, int combine,
+                           SortCounters *counters) {
+    int passes = (32 + bits - 1) / bits;
+    size_t buckets = (size_t)1 << bits;
+    unsigned mask = (unsigned)buckets - 1;
+    size_t *hist = (size_t *)calloc(passes * buckets, sizeof(size_t));
+    size_t *pos = (size_t *)checked_malloc(buckets * sizeof(size_t));
+    int *buffer = (int *)sort_scratch(SCRATCH_DATA, n * sizeof(int));
+    int *src = arr, *dst = buffer;
+    WriteBuffers wc;
+    int p;
+
+    if (hist == NULL) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+    if (combine) {
+        write_buffers_init(&wc, buckets);
+    }
+
+    count_digits(arr, 0, n, bits, passes, hist);
+
+    for (p = 0; p < passes; p++) {
+        const size_t *h = hist + p * buckets;
+        size_t sum = 0, b;
+
+        // Passe trivial: todos os elementos no mesmo balde
+        if (h[RADIX_DIGIT(src[0], p * bits, mask)] == n) {
+            continue;
+        }
+
+        for (b = 0; b < buckets; b++) {
+            pos[b] = sum;
+            sum += h[b];
+        }
+        if (combine) {
+            scatter_combined(src, dst, 0, n, p * bits, mask, pos, &wc,
+                             counters);
+        } else {
+            scatter(src, dst, 0, n, p * bits, mask, pos, counters);
+        }
+
+        int *temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != arr) {
+        memcpy(arr, src, n * sizeof(int));
+        COUNT_MOVEMENTS(counters, n);
+    }
+    sort_scratch_done(buffer);
+
+    if (combine) {
+        write_buffers_free(&wc);
+    }
+    free(pos);
+    free(hist);
+}
+
+/**
+ * Executa um Radix Sort LSD medindo o tempo
+ */
+static SortResult timed_lsd_radix_sort(int *arr, size_t n, int bits,
+                                       int combine) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    if (n > 1) {
+        lsd_radix_sort(arr, n, bits, combine, &counters);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Radix Sort LSD com dígitos de 8 bits
+ */
+SortResult SORT_KERNEL(lsd_radix_sort_8)(int *arr, size_t n) {
+    return timed_lsd_radix_sort(arr, n, 8, 0);
+}
+
+/**
+ * Radix Sort LSD com dígitos de 11 bits
+ */
+SortResult SORT_KERNEL(lsd_radix_sort_11)(int *arr, size_t n) {
+    return timed_lsd_radix_sort(arr, n, 11, 0);
+}
+
+/**
+ * Radix Sort LSD com dígitos de 11 bits e combinação de escrita
+ */
+SortResult SORT_KERNEL(lsd_radix_sort_11_wc)(int *arr, size_t n) {
+    return timed_lsd_radix_sort(arr, n, 11, 1);
+}
+
+/**
+ * Estado compartilhado de uma execução do Radix Sort paralelo
+ */
+typedef struct {
+    const int *src;
+    int *dst;
+    size_t n;
+    int num_chunks;
+    int bits;
+    int passes;
+    int shift;              // Dígito do passe atual
+    size_t *chunk_hist;     // num_chunks x buckets do passe atual
+    size_t *all_hist;       // num_chunks x passes x buckets (primeira leitura)
+    SortCounters *total;
+} RadixState;
+
+/**
+ * Tarefa do Radix Sort paralelo: um trecho
+ */
+typedef struct {
+    RadixState *state;
+    int index;
+} RadixTask;
+
+static void radix_chunk_range(const RadixState *state, int c, size_t *begin,
+                              size_t *end) {
+    *begin = (size_t)((unsigned long long)state->n * c / state->num_chunks);
+    *end = (size_t)((unsigned long long)state->n * (c + 1) /
+                    state->num_chunks);
+}
+
+/**
+ * Histogramas de todos os dígitos de um trecho (primeira leitura)
+ */
+static void radix_count_all(void *arg) {
+    RadixTask *task = (RadixTask *)arg;
+    RadixState *state = task->state;
+    size_t stride = (size_t)state->passes << state->bits;
+    size_t begin, end;
+
+    radix_chunk_range(state, task->index, &begin, &end);
+    count_digits(state->src, begin, end, state->bits, state->passes,
+                 state->all_hist + task->index * stride);
+}
+
+/**
+ * Histograma do dígito do passe atual em um trecho
+ */
+static void radix_count_pass(void *arg) {
+    RadixTask *task = (RadixTask *)arg;
+    RadixState *state = task->state;
+    size_t buckets = (size_t)1 << state->bits;
+    size_t *hist = state->chunk_hist + task->index * buckets;
+    unsigned mask = (unsigned)buckets - 1;
+    size_t begin, end, i;
+
+    radix_chunk_range(state, task->index, &begin, &end);
+    memset(hist, 0, buckets * sizeof(size_t));
+    for (i = begin; i < end; i++) {
+        hist[RADIX_DIGIT(state->src[i], state->shift, mask)]++;
+    }
+}
+
+/**
+ * Distribui um trecho (as posições iniciais já estão em chunk_hist)
+ */
+static void radix_scatter_chunk(void *arg) {
+    RadixTask *task = (RadixTask *)arg;
+    RadixState *state = task->state;
+    size_t buckets = (size_t)1 << state->bits;
+    SortCounters counters = {0, 0};
+    WriteBuffers wc;
+    size_t begin, end;
+
+    radix_chunk_range(state, task->index, &begin, &end);
+    write_buffers_init(&wc, buckets);
+    scatter_combined(state->src, state->dst, begin, end, state->shift,
+                     (unsigned)buckets - 1,
+                     state->chunk_hist + task->index * buckets, &wc,
+                     &counters);
+    write_buffers_free(&wc);
+
+    COUNT_MERGE_ATOMIC(state->total, &counters);
+}
+
+/**
+ * Executa uma tarefa por trecho e aguarda todas
+ */
+static void run_chunks(ThreadPool *pool, RadixState *state,
+                       TaskFunction function) {
+    RadixTask *tasks =
+        (RadixTask *)checked_malloc(state->num_chunks * sizeof(RadixTask));
+    TaskGroup group;
+    int i;
+
+    task_group_init(&group);
+    for (i = 0; i < state->num_chunks; i++) {
+        tasks[i].state = state;
+        tasks[i].index = i;
+        thread_pool_submit(pool, &group, function, &tasks[i]);
+    }
+    thread_pool_wait(pool, &group);
+
+    free(tasks);
+}
+
+/**
+ * Radix Sort LSD paralelo
+ */
+SortResult SORT_KERNEL(parallel_radix_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    ThreadPool *pool = parallel_shared_pool();
+    int threads = thread_pool_size(pool);
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    if (threads == 1 || n < PARALLEL_RADIX_CUTOFF) {
+        if (n > 1) {
+            lsd_radix_sort(arr, n, 11, 1, &counters);
+        }
+    } else {
+        RadixState state;
+        size_t buckets = (size_t)1 << 11;
+        int *buffer = (int *)sort_scratch(SCRATCH_DATA, n * sizeof(int));
+        int first_pass = 1;
+        int c, p;
+        size_t b;
+
+        state.src = arr;
+        state.dst = buffer;
+        state.n = n;
+        state.num_chunks = threads;
+        state.bits = 11;
+        state.passes = 3;
+        state.total = &counters;
+        state.chunk_hist =
+            (size_t *)checked_malloc(threads * buckets * sizeof(size_t));
+        state.all_hist = (size_t *)calloc(
+            (size_t)threads * state.passes * buckets, sizeof(size_t));
+        if (state.all_hist == NULL) {
+            fprintf(stderr, "Erro na alocação de memória\n");
+            exit(EXIT_FAILURE);
+        }
+
+        // Histogramas de todos os dígitos por trecho, em uma única leitura
+        run_chunks(pool, &state, radix_count_all);
+
+        for (p = 0; p < state.passes; p++) {
+            size_t sum = 0;
+            int trivial = 0;
+
+            // Passe trivial: todos os elementos no mesmo balde
+            for (b = 0; b < buckets && !trivial; b++) {
+                size_t total = 0;
+                for (c = 0; c < threads; c++) {
+                    total += state.all_hist[(c * state.passes + p) * buckets +
+                                            b];
+                }
+                trivial = total == n;
+            }
+            if (trivial) {
+                continue;
+            }
+
+            state.shift = p * state.bits;
+            if (first_pass) {
+                // Os trechos ainda estão na ordem original
+                for (c = 0; c < threads; c++) {
+                    memcpy(state.chunk_hist + c * buckets,
+                           state.all_hist + (c * state.passes + p) * buckets,
+                           buckets * sizeof(size_t));
+                }
+                first_pass = 0;
+            } else {
+                run_chunks(pool, &state, radix_count_pass);
+            }
+
+            // Posições iniciais: balde a balde, trecho a trecho (estável)
+            for (b = 0; b < buckets; b++) {
+                for (c = 0; c < threads; c++) {
+                    size_t count = state.chunk_hist[c * buckets + b];
+                    state.chunk_hist[c * buckets + b] = sum;
+                    sum += count;
+                }
+            }
+
+            run_chunks(pool, &state, radix_scatter_chunk);
+
+            int *temp = (int *)state.src;
+            state.src = state.dst;
+            state.dst = temp;
+        }
+
+        if (state.src != arr) {
+            memcpy(arr, state.src, n * sizeof(int));
+            COUNT_MOVEMENTS(&counters, n);
+        }
+
+        free(state.all_hist);
+        free(state.chunk_hist);
+        sort_scratch_done(buffer);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    result.threads = threads;
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Inserção nos baldes pequenos do American flag sort
+ */
+static void flag_insertion_sort(int *arr, size_t n, SortCounters *counters) {
+    size_t i, j;
+
+    for (i = 1; i < n; i++) {
+        int key = arr[i];
+        for (j = i; j > 0; j--) {
+            COUNT_COMPARISON(counters);
+            if (arr[j - 1] <= key) {
+                break;
+            }
+            arr[j] = arr[j - 1];
+            COUNT_MOVEMENT(counters);
+        }
+        arr[j] = key;
+        COUNT_MOVEMENT(counters);
+    }
+}
+
+/**
+ * American flag sort de um trecho a partir do dígito em `shift`
+ */
+static void american_flag_sort_range(int *arr, size_t n, int shift,
+                                     SortCounters *counters) {
+    size_t count[256], head[256], tail[256];
+    size_t sum = 0, i;
+    int b;
+
+    if (n <= FLAG_SORT_INSERTION_CUTOFF) {
+        flag_insertion_sort(arr, n, counters);
+        return;
+    }
+
+    // Dígitos iguais em todos os elementos não exigem permutação
+    for (;;) {
+        memset(count, 0, sizeof(count));
+        for (i = 0; i < n; i++) {
+            count[RADIX_DIGIT(arr[i], shift, 0xFFu)]++;
+        }
+        if (count[RADIX_DIGIT(arr[0], shift, 0xFFu)] != n) {
+            break;
+        }
+        if (shift == 0) {
+            return;
+        }
+        shift -= 8;
+    }
+
+    for (b = 0; b < 256; b++) {
+        head[b] = sum;
+        sum += count[b];
+        tail[b] = sum;
+    }
+
+    // Ciclos de permutação: cada elemento vai direto para o seu balde
+    for (b = 0; b < 256; b++) {
+        while (head[b] < tail[b]) {
+            int value = arr[head[b]];
+            unsigned digit = RADIX_DIGIT(value, shift, 0xFFu);
+            while (digit != (unsigned)b) {
+                int temp = arr[head[digit]];
+                arr[head[digit]++] = value;
+                COUNT_MOVEMENT(counters);
+                value = temp;
+                digit = RADIX_DIGIT(value, shift, 0xFFu);
+            }
+            arr[head[b]++] = value;
+            COUNT_MOVEMENT(counters);
+        }
+    }
+
+    if (shift == 0) {
+        return;
+    }
+    for (b = 0, sum = 0; b < 256; b++) {
+        if (count[b] > 1) {
+            american_flag_sort_range(arr + sum, count[b], shift - 8,
+                                     counters);
+        }
+        sum += count[b];
+    }
+}
+
+/**
+ * American flag sort
+ */
+SortResult SORT_KERNEL(american_flag_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    if (n > 1) {
+        american_flag_sort_range(arr, n, 24, &counters);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
@@ -0,0 +1,72 @@
+/**
+ * radix_sorts.h
+ * Ordenações por dígitos (radix) para chaves inteiras: LSD com dígitos de
+ * 8 ou 11 bits, LSD paralelo e MSD no próprio array (American flag sort)
+ */
+
+#ifndef RADIX_SORTS_H
+#define RADIX_SORTS_H
+
+#include "sorting_algorithms.h"
+
+/**
+ * Radix Sort LSD com dígitos de 8 bits (até 4 passes); passes em que todos
+ * os elementos têm o mesmo dígito são pulados
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult lsd_radix_sort_8(int *arr, size_t n);
+
+/**
+ * Radix Sort LSD com dígitos de 11 bits (até 3 passes)
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult lsd_radix_sort_11(int *arr, size_t n);
+
+/**
+ * Radix Sort LSD com dígitos de 11 bits e buffers de combinação de escrita
+ * em software: cada balde acumula uma linha de cache antes de escrevê-la no
+ * destino, o que reduz as faltas de cache e de TLB da distribuição
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult lsd_radix_sort_11_wc(int *arr, size_t n);
+
+/**
+ * Radix Sort LSD paralelo (dígitos de 11 bits): histogramas por trecho e
+ * distribuição estável de cada trecho em paralelo no pool de threads
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult parallel_radix_sort(int *arr, size_t n);
+
+/**
+ * American flag sort: Radix Sort MSD com dígitos de 8 bits que permuta os
+ * elementos no próprio array (sem buffer auxiliar) e usa inserção nos
+ * baldes pequenos
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult american_flag_sort(int *arr, size_t n);
+
+/**
+ * Variantes sem instrumentação
+ */
+SortResult lsd_radix_sort_8_fast(int *arr, size_t n);
+SortResult lsd_radix_sort_11_fast(int *arr, size_t n);
+SortResult lsd_radix_sort_11_wc_fast(int *arr, size_t n);
+SortResult parallel_radix_sort_fast(int *arr, size_t n);
+SortResult american_flag_sort_fast(int *arr, size_t n);
+
+#endif /* RADIX_SORTS_H */
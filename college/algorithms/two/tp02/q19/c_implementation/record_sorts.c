@@ -0,0 +1,457 @@
+/**
+ * record_sorts.c
+ * Implementação da ordenação de registros largos
+ *
+ * Compilado duas vezes, como sorting_algorithms.c (ver
+ * sort_instrumentation.h). Os algoritmos são os de wide_sorts_template.h,
+ * incluído uma vez por forma de elemento: registros de cada carga, índices
+ * de 32 bits (argsort) e ponteiros.
+ */
+
+#include "record_sorts.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "large_memory.h"
+#include "sort_instrumentation.h"
+
+// Parâmetros dos algoritmos (os mesmos de wide_sorts.c)
+#define WIDE_INSERTION_CUTOFF 24
+#define WIDE_NINTHER_THRESHOLD 128
+#define WIDE_RADIX_BITS 11
+#define WIDE_RADIX_PASSES 6
+
+// Nomes gerados pelo modelo: base + sufixo do elemento + sufixo da variante
+#define WIDE_CONCAT_(base, key, variant) base##key##variant
+#define WIDE_CONCAT(base, key, variant) WIDE_CONCAT_(base, key, variant)
+
+#if SORT_COUNTED
+#define WIDE_VARIANT
+#else
+#define WIDE_VARIANT _fast
+#endif
+
+// Chaves geradas por vez ao montar os registros
+#define RECORD_GENERATE_CHUNK 4096
+
+// Chave int32 convertida em uint64_t com a mesma ordem
+#define RECORD_ORDER(key) ((uint64_t)((uint32_t)(key) ^ 0x80000000u))
+
+/**
+ * Registros por valor, um tipo por carga suportada
+ */
+typedef struct {
+    int32_t key;
+    unsigned char payload[8];
+} Record8;
+
+typedef struct {
+    int32_t key;
+    unsigned char payload[16];
+} Record16;
+
+typedef struct {
+    int32_t key;
+    unsigned char payload[64];
+} Record64;
+
+typedef struct {
+    int32_t key;
+    unsigned char payload[256];
+} Record256;
+
+/**
+ * Ponteiro para um registro (a chave fica no início)
+ */
+typedef const unsigned char *RecordPtr;
+
+#define POINTER_KEY(p) (*(const int32_t *)(p))
+
+/**
+ * Registros do argsort: os índices comparam as chaves nesta base, com este
+ * passo (contexto passado a cada chamada, o que mantém os algoritmos
+ * reentrantes)
+ */
+typedef struct {
+    const unsigned char *base;  // Primeiro registro
+    size_t stride;              // Bytes por registro
+} RecordIndex;
+
+#define INDEX_KEY(i) \
+    (*(const int32_t *)(ctx->base + (size_t)(i) * ctx->stride))
+
+// Os algoritmos gerados só são usados por este arquivo
+#define KEY_LINKAGE static
+
+#define KEY_LESS(a, b) ((a).key < (b).key)
+#define KEY_ORDER(x) RECORD_ORDER((x).key)
+
+#define KEY_T Record8
+#define KEY_SUFFIX _rec8
+#include "wide_sorts_template.h"
+#undef KEY_T
+#undef KEY_SUFFIX
+
+#define KEY_T Record16
+#define KEY_SUFFIX _rec16
+#include "wide_sorts_template.h"
+#undef KEY_T
+#undef KEY_SUFFIX
+
+#define KEY_T Record64
+#define KEY_SUFFIX _rec64
+#include "wide_sorts_template.h"
+#undef KEY_T
+#undef KEY_SUFFIX
+
+#define KEY_T Record256
+#define KEY_SUFFIX _rec256
+#include "wide_sorts_template.h"
+#undef KEY_T
+#undef KEY_SUFFIX
+
+#undef KEY_LESS
+#undef KEY_ORDER
+
+#define KEY_T uint32_t
+#define KEY_SUFFIX _idx
+#define KEY_CONTEXT RecordIndex
+#define KEY_LESS(a, b) (INDEX_KEY(a) < INDEX_KEY(b))
+#define KEY_ORDER(x) RECORD_ORDER(INDEX_KEY(x))
+#include "wide_sorts_template.h"
+#undef KEY_T
+#undef KEY_SUFFIX
+#undef KEY_CONTEXT
+#undef KEY_LESS
+#undef KEY_ORDER
+
+#define KEY_T RecordPtr
+#define KEY_SUFFIX _ptr
+#define KEY_LESS(a, b) (POINTER_KEY(a) < POINTER_KEY(b))
+#define KEY_ORDER(x) RECORD_ORDER(POINTER_KEY(x))
+#include "wide_sorts_template.h"
+#undef KEY_T
+#undef KEY_SUFFIX
+#undef KEY_LESS
+#undef KEY_ORDER
+
+#undef KEY_LINKAGE
+
+/**
+ * Variantes de um algoritmo para cada forma de elemento
+ */
+typedef struct {
+    SortResult (*rec8)(Record8 *arr, size_t n);
+    SortResult (*rec16)(Record16 *arr, size_t n);
+    SortResult (*rec64)(Record64 *arr, size_t n);
+    SortResult (*rec256)(Record256 *arr, size_t n);
+    SortResult (*by_index)(uint32_t *arr, size_t n, const RecordIndex *ctx);
+    SortResult (*by_pointer)(RecordPtr *arr, size_t n);
+} RecordKernels;
+
+#define RECORD_KERNELS(base)                                           \
+    {                                                                  \
+        WIDE_CONCAT(base, _rec8, WIDE_VARIANT),                        \
+            WIDE_CONCAT(base, _rec16, WIDE_VARIANT),                   \
+            WIDE_CONCAT(base, _rec64, WIDE_VARIANT),                   \
+            WIDE_CONCAT(base, _rec256, WIDE_VARIANT),                  \
+            WIDE_CONCAT(base, _idx, WIDE_VARIANT),                     \
+            WIDE_CONCAT(base, _ptr, WIDE_VARIANT)                      \
+    }
+
+static const RecordKernels intro_kernels = RECORD_KERNELS(intro_sort);
+static const RecordKernels radix_kernels = RECORD_KERNELS(lsd_radix_sort_11);
+
+/**
+ * Copia para out, na ordem da permutação, os registros do tipo indicado
+ * (cópia de tamanho fixo, sem chamar memcpy por registro)
+ */
+#define RECORD_GATHER(type, out, source)                  \
+    do {                                                  \
+        for (i = 0; i < n; i++) {                         \
+            ((type *)(out))[i] = *(const type *)(source); \
+        }                                                 \
+    } while (0)
+
+/**
+ * Copia os registros para out na ordem dada por índices ou ponteiros
+ *
+ * @param out Destino (n registros)
+ * @param records Registros originais
+ * @param perm Índices (NULL se ptrs for usado)
+ * @param ptrs Ponteiros (NULL se perm for usado)
+ * @param n Número de registros
+ * @param payload Bytes de carga
+ */
+static void gather_records(void *out, const unsigned char *records,
+                           const uint32_t *perm, const RecordPtr *ptrs,
+                           size_t n, size_t payload) {
+    size_t size = record_size(payload);
+    size_t i;
+
+#define RECORD_SOURCE \
+    (perm != NULL ? records + (size_t)perm[i] * size : ptrs[i])
+    switch (payload) {
+        case 8:
+            RECORD_GATHER(Record8, out, RECORD_SOURCE);
+            break;
+        case 16:
+            RECORD_GATHER(Record16, out, RECORD_SOURCE);
+            break;
+        case 64:
+            RECORD_GATHER(Record64, out, RECORD_SOURCE);
+            break;
+        case 256:
+        default:
+            RECORD_GATHER(Record256, out, RECORD_SOURCE);
+            break;
+    }
+#undef RECORD_SOURCE
+}
+
+/**
+ * Ordena os registros com as variantes de um algoritmo
+ *
+ * @param records Registros
+ * @param n Número de registros
+ * @param layout Forma (records, argsort ou pointers)
+ * @param payload Bytes de carga
+ * @param kernels Variantes do algoritmo
+ * @return Resultado (contadores do algoritmo e das cópias da reorganização)
+ */
+static SortResult record_sort(void *records, size_t n, RecordLayout layout,
+                              size_t payload, const RecordKernels *kernels) {
+    SortResult result = {0};
+    SortResult inner = {0};
+    SortCounters counters = {0, 0};
+    size_t size = record_size(payload);
+    size_t i;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    switch (layout) {
+        case LAYOUT_ARGSORT: {
+            // Índices em SCRATCH_AUX, reorganização em SCRATCH_DATA
+            uint32_t *perm = (uint32_t *)sort_scratch(
+                SCRATCH_AUX, n * sizeof(uint32_t));
+            for (i = 0; i < n; i++) {
+                perm[i] = (uint32_t)i;
+            }
+            RecordIndex index;
+            index.base = (const unsigned char *)records;
+            index.stride = size;
+            inner = kernels->by_index(perm, n, &index);
+
+            void *out = sort_scratch(SCRATCH_DATA, n * size);
+            gather_records(out, (const unsigned char *)records, perm, NULL,
+                           n, payload);
+            memcpy(records, out, n * size);
+            COUNT_MOVEMENTS(&counters, 2 * n);
+            sort_scratch_done(out);
+            sort_scratch_done(perm);
+            break;
+        }
+        case LAYOUT_POINTERS: {
+            RecordPtr *ptrs = (RecordPtr *)sort_scratch(
+                SCRATCH_AUX, n * sizeof(RecordPtr));
+            for (i = 0; i < n; i++) {
+                ptrs[i] = (const unsigned char *)records + i * size;
+            }
+            inner = kernels->by_pointer(ptrs, n);
+
+            void *out = sort_scratch(SCRATCH_DATA, n * size);
+            gather_records(out, (const unsigned char *)records, NULL, ptrs,
+                           n, payload);
+            memcpy(records, out, n * size);
+            COUNT_MOVEMENTS(&counters, 2 * n);
+            sort_scratch_done(out);
+            sort_scratch_done(ptrs);
+            break;
+        }
+        case LAYOUT_RECORDS:
+        default:
+            switch (payload) {
+                case 8:
+                    inner = kernels->rec8((Record8 *)records, n);
+                    break;
+                case 16:
+                    inner = kernels->rec16((Record16 *)records, n);
+                    break;
+                case 64:
+                    inner = kernels->rec64((Record64 *)records, n);
+                    break;
+                case 256:
+                default:
+                    inner = kernels->rec256((Record256 *)records, n);
+                    break;
+            }
+            break;
+    }
+    COUNT_COMPARISONS(&counters, inner.comparisons);
+    COUNT_MOVEMENTS(&counters, inner.movements);
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * IntroSort de registros
+ */
+SortResult SORT_KERNEL(intro_sort_records)(void *records, size_t n,
+                                           RecordLayout layout,
+                                           size_t payload) {
+    return record_sort(records, n, layout, payload, &intro_kernels);
+}
+
+/**
+ * Radix Sort LSD de registros
+ */
+SortResult SORT_KERNEL(lsd_radix_sort_11_records)(void *records, size_t n,
+                                                  RecordLayout layout,
+                                                  size_t payload) {
+    return record_sort(records, n, layout, payload, &radix_kernels);
+}
+
+#if SORT_COUNTED
+
+/**
+ * Nomes das formas dos dados
+ */
+static const char *const layout_names[LAYOUT_COUNT] = {
+    "keys", "records", "argsort", "pointers"};
+
+/**
+ * Nome da forma dos dados
+ */
+const char *record_layout_name(RecordLayout layout) {
+    return layout >= 0 && layout < LAYOUT_COUNT ? layout_names[layout]
+                                                : "unknown";
+}
+
+/**
+ * Converte o nome da forma dos dados
+ */
+int record_layout_from_name(const char *name, RecordLayout *layout) {
+    int i;
+    for (i = 0; i < LAYOUT_COUNT; i++) {
+        if (strcmp(layout_names[i], name) == 0) {
+            *layout = (RecordLayout)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Verifica se há registros com essa carga
+ */
+int record_payload_supported(size_t payload) {
+    return payload == 8 || payload == 16 || payload == 64 || payload == 256;
+}
+
+/**
+ * Tamanho de um registro
+ */
+size_t record_size(size_t payload) {
+    return sizeof(int32_t) + payload;
+}
+
+/**
+ * Palavra w da carga do registro com a chave key
+ */
+static uint32_t payload_word(int32_t key, size_t w) {
+    return ((uint32_t)key * 2654435761u) ^ (uint32_t)w;
+}
+
+/**
+ * Preenche n registros com as chaves da distribuição
+ */
+void generate_records(void *records, size_t n, size_t payload,
+                      const DistributionParams *params) {
+    int keys[RECORD_GENERATE_CHUNK];
+    size_t size = record_size(payload);
+    size_t begin, i, w;
+
+    // Chaves geradas por partes: mesma sequência de generate_keys
+    for (begin = 0; begin < n; begin += RECORD_GENERATE_CHUNK) {
+        size_t count = n - begin < RECORD_GENERATE_CHUNK
+                           ? n - begin
+                           : RECORD_GENERATE_CHUNK;
+        generate_keys_range(keys, begin, count, n, KEY_INT32, params);
+
+        for (i = 0; i < count; i++) {
+            unsigned char *record =
+                (unsigned char *)records + (begin + i) * size;
+            int32_t key = keys[i];
+            memcpy(record, &key, sizeof(key));
+            for (w = 0; w < payload / sizeof(uint32_t); w++) {
+                uint32_t word = payload_word(key, w);
+                memcpy(record + sizeof(key) + w * sizeof(word), &word,
+                       sizeof(word));
+            }
+        }
+    }
+}
+
+/**
+ * Verifica a ordem e a integridade dos registros
+ */
+int records_sorted(const void *records, size_t n, size_t payload) {
+    size_t size = record_size(payload);
+    int32_t previous = 0;
+    size_t i, w;
+
+    for (i = 0; i < n; i++) {
+        const unsigned char *record = (const unsigned char *)records + i * size;
+        int32_t key;
+        memcpy(&key, record, sizeof(key));
+        if (i > 0 && key < previous) {
+            return 0;
+        }
+        for (w = 0; w < payload / sizeof(uint32_t); w++) {
+            uint32_t word;
+            memcpy(&word, record + sizeof(key) + w * sizeof(word),
+                   sizeof(word));
+            if (word != payload_word(key, w)) {
+                return 0;
+            }
+        }
+        previous = key;
+    }
+    return 1;
+}
+
+/**
+ * Registro dos algoritmos de registros
+ */
+const RecordSortAlgorithm record_sort_algorithms[] = {
+    {"intro_sort", intro_sort_records, intro_sort_records_fast},
+    {"lsd_radix_sort_11", lsd_radix_sort_11_records,
+     lsd_radix_sort_11_records_fast},
+};
+
+const int num_record_sort_algorithms =
+    (int)(sizeof(record_sort_algorithms) / sizeof(record_sort_algorithms[0]));
+
+/**
+ * Procura um algoritmo de registros pelo nome
+ */
+const RecordSortAlgorithm *find_record_sort_algorithm(const char *name) {
+    int i;
+    for (i = 0; i < num_record_sort_algorithms; i++) {
+        if (strcmp(record_sort_algorithms[i].name, name) == 0) {
+            return &record_sort_algorithms[i];
+        }
+    }
+    return NULL;
+}
+
+#endif /* SORT_COUNTED */
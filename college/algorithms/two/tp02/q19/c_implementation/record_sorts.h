@@ -0,0 +1,141 @@
+/**
+ * record_sorts.h
+ * Ordenação de registros largos (chave int + carga), como o struct Show dos
+ * programas do tp02: por valor, por índices (argsort) ou por ponteiros,
+ * seguida da reorganização dos registros
+ */
+
+#ifndef RECORD_SORTS_H
+#define RECORD_SORTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "distributions.h"
+#include "sorting_algorithms.h"
+
+/**
+ * Forma dos dados ordenados (--layout)
+ */
+typedef enum {
+    LAYOUT_KEYS = 0,  // Apenas as chaves (--key-type)
+    LAYOUT_RECORDS,   // Registros movidos por valor
+    LAYOUT_ARGSORT,   // Permutação de índices ordenada, depois reorganização
+    LAYOUT_POINTERS,  // Ponteiros ordenados, depois reorganização
+    LAYOUT_COUNT
+} RecordLayout;
+
+// Carga padrão de cada registro (--payload)
+#define RECORD_DEFAULT_PAYLOAD 64
+
+// Maior carga aceita
+#define RECORD_MAX_PAYLOAD 256
+
+/**
+ * Nome da forma dos dados
+ *
+ * @param layout Forma
+ * @return Nome (keys, records, argsort ou pointers)
+ */
+const char *record_layout_name(RecordLayout layout);
+
+/**
+ * Converte o nome da forma dos dados
+ *
+ * @param name Nome
+ * @param layout Destino
+ * @return 1 se o nome é válido, 0 caso contrário
+ */
+int record_layout_from_name(const char *name, RecordLayout *layout);
+
+/**
+ * Verifica se há registros com essa carga (8, 16, 64 ou 256 bytes)
+ *
+ * @param payload Bytes de carga
+ * @return 1 se suportada, 0 caso contrário
+ */
+int record_payload_supported(size_t payload);
+
+/**
+ * Tamanho de um registro: chave int32 seguida da carga
+ *
+ * @param payload Bytes de carga
+ * @return Bytes por registro
+ */
+size_t record_size(size_t payload);
+
+/**
+ * Preenche n registros com as chaves da distribuição; a carga de cada um é
+ * derivada da chave, para que a verificação detecte cargas separadas delas
+ *
+ * @param records Destino (n * record_size(payload) bytes)
+ * @param n Número de registros
+ * @param payload Bytes de carga
+ * @param params Parâmetros de geração
+ */
+void generate_records(void *records, size_t n, size_t payload,
+                      const DistributionParams *params);
+
+/**
+ * Verifica se os registros estão ordenados pela chave e cada carga continua
+ * com a sua chave
+ *
+ * @param records Registros
+ * @param n Número de registros
+ * @param payload Bytes de carga
+ * @return 1 se correto, 0 caso contrário
+ */
+int records_sorted(const void *records, size_t n, size_t payload);
+
+/**
+ * Assinatura dos algoritmos de registros: ordena n registros com a forma e a
+ * carga indicadas. Em argsort e pointers o tempo inclui a construção da
+ * permutação e a reorganização dos registros no lugar (cada ciclo da
+ * permutação é percorrido uma vez)
+ */
+typedef SortResult (*RecordSortFunction)(void *records, size_t n,
+                                         RecordLayout layout, size_t payload);
+
+/**
+ * IntroSort e Radix Sort LSD de 11 bits sobre registros (mesmo corpo dos
+ * algoritmos de chaves de 64 bits, em wide_sorts_template.h)
+ */
+SortResult intro_sort_records(void *records, size_t n, RecordLayout layout,
+                              size_t payload);
+SortResult lsd_radix_sort_11_records(void *records, size_t n,
+                                     RecordLayout layout, size_t payload);
+
+/**
+ * Variantes sem instrumentação
+ */
+SortResult intro_sort_records_fast(void *records, size_t n,
+                                   RecordLayout layout, size_t payload);
+SortResult lsd_radix_sort_11_records_fast(void *records, size_t n,
+                                          RecordLayout layout,
+                                          size_t payload);
+
+/**
+ * Entrada do registro de algoritmos de registros; o nome é o mesmo do
+ * algoritmo equivalente em sort_algorithms
+ */
+typedef struct {
+    const char *name;
+    RecordSortFunction function;  // Variante instrumentada
+    RecordSortFunction fast;      // Variante limpa
+} RecordSortAlgorithm;
+
+/**
+ * Registro dos algoritmos de registros
+ */
+extern const RecordSortAlgorithm record_sort_algorithms[];
+extern const int num_record_sort_algorithms;
+
+/**
+ * Procura um algoritmo de registros pelo nome
+ *
+ * @param name Nome do algoritmo
+ * @return Entrada do registro ou NULL se não existir
+ */
+const RecordSortAlgorithm *find_record_sort_algorithm(const char *name);
+
+#endif /* RECORD_SORTS_H */
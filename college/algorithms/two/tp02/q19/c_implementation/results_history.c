@@ -0,0 +1,565 @@
+/**
+ * results_history.c
+ * Implementação do histórico de resultados e da comparação entre revisões
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "results_history.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "json_writer.h"
+
+/**
+ * Célula comparada: amostras das duas revisões
+ */
+typedef struct {
+    HistoryRecord key;    // Primeiro registro da célula (sem amostras)
+    double *samples[2];   // Amostras da referência [0] e da avaliada [1]
+    int count[2];
+    int capacity[2];
+} CompareCell;
+
+/**
+ * Preenche a chave de um registro
+ */
+void history_record_init(HistoryRecord *record, const EnvironmentInfo *env) {
+    memset(record, 0, sizeof(*record));
+    snprintf(record->revision, sizeof(record->revision), "%s", env->revision);
+    snprintf(record->compiler, sizeof(record->compiler), "%s", env->compiler);
+    snprintf(record->cflags, sizeof(record->cflags), "%s", env->cflags);
+    snprintf(record->host_id, sizeof(record->host_id), "%s", env->host_id);
+    snprintf(record->timestamp, sizeof(record->timestamp), "%s",
+             env->timestamp);
+}
+
+/**
+ * Acrescenta um registro ao histórico
+ */
+void history_write_record(FILE *file, const HistoryRecord *record) {
+    BenchStats stats = bench_compute_stats(record->samples, record->count, 0);
+    int first = 1;
+
+    fputc('{', file);
+    json_write_string_field(file, &first, "revision", record->revision);
+    json_write_string_field(file, &first, "compiler", record->compiler);
+    json_write_string_field(file, &first, "cflags", record->cflags);
+    json_write_string_field(file, &first, "host_id", record->host_id);
+    json_write_string_field(file, &first, "timestamp", record->timestamp);
+    json_write_string_field(file, &first, "algorithm", record->algorithm);
+    json_write_string_field(file, &first, "distribution",
+                            record->distribution);
+    json_write_uint_field(file, &first, "size",
+                          (unsigned long long)record->size);
+    json_write_string_field(file, &first, "key_type", record->key_type);
+    json_write_uint_field(file, &first, "threads",
+                          (unsigned long long)record->threads);
+    json_write_uint_field(file, &first, "seed", record->seed);
+    json_write_double_field(file, &first, "median_time_s", stats.median);
+    json_write_double_array_field(file, &first, "samples_s", record->samples,
+                                  record->count);
+    fputs("}\n", file);
+}
+
+/**
+ * Posição do valor de "chave" em uma linha JSON plana
+ */
+static const char *find_value(const char *line, const char *key) {
+    char pattern[80];
+    const char *found;
+
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    found = strstr(line, pattern);
+    return found != NULL ? found + strlen(pattern) : NULL;
+}
+
+/**
+ * Lê um campo string (escapes de json_write_string)
+ *
+ * @return 1 se encontrado e válido
+ */
+static int read_string(const char *line, const char *key, char *dest,
+                       size_t size) {
+    const char *p = find_value(line, key);
+    size_t length = 0;
+
+    if (p == NULL || *p != '"') {
+        return 0;
+    }
+    for (p++; *p != '"'; p++) {
+        char c = *p;
+        if (c == '\0') {
+            return 0;
+        }
+        if (c == '\\') {
+            p++;
+            switch (*p) {
+                case 'n':
+                    c = '\n';
+                    break;
+                case 'r':
+                    c = '\r';
+                    break;
+                case 't':
+                    c = '\t';
+                    break;
+                case 'u': {
+                    // Só caracteres de controle são escritos assim
+                    char hex[5];
+                    if (strlen(p) < 5) {
+                        return 0;
+                    }
+                    memcpy(hex, p + 1, 4);
+                    hex[4] = '\0';
+                    c = (char)strtol(hex, NULL, 16);
+                    p += 4;
+                    break;
+                }
+                case '\0':
+                    return 0;
+                default:
+                    c = *p;
+            }
+        }
+        if (length + 1 < size) {
+            dest[length++] = c;
+        }
+    }
+    dest[length] = '\0';
+    return 1;
+}
+
+/**
+ * Lê um campo numérico inteiro
+ */
+static int read_uint(const char *line, const char *key,
+                     unsigned long long *value) {
+    const char *p = find_value(line, key);
+    char *end;
+
+    if (p == NULL) {
+        return 0;
+    }
+    *value = strtoull(p, &end, 10);
+    return end != p;
+}
+
+/**
+ * Lê o vetor "samples_s" (valores null são ignorados)
+ */
+static int read_samples(const char *line, HistoryRecord *record) {
+    const char *p = find_value(line, "samples_s");
+    int capacity = 0;
+
+    record->samples = NULL;
+    record->count = 0;
+    if (p == NULL || *p != '[') {
+        return 0;
+    }
+    for (p++; *p != ']';) {
+        if (strncmp(p, "null", 4) == 0) {
+            p += 4;
+        } else {
+            char *end;
+            double value = strtod(p, &end);
+            if (end == p) {
+                return 0;
+            }
+            if (record->count == capacity) {
+                capacity = capacity > 0 ? 2 * capacity : 16;
+                double *grown = (double *)realloc(record->samples,
+                                                  capacity * sizeof(double));
+                if (grown == NULL) {
+                    return 0;
+                }
+                record->samples = grown;
+            }
+            record->samples[record->count++] = value;
+            p = end;
+        }
+        if (*p == ',') {
+            p++;
+        } else if (*p != ']') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Interpreta uma linha do histórico
+ *
+ * @return 1 se válida (samples alocado), 0 caso contrário
+ */
+static int parse_record(const char *line, HistoryRecord *record) {
+    unsigned long long size, threads, seed;
+
+    memset(record, 0, sizeof(*record));
+    if (!read_string(line, "revision", record->revision,
+                     sizeof(record->revision)) ||
+        !read_string(line, "host_id", record->host_id,
+                     sizeof(record->host_id)) ||
+        !read_string(line, "algorithm", record->algorithm,
+                     sizeof(record->algorithm)) ||
+        !read_string(line, "distribution", record->distribution,
+                     sizeof(record->distribution)) ||
+        !read_string(line, "key_type", record->key_type,
+                     sizeof(record->key_type)) ||
+        !read_uint(line, "size", &size) ||
+        !read_uint(line, "threads", &threads) ||
+        !read_uint(line, "seed", &seed)) {
+        return 0;
+    }
+    read_string(line, "compiler", record->compiler, sizeof(record->compiler));
+    read_string(line, "cflags", record->cflags, sizeof(record->cflags));
+    read_string(line, "timestamp", record->timestamp,
+                sizeof(record->timestamp));
+    record->size = (size_t)size;
+    record->threads = (int)threads;
+    record->seed = seed;
+
+    if (!read_samples(line, record)) {
+        free(record->samples);
+        record->samples = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Resolve o nome pedido para uma única revisão do histórico: a igual a ele,
+ * se existir; senão, a única que começa por ele. Um prefixo de várias
+ * revisões (como v1.0 de v1.0-5-g... e v1.0-dirty) misturaria builds
+ * diferentes no mesmo lado e é recusado
+ *
+ * @param path Arquivo do histórico
+ * @param wanted Nome pedido (revisão ou prefixo)
+ * @param resolved Destino da revisão encontrada
+ * @return 0 se resolvida, -1 se ambígua, ausente ou em caso de erro
+ */
+static int resolve_revision(const char *path, const char *wanted,
+                            char resolved[64]) {
+    FILE *file = fopen(path, "r");
+    char (*matches)[64] = NULL;
+    int num_matches = 0, capacity = 0, exact = 0;
+    char *line = NULL;
+    size_t line_size = 0;
+    size_t wanted_length = strlen(wanted);
+    int i, status = 0;
+
+    if (file == NULL) {
+        fprintf(stderr, "Erro ao abrir o histórico %s\n", path);
+        return -1;
+    }
+
+    // Revisões distintas que começam pelo nome pedido
+    while (!exact && getline(&line, &line_size, file) != -1) {
+        char revision[64];
+        if (!read_string(line, "revision", revision, sizeof(revision)) ||
+            strncmp(revision, wanted, wanted_length) != 0) {
+            continue;
+        }
+        exact = strcmp(revision, wanted) == 0;
+        for (i = 0; i < num_matches && strcmp(matches[i], revision) != 0;
+             i++) {
+        }
+        if (i < num_matches) {
+            continue;
+        }
+        if (num_matches == capacity) {
+            capacity = capacity > 0 ? 2 * capacity : 8;
+            char (*grown)[64] = (char (*)[64])realloc(
+                matches, capacity * sizeof(*matches));
+            if (grown == NULL) {
+                fprintf(stderr, "Erro na alocação de memória\n");
+                exit(EXIT_FAILURE);
+            }
+            matches = grown;
+        }
+        memcpy(matches[num_matches++], revision, sizeof(revision));
+    }
+    free(line);
+    fclose(file);
+
+    if (exact) {
+        snprintf(resolved, 64, "%s", wanted);
+    } else if (num_matches == 1) {
+        snprintf(resolved, 64, "%s", matches[0]);
+    } else if (num_matches == 0) {
+        fprintf(stderr, "Revisão sem registros no histórico %s: %s\n", path,
+                wanted);
+        status = -1;
+    } else {
+        fprintf(stderr, "Revisão ambígua no histórico %s: %s corresponde a",
+                path, wanted);
+        for (i = 0; i < num_matches; i++) {
+            fprintf(stderr, " %s", matches[i]);
+        }
+        fprintf(stderr, "\n");
+        status = -1;
+    }
+    free(matches);
+    return status;
+}
+
+/**
+ * Verifica se dois registros são da mesma célula e da mesma máquina
+ */
+static int same_cell_on_host(const HistoryRecord *a, const HistoryRecord *b) {
+    return a->size == b->size && a->threads == b->threads &&
+           a->seed == b->seed && strcmp(a->host_id, b->host_id) == 0 &&
+           strcmp(a->algorithm, b->algorithm) == 0 &&
+           strcmp(a->distribution, b->distribution) == 0 &&
+           strcmp(a->key_type, b->key_type) == 0;
+}
+
+/**
+ * Verifica se dois registros são da mesma célula, máquina, compilador e
+ * flags (outro compilador ou -O0 não é uma regressão do código)
+ */
+static int same_cell(const HistoryRecord *a, const HistoryRecord *b) {
+    return same_cell_on_host(a, b) &&
+           strcmp(a->compiler, b->compiler) == 0 &&
+           strcmp(a->cflags, b->cflags) == 0;
+}
+
+/**
+ * Conta as células medidas só na referência que têm, na revisão avaliada,
+ * uma correspondente que difere apenas no compilador ou nas flags
+ */
+static int count_toolchain_mismatches(const CompareCell *cells,
+                                      int num_cells) {
+    int mismatches = 0;
+    int i, j;
+
+    for (i = 0; i < num_cells; i++) {
+        if (cells[i].count[0] == 0 || cells[i].count[1] > 0) {
+            continue;
+        }
+        for (j = 0; j < num_cells; j++) {
+            if (cells[j].count[1] > 0 && cells[j].count[0] == 0 &&
+                same_cell_on_host(&cells[i].key, &cells[j].key)) {
+                mismatches++;
+                break;
+            }
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * Acrescenta as amostras de um registro a um lado da célula
+ */
+static int append_samples(CompareCell *cell, int side,
+                          const HistoryRecord *record) {
+    int needed = cell->count[side] + record->count;
+
+    if (needed > cell->capacity[side]) {
+        int capacity = cell->capacity[side] > 0 ? cell->capacity[side] : 16;
+        while (capacity < needed) {
+            capacity *= 2;
+        }
+        double *grown = (double *)realloc(cell->samples[side],
+                                          capacity * sizeof(double));
+        if (grown == NULL) {
+            return 0;
+        }
+        cell->samples[side] = grown;
+        cell->capacity[side] = capacity;
+    }
+    memcpy(cell->samples[side] + cell->count[side], record->samples,
+           record->count * sizeof(double));
+    cell->count[side] = needed;
+    return 1;
+}
+
+/**
+ * Lê o histórico e agrupa as amostras das duas revisões por célula
+ *
+ * @return Número de células, ou -1 em caso de erro
+ */
+static int load_cells(const CompareOptions *options, CompareCell **cells_out,
+                      int found[2]) {
+    FILE *file = fopen(options->history_path, "r");
+    CompareCell *cells = NULL;
+    int num_cells = 0, capacity = 0;
+    char *line = NULL;
+    size_t line_size = 0;
+    long line_number = 0;
+    int i;
+
+    if (file == NULL) {
+        fprintf(stderr, "Erro ao abrir o histórico %s\n",
+                options->history_path);
+        return -1;
+    }
+
+    found[0] = found[1] = 0;
+    while (getline(&line, &line_size, file) != -1) {
+        HistoryRecord record;
+
+        line_number++;
+        if (line[strspn(line, " \t\r\n")] == '\0') {
+            continue;
+        }
+        if (!parse_record(line, &record)) {
+            fprintf(stderr, "Aviso: linha %ld do histórico ignorada\n",
+                    line_number);
+            continue;
+        }
+
+        // Só as duas revisões já resolvidas, sem prefixos
+        int side;
+        if (strcmp(record.revision, options->base) == 0) {
+            side = 0;
+        } else if (strcmp(record.revision, options->candidate) == 0) {
+            side = 1;
+        } else {
+            free(record.samples);
+            continue;
+        }
+        found[side]++;
+
+        for (i = 0; i < num_cells && !same_cell(&cells[i].key, &record);
+             i++) {
+        }
+        if (i == num_cells) {
+            if (num_cells == capacity) {
+                capacity = capacity > 0 ? 2 * capacity : 64;
+                CompareCell *grown = (CompareCell *)realloc(
+                    cells, capacity * sizeof(CompareCell));
+                if (grown == NULL) {
+                    fprintf(stderr, "Erro na alocação de memória\n");
+                    exit(EXIT_FAILURE);
+                }
+                cells = grown;
+            }
+            memset(&cells[num_cells], 0, sizeof(CompareCell));
+            cells[num_cells].key = record;
+            cells[num_cells].key.samples = NULL;
+            cells[num_cells].key.count = 0;
+            num_cells++;
+        }
+        if (!append_samples(&cells[i], side, &record)) {
+            fprintf(stderr, "Erro na alocação de memória\n");
+            exit(EXIT_FAILURE);
+        }
+        free(record.samples);
+    }
+
+    free(line);
+    fclose(file);
+    *cells_out = cells;
+    return num_cells;
+}
+
+/**
+ * Mediana de uma amostra
+ */
+static double sample_median(const double *samples, int count) {
+    return bench_compute_stats(samples, count, 0).median;
+}
+
+/**
+ * Compara as duas revisões
+ */
+int history_compare(const CompareOptions *options) {
+    CompareOptions resolved = *options;
+    char base_revision[64], candidate_revision[64];
+    CompareCell *cells = NULL;
+    int found[2];
+    int regressions = 0, improvements = 0, compared = 0;
+    int i;
+
+    // Nomes pedidos resolvidos para revisões exatas do histórico
+    if (resolve_revision(options->history_path, options->base,
+                         base_revision) != 0 ||
+        resolve_revision(options->history_path, options->candidate,
+                         candidate_revision) != 0) {
+        return 2;
+    }
+    resolved.base = base_revision;
+    resolved.candidate = candidate_revision;
+    options = &resolved;
+    if (strcmp(options->base, options->candidate) == 0) {
+        fprintf(stderr, "As revisões comparadas são iguais: %s\n",
+                options->base);
+        return 2;
+    }
+
+    int num_cells = load_cells(options, &cells, found);
+    if (num_cells < 0) {
+        return 2;
+    }
+    if (found[0] == 0 || found[1] == 0) {
+        fprintf(stderr, "Revisão sem registros no histórico %s: %s\n",
+                options->history_path,
+                found[0] == 0 ? options->base : options->candidate);
+        free(cells);
+        return 2;
+    }
+
+    // Toolchains diferentes ficam fora da comparação, mas avisadas
+    int mismatches = count_toolchain_mismatches(cells, num_cells);
+    if (mismatches > 0) {
+        fprintf(stderr,
+                "Aviso: %d células medidas com compilador ou flags "
+                "diferentes nas duas revisões não foram comparadas\n",
+                mismatches);
+    }
+
+    printf("Comparação %s -> %s (limiar %.1f%%, alfa %.3g, %s)\n\n",
+           options->base, options->candidate, 100.0 * options->threshold,
+           options->alpha, options->history_path);
+    printf("%-24s %-14s %12s %-7s %7s %-16s %13s %13s %9s %9s  %s\n",
+           "algoritmo", "distribuição", "tamanho", "chaves", "threads",
+           "máquina", "base (s)", "nova (s)", "variação", "p", "situação");
+
+    for (i = 0; i < num_cells; i++) {
+        CompareCell *cell = &cells[i];
+
+        if (cell->count[0] > 0 && cell->count[1] > 0) {
+            double base = sample_median(cell->samples[0], cell->count[0]);
+            double candidate =
+                sample_median(cell->samples[1], cell->count[1]);
+            double change = base > 0.0 ? candidate / base - 1.0 : 0.0;
+            double p = bench_mann_whitney(cell->samples[0], cell->count[0],
+                                          cell->samples[1], cell->count[1]);
+            const char *status = "";
+
+            // Só diferenças significativas e além do limiar contam
+            if (p < options->alpha && change > options->threshold) {
+                status = "REGRESSÃO";
+                regressions++;
+            } else if (p < options->alpha && change < -options->threshold) {
+                status = "melhora";
+                improvements++;
+            }
+            compared++;
+
+            printf("%-24s %-14s %12zu %-7s %7d %-16s %13.9f %13.9f %+8.1f%% "
+                   "%9.2g  %s\n",
+                   cell->key.algorithm, cell->key.distribution,
+                   cell->key.size, cell->key.key_type, cell->key.threads,
+                   cell->key.host_id, base, candidate, 100.0 * change, p,
+                   status);
+        }
+        free(cell->samples[0]);
+        free(cell->samples[1]);
+    }
+    free(cells);
+
+    if (compared == 0) {
+        fprintf(stderr,
+                "Nenhuma célula medida nas duas revisões na mesma máquina "
+                "e com o mesmo compilador e flags\n");
+        return 2;
+    }
+
+    printf("\n%d células comparadas: %d regressões, %d melhoras\n", compared,
+           regressions, improvements);
+    return regressions > 0 ? 1 : 0;
+}
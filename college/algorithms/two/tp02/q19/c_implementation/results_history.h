@@ -0,0 +1,74 @@
+/**
+ * results_history.h
+ * Histórico de resultados (JSON Lines, só acrescentado), com chave revisão,
+ * compilador, flags e máquina, e comparação estatística entre revisões
+ */
+
+#ifndef RESULTS_HISTORY_H
+#define RESULTS_HISTORY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "environment.h"
+
+/**
+ * Um registro do histórico: os tempos de uma célula em uma execução
+ */
+typedef struct {
+    char revision[64];       // Revisão git
+    char compiler[128];      // Compilador e versão
+    char cflags[256];        // Flags de compilação
+    char host_id[17];        // Impressão digital da máquina
+    char timestamp[32];      // Início da execução (UTC)
+    char algorithm[64];      // Algoritmo
+    char distribution[32];   // Distribuição da entrada
+    char key_type[16];       // Tipo das chaves
+    size_t size;             // Tamanho da entrada
+    int threads;             // Threads usadas
+    uint64_t seed;           // Semente da entrada
+    double *samples;         // Tempo por ordenação de cada repetição (s)
+    int count;               // Número de amostras
+} HistoryRecord;
+
+/**
+ * Parâmetros de "sort_analyzer compare"
+ */
+typedef struct {
+    const char *history_path;  // Arquivo do histórico
+    const char *base;          // Revisão de referência (ou prefixo único)
+    const char *candidate;     // Revisão avaliada (ou prefixo único)
+    double threshold;          // Piora relativa da mediana tolerada (0.05)
+    double alpha;              // Nível de significância do teste
+} CompareOptions;
+
+/**
+ * Preenche a chave de um registro (revisão, compilador, flags, máquina)
+ *
+ * @param record Registro
+ * @param env Metadados do ambiente
+ */
+void history_record_init(HistoryRecord *record, const EnvironmentInfo *env);
+
+/**
+ * Acrescenta um registro ao histórico (uma linha JSON)
+ *
+ * @param file Arquivo aberto em modo "a"
+ * @param record Registro
+ */
+void history_write_record(FILE *file, const HistoryRecord *record);
+
+/**
+ * Compara as células medidas nas duas revisões (mesma máquina, compilador,
+ * flags, algoritmo, distribuição, tamanho, chaves e threads) com o teste de
+ * Mann-Whitney e imprime uma tabela. Cada nome é uma revisão exata do
+ * histórico ou o prefixo de uma única revisão; um prefixo ambíguo é um erro
+ *
+ * @param options Parâmetros
+ * @return 0 sem regressões, 1 se alguma célula piorou além do limiar com
+ *         significância, 2 em caso de erro
+ */
+int history_compare(const CompareOptions *options);
+
+#endif /* RESULTS_HISTORY_H */
@@ -0,0 +1,403 @@
+/**
+ * segmented_sorts.c
+ * Implementação da ordenação segmentada
+ *
+ * Compilado duas vezes, como sorting_algorithms.c (ver
+ * sort_instrumentation.h). Os segmentos são ordenados por classe de
+ * tamanho (contagem dos índices), para que cada tarefa percorra longas
+ * sequências de segmentos com o mesmo método, sem desvios imprevisíveis
+ * na escolha do método.
+ */
+
+#include "segmented_sorts.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "distributions.h"
+#include "large_memory.h"
+#include "sort_instrumentation.h"
+#include "thread_pool.h"
+
+// Maior segmento ordenado por inserção (acima disso, intercalação)
+#define SEGMENT_INSERTION_MAX 32
+
+// Bloco ordenado pela rede de 16 entradas antes das intercalações
+#define SEGMENT_MERGE_BLOCK 16
+
+// Tarefas por thread (mais tarefas equilibram melhor a carga)
+#define SEGMENT_TASKS_PER_THREAD 8
+
+// Menor tarefa, em elementos
+#define SEGMENT_MIN_TASK_ELEMENTS (1 << 14)
+
+/**
+ * Classes de tamanho: cada uma usa um único método
+ */
+typedef enum {
+    SEGMENT_NETWORK_4 = 0,  // 2 a 4 elementos: rede de 4 entradas
+    SEGMENT_NETWORK_8,      // 5 a 8 elementos: rede de 8 entradas
+    SEGMENT_NETWORK_16,     // 9 a 16 elementos: rede de 16 entradas
+    SEGMENT_INSERTION,      // Até SEGMENT_INSERTION_MAX elementos
+    SEGMENT_MERGE,          // Acima disso
+    SEGMENT_CLASSES
+} SegmentClass;
+
+/**
+ * Redes de ordenação par-ímpar de Batcher (comparadores na ordem de
+ * execução), como listas de X(i, j). Expandidas com índices constantes, as
+ * posições ficam em registradores. Segmentos menores que a rede são
+ * completados com INT_MAX, que nunca sai das posições finais.
+ */
+#define NETWORK_4(X) \
+    X(0, 1) X(2, 3) X(0, 2) X(1, 3) X(1, 2)
+
+#define NETWORK_8(X) \
+    X(0, 1) X(2, 3) X(4, 5) X(6, 7) X(0, 2) X(1, 3) X(4, 6) X(5, 7) \
+    X(1, 2) X(5, 6) X(0, 4) X(1, 5) X(2, 6) X(3, 7) X(2, 4) X(3, 5) \
+    X(1, 2) X(3, 4) X(5, 6)
+
+#define NETWORK_16(X) \
+    X(0, 1) X(2, 3) X(4, 5) X(6, 7) X(8, 9) X(10, 11) X(12, 13) X(14, 15) \
+    X(0, 2) X(1, 3) X(4, 6) X(5, 7) X(8, 10) X(9, 11) X(12, 14) X(13, 15) \
+    X(1, 2) X(5, 6) X(9, 10) X(13, 14) X(0, 4) X(1, 5) X(2, 6) X(3, 7) \
+    X(8, 12) X(9, 13) X(10, 14) X(11, 15) X(2, 4) X(3, 5) X(10, 12) \
+    X(11, 13) X(1, 2) X(3, 4) X(5, 6) X(9, 10) X(11, 12) X(13, 14) X(0, 8) \
+    X(1, 9) X(2, 10) X(3, 11) X(4, 12) X(5, 13) X(6, 14) X(7, 15) X(4, 8) \
+    X(5, 9) X(6, 10) X(7, 11) X(2, 4) X(3, 5) X(6, 8) X(7, 9) X(10, 12) \
+    X(11, 13) X(1, 2) X(3, 4) X(5, 6) X(7, 8) X(9, 10) X(11, 12) X(13, 14)
+
+// Comparador da rede: mínimo e máximo, sem desvios condicionais
+#define NETWORK_COMPARATOR(i, j)                 \
+    {                                            \
+        int a = v[i], b = v[j];                  \
+        v[i] = b < a ? b : a;                    \
+        v[j] = b < a ? a : b;                    \
+        COUNT_MOVEMENTS(counters, b < a);        \
+        COUNT_COMPARISON(counters);              \
+    }
+
+/**
+ * Define network_sort_<width>: ordena até width elementos com a rede
+ */
+#define DEFINE_NETWORK_SORT(width, NETWORK)                             \
+    static void network_sort_##width(int *arr, size_t len,              \
+                                     SortCounters *counters) {          \
+        int v[width];                                                   \
+        size_t i;                                                       \
+                                                                        \
+        memcpy(v, arr, len * sizeof(int));                              \
+        for (i = len; i < width; i++) {                                 \
+            v[i] = INT_MAX;                                             \
+        }                                                               \
+        NETWORK(NETWORK_COMPARATOR)                                     \
+        memcpy(arr, v, len * sizeof(int));                              \
+    }
+
+DEFINE_NETWORK_SORT(4, NETWORK_4)
+DEFINE_NETWORK_SORT(8, NETWORK_8)
+DEFINE_NETWORK_SORT(16, NETWORK_16)
+
+/**
+ * Tarefa: um trecho da lista de segmentos ordenada por classe
+ */
+typedef struct {
+    int *data;
+    int *scratch;              // Área da intercalação (mesmos offsets)
+    const size_t *offsets;
+    const size_t *order;       // Segmentos ordenados por classe
+    size_t begin, end;         // Trecho de order
+    SortCounters *total;
+} SegmentTask;
+
+/**
+ * Aloca memória ou encerra o programa
+ */
+static void *checked_malloc(size_t bytes) {
+    void *ptr = malloc(bytes > 0 ? bytes : 1);
+    if (ptr == NULL) {
+        fprintf(stderr, "Erro na alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+    return ptr;
+}
+
+/**
+ * Classe de um segmento de len elementos (len >= 2)
+ */
+static SegmentClass segment_class(size_t len) {
+    if (len <= 4) {
+        return SEGMENT_NETWORK_4;
+    }
+    if (len <= 8) {
+        return SEGMENT_NETWORK_8;
+    }
+    if (len <= 16) {
+        return SEGMENT_NETWORK_16;
+    }
+    return len <= SEGMENT_INSERTION_MAX ? SEGMENT_INSERTION : SEGMENT_MERGE;
+}
+
+/**
+ * Ordenação por inserção de arr[0 .. n)
+ */
+static void insertion_sort_segment(int *arr, size_t n,
+                                   SortCounters *counters) {
+    size_t i, j;
+    for (i = 1; i < n; i++) {
+        int key = arr[i];
+        for (j = i; j > 0; j--) {
+            COUNT_COMPARISON(counters);
+            if (arr[j - 1] <= key) {
+                break;
+            }
+            arr[j] = arr[j - 1];
+            COUNT_MOVEMENT(counters);
+        }
+        if (j != i) {
+            arr[j] = key;
+            COUNT_MOVEMENT(counters);
+        }
+    }
+}
+
+/**
+ * Intercala a[0..na) e b[0..nb) em out (empates ficam com a)
+ */
+static void merge_segment_runs(const int *a, size_t na, const int *b,
+                               size_t nb, int *out, SortCounters *counters) {
+    size_t ia = 0, ib = 0, io = 0;
+
+    while (ia < na && ib < nb) {
+        int take_b = b[ib] < a[ia];
+        out[io++] = take_b ? b[ib] : a[ia];
+        ib += take_b;
+        ia += !take_b;
+        COUNT_COMPARISON(counters);
+    }
+    memcpy(out + io, a + ia, (na - ia) * sizeof(int));
+    io += na - ia;
+    memcpy(out + io, b + ib, (nb - ib) * sizeof(int));
+    COUNT_MOVEMENTS(counters, na + nb);
+}
+
+/**
+ * MergeSort de um segmento: blocos ordenados pela rede e intercalações
+ * de baixo para cima com scratch (mesmo tamanho); o resultado fica em arr
+ */
+static void merge_sort_segment(int *arr, int *scratch, size_t n,
+                               SortCounters *counters) {
+    int *src = arr, *dst = scratch;
+    size_t begin, width;
+
+    for (begin = 0; begin < n; begin += SEGMENT_MERGE_BLOCK) {
+        size_t len = n - begin < SEGMENT_MERGE_BLOCK ? n - begin
+                                                     : SEGMENT_MERGE_BLOCK;
+        network_sort_16(arr + begin, len, counters);
+    }
+
+    for (width = SEGMENT_MERGE_BLOCK; width < n; width *= 2) {
+        for (begin = 0; begin < n; begin += 2 * width) {
+            size_t mid = begin + width < n ? begin + width : n;
+            size_t end = mid + width < n ? mid + width : n;
+            merge_segment_runs(src + begin, mid - begin, src + mid,
+                               end - mid, dst + begin, counters);
+        }
+        int *temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != arr) {
+        memcpy(arr, src, n * sizeof(int));
+        COUNT_MOVEMENTS(counters, n);
+    }
+}
+
+/**
+ * Ordena os segmentos de um trecho da lista (todos de classes vizinhas)
+ */
+static void sort_segment_range(void *arg) {
+    SegmentTask *task = (SegmentTask *)arg;
+    SortCounters counters = {0, 0};
+    size_t i;
+
+    for (i = task->begin; i < task->end; i++) {
+        size_t s = task->order[i];
+        size_t first = task->offsets[s];
+        size_t len = task->offsets[s + 1] - first;
+        int *arr = task->data + first;
+
+        switch (segment_class(len)) {
+            case SEGMENT_NETWORK_4:
+                network_sort_4(arr, len, &counters);
+                break;
+            case SEGMENT_NETWORK_8:
+                network_sort_8(arr, len, &counters);
+                break;
+            case SEGMENT_NETWORK_16:
+                network_sort_16(arr, len, &counters);
+                break;
+            case SEGMENT_INSERTION:
+                insertion_sort_segment(arr, len, &counters);
+                break;
+            case SEGMENT_MERGE:
+            default:
+                merge_sort_segment(arr, task->scratch + first, len,
+                                   &counters);
+                break;
+        }
+    }
+
+    COUNT_MERGE_ATOMIC(task->total, &counters);
+}
+
+/**
+ * Ordenação segmentada
+ */
+SortResult SORT_KERNEL(segmented_sort)(int *data, const size_t *offsets,
+                                       size_t num_segments) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    size_t count[SEGMENT_CLASSES] = {0};
+    size_t start[SEGMENT_CLASSES];
+    size_t s, sorted = 0, total = 0;
+    int c, threads = 1;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    // Contar os segmentos de cada classe (0 ou 1 elemento: nada a fazer)
+    for (s = 0; s < num_segments; s++) {
+        size_t len = offsets[s + 1] - offsets[s];
+        if (len >= 2) {
+            count[segment_class(len)]++;
+            sorted++;
+            total += len;
+        }
+    }
+
+    if (sorted > 0) {
+        // Segmentos agrupados por classe (contagem dos índices)
+        size_t *order =
+            (size_t *)sort_scratch(SCRATCH_AUX, sorted * sizeof(size_t));
+        size_t position = 0;
+        for (c = 0; c < SEGMENT_CLASSES; c++) {
+            start[c] = position;
+            position += count[c];
+        }
+        for (s = 0; s < num_segments; s++) {
+            size_t len = offsets[s + 1] - offsets[s];
+            if (len >= 2) {
+                order[start[segment_class(len)]++] = s;
+            }
+        }
+
+        SegmentTask base;
+        base.data = data;
+        base.scratch = NULL;
+        base.offsets = offsets;
+        base.order = order;
+        base.begin = 0;
+        base.end = sorted;
+        base.total = &counters;
+        if (count[SEGMENT_MERGE] > 0) {
+            base.scratch = (int *)sort_scratch(
+                SCRATCH_DATA, offsets[num_segments] * sizeof(int));
+        }
+
+        // Tarefas com número parecido de elementos
+        ThreadPool *pool = NULL;
+        if (parallel_get_threads() > 1 &&
+            total >= 2 * (size_t)SEGMENT_MIN_TASK_ELEMENTS) {
+            pool = parallel_shared_pool();
+            threads = thread_pool_size(pool);
+        }
+
+        if (pool == NULL) {
+            sort_segment_range(&base);
+        } else {
+            size_t target =
+                total / ((size_t)threads * SEGMENT_TASKS_PER_THREAD);
+            if (target < SEGMENT_MIN_TASK_ELEMENTS) {
+                target = SEGMENT_MIN_TASK_ELEMENTS;
+            }
+            size_t max_tasks = total / target + 1;
+            SegmentTask *tasks =
+                (SegmentTask *)checked_malloc(max_tasks * sizeof(SegmentTask));
+            TaskGroup group;
+            size_t num_tasks = 0, begin = 0, elements = 0, i;
+
+            task_group_init(&group);
+            for (i = 0; i < sorted; i++) {
+                s = order[i];
+                elements += offsets[s + 1] - offsets[s];
+                if (elements >= target || i + 1 == sorted) {
+                    tasks[num_tasks] = base;
+                    tasks[num_tasks].begin = begin;
+                    tasks[num_tasks].end = i + 1;
+                    thread_pool_submit(pool, &group, sort_segment_range,
+                                       &tasks[num_tasks]);
+                    num_tasks++;
+                    begin = i + 1;
+                    elements = 0;
+                }
+            }
+            thread_pool_wait(pool, &group);
+            free(tasks);
+        }
+
+        sort_scratch_done(base.scratch);
+        sort_scratch_done(order);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    result.threads = threads;
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+#if SORT_COUNTED
+
+/**
+ * Gera os limites dos segmentos
+ */
+size_t generate_segment_offsets(size_t *offsets, size_t num_segments,
+                                size_t max_length, uint64_t seed) {
+    // Sequência separada da usada pelas distribuições das chaves
+    uint64_t stream = seed ^ 0x5E65E65E65E65E6Bull;
+    size_t s, position = 0;
+
+    for (s = 0; s < num_segments; s++) {
+        offsets[s] = position;
+        position += prng_bounded(prng_at(stream, s),
+                                 (uint32_t)max_length + 1);
+    }
+    offsets[num_segments] = position;
+    return position;
+}
+
+/**
+ * Verifica se cada segmento está ordenado
+ */
+int segments_sorted(const int *data, const size_t *offsets,
+                    size_t num_segments) {
+    size_t s, i;
+
+    for (s = 0; s < num_segments; s++) {
+        for (i = offsets[s] + 1; i < offsets[s + 1]; i++) {
+            if (data[i - 1] > data[i]) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+#endif /* SORT_COUNTED */
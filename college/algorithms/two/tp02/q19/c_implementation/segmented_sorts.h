@@ -0,0 +1,71 @@
+/**
+ * segmented_sorts.h
+ * Ordenação segmentada: muitos arrays pequenos e independentes guardados em
+ * um único buffer, como as listas de elenco e de gêneros que os programas
+ * do tp02 ordenam uma a uma
+ */
+
+#ifndef SEGMENTED_SORTS_H
+#define SEGMENTED_SORTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sorting_algorithms.h"
+
+// Maior tamanho de segmento gerado quando --segment-length não é informado
+#define SEGMENT_DEFAULT_MAX_LENGTH 128
+
+// Maior tamanho de segmento aceito
+#define SEGMENT_MAX_LENGTH (1 << 20)
+
+// Algoritmos chamados em cada segmento quando --algorithms é "all" (o
+// selection_sort é o order_strings dos programas do tp02)
+#define SEGMENT_BASELINE_ALGORITHMS "selection_sort,insertion_sort,intro_sort"
+
+/**
+ * Ordena todos os segmentos em uma chamada. Os segmentos são agrupados por
+ * tamanho e cada grupo usa um único método: redes de ordenação (até 16
+ * elementos), inserção (até 32) e intercalação (acima disso). Os grupos são
+ * divididos em tarefas de tamanho parecido no pool de threads.
+ *
+ * @param data Buffer com todos os segmentos
+ * @param offsets num_segments + 1 posições: o segmento s é
+ *                data[offsets[s] .. offsets[s + 1])
+ * @param num_segments Número de segmentos
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult segmented_sort(int *data, const size_t *offsets,
+                          size_t num_segments);
+
+/**
+ * Variante sem instrumentação
+ */
+SortResult segmented_sort_fast(int *data, const size_t *offsets,
+                               size_t num_segments);
+
+/**
+ * Gera os limites de num_segments segmentos com tamanhos uniformes em
+ * [0, max_length]
+ *
+ * @param offsets Destino (num_segments + 1 posições)
+ * @param num_segments Número de segmentos
+ * @param max_length Maior tamanho de segmento
+ * @param seed Semente
+ * @return Total de elementos (offsets[num_segments])
+ */
+size_t generate_segment_offsets(size_t *offsets, size_t num_segments,
+                                size_t max_length, uint64_t seed);
+
+/**
+ * Verifica se cada segmento está ordenado
+ *
+ * @param data Buffer com todos os segmentos
+ * @param offsets Limites dos segmentos
+ * @param num_segments Número de segmentos
+ * @return 1 se todos estão ordenados, 0 caso contrário
+ */
+int segments_sorted(const int *data, const size_t *offsets,
+                    size_t num_segments);
+
+#endif /* SEGMENTED_SORTS_H */
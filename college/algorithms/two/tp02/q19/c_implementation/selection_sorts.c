@@ -0,0 +1,394 @@
+/**
+ * selection_sorts.c
+ * Implementação dos algoritmos de seleção e ordenação parcial
+ *
+ * Compilado duas vezes, como sorting_algorithms.c (ver
+ * sort_instrumentation.h). Comparações e movimentações são contadas como nos
+ * algoritmos de ordenação completa, para comparar o custo do top-k com o de
+ * ordenar tudo.
+ */
+
+#include "selection_sorts.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "sort_helpers.h"
+#include "sort_instrumentation.h"
+
+/**
+ * Parâmetros da seleção
+ */
+#define SELECT_INSERTION_CUTOFF 24     // Abaixo disso, ordenação por inserção
+#define SELECT_NINTHER_THRESHOLD 128   // A partir disso, pivô pelo ninther
+#define FLOYD_RIVEST_SAMPLE_CUTOFF 600 // Acima disso, restringe pela amostra
+
+/**
+ * Limite de profundidade: 2 * floor(log2(n))
+ */
+static int depth_limit_for(size_t n) {
+    int depth = 0;
+    for (; n > 1; n >>= 1) {
+        depth += 2;
+    }
+    return depth;
+}
+
+/**
+ * Pivô: mediana de três ou, em partições grandes, ninther de Tukey
+ */
+static ptrdiff_t choose_pivot(int *arr, ptrdiff_t low, ptrdiff_t high,
+                              SortCounters *counters) {
+    ptrdiff_t n = high - low + 1;
+    ptrdiff_t mid = low + n / 2;
+
+    if (n < SELECT_NINTHER_THRESHOLD) {
+        return median_of_three(arr, low, mid, high, counters);
+    }
+
+    ptrdiff_t step = n / 8;
+    ptrdiff_t m1 =
+        median_of_three(arr, low, low + step, low + 2 * step, counters);
+    ptrdiff_t m2 = median_of_three(arr, mid - step, mid, mid + step, counters);
+    ptrdiff_t m3 =
+        median_of_three(arr, high - 2 * step, high - step, high, counters);
+    return median_of_three(arr, m1, m2, m3, counters);
+}
+
+/**
+ * Partição de Hoare com o pivô escolhido levado a arr[low]
+ *
+ * @return Posição final do pivô: arr[low .. p) <= arr[p] <= arr(p .. high]
+ */
+static ptrdiff_t partition(int *arr, ptrdiff_t low, ptrdiff_t high,
+                           SortCounters *counters) {
+    swap_elements(arr, low, choose_pivot(arr, low, high, counters), counters);
+
+    int pivot = arr[low];
+    ptrdiff_t i = low, j = high + 1;
+
+    // Os dois lados param em elementos iguais ao pivô, o que equilibra a
+    // partição quando há muitas repetições
+    for (;;) {
+        while (less_than(arr[++i], pivot, counters)) {
+            if (i == high) {
+                break;
+            }
+        }
+        while (less_than(pivot, arr[--j], counters)) {
+        }
+        if (i >= j) {
+            break;
+        }
+        swap_elements(arr, i, j, counters);
+    }
+
+    swap_elements(arr, low, j, counters);
+    return j;
+}
+
+/**
+ * Ordena um heap máximo arr[base .. base + size - 1] em ordem crescente
+ */
+static void sort_heap(int *arr, ptrdiff_t base, ptrdiff_t size,
+                      SortCounters *counters) {
+    ptrdiff_t i;
+    for (i = size - 1; i > 0; i--) {
+        swap_elements(arr, base, base + i, counters);
+        sift_down(arr, base, 0, i, counters);
+    }
+}
+
+/**
+ * QuickSort parcial: ordena as posições [low, last] de arr[low .. high]
+ * (last <= high), que recebem os menores elementos do trecho. O lado
+ * direito do pivô só é visitado se o pivô cair antes de last
+ */
+static void partial_quick_loop(int *arr, ptrdiff_t low, ptrdiff_t high,
+                               ptrdiff_t last, int depth_limit,
+                               SortCounters *counters) {
+    while (high - low + 1 > SELECT_INSERTION_CUTOFF) {
+        if (depth_limit == 0) {
+            heap_sort_range(arr, low, high, counters);
+            return;
+        }
+        depth_limit--;
+
+        ptrdiff_t p = partition(arr, low, high, counters);
+        if (p > last) {
+            high = p - 1;
+            continue;
+        }
+
+        // Todo o lado esquerdo está antes de last: ordenação completa
+        partial_quick_loop(arr, low, p - 1, p - 1, depth_limit, counters);
+        if (p == last) {
+            return;
+        }
+        low = p + 1;
+    }
+
+    insertion_sort_range(arr, low, high, counters);
+}
+
+/**
+ * Ordena arr[0 .. k - 1), que já contém os menores elementos (após a
+ * seleção da posição k - 1)
+ */
+static void sort_prefix(int *arr, size_t k, SortCounters *counters) {
+    if (k > 2) {
+        ptrdiff_t last = (ptrdiff_t)k - 2;
+        partial_quick_loop(arr, 0, last, last, depth_limit_for(k - 1),
+                           counters);
+    }
+}
+
+/**
+ * QuickSelect com limite de profundidade: ao final, arr[nth] é o elemento
+ * dessa posição na ordem, com os menores antes e os maiores depois
+ */
+static void introselect_loop(int *arr, ptrdiff_t low, ptrdiff_t high,
+                             ptrdiff_t nth, int depth_limit,
+                             SortCounters *counters) {
+    while (high - low + 1 > SELECT_INSERTION_CUTOFF) {
+        if (depth_limit == 0) {
+            heap_sort_range(arr, low, high, counters);
+            return;
+        }
+        depth_limit--;
+
+        ptrdiff_t p = partition(arr, low, high, counters);
+        if (p == nth) {
+            return;
+        }
+        if (nth < p) {
+            high = p - 1;
+        } else {
+            low = p + 1;
+        }
+    }
+
+    insertion_sort_range(arr, low, high, counters);
+}
+
+/**
+ * Seleção de Floyd-Rivest da posição nth em arr[left .. right]
+ */
+static void floyd_rivest_loop(int *arr, ptrdiff_t left, ptrdiff_t right,
+                              ptrdiff_t nth, SortCounters *counters) {
+    while (right > left) {
+        // Restringir a busca ao intervalo em torno de nth estimado pela
+        // amostra (s elementos, com desvio sd)
+        if (right - left > FLOYD_RIVEST_SAMPLE_CUTOFF) {
+            double n = (double)(right - left + 1);
+            double rank = (double)(nth - left + 1);
+            double z = log(n);
+            double s = 0.5 * exp(2.0 * z / 3.0);
+            double sd = 0.5 * sqrt(z * s * (n - s) / n) *
+                        (rank < n / 2.0 ? -1.0 : 1.0);
+            ptrdiff_t new_left = (ptrdiff_t)(nth - rank * s / n + sd);
+            ptrdiff_t new_right =
+                (ptrdiff_t)(nth + (n - rank) * s / n + sd);
+            floyd_rivest_loop(arr, new_left > left ? new_left : left,
+                              new_right < right ? new_right : right, nth,
+                              counters);
+        }
+
+        // Partição em torno de t = arr[nth], com sentinelas nas pontas
+        int t = arr[nth];
+        ptrdiff_t i = left, j = right;
+        swap_elements(arr, left, nth, counters);
+        if (less_than(t, arr[right], counters)) {
+            swap_elements(arr, right, left, counters);
+        }
+        while (i < j) {
+            swap_elements(arr, i, j, counters);
+            i++;
+            j--;
+            while (less_than(arr[i], t, counters)) {
+                i++;
+            }
+            while (less_than(t, arr[j], counters)) {
+                j--;
+            }
+        }
+
+        COUNT_COMPARISON(counters);
+        if (arr[left] == t) {
+            swap_elements(arr, left, j, counters);
+        } else {
+            j++;
+            swap_elements(arr, j, right, counters);
+        }
+
+        if (j <= nth) {
+            left = j + 1;
+        }
+        if (nth <= j) {
+            right = j - 1;
+        }
+    }
+}
+
+/**
+ * k efetivo de uma chamada
+ */
+static size_t effective_k(size_t n) {
+    size_t k = selection_get_k();
+    return k < n ? k : n;
+}
+
+/**
+ * IntroSelect
+ */
+SortResult SORT_KERNEL(intro_select)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    size_t k = effective_k(n);
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    if (k > 0 && n > 1) {
+        introselect_loop(arr, 0, (ptrdiff_t)n - 1, (ptrdiff_t)k - 1,
+                         depth_limit_for(n), &counters);
+        sort_prefix(arr, k, &counters);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Seleção de Floyd-Rivest
+ */
+SortResult SORT_KERNEL(floyd_rivest_select)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    size_t k = effective_k(n);
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    if (k > 0 && n > 1) {
+        floyd_rivest_loop(arr, 0, (ptrdiff_t)n - 1, (ptrdiff_t)k - 1,
+                          &counters);
+        sort_prefix(arr, k, &counters);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Top-k por heap limitado
+ */
+SortResult SORT_KERNEL(heap_select)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    ptrdiff_t k = (ptrdiff_t)effective_k(n);
+    ptrdiff_t i;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    if (k > 0) {
+        // Heap máximo com os k primeiros; o topo é o maior dos k menores
+        for (i = k / 2 - 1; i >= 0; i--) {
+            sift_down(arr, 0, i, k, &counters);
+        }
+        for (i = k; i < (ptrdiff_t)n; i++) {
+            if (less_than(arr[i], arr[0], &counters)) {
+                swap_elements(arr, 0, i, &counters);
+                sift_down(arr, 0, 0, k, &counters);
+            }
+        }
+        sort_heap(arr, 0, k, &counters);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * QuickSort parcial
+ */
+SortResult SORT_KERNEL(partial_quick_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    size_t k = effective_k(n);
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    if (k > 0 && n > 1) {
+        partial_quick_loop(arr, 0, (ptrdiff_t)n - 1, (ptrdiff_t)k - 1,
+                           depth_limit_for(n), &counters);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+#if SORT_COUNTED
+
+/**
+ * k dos algoritmos de seleção (compartilhado pelas duas variantes)
+ */
+static size_t selection_k = SELECTION_DEFAULT_K;
+
+/**
+ * Define quantos elementos os algoritmos de seleção ordenam
+ */
+void selection_set_k(size_t k) {
+    selection_k = k;
+}
+
+/**
+ * Número de elementos ordenados pelos algoritmos de seleção
+ */
+size_t selection_get_k(void) {
+    return selection_k;
+}
+
+/**
+ * Registro dos algoritmos de seleção
+ */
+const SortAlgorithm selection_algorithms[] = {
+    {"intro_select", intro_select, intro_select_fast, 0},
+    {"floyd_rivest_select", floyd_rivest_select, floyd_rivest_select_fast, 0},
+    {"heap_select", heap_select, heap_select_fast, 0},
+    {"partial_quick_sort", partial_quick_sort, partial_quick_sort_fast, 0},
+};
+
+const int num_selection_algorithms =
+    (int)(sizeof(selection_algorithms) / sizeof(selection_algorithms[0]));
+
+/**
+ * Procura um algoritmo de seleção pelo nome
+ */
+const SortAlgorithm *find_selection_algorithm(const char *name) {
+    int i;
+    for (i = 0; i < num_selection_algorithms; i++) {
+        if (strcmp(selection_algorithms[i].name, name) == 0) {
+            return &selection_algorithms[i];
+        }
+    }
+    return NULL;
+}
+
+#endif /* SORT_COUNTED */
@@ -0,0 +1,97 @@
+/**
+ * selection_sorts.h
+ * Algoritmos de seleção e ordenação parcial (top-k): deixam em arr[0 .. k)
+ * os k menores elementos em ordem crescente, como o heapsort, a inserção e o
+ * quicksort parciais das questões 16 a 18 (k = 10)
+ */
+
+#ifndef SELECTION_SORTS_H
+#define SELECTION_SORTS_H
+
+#include <stddef.h>
+
+#include "sorting_algorithms.h"
+
+// k usado quando --k não é informado (o das questões 16 a 18)
+#define SELECTION_DEFAULT_K 10
+
+/**
+ * Define quantos elementos os algoritmos de seleção ordenam
+ *
+ * @param k Número de menores elementos (limitado a n em cada chamada)
+ */
+void selection_set_k(size_t k);
+
+/**
+ * Número de elementos ordenados pelos algoritmos de seleção
+ *
+ * @return k definido por selection_set_k
+ */
+size_t selection_get_k(void);
+
+/**
+ * IntroSelect (nth_element): QuickSelect com pivô mediana de três (ninther
+ * em partições grandes) e HeapSort do trecho ao esgotar 2·log2(n) níveis;
+ * depois ordena os k primeiros
+ *
+ * @param arr Array
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult intro_select(int *arr, size_t n);
+
+/**
+ * Seleção de Floyd-Rivest: restringe a partição a um intervalo estimado por
+ * uma amostra recursiva, com cerca de n + min(k, n - k) comparações;
+ * depois ordena os k primeiros
+ *
+ * @param arr Array
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult floyd_rivest_select(int *arr, size_t n);
+
+/**
+ * Top-k por heap máximo limitado a k elementos: cada elemento menor que o
+ * topo o substitui; no final o heap é ordenado
+ *
+ * @param arr Array
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult heap_select(int *arr, size_t n);
+
+/**
+ * QuickSort parcial: só desce no lado direito do pivô se ele cair antes da
+ * posição k
+ *
+ * @param arr Array
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult partial_quick_sort(int *arr, size_t n);
+
+/**
+ * Variantes sem instrumentação
+ */
+SortResult intro_select_fast(int *arr, size_t n);
+SortResult floyd_rivest_select_fast(int *arr, size_t n);
+SortResult heap_select_fast(int *arr, size_t n);
+SortResult partial_quick_sort_fast(int *arr, size_t n);
+
+/**
+ * Registro dos algoritmos de seleção (fora de sort_algorithms porque não
+ * ordenam o array inteiro)
+ */
+extern const SortAlgorithm selection_algorithms[];
+extern const int num_selection_algorithms;
+
+/**
+ * Procura um algoritmo de seleção pelo nome
+ *
+ * @param name Nome do algoritmo
+ * @return Entrada do registro ou NULL se não existir
+ */
+const SortAlgorithm *find_selection_algorithm(const char *name);
+
+#endif /* SELECTION_SORTS_H */
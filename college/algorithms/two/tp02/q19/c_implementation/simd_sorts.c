@@ -0,0 +1,1108 @@
+/**
+ * simd_sorts.c
+ * Implementação dos algoritmos de ordenação vetorizados
+ *
+ * Compilado duas vezes, como sorting_algorithms.c (ver
+ * sort_instrumentation.h). As funções de cada conjunto de instruções levam
+ * atributos de alvo, então o arquivo não precisa de -mavx2/-mavx512f e o
+ * despacho por CPUID escolhe o caminho em tempo de execução. Na variante
+ * instrumentada, cada operação vetorial conta uma comparação por par de
+ * elementos comparado e uma movimentação por elemento escrito na memória.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "simd_sorts.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "large_memory.h"
+#include "sort_instrumentation.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#else
+#define SIMD_X86 0
+#endif
+
+// Atributos de alvo das funções de cada conjunto de instruções
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+
+// Elementos por registrador
+#define AVX2_LANES 8
+#define AVX512_LANES 16
+
+// Registradores de uma rede de ordenação (bloco de 128 ou 256 elementos)
+#define NETWORK_VECTORS 16
+
+// Bloco ordenado por inserção no caminho escalar
+#define SCALAR_BLOCK 16
+
+// Amostras usadas na escolha do pivô (a mediana é o pivô)
+#define PIVOT_SAMPLES 15
+
+/**
+ * Tabela de permutações da partição AVX2: para cada máscara de 8 bits
+ * (elemento menor que o pivô), os índices dos menores seguidos dos demais.
+ * Definida na variante instrumentada e preenchida por simd_detect_level.
+ */
+extern int simd_avx2_permutations[256][AVX2_LANES];
+
+/**
+ * Operações de um conjunto de instruções usadas pelos algoritmos
+ */
+typedef struct {
+    SimdLevel level;
+    int block;  // Maior trecho ordenado de uma vez por sort_block
+
+    // Ordena até `block` elementos
+    void (*sort_block)(int *arr, int n, SortCounters *counters);
+
+    // Particiona em [< pivô | >= pivô], devolvendo o tamanho do lado esquerdo
+    // e o menor e o maior elemento do trecho
+    ptrdiff_t (*partition)(int *arr, ptrdiff_t n, int pivot, int *smallest,
+                           int *biggest, SortCounters *counters);
+
+    // Intercala duas sequências ordenadas em out
+    void (*merge)(const int *a, size_t na, const int *b, size_t nb, int *out,
+                  SortCounters *counters);
+} SimdKernels;
+
+/**
+ * Ordena sequencialmente um trecho com o IntroSort, somando os contadores
+ * (usado quando a recursão passa do limite de profundidade)
+ */
+static void fallback_sort(int *arr, size_t n, SortCounters *counters) {
+    SortResult partial = SORT_KERNEL(intro_sort)(arr, n);
+    COUNT_COMPARISONS(counters, partial.comparisons);
+    COUNT_MOVEMENTS(counters, partial.movements);
+}
+
+/* ------------------------------------------------------------------------
+ * Caminho escalar
+ * ------------------------------------------------------------------------ */
+
+static void scalar_sort_block(int *arr, int n, SortCounters *counters) {
+    int i, j;
+
+    for (i = 1; i < n; i++) {
+        int key = arr[i];
+        for (j = i - 1; j >= 0; j--) {
+            COUNT_COMPARISON(counters);
+            if (arr[j] <= key) {
+                break;
+            }
+            arr[j + 1] = arr[j];
+            COUNT_MOVEMENT(counters);
+        }
+        arr[j + 1] = key;
+        COUNT_MOVEMENT(counters);
+    }
+}
+
+static ptrdiff_t scalar_partition(int *arr, ptrdiff_t n, int pivot,
+                                  int *smallest, int *biggest,
+                                  SortCounters *counters) {
+    int lo = INT_MAX, hi = INT_MIN;
+    ptrdiff_t store = 0;
+    ptrdiff_t i;
+
+    for (i = 0; i < n; i++) {
+        int value = arr[i];
+        lo = value < lo ? value : lo;
+        hi = value > hi ? value : hi;
+        COUNT_COMPARISON(counters);
+        if (value < pivot) {
+            arr[i] = arr[store];
+            arr[store++] = value;
+            COUNT_MOVEMENTS(counters, 2);
+        }
+    }
+
+    *smallest = lo;
+    *biggest = hi;
+    return store;
+}
+
+static void scalar_merge(const int *a, size_t na, const int *b, size_t nb,
+                         int *out, SortCounters *counters) {
+    size_t ia = 0, ib = 0, io = 0;
+
+    while (ia < na && ib < nb) {
+        COUNT_COMPARISON(counters);
+        out[io++] = b[ib] < a[ia] ? b[ib++] : a[ia++];
+    }
+    memcpy(out + io, a + ia, (na - ia) * sizeof(int));
+    io += na - ia;
+    memcpy(out + io, b + ib, (nb - ib) * sizeof(int));
+    COUNT_MOVEMENTS(counters, na + nb);
+}
+
+/**
+ * Termina uma intercalação vetorial: `carry` (registrador já ordenado) e os
+ * restos das duas entradas, sendo um deles menor que um registrador
+ */
+static void finish_merge(const int *carry, size_t lanes, const int *a,
+                         size_t na, const int *b, size_t nb, int *out,
+                         SortCounters *counters) {
+    int small[2 * AVX512_LANES];
+
+    // Junta o registrador com o resto curto e depois com o longo
+    if (na < nb) {
+        scalar_merge(carry, lanes, a, na, small, counters);
+        scalar_merge(small, lanes + na, b, nb, out, counters);
+    } else {
+        scalar_merge(carry, lanes, b, nb, small, counters);
+        scalar_merge(small, lanes + nb, a, na, out, counters);
+    }
+}
+
+static const SimdKernels scalar_kernels = {
+    SIMD_SCALAR, SCALAR_BLOCK, scalar_sort_block, scalar_partition,
+    scalar_merge};
+
+#if SIMD_X86
+
+/* ------------------------------------------------------------------------
+ * AVX2: 8 inteiros por registrador
+ * ------------------------------------------------------------------------ */
+
+/**
+ * Troca cada elemento com o da posição i ^ j (j = 1, 2 ou 4)
+ */
+static inline TARGET_AVX2 __m256i avx2_swap_lanes(__m256i v, int j) {
+    switch (j) {
+        case 1:
+            return _mm256_shuffle_epi32(v, 0xB1);
+        case 2:
+            return _mm256_shuffle_epi32(v, 0x4E);
+        default:
+            return _mm256_permute2x128_si256(v, v, 0x01);
+    }
+}
+
+/**
+ * Comparador-trocador entre as posições i e i ^ j do registrador: as
+ * posições de max_lanes (imediato de 8 bits) ficam com o maior
+ */
+#define AVX2_EXCHANGE(v, j, max_lanes, counters)                        \
+    do {                                                                \
+        __m256i swapped_ = avx2_swap_lanes((v), (j));                   \
+        (v) = _mm256_blend_epi32(_mm256_min_epi32((v), swapped_),       \
+                                 _mm256_max_epi32((v), swapped_),       \
+                                 (max_lanes));                          \
+        COUNT_COMPARISONS((counters), AVX2_LANES / 2);                  \
+    } while (0)
+
+/**
+ * Intercala um registrador bitônico (últimos 3 níveis da rede bitônica)
+ */
+static inline TARGET_AVX2 __m256i avx2_merge_vector(__m256i v,
+                                                    SortCounters *counters) {
+    AVX2_EXCHANGE(v, 4, 0xF0, counters);
+    AVX2_EXCHANGE(v, 2, 0xCC, counters);
+    AVX2_EXCHANGE(v, 1, 0xAA, counters);
+    return v;
+}
+
+/**
+ * Ordena um registrador com a rede bitônica completa (6 níveis)
+ */
+static inline TARGET_AVX2 __m256i avx2_sort_vector(__m256i v,
+                                                   SortCounters *counters) {
+    AVX2_EXCHANGE(v, 1, 0x66, counters);
+    AVX2_EXCHANGE(v, 2, 0x3C, counters);
+    AVX2_EXCHANGE(v, 1, 0x5A, counters);
+    return avx2_merge_vector(v, counters);
+}
+
+static inline TARGET_AVX2 __m256i avx2_reverse(__m256i v) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_set_epi32(0, 1, 2, 3, 4, 5,
+                                                            6, 7));
+}
+
+/**
+ * Intercala duas sequências ordenadas de m registradores cada, em v[0..m)
+ * e v[m..2m): inverte a segunda e aplica a rede de intercalação bitônica
+ */
+static TARGET_AVX2 void avx2_merge_vectors(__m256i *v, int m,
+                                           SortCounters *counters) {
+    int i, d;
+
+    for (i = 0; i < m / 2; i++) {
+        __m256i temp = v[m + i];
+        v[m + i] = v[2 * m - 1 - i];
+        v[2 * m - 1 - i] = temp;
+    }
+    for (i = m; i < 2 * m; i++) {
+        v[i] = avx2_reverse(v[i]);
+    }
+
+    // Meio-limpadores entre registradores (distâncias m, m/2, ..., 1)
+    for (d = m; d >= 1; d /= 2) {
+        for (i = 0; i < 2 * m; i++) {
+            if ((i & d) == 0) {
+                __m256i low = _mm256_min_epi32(v[i], v[i + d]);
+                v[i + d] = _mm256_max_epi32(v[i], v[i + d]);
+                v[i] = low;
+                COUNT_COMPARISONS(counters, AVX2_LANES);
+            }
+        }
+    }
+    for (i = 0; i < 2 * m; i++) {
+        v[i] = avx2_merge_vector(v[i], counters);
+    }
+}
+
+/**
+ * Máscara das posições válidas de um registrador parcial
+ */
+static inline TARGET_AVX2 __m256i avx2_prefix_mask(int count) {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(count),
+                              _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+/**
+ * Ordena até 128 elementos nos registradores com a rede bitônica; o último
+ * registrador é completado com INT_MAX
+ */
+static TARGET_AVX2 void avx2_sort_block(int *arr, int n,
+                                        SortCounters *counters) {
+    __m256i v[NETWORK_VECTORS];
+    int count = (n + AVX2_LANES - 1) / AVX2_LANES;
+    int vectors = 1;
+    int i, m;
+
+    while (vectors < count) {
+        vectors *= 2;
+    }
+
+    for (i = 0; i < vectors; i++) {
+        int remaining = n - i * AVX2_LANES;
+        if (remaining >= AVX2_LANES) {
+            v[i] = _mm256_loadu_si256((const __m256i *)(arr + i * AVX2_LANES));
+        } else if (remaining > 0) {
+            __m256i mask = avx2_prefix_mask(remaining);
+            __m256i loaded = _mm256_maskload_epi32(arr + i * AVX2_LANES, mask);
+            v[i] = _mm256_blendv_epi8(_mm256_set1_epi32(INT_MAX), loaded, mask);
+        } else {
+            v[i] = _mm256_set1_epi32(INT_MAX);
+        }
+        v[i] = avx2_sort_vector(v[i], counters);
+    }
+
+    for (m = 1; m < vectors; m *= 2) {
+        for (i = 0; i < vectors; i += 2 * m) {
+            avx2_merge_vectors(v + i, m, counters);
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        int remaining = n - i * AVX2_LANES;
+        if (remaining >= AVX2_LANES) {
+            _mm256_storeu_si256((__m256i *)(arr + i * AVX2_LANES), v[i]);
+        } else {
+            _mm256_maskstore_epi32(arr + i * AVX2_LANES,
+                                   avx2_prefix_mask(remaining), v[i]);
+        }
+    }
+    COUNT_MOVEMENTS(counters, n);
+}
+
+/**
+ * Particiona um registrador: a permutação da tabela junta os menores no
+ * início e os demais no fim; o resultado é escrito inteiro nas duas janelas
+ * livres (a esquerda recebe os menores, a direita termina com os maiores)
+ *
+ * @return Quantidade de elementos menores que o pivô
+ */
+static inline TARGET_AVX2 int avx2_partition_vector(int *arr,
+                                                    ptrdiff_t l_store,
+                                                    ptrdiff_t r_store,
+                                                    __m256i curr,
+                                                    __m256i pivot,
+                                                    SortCounters *counters) {
+    __m256i less = _mm256_cmpgt_epi32(pivot, curr);
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(less));
+    __m256i perm = _mm256_loadu_si256(
+        (const __m256i *)simd_avx2_permutations[mask]);
+    __m256i packed = _mm256_permutevar8x32_epi32(curr, perm);
+
+    _mm256_storeu_si256((__m256i *)(arr + l_store), packed);
+    _mm256_storeu_si256((__m256i *)(arr + r_store), packed);
+    COUNT_COMPARISONS(counters, AVX2_LANES);
+    COUNT_MOVEMENTS(counters, AVX2_LANES);
+
+    return __builtin_popcount((unsigned)mask);
+}
+
+static inline TARGET_AVX2 int avx2_reduce_min(__m256i v) {
+    __m128i m = _mm_min_epi32(_mm256_castsi256_si128(v),
+                              _mm256_extracti128_si256(v, 1));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, 0x4E));
+    m = _mm_min_epi32(m, _mm_shuffle_epi32(m, 0xB1));
+    return _mm_cvtsi128_si32(m);
+}
+
+static inline TARGET_AVX2 int avx2_reduce_max(__m256i v) {
+    __m128i m = _mm_max_epi32(_mm256_castsi256_si128(v),
+                              _mm256_extracti128_si256(v, 1));
+    m = _mm_max_epi32(m, _mm_shuffle_epi32(m, 0x4E));
+    m = _mm_max_epi32(m, _mm_shuffle_epi32(m, 0xB1));
+    return _mm_cvtsi128_si32(m);
+}
+
+/**
+ * Partição vetorial no próprio array: os registradores das duas pontas
+ * ficam guardados, o que abre uma janela livre de um registrador em cada
+ * lado; cada leitura vem do lado com menos espaço livre, então as escritas
+ * nunca alcançam dados ainda não lidos
+ */
+static TARGET_AVX2 ptrdiff_t avx2_partition(int *arr, ptrdiff_t n, int pivot,
+                                            int *smallest, int *biggest,
+                                            SortCounters *counters) {
+    ptrdiff_t left = 0, right = n;
+    int lo = INT_MAX, hi = INT_MIN;
+    ptrdiff_t l_store, r_store;
+    int i;
+
+    // A sobra (n % 8) é particionada de forma escalar
+    for (i = n % AVX2_LANES; i > 0; i--) {
+        int value = arr[left];
+        lo = value < lo ? value : lo;
+        hi = value > hi ? value : hi;
+        COUNT_COMPARISON(counters);
+        if (value >= pivot) {
+            arr[left] = arr[--right];
+            arr[right] = value;
+            COUNT_MOVEMENTS(counters, 2);
+        } else {
+            left++;
+        }
+    }
+
+    l_store = left;
+    if (left < right) {
+        __m256i pivot_vec = _mm256_set1_epi32(pivot);
+        __m256i first = _mm256_loadu_si256((const __m256i *)(arr + left));
+        __m256i min_vec = _mm256_min_epi32(_mm256_set1_epi32(lo), first);
+        __m256i max_vec = _mm256_max_epi32(_mm256_set1_epi32(hi), first);
+
+        if (right - left == AVX2_LANES) {
+            l_store += avx2_partition_vector(arr, left, left, first,
+                                             pivot_vec, counters);
+        } else {
+            __m256i last = _mm256_loadu_si256(
+                (const __m256i *)(arr + right - AVX2_LANES));
+            min_vec = _mm256_min_epi32(min_vec, last);
+            max_vec = _mm256_max_epi32(max_vec, last);
+            r_store = right - AVX2_LANES;
+            left += AVX2_LANES;
+            right -= AVX2_LANES;
+
+            while (left < right) {
+                __m256i curr;
+                int amount;
+                if ((r_store + AVX2_LANES) - right < left - l_store) {
+                    right -= AVX2_LANES;
+                    curr = _mm256_loadu_si256((const __m256i *)(arr + right));
+                } else {
+                    curr = _mm256_loadu_si256((const __m256i *)(arr + left));
+                    left += AVX2_LANES;
+                }
+                min_vec = _mm256_min_epi32(min_vec, curr);
+                max_vec = _mm256_max_epi32(max_vec, curr);
+                amount = avx2_partition_vector(arr, l_store, r_store, curr,
+                                               pivot_vec, counters);
+                l_store += amount;
+                r_store -= AVX2_LANES - amount;
+            }
+
+            // Os dois registradores guardados fecham as janelas livres
+            i = avx2_partition_vector(arr, l_store, r_store, first, pivot_vec,
+                                      counters);
+            l_store += i;
+            r_store -= AVX2_LANES - i;
+            l_store += avx2_partition_vector(arr, l_store, r_store, last,
+                                             pivot_vec, counters);
+        }
+        lo = avx2_reduce_min(min_vec);
+        hi = avx2_reduce_max(max_vec);
+    }
+
+    *smallest = lo;
+    *biggest = hi;
+    return l_store;
+}
+
+/**
+ * Intercala dois registradores ordenados: lo recebe os 8 menores e hi os 8
+ * maiores
+ */
+static inline TARGET_AVX2 void avx2_merge_pair(__m256i *lo, __m256i *hi,
+                                               SortCounters *counters) {
+    __m256i reversed = avx2_reverse(*hi);
+    __m256i low = _mm256_min_epi32(*lo, reversed);
+    __m256i high = _mm256_max_epi32(*lo, reversed);
+    COUNT_COMPARISONS(counters, AVX2_LANES);
+    *lo = avx2_merge_vector(low, counters);
+    *hi = avx2_merge_vector(high, counters);
+}
+
+/**
+ * Intercalação vetorial: o registrador hi guarda os 8 maiores já vistos e
+ * cada passo carrega o próximo registrador da entrada de menor cabeça
+ */
+static TARGET_AVX2 void avx2_merge(const int *a, size_t na, const int *b,
+                                   size_t nb, int *out,
+                                   SortCounters *counters) {
+    size_t ia = AVX2_LANES, ib = AVX2_LANES, io = AVX2_LANES;
+    int carry[AVX2_LANES];
+
+    if (na < AVX2_LANES || nb < AVX2_LANES) {
+        scalar_merge(a, na, b, nb, out, counters);
+        return;
+    }
+
+    __m256i lo = _mm256_loadu_si256((const __m256i *)a);
+    __m256i hi = _mm256_loadu_si256((const __m256i *)b);
+    avx2_merge_pair(&lo, &hi, counters);
+    _mm256_storeu_si256((__m256i *)out, lo);
+
+    while (ia + AVX2_LANES <= na && ib + AVX2_LANES <= nb) {
+        COUNT_COMPARISON(counters);
+        if (a[ia] <= b[ib]) {
+            lo = _mm256_loadu_si256((const __m256i *)(a + ia));
+            ia += AVX2_LANES;
+        } else {
+            lo = _mm256_loadu_si256((const __m256i *)(b + ib));
+            ib += AVX2_LANES;
+        }
+        avx2_merge_pair(&lo, &hi, counters);
+        _mm256_storeu_si256((__m256i *)(out + io), lo);
+        io += AVX2_LANES;
+    }
+    COUNT_MOVEMENTS(counters, io);
+
+    _mm256_storeu_si256((__m256i *)carry, hi);
+    finish_merge(carry, AVX2_LANES, a + ia, na - ia, b + ib, nb - ib,
+                 out + io, counters);
+}
+
+static const SimdKernels avx2_kernels = {
+    SIMD_AVX2, NETWORK_VECTORS * AVX2_LANES, avx2_sort_block, avx2_partition,
+    avx2_merge};
+
+/* ------------------------------------------------------------------------
+ * AVX-512: 16 inteiros por registrador
+ * ------------------------------------------------------------------------ */
+
+/**
+ * Troca cada elemento com o da posição i ^ j (j = 1, 2, 4 ou 8)
+ */
+static inline TARGET_AVX512 __m512i avx512_swap_lanes(__m512i v, int j) {
+    switch (j) {
+        case 1:
+            return _mm512_shuffle_epi32(v, (_MM_PERM_ENUM)0xB1);
+        case 2:
+            return _mm512_shuffle_epi32(v, (_MM_PERM_ENUM)0x4E);
+        case 4:
+            return _mm512_shuffle_i32x4(v, v, 0xB1);
+        default:
+            return _mm512_shuffle_i32x4(v, v, 0x4E);
+    }
+}
+
+/**
+ * Comparador-trocador entre as posições i e i ^ j do registrador: as
+ * posições de max_lanes ficam com o maior
+ */
+static inline TARGET_AVX512 __m512i avx512_exchange(__m512i v, int j,
+                                                    __mmask16 max_lanes,
+                                                    SortCounters *counters) {
+    __m512i swapped = avx512_swap_lanes(v, j);
+    COUNT_COMPARISONS(counters, AVX512_LANES / 2);
+    return _mm512_mask_max_epi32(_mm512_min_epi32(v, swapped), max_lanes, v,
+                                 swapped);
+}
+
+/**
+ * Intercala um registrador bitônico (últimos 4 níveis da rede bitônica)
+ */
+static inline TARGET_AVX512 __m512i avx512_merge_vector(
+    __m512i v, SortCounters *counters) {
+    v = avx512_exchange(v, 8, 0xFF00, counters);
+    v = avx512_exchange(v, 4, 0xF0F0, counters);
+    v = avx512_exchange(v, 2, 0xCCCC, counters);
+    return avx512_exchange(v, 1, 0xAAAA, counters);
+}
+
+/**
+ * Ordena um registrador com a rede bitônica completa (10 níveis)
+ */
+static inline TARGET_AVX512 __m512i avx512_sort_vector(
+    __m512i v, SortCounters *counters) {
+    v = avx512_exchange(v, 1, 0x6666, counters);
+    v = avx512_exchange(v, 2, 0x3C3C, counters);
+    v = avx512_exchange(v, 1, 0x5A5A, counters);
+    v = avx512_exchange(v, 4, 0x0FF0, counters);
+    v = avx512_exchange(v, 2, 0x33CC, counters);
+    v = avx512_exchange(v, 1, 0x55AA, counters);
+    return avx512_merge_vector(v, counters);
+}
+
+static inline TARGET_AVX512 __m512i avx512_reverse(__m512i v) {
+    return _mm512_permutexvar_epi32(
+        _mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+                         15),
+        v);
+}
+
+/**
+ * Intercala duas sequências ordenadas de m registradores cada, em v[0..m)
+ * e v[m..2m): inverte a segunda e aplica a rede de intercalação bitônica
+ */
+static TARGET_AVX512 void avx512_merge_vectors(__m512i *v, int m,
+                                               SortCounters *counters) {
+    int i, d;
+
+    for (i = 0; i < m / 2; i++) {
+        __m512i temp = v[m + i];
+        v[m + i] = v[2 * m - 1 - i];
+        v[2 * m - 1 - i] = temp;
+    }
+    for (i = m; i < 2 * m; i++) {
+        v[i] = avx512_reverse(v[i]);
+    }
+
+    // Meio-limpadores entre registradores (distâncias m, m/2, ..., 1)
+    for (d = m; d >= 1; d /= 2) {
+        for (i = 0; i < 2 * m; i++) {
+            if ((i & d) == 0) {
+                __m512i low = _mm512_min_epi32(v[i], v[i + d]);
+                v[i + d] = _mm512_max_epi32(v[i], v[i + d]);
+                v[i] = low;
+                COUNT_COMPARISONS(counters, AVX512_LANES);
+            }
+        }
+    }
+    for (i = 0; i < 2 * m; i++) {
+        v[i] = avx512_merge_vector(v[i], counters);
+    }
+}
+
+/**
+ * Ordena até 256 elementos nos registradores com a rede bitônica; o último
+ * registrador é completado com INT_MAX
+ */
+static TARGET_AVX512 void avx512_sort_block(int *arr, int n,
+                                            SortCounters *counters) {
+    __m512i v[NETWORK_VECTORS];
+    int count = (n + AVX512_LANES - 1) / AVX512_LANES;
+    int vectors = 1;
+    int i, m;
+
+    while (vectors < count) {
+        vectors *= 2;
+    }
+
+    for (i = 0; i < vectors; i++) {
+        int remaining = n - i * AVX512_LANES;
+        if (remaining >= AVX512_LANES) {
+            v[i] = _mm512_loadu_si512(arr + i * AVX512_LANES);
+        } else if (remaining > 0) {
+            v[i] = _mm512_mask_loadu_epi32(_mm512_set1_epi32(INT_MAX),
+                                           (__mmask16)((1u << remaining) - 1),
+                                           arr + i * AVX512_LANES);
+        } else {
+            v[i] = _mm512_set1_epi32(INT_MAX);
+        }
+        v[i] = avx512_sort_vector(v[i], counters);
+    }
+
+    for (m = 1; m < vectors; m *= 2) {
+        for (i = 0; i < vectors; i += 2 * m) {
+            avx512_merge_vectors(v + i, m, counters);
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        int remaining = n - i * AVX512_LANES;
+        if (remaining >= AVX512_LANES) {
+            _mm512_storeu_si512(arr + i * AVX512_LANES, v[i]);
+        } else {
+            _mm512_mask_storeu_epi32(arr + i * AVX512_LANES,
+                                     (__mmask16)((1u << remaining) - 1),
+                                     v[i]);
+        }
+    }
+    COUNT_MOVEMENTS(counters, n);
+}
+
+/**
+ * Particiona um registrador por compressão: os menores são compactados e
+ * escritos na janela esquerda, os demais terminam a janela direita. A
+ * compressão é feita no registrador (a versão com destino na memória é
+ * microcodificada em alguns processadores).
+ *
+ * @return Quantidade de elementos menores que o pivô
+ */
+static inline TARGET_AVX512 int avx512_partition_vector(
+    int *arr, ptrdiff_t l_store, ptrdiff_t r_store, __m512i curr,
+    __m512i pivot, SortCounters *counters) {
+    __mmask16 less = _mm512_cmplt_epi32_mask(curr, pivot);
+    int amount = __builtin_popcount((unsigned)less);
+    __mmask16 high_lanes = (__mmask16)((1u << (AVX512_LANES - amount)) - 1);
+
+    _mm512_storeu_si512(arr + l_store, _mm512_maskz_compress_epi32(less, curr));
+    _mm512_mask_storeu_epi32(
+        arr + r_store + amount, high_lanes,
+        _mm512_maskz_compress_epi32((__mmask16)~less, curr));
+    COUNT_COMPARISONS(counters, AVX512_LANES);
+    COUNT_MOVEMENTS(counters, AVX512_LANES);
+
+    return amount;
+}
+
+/**
+ * Partição vetorial no próprio array (mesmo esquema de avx2_partition)
+ */
+static TARGET_AVX512 ptrdiff_t avx512_partition(int *arr, ptrdiff_t n,
+                                                int pivot, int *smallest,
+                                                int *biggest,
+                                                SortCounters *counters) {
+    ptrdiff_t left = 0, right = n;
+    int lo = INT_MAX, hi = INT_MIN;
+    ptrdiff_t l_store, r_store;
+    int i;
+
+    // A sobra (n % 16) é particionada de forma escalar
+    for (i = n % AVX512_LANES; i > 0; i--) {
+        int value = arr[left];
+        lo = value < lo ? value : lo;
+        hi = value > hi ? value : hi;
+        COUNT_COMPARISON(counters);
+        if (value >= pivot) {
+            arr[left] = arr[--right];
+            arr[right] = value;
+            COUNT_MOVEMENTS(counters, 2);
+        } else {
+            left++;
+        }
+    }
+
+    l_store = left;
+    if (left < right) {
+        __m512i pivot_vec = _mm512_set1_epi32(pivot);
+        __m512i first = _mm512_loadu_si512(arr + left);
+        __m512i min_vec = _mm512_min_epi32(_mm512_set1_epi32(lo), first);
+        __m512i max_vec = _mm512_max_epi32(_mm512_set1_epi32(hi), first);
+
+        if (right - left == AVX512_LANES) {
+            l_store += avx512_partition_vector(arr, left, left, first,
+                                               pivot_vec, counters);
+        } else {
+            __m512i last = _mm512_loadu_si512(arr + right - AVX512_LANES);
+            min_vec = _mm512_min_epi32(min_vec, last);
+            max_vec = _mm512_max_epi32(max_vec, last);
+            r_store = right - AVX512_LANES;
+            left += AVX512_LANES;
+            right -= AVX512_LANES;
+
+            while (left < right) {
+                __m512i curr;
+                int amount;
+                if ((r_store + AVX512_LANES) - right < left - l_store) {
+                    right -= AVX512_LANES;
+                    curr = _mm512_loadu_si512(arr + right);
+                } else {
+                    curr = _mm512_loadu_si512(arr + left);
+                    left += AVX512_LANES;
+                }
+                min_vec = _mm512_min_epi32(min_vec, curr);
+                max_vec = _mm512_max_epi32(max_vec, curr);
+                amount = avx512_partition_vector(arr, l_store, r_store, curr,
+                                                 pivot_vec, counters);
+                l_store += amount;
+                r_store -= AVX512_LANES - amount;
+            }
+
+            // Os dois registradores guardados fecham as janelas livres
+            i = avx512_partition_vector(arr, l_store, r_store, first,
+                                        pivot_vec, counters);
+            l_store += i;
+            r_store -= AVX512_LANES - i;
+            l_store += avx512_partition_vector(arr, l_store, r_store, last,
+                                               pivot_vec, counters);
+        }
+        lo = _mm512_reduce_min_epi32(min_vec);
+        hi = _mm512_reduce_max_epi32(max_vec);
+    }
+
+    *smallest = lo;
+    *biggest = hi;
+    return l_store;
+}
+
+/**
+ * Intercala dois registradores ordenados: lo recebe os 16 menores e hi os
+ * 16 maiores
+ */
+static inline TARGET_AVX512 void avx512_merge_pair(__m512i *lo, __m512i *hi,
+                                                   SortCounters *counters) {
+    __m512i reversed = avx512_reverse(*hi);
+    __m512i low = _mm512_min_epi32(*lo, reversed);
+    __m512i high = _mm512_max_epi32(*lo, reversed);
+    COUNT_COMPARISONS(counters, AVX512_LANES);
+    *lo = avx512_merge_vector(low, counters);
+    *hi = avx512_merge_vector(high, counters);
+}
+
+/**
+ * Intercalação vetorial (mesmo esquema de avx2_merge)
+ */
+static TARGET_AVX512 void avx512_merge(const int *a, size_t na, const int *b,
+                                       size_t nb, int *out,
+                                       SortCounters *counters) {
+    size_t ia = AVX512_LANES, ib = AVX512_LANES, io = AVX512_LANES;
+    int carry[AVX512_LANES];
+
+    if (na < AVX512_LANES || nb < AVX512_LANES) {
+        scalar_merge(a, na, b, nb, out, counters);
+        return;
+    }
+
+    __m512i lo = _mm512_loadu_si512(a);
+    __m512i hi = _mm512_loadu_si512(b);
+    avx512_merge_pair(&lo, &hi, counters);
+    _mm512_storeu_si512(out, lo);
+
+    while (ia + AVX512_LANES <= na && ib + AVX512_LANES <= nb) {
+        COUNT_COMPARISON(counters);
+        if (a[ia] <= b[ib]) {
+            lo = _mm512_loadu_si512(a + ia);
+            ia += AVX512_LANES;
+        } else {
+            lo = _mm512_loadu_si512(b + ib);
+            ib += AVX512_LANES;
+        }
+        avx512_merge_pair(&lo, &hi, counters);
+        _mm512_storeu_si512(out + io, lo);
+        io += AVX512_LANES;
+    }
+    COUNT_MOVEMENTS(counters, io);
+
+    _mm512_storeu_si512(carry, hi);
+    finish_merge(carry, AVX512_LANES, a + ia, na - ia, b + ib, nb - ib,
+                 out + io, counters);
+}
+
+static const SimdKernels avx512_kernels = {
+    SIMD_AVX512, NETWORK_VECTORS * AVX512_LANES, avx512_sort_block,
+    avx512_partition, avx512_merge};
+
+#endif /* SIMD_X86 */
+
+/**
+ * Operações do conjunto de instruções ativo
+ */
+static const SimdKernels *active_kernels(void) {
+    switch (simd_active_level()) {
+#if SIMD_X86
+        case SIMD_AVX512:
+            return &avx512_kernels;
+        case SIMD_AVX2:
+            return &avx2_kernels;
+#endif
+        default:
+            return &scalar_kernels;
+    }
+}
+
+/* ------------------------------------------------------------------------
+ * Algoritmos (comuns aos conjuntos de instruções)
+ * ------------------------------------------------------------------------ */
+
+/**
+ * Pivô: mediana de amostras espaçadas uniformemente
+ */
+static int choose_pivot(const int *arr, ptrdiff_t n, SortCounters *counters) {
+    int samples[PIVOT_SAMPLES];
+    int i;
+
+    for (i = 0; i < PIVOT_SAMPLES; i++) {
+        samples[i] = arr[(long long)n * (2 * i + 1) / (2 * PIVOT_SAMPLES)];
+    }
+    scalar_sort_block(samples, PIVOT_SAMPLES, counters);
+    return samples[PIVOT_SAMPLES / 2];
+}
+
+/**
+ * QuickSort vetorizado: recursão no lado menor, laço no maior e IntroSort
+ * ao passar de 2·log2(n) níveis
+ */
+static void simd_quick_sort_range(const SimdKernels *kernels, int *arr,
+                                  ptrdiff_t n, int depth_limit,
+                                  SortCounters *counters) {
+    while (n > kernels->block) {
+        int smallest, biggest;
+
+        if (depth_limit-- == 0) {
+            fallback_sort(arr, (size_t)n, counters);
+            return;
+        }
+
+        int pivot = choose_pivot(arr, n, counters);
+        ptrdiff_t split = kernels->partition(arr, n, pivot, &smallest,
+                                             &biggest, counters);
+
+        if (smallest == biggest) {
+            return;  // Todos os elementos são iguais
+        }
+        if (pivot == smallest) {
+            // Nada é menor que o pivô: separa as cópias do mínimo
+            // (pivot < biggest, então pivot + 1 não transborda)
+            split = kernels->partition(arr, n, pivot + 1, &smallest,
+                                       &biggest, counters);
+            arr += split;
+            n -= split;
+            continue;
+        }
+        if (pivot == biggest) {
+            n = split;  // O lado direito só tem cópias do máximo
+            continue;
+        }
+
+        if (split < n - split) {
+            simd_quick_sort_range(kernels, arr, split, depth_limit, counters);
+            arr += split;
+            n -= split;
+        } else {
+            simd_quick_sort_range(kernels, arr + split, n - split,
+                                  depth_limit, counters);
+            n = split;
+        }
+    }
+
+    kernels->sort_block(arr, (int)n, counters);
+}
+
+/**
+ * QuickSort vetorizado
+ */
+SortResult SORT_KERNEL(simd_quick_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    const SimdKernels *kernels = active_kernels();
+    int depth_limit = 0;
+    size_t size;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    for (size = n; size > 1; size >>= 1) {
+        depth_limit += 2;
+    }
+    if (n > 1) {
+        simd_quick_sort_range(kernels, arr, (ptrdiff_t)n, depth_limit,
+                              &counters);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+    result.variant = simd_level_name(kernels->level);
+
+    return result;
+}
+
+/**
+ * MergeSort vetorizado
+ */
+SortResult SORT_KERNEL(simd_merge_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    const SimdKernels *kernels = active_kernels();
+    size_t block = (size_t)kernels->block;
+    size_t begin, width;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    for (begin = 0; begin < n; begin += block) {
+        kernels->sort_block(arr + begin,
+                            (int)(n - begin < block ? n - begin : block),
+                            &counters);
+    }
+
+    if (n > block) {
+        int *buffer = (int *)sort_scratch(SCRATCH_DATA, n * sizeof(int));
+        int *src = arr, *dst = buffer;
+
+        // Intercalação de baixo para cima, alternando entre arr e buffer
+        for (width = block; width < n; width *= 2) {
+            for (begin = 0; begin < n; begin += 2 * width) {
+                size_t mid = begin + width < n ? begin + width : n;
+                size_t end = mid + width < n ? mid + width : n;
+                kernels->merge(src + begin, mid - begin, src + mid, end - mid,
+                               dst + begin, &counters);
+            }
+            int *temp = src;
+            src = dst;
+            dst = temp;
+        }
+
+        if (src != arr) {
+            memcpy(arr, src, n * sizeof(int));
+            COUNT_MOVEMENTS(&counters, n);
+        }
+        sort_scratch_done(buffer);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+    result.variant = simd_level_name(kernels->level);
+
+    return result;
+}
+
+#if SORT_COUNTED
+
+/**
+ * Estado do despacho (compartilhado pelas duas variantes)
+ */
+int simd_avx2_permutations[256][AVX2_LANES];
+static SimdLevel requested_level = SIMD_AUTO;
+static SimdLevel detected_level = SIMD_SCALAR;
+static pthread_once_t detect_once = PTHREAD_ONCE_INIT;
+
+static const char *simd_level_names[] = {"scalar", "avx2", "avx512", "auto"};
+
+#if SIMD_X86
+
+/**
+ * Estados de registradores habilitados pelo sistema operacional (XCR0)
+ */
+static unsigned long long read_xcr0(void) {
+    unsigned int eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+}
+
+/**
+ * Consulta a CPUID: AVX2 exige o estado YMM salvo pelo sistema e AVX-512F
+ * também os estados de máscaras e ZMM
+ */
+static SimdLevel query_cpuid(void) {
+    unsigned int eax, ebx, ecx, edx;
+    SimdLevel level = SIMD_SCALAR;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & (1u << 27)) ||
+        !(ecx & (1u << 28))) {
+        return SIMD_SCALAR;  // Sem OSXSAVE ou sem AVX
+    }
+
+    unsigned long long xcr0 = read_xcr0();
+    if ((xcr0 & 0x6) != 0x6 ||
+        !__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return SIMD_SCALAR;
+    }
+
+    if (ebx & (1u << 5)) {
+        level = SIMD_AVX2;
+    }
+    if ((ebx & (1u << 16)) && (xcr0 & 0xE6) == 0xE6) {
+        level = SIMD_AVX512;
+    }
+    return level;
+}
+
+#endif /* SIMD_X86 */
+
+/**
+ * Detecção e tabela de permutações, feitas uma única vez
+ */
+static void simd_initialize(void) {
+    int mask, lane;
+
+    for (mask = 0; mask < 256; mask++) {
+        int count = 0;
+        for (lane = 0; lane < AVX2_LANES; lane++) {
+            if (mask & (1 << lane)) {
+                simd_avx2_permutations[mask][count++] = lane;
+            }
+        }
+        for (lane = 0; lane < AVX2_LANES; lane++) {
+            if (!(mask & (1 << lane))) {
+                simd_avx2_permutations[mask][count++] = lane;
+            }
+        }
+    }
+
+#if SIMD_X86
+    detected_level = query_cpuid();
+#endif
+}
+
+/**
+ * Detecta o melhor conjunto de instruções suportado
+ */
+SimdLevel simd_detect_level(void) {
+    pthread_once(&detect_once, simd_initialize);
+    return detected_level;
+}
+
+/**
+ * Define o conjunto de instruções dos algoritmos vetorizados
+ */
+void simd_set_level(SimdLevel level) {
+    requested_level = level;
+}
+
+/**
+ * Conjunto de instruções efetivamente usado
+ */
+SimdLevel simd_active_level(void) {
+    SimdLevel detected = simd_detect_level();
+
+    if (requested_level == SIMD_AUTO || requested_level > detected) {
+        return detected;
+    }
+    return requested_level;
+}
+
+/**
+ * Nome do nível
+ */
+const char *simd_level_name(SimdLevel level) {
+    if (level < SIMD_SCALAR || level > SIMD_AUTO) {
+        return "unknown";
+    }
+    return simd_level_names[level];
+}
+
+/**
+ * Procura um nível pelo nome
+ */
+int simd_level_from_name(const char *name, SimdLevel *level) {
+    int i;
+    for (i = SIMD_SCALAR; i <= SIMD_AUTO; i++) {
+        if (strcmp(name, simd_level_names[i]) == 0) {
+            *level = (SimdLevel)i;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#endif /* SORT_COUNTED */
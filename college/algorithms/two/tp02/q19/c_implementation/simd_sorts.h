@@ -0,0 +1,90 @@
+/**
+ * simd_sorts.h
+ * Algoritmos de ordenação vetorizados (AVX-512, AVX2 ou escalar, escolhido
+ * em tempo de execução pela CPUID)
+ */
+
+#ifndef SIMD_SORTS_H
+#define SIMD_SORTS_H
+
+#include "sorting_algorithms.h"
+
+/**
+ * Conjunto de instruções usado pelos algoritmos vetorizados
+ */
+typedef enum {
+    SIMD_SCALAR,  // Código escalar (sem vetorização)
+    SIMD_AVX2,    // Registradores de 256 bits (8 inteiros)
+    SIMD_AVX512,  // Registradores de 512 bits (16 inteiros, AVX-512F)
+    SIMD_AUTO     // O melhor suportado pelo processador
+} SimdLevel;
+
+/**
+ * Detecta o melhor conjunto de instruções suportado pelo processador e pelo
+ * sistema operacional (CPUID e XGETBV)
+ *
+ * @return Nível detectado (SIMD_SCALAR fora de x86-64)
+ */
+SimdLevel simd_detect_level(void);
+
+/**
+ * Define o conjunto de instruções dos algoritmos vetorizados; pedidos acima
+ * do suportado são limitados ao nível detectado
+ *
+ * @param level Nível pedido (SIMD_AUTO = detectar)
+ */
+void simd_set_level(SimdLevel level);
+
+/**
+ * Conjunto de instruções efetivamente usado pelos algoritmos vetorizados
+ *
+ * @return Nível ativo (nunca SIMD_AUTO)
+ */
+SimdLevel simd_active_level(void);
+
+/**
+ * Nome do nível ("scalar", "avx2", "avx512" ou "auto")
+ *
+ * @param level Nível
+ * @return Nome
+ */
+const char *simd_level_name(SimdLevel level);
+
+/**
+ * Procura um nível pelo nome
+ *
+ * @param name Nome do nível
+ * @param level Saída com o nível encontrado
+ * @return 1 se encontrado, 0 caso contrário
+ */
+int simd_level_from_name(const char *name, SimdLevel *level);
+
+/**
+ * QuickSort vetorizado: partição por compressão (AVX-512) ou por tabela de
+ * permutações (AVX2) e redes de ordenação bitônicas nos blocos de até 256
+ * elementos (128 no AVX2)
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult simd_quick_sort(int *arr, size_t n);
+
+/**
+ * MergeSort vetorizado: blocos ordenados pelas redes bitônicas e
+ * intercalação de baixo para cima com a rede de intercalação bitônica de
+ * dois registradores
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult simd_merge_sort(int *arr, size_t n);
+
+/**
+ * Variantes sem instrumentação
+ */
+SortResult simd_quick_sort_fast(int *arr, size_t n);
+SortResult simd_merge_sort_fast(int *arr, size_t n);
+
+#endif /* SIMD_SORTS_H */
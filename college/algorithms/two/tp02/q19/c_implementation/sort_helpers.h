@@ -0,0 +1,121 @@
+/**
+ * sort_helpers.h
+ * Rotinas auxiliares instrumentadas compartilhadas pelos algoritmos de
+ * ordenação, seleção e pelas referências (comparação, troca, mediana de
+ * três, inserção e HeapSort em um intervalo)
+ *
+ * São static inline para que cada arquivo as compile com a sua própria
+ * variante de sort_instrumentation.h (contada, limpa ou do adversário):
+ * SORT_LESS e os contadores são expandidos no arquivo que as inclui.
+ */
+
+#ifndef SORT_HELPERS_H
+#define SORT_HELPERS_H
+
+#include <stddef.h>
+
+#include "sort_instrumentation.h"
+
+/**
+ * Compara dois valores contando a comparação
+ */
+static inline int less_than(int a, int b, SortCounters *counters) {
+    COUNT_COMPARISON(counters);
+    return SORT_LESS(a, b);
+}
+
+/**
+ * Troca dois elementos contando uma movimentação
+ */
+static inline void swap_elements(int *arr, ptrdiff_t a, ptrdiff_t b,
+                                 SortCounters *counters) {
+    int temp = arr[a];
+    arr[a] = arr[b];
+    arr[b] = temp;
+    COUNT_MOVEMENT(counters);
+}
+
+/**
+ * Índice da mediana entre arr[a], arr[b] e arr[c]
+ */
+static inline ptrdiff_t median_of_three(int *arr, ptrdiff_t a, ptrdiff_t b,
+                                        ptrdiff_t c, SortCounters *counters) {
+    if (less_than(arr[a], arr[b], counters)) {
+        if (less_than(arr[b], arr[c], counters)) {
+            return b;
+        }
+        return less_than(arr[a], arr[c], counters) ? c : a;
+    }
+    if (less_than(arr[a], arr[c], counters)) {
+        return a;
+    }
+    return less_than(arr[b], arr[c], counters) ? c : b;
+}
+
+/**
+ * Ordenação por inserção no intervalo [low, high]
+ */
+static inline void insertion_sort_range(int *arr, ptrdiff_t low,
+                                        ptrdiff_t high,
+                                        SortCounters *counters) {
+    ptrdiff_t i, j;
+    for (i = low + 1; i <= high; i++) {
+        int key = arr[i];
+        j = i - 1;
+
+        while (j >= low && less_than(key, arr[j], counters)) {
+            arr[j + 1] = arr[j];
+            COUNT_MOVEMENT(counters);
+            j--;
+        }
+
+        if (j + 1 != i) {
+            arr[j + 1] = key;
+            COUNT_MOVEMENT(counters);
+        }
+    }
+}
+
+/**
+ * Desce o elemento root no heap máximo arr[base .. base + size - 1]
+ */
+static inline void sift_down(int *arr, ptrdiff_t base, ptrdiff_t root,
+                             ptrdiff_t size, SortCounters *counters) {
+    int value = arr[base + root];
+
+    while (2 * root + 1 < size) {
+        ptrdiff_t child = 2 * root + 1;
+        if (child + 1 < size &&
+            less_than(arr[base + child], arr[base + child + 1], counters)) {
+            child++;
+        }
+        if (!less_than(value, arr[base + child], counters)) {
+            break;
+        }
+        arr[base + root] = arr[base + child];
+        COUNT_MOVEMENT(counters);
+        root = child;
+    }
+
+    arr[base + root] = value;
+}
+
+/**
+ * HeapSort no intervalo [low, high] (recurso quando a profundidade da
+ * recursão se esgota)
+ */
+static inline void heap_sort_range(int *arr, ptrdiff_t low, ptrdiff_t high,
+                                   SortCounters *counters) {
+    ptrdiff_t size = high - low + 1;
+    ptrdiff_t i;
+
+    for (i = size / 2 - 1; i >= 0; i--) {
+        sift_down(arr, low, i, size, counters);
+    }
+    for (i = size - 1; i > 0; i--) {
+        swap_elements(arr, low, low + i, counters);
+        sift_down(arr, low, 0, i, counters);
+    }
+}
+
+#endif /* SORT_HELPERS_H */
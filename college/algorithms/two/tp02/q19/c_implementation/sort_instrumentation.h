@@ -0,0 +1,90 @@
+/**
+ * sort_instrumentation.h
+ * Política de instrumentação dos algoritmos de ordenação
+ *
+ * sorting_algorithms.c é compilado duas vezes a partir do mesmo código:
+ * com SORT_COUNTED=1 (variante instrumentada, nomes públicos originais, conta
+ * comparações e movimentações) e com SORT_COUNTED=0 (variante limpa, sufixo
+ * _fast, usada para medir o tempo). Os contadores ficam em uma estrutura por
+ * chamada, então as duas variantes são reentrantes.
+ *
+ * Os arquivos com alvos do antiqsort são compilados uma terceira vez com
+ * SORT_ADVERSARY=1 (e SORT_COUNTED=0, fora do registro): sufixo _adversary,
+ * contadores ligados e SORT_LESS desviado para o adversário de McIlroy, que
+ * recebe identidades dos elementos em vez de chaves (antiqsort.h).
+ */
+
+#ifndef SORT_INSTRUMENTATION_H
+#define SORT_INSTRUMENTATION_H
+
+#ifndef SORT_COUNTED
+#define SORT_COUNTED 1
+#endif
+
+#ifndef SORT_ADVERSARY
+#define SORT_ADVERSARY 0
+#endif
+
+/**
+ * Contadores de uma chamada de ordenação
+ */
+typedef struct {
+    unsigned long long comparisons;  // Número de comparações
+    unsigned long long movements;    // Número de movimentações
+} SortCounters;
+
+#if SORT_COUNTED || SORT_ADVERSARY
+
+#if SORT_ADVERSARY
+// Nome da função na variante atacada pelo adversário
+#define SORT_KERNEL(name) name##_adversary
+
+// Comparação respondida pelo adversário (a e b são identidades)
+int antiqsort_less(int a, int b);
+#define SORT_LESS(a, b) antiqsort_less((a), (b))
+#else
+// Nome da função na variante instrumentada
+#define SORT_KERNEL(name) name
+
+// Comparação de chaves
+#define SORT_LESS(a, b) ((a) < (b))
+#endif
+
+#define COUNT_COMPARISON(c) ((c)->comparisons++)
+#define COUNT_COMPARISONS(c, k) ((c)->comparisons += (k))
+#define COUNT_MOVEMENT(c) ((c)->movements++)
+#define COUNT_MOVEMENTS(c, k) ((c)->movements += (k))
+
+// Soma contadores de uma tarefa aos da chamada (algoritmos paralelos)
+#define COUNT_MERGE_ATOMIC(total, c)                                       \
+    do {                                                                   \
+        __atomic_add_fetch(&(total)->comparisons, (c)->comparisons,        \
+                           __ATOMIC_RELAXED);                              \
+        __atomic_add_fetch(&(total)->movements, (c)->movements,            \
+                           __ATOMIC_RELAXED);                              \
+    } while (0)
+
+// Copia os contadores da chamada para o resultado
+#define SORT_STORE_COUNTERS(result, c)       \
+    do {                                         \
+        (result).comparisons = (c)->comparisons; \
+        (result).movements = (c)->movements;     \
+    } while (0)
+
+#else
+
+// Nome da função na variante limpa
+#define SORT_KERNEL(name) name##_fast
+#define SORT_LESS(a, b) ((a) < (b))
+
+// Sem efeito: o compilador elimina os contadores por completo
+#define COUNT_COMPARISON(c) ((void)(c))
+#define COUNT_COMPARISONS(c, k) ((void)(c), (void)(k))
+#define COUNT_MOVEMENT(c) ((void)(c))
+#define COUNT_MOVEMENTS(c, k) ((void)(c), (void)(k))
+#define COUNT_MERGE_ATOMIC(total, c) ((void)(total), (void)(c))
+#define SORT_STORE_COUNTERS(result, c) ((void)(c))
+
+#endif /* SORT_COUNTED || SORT_ADVERSARY */
+
+#endif /* SORT_INSTRUMENTATION_H */
@@ -1,200 +1,1371 @@
-/**
- * sorting_algorithms.c
- * Implementação de algoritmos de ordenação com contadores de comparações e
- * movimentações
- */
-
-#include "sorting_algorithms.h"
-
-#include <stdio.h>
-#include <string.h>
-#include <time.h>
-
-/**
- * Selection Sort (Ordenação por Seleção)
- */
-SortResult selection_sort(int *arr, int n) {
-    SortResult result = {0, 0, 0.0};
-    int i, j, min_idx;
-
-    // Medir tempo de início
-    clock_t start_time = clock();
-
-    // Algoritmo Selection Sort
-    for (i = 0; i < n - 1; i++) {
-        min_idx = i;
-        for (j = i + 1; j < n; j++) {
-            result.comparisons++;
-            if (arr[j] < arr[min_idx]) {
-                min_idx = j;
-            }
-        }
-
-        // Trocar o elemento mínimo com o primeiro elemento não ordenado
-        if (min_idx != i) {
-            int temp = arr[i];
-            arr[i] = arr[min_idx];
-            arr[min_idx] = temp;
-            result.movements++;
-        }
-    }
-
-    // Calcular tempo de execução em segundos
-    result.execution_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
-
-    return result;
-}
-
-/**
- * Insertion Sort (Ordenação por Inserção)
- */
-SortResult insertion_sort(int *arr, int n) {
-    SortResult result = {0, 0, 0.0};
-    int i, j, key;
-
-    // Medir tempo de início
-    clock_t start_time = clock();
-
-    // Algoritmo Insertion Sort
-    for (i = 1; i < n; i++) {
-        key = arr[i];
-        j = i - 1;
-
-        // Cada verificação de condição conta como uma comparação
-        result.comparisons++;
-
-        // Mover elementos maiores que key para uma posição à frente
-        while (j >= 0 && arr[j] > key) {
-            arr[j + 1] = arr[j];
-            result.movements++;
-            j--;
-
-            // Se não chegamos ao fim do array, temos outra comparação
-            if (j >= 0) {
-                result.comparisons++;
-            }
-        }
-
-        if (j + 1 != i) {
-            arr[j + 1] = key;
-            result.movements++;
-        }
-    }
-
-    // Calcular tempo de execução em segundos
-    result.execution_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
-
-    return result;
-}
-
-/**
- * Bubble Sort (Ordenação por Bolha)
- */
-SortResult bubble_sort(int *arr, int n) {
-    SortResult result = {0, 0, 0.0};
-    int i, j;
-    int swapped;
-
-    // Medir tempo de início
-    clock_t start_time = clock();
-
-    // Algoritmo Bubble Sort
-    for (i = 0; i < n; i++) {
-        swapped = 0;
-
-        for (j = 0; j < n - i - 1; j++) {
-            result.comparisons++;
-            if (arr[j] > arr[j + 1]) {
-                // Trocar os elementos
-                int temp = arr[j];
-                arr[j] = arr[j + 1];
-                arr[j + 1] = temp;
-                result.movements++;
-                swapped = 1;
-            }
-        }
-
-        // Se nenhuma troca foi feita nesta passagem, o array já está ordenado
-        if (swapped == 0) {
-            break;
-        }
-    }
-
-    // Calcular tempo de execução em segundos
-    result.execution_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
-
-    return result;
-}
-
-// Funções auxiliares para o QuickSort
-static unsigned long long quick_sort_comparisons = 0;
-static unsigned long long quick_sort_movements = 0;
-
-/**
- * Função para particionar o array (QuickSort)
- */
-static int partition(int *arr, int low, int high) {
-    int pivot = arr[high];
-    int i = low - 1;
-    int j;
-
-    for (j = low; j < high; j++) {
-        quick_sort_comparisons++;
-        if (arr[j] <= pivot) {
-            i++;
-            // Trocar arr[i] e arr[j]
-            int temp = arr[i];
-            arr[i] = arr[j];
-            arr[j] = temp;
-            quick_sort_movements++;
-        }
-    }
-
-    // Trocar arr[i+1] e arr[high] (pivô)
-    int temp = arr[i + 1];
-    arr[i + 1] = arr[high];
-    arr[high] = temp;
-    quick_sort_movements++;
-
-    return i + 1;
-}
-
-/**
- * Função recursiva do QuickSort
- */
-static void quicksort_recursive(int *arr, int low, int high) {
-    if (low < high) {
-        // Particionar o array
-        int pivot_idx = partition(arr, low, high);
-
-        // Ordenar elementos antes e depois da partição
-        quicksort_recursive(arr, low, pivot_idx - 1);
-        quicksort_recursive(arr, pivot_idx + 1, high);
-    }
-}
-
-/**
- * Quick Sort (Ordenação Rápida)
- */
-SortResult quick_sort(int *arr, int n) {
-    SortResult result = {0, 0, 0.0};
-
-    // Reiniciar contadores globais
-    quick_sort_comparisons = 0;
-    quick_sort_movements = 0;
-
-    // Medir tempo de início
-    clock_t start_time = clock();
-
-    // Algoritmo QuickSort
-    quicksort_recursive(arr, 0, n - 1);
-
-    // Calcular tempo de execução em segundos
-    result.execution_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
-
-    // Copiar contadores globais para o resultado
-    result.comparisons = quick_sort_comparisons;
-    result.movements = quick_sort_movements;
-
-    return result;
-}
\ No newline at end of file
+/**
+ * sorting_algorithms.c
+ * Implementação de algoritmos de ordenação com contadores de comparações e
+ * movimentações
+ *
+ * Compilado duas vezes (ver sort_instrumentation.h): SORT_COUNTED=1 gera as
+ * funções instrumentadas e o registro; SORT_COUNTED=0 gera as variantes _fast.
+ * Uma terceira compilação com SORT_ADVERSARY=1 gera os alvos do antiqsort.
+ */
+
+#include "sorting_algorithms.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "baseline_sorts.h"
+#include "benchmark.h"
+#include "large_memory.h"
+#include "parallel_sorts.h"
+#include "radix_sorts.h"
+#include "simd_sorts.h"
+#include "sort_helpers.h"
+#include "sort_instrumentation.h"
+
+/**
+ * Selection Sort (Ordenação por Seleção)
+ */
+SortResult SORT_KERNEL(selection_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    size_t i, j, min_idx;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    // Algoritmo Selection Sort
+    for (i = 0; i + 1 < n; i++) {
+        min_idx = i;
+        for (j = i + 1; j < n; j++) {
+            COUNT_COMPARISON(&counters);
+            if (arr[j] < arr[min_idx]) {
+                min_idx = j;
+            }
+        }
+
+        // Trocar o elemento mínimo com o primeiro elemento não ordenado
+        if (min_idx != i) {
+            int temp = arr[i];
+            arr[i] = arr[min_idx];
+            arr[min_idx] = temp;
+            COUNT_MOVEMENT(&counters);
+        }
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Insertion Sort (Ordenação por Inserção)
+ */
+SortResult SORT_KERNEL(insertion_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    size_t i, j;
+    int key;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    // Algoritmo Insertion Sort (j é a posição livre, sem índices negativos)
+    for (i = 1; i < n; i++) {
+        key = arr[i];
+        j = i;
+
+        // Cada verificação de condição conta como uma comparação
+        COUNT_COMPARISON(&counters);
+
+        // Mover elementos maiores que key para uma posição à frente
+        while (j > 0 && arr[j - 1] > key) {
+            arr[j] = arr[j - 1];
+            COUNT_MOVEMENT(&counters);
+            j--;
+
+            // Se não chegamos ao fim do array, temos outra comparação
+            if (j > 0) {
+                COUNT_COMPARISON(&counters);
+            }
+        }
+
+        if (j != i) {
+            arr[j] = key;
+            COUNT_MOVEMENT(&counters);
+        }
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Bubble Sort (Ordenação por Bolha)
+ */
+SortResult SORT_KERNEL(bubble_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    size_t i, j;
+    int swapped;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    // Algoritmo Bubble Sort
+    for (i = 0; i < n; i++) {
+        swapped = 0;
+
+        for (j = 0; j + 1 < n - i; j++) {
+            COUNT_COMPARISON(&counters);
+            if (arr[j] > arr[j + 1]) {
+                // Trocar os elementos
+                int temp = arr[j];
+                arr[j] = arr[j + 1];
+                arr[j + 1] = temp;
+                COUNT_MOVEMENT(&counters);
+                swapped = 1;
+            }
+        }
+
+        // Se nenhuma troca foi feita nesta passagem, o array já está ordenado
+        if (swapped == 0) {
+            break;
+        }
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Função para particionar o array (QuickSort)
+ */
+static ptrdiff_t partition(int *arr, ptrdiff_t low, ptrdiff_t high,
+                           SortCounters *counters) {
+    int pivot = arr[high];
+    ptrdiff_t i = low - 1;
+    ptrdiff_t j;
+
+    for (j = low; j < high; j++) {
+        COUNT_COMPARISON(counters);
+        if (!SORT_LESS(pivot, arr[j])) {
+            i++;
+            // Trocar arr[i] e arr[j]
+            int temp = arr[i];
+            arr[i] = arr[j];
+            arr[j] = temp;
+            COUNT_MOVEMENT(counters);
+        }
+    }
+
+    // Trocar arr[i+1] e arr[high] (pivô)
+    int temp = arr[i + 1];
+    arr[i + 1] = arr[high];
+    arr[high] = temp;
+    COUNT_MOVEMENT(counters);
+
+    return i + 1;
+}
+
+/**
+ * Função recursiva do QuickSort: recursão só no lado menor e laço no maior,
+ * de modo que a pilha fica em O(log n) mesmo quando o pivô arr[high] leva a
+ * partições degeneradas (entradas ordenadas ou todas iguais), cujo tempo
+ * quadrático continua aparecendo nas medições
+ */
+static void quicksort_recursive(int *arr, ptrdiff_t low, ptrdiff_t high,
+                                SortCounters *counters) {
+    while (low < high) {
+        // Particionar o array
+        ptrdiff_t pivot_idx = partition(arr, low, high, counters);
+
+        // Ordenar o lado menor por recursão e continuar no maior
+        if (pivot_idx - low < high - pivot_idx) {
+            quicksort_recursive(arr, low, pivot_idx - 1, counters);
+            low = pivot_idx + 1;
+        } else {
+            quicksort_recursive(arr, pivot_idx + 1, high, counters);
+            high = pivot_idx - 1;
+        }
+    }
+}
+
+/**
+ * Quick Sort (Ordenação Rápida)
+ */
+SortResult SORT_KERNEL(quick_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    // Algoritmo QuickSort
+    quicksort_recursive(arr, 0, (ptrdiff_t)n - 1, &counters);
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+
+    // Copiar os contadores da chamada para o resultado
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Parâmetros do IntroSort
+ */
+#define INTRO_SORT_INSERTION_CUTOFF 24    // Abaixo disso, ordenação por inserção
+#define INTRO_SORT_NINTHER_THRESHOLD 128  // A partir disso, pivô pelo ninther
+
+/**
+ * Escolhe o pivô: mediana de três ou, em partições grandes, o ninther de
+ * Tukey (mediana das medianas de três trios espalhados pela partição)
+ */
+static ptrdiff_t choose_pivot(int *arr, ptrdiff_t low, ptrdiff_t high,
+                              SortCounters *counters) {
+    ptrdiff_t n = high - low + 1;
+    ptrdiff_t mid = low + n / 2;
+
+    if (n < INTRO_SORT_NINTHER_THRESHOLD) {
+        return median_of_three(arr, low, mid, high, counters);
+    }
+
+    ptrdiff_t step = n / 8;
+    ptrdiff_t m1 =
+        median_of_three(arr, low, low + step, low + 2 * step, counters);
+    ptrdiff_t m2 = median_of_three(arr, mid - step, mid, mid + step, counters);
+    ptrdiff_t m3 =
+        median_of_three(arr, high - 2 * step, high - step, high, counters);
+    return median_of_three(arr, m1, m2, m3, counters);
+}
+
+/**
+ * Partição em três vias de Bentley-McIlroy com pivô em arr[low]
+ *
+ * Ao final, arr[low .. *lt_end] < pivô, arr[*lt_end + 1 .. *gt_begin - 1]
+ * == pivô e arr[*gt_begin .. high] > pivô.
+ */
+static void partition_three_way(int *arr, ptrdiff_t low, ptrdiff_t high,
+                                ptrdiff_t *lt_end, ptrdiff_t *gt_begin,
+                                SortCounters *counters) {
+    int pivot = arr[low];
+    ptrdiff_t i = low, j = high + 1;
+    ptrdiff_t p = low, q = high + 1;
+    ptrdiff_t k;
+
+    for (;;) {
+        while (less_than(arr[++i], pivot, counters)) {
+            if (i == high) {
+                break;
+            }
+        }
+        while (less_than(pivot, arr[--j], counters)) {
+            if (j == low) {
+                break;
+            }
+        }
+
+        // Os índices se cruzaram sobre um elemento igual ao pivô
+        if (i == j && !less_than(arr[i], pivot, counters)) {
+            swap_elements(arr, ++p, i, counters);
+        }
+        if (i >= j) {
+            break;
+        }
+
+        swap_elements(arr, i, j, counters);
+
+        // Guardar os iguais ao pivô nas extremidades
+        if (!less_than(arr[i], pivot, counters)) {
+            swap_elements(arr, ++p, i, counters);
+        }
+        if (!less_than(pivot, arr[j], counters)) {
+            swap_elements(arr, --q, j, counters);
+        }
+    }
+
+    // Trazer os iguais das extremidades para o meio
+    i = j + 1;
+    for (k = low; k <= p; k++) {
+        swap_elements(arr, k, j--, counters);
+    }
+    for (k = high; k >= q; k--) {
+        swap_elements(arr, k, i++, counters);
+    }
+
+    *lt_end = j;
+    *gt_begin = i;
+}
+
+/**
+ * Laço principal do IntroSort: recursão apenas no lado menor, iteração no
+ * maior, e HeapSort quando a profundidade esgota
+ */
+static void introsort_loop(int *arr, ptrdiff_t low, ptrdiff_t high,
+                           int depth_limit, SortCounters *counters) {
+    while (high - low + 1 > INTRO_SORT_INSERTION_CUTOFF) {
+        if (depth_limit == 0) {
+            heap_sort_range(arr, low, high, counters);
+            return;
+        }
+        depth_limit--;
+
+        ptrdiff_t pivot_idx = choose_pivot(arr, low, high, counters);
+        swap_elements(arr, low, pivot_idx, counters);
+
+        ptrdiff_t lt_end, gt_begin;
+        partition_three_way(arr, low, high, &lt_end, &gt_begin, counters);
+
+        if (lt_end - low < high - gt_begin) {
+            introsort_loop(arr, low, lt_end, depth_limit, counters);
+            low = gt_begin;
+        } else {
+            introsort_loop(arr, gt_begin, high, depth_limit, counters);
+            high = lt_end;
+        }
+    }
+
+    insertion_sort_range(arr, low, high, counters);
+}
+
+/**
+ * IntroSort
+ */
+SortResult SORT_KERNEL(intro_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    // Limite de profundidade: 2 * floor(log2(n))
+    int depth_limit = 0;
+    size_t m;
+    for (m = n; m > 1; m >>= 1) {
+        depth_limit += 2;
+    }
+
+    if (n > 1) {
+        introsort_loop(arr, 0, (ptrdiff_t)n - 1, depth_limit, &counters);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Parâmetros do BlockQuickSort
+ */
+#define BLOCK_QUICK_SORT_BLOCK 64  // Elementos por bloco (offsets de 1 byte)
+
+/**
+ * Partição em blocos de Edelkamp e Weiss (BlockQuickSort) com pivô em
+ * arr[low]
+ *
+ * Cada lado classifica um bloco de BLOCK_QUICK_SORT_BLOCK elementos sem
+ * desvios condicionais: o offset é sempre gravado e o contador só avança se
+ * o elemento estiver do lado errado. As trocas são feitas depois, em lote,
+ * entre os offsets dos dois lados. O resto (menos de três blocos) é
+ * particionado da forma tradicional.
+ *
+ * @return Posição final do pivô: arr[low .. p) < pivô <= arr(p .. high]
+ */
+static ptrdiff_t block_partition(int *arr, ptrdiff_t low, ptrdiff_t high,
+                                 SortCounters *counters) {
+    unsigned char offsets_l[BLOCK_QUICK_SORT_BLOCK];
+    unsigned char offsets_r[BLOCK_QUICK_SORT_BLOCK];
+    int pivot = arr[low];
+    ptrdiff_t first = low + 1, last = high + 1;
+    int num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+    int i;
+
+    // Invariante: arr[low + 1 .. first) < pivô <= arr[last .. high]
+    while (last - first > 2 * BLOCK_QUICK_SORT_BLOCK) {
+        if (num_l == 0) {
+            start_l = 0;
+            for (i = 0; i < BLOCK_QUICK_SORT_BLOCK; i++) {
+                offsets_l[num_l] = (unsigned char)i;
+                num_l += !SORT_LESS(arr[first + i], pivot);
+            }
+            COUNT_COMPARISONS(counters, BLOCK_QUICK_SORT_BLOCK);
+        }
+        if (num_r == 0) {
+            start_r = 0;
+            for (i = 0; i < BLOCK_QUICK_SORT_BLOCK; i++) {
+                offsets_r[num_r] = (unsigned char)i;
+                num_r += SORT_LESS(arr[last - 1 - i], pivot);
+            }
+            COUNT_COMPARISONS(counters, BLOCK_QUICK_SORT_BLOCK);
+        }
+
+        // Trocas em lote entre os elementos fora do lugar dos dois blocos
+        int num = num_l < num_r ? num_l : num_r;
+        for (i = 0; i < num; i++) {
+            ptrdiff_t a = first + offsets_l[start_l + i];
+            ptrdiff_t b = last - 1 - offsets_r[start_r + i];
+            int temp = arr[a];
+            arr[a] = arr[b];
+            arr[b] = temp;
+        }
+        COUNT_MOVEMENTS(counters, num);
+
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0) {
+            first += BLOCK_QUICK_SORT_BLOCK;
+        }
+        if (num_r == 0) {
+            last -= BLOCK_QUICK_SORT_BLOCK;
+        }
+    }
+
+    // Resto: offsets pendentes são descartados, pois o bloco incompleto
+    // continua em [first, last) e é reclassificado aqui
+    ptrdiff_t j = last - 1;
+    for (;;) {
+        while (first <= j && less_than(arr[first], pivot, counters)) {
+            first++;
+        }
+        while (first <= j && !less_than(arr[j], pivot, counters)) {
+            j--;
+        }
+        if (first >= j) {
+            break;
+        }
+        swap_elements(arr, first, j, counters);
+        first++;
+        j--;
+    }
+
+    swap_elements(arr, low, first - 1, counters);
+    return first - 1;
+}
+
+/**
+ * Separa os iguais ao pivô arr[low], quando ele também é o menor elemento
+ * do trecho (igual ao elemento anterior ao trecho)
+ *
+ * @return Início dos elementos maiores que o pivô
+ */
+static ptrdiff_t partition_equal(int *arr, ptrdiff_t low, ptrdiff_t high,
+                                 SortCounters *counters) {
+    int pivot = arr[low];
+    ptrdiff_t i = low + 1;
+    ptrdiff_t j;
+
+    for (j = low + 1; j <= high; j++) {
+        if (!less_than(pivot, arr[j], counters)) {
+            if (i != j) {
+                swap_elements(arr, i, j, counters);
+            }
+            i++;
+        }
+    }
+    return i;
+}
+
+/**
+ * Laço principal do BlockQuickSort: mesmo controle do IntroSort (recursão
+ * no lado menor, inserção abaixo do corte, HeapSort ao esgotar a
+ * profundidade)
+ *
+ * @param leftmost 1 se não há elemento antes de arr[low] no array
+ */
+static void block_quicksort_loop(int *arr, ptrdiff_t low, ptrdiff_t high,
+                                 int depth_limit, int leftmost,
+                                 SortCounters *counters) {
+    while (high - low + 1 > INTRO_SORT_INSERTION_CUTOFF) {
+        if (depth_limit == 0) {
+            heap_sort_range(arr, low, high, counters);
+            return;
+        }
+        depth_limit--;
+
+        ptrdiff_t pivot_idx = choose_pivot(arr, low, high, counters);
+        swap_elements(arr, low, pivot_idx, counters);
+
+        // Todo elemento antes do trecho é <= a todos os do trecho; se o
+        // anterior não é menor que o pivô, o pivô é o mínimo e repetido
+        if (!leftmost && !less_than(arr[low - 1], arr[low], counters)) {
+            low = partition_equal(arr, low, high, counters);
+            continue;
+        }
+
+        ptrdiff_t p = block_partition(arr, low, high, counters);
+        if (p - low < high - p) {
+            block_quicksort_loop(arr, low, p - 1, depth_limit, leftmost,
+                                 counters);
+            low = p + 1;
+            leftmost = 0;
+        } else {
+            block_quicksort_loop(arr, p + 1, high, depth_limit, 0, counters);
+            high = p - 1;
+        }
+    }
+
+    insertion_sort_range(arr, low, high, counters);
+}
+
+/**
+ * BlockQuickSort
+ */
+SortResult SORT_KERNEL(block_quick_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    // Limite de profundidade: 2 * floor(log2(n))
+    int depth_limit = 0;
+    size_t m;
+    for (m = n; m > 1; m >>= 1) {
+        depth_limit += 2;
+    }
+
+    if (n > 1) {
+        block_quicksort_loop(arr, 0, (ptrdiff_t)n - 1, depth_limit, 1,
+                             &counters);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Parâmetros do PowerSort
+ */
+#define POWER_SORT_MIN_GALLOP 7  // Vitórias seguidas para entrar no galope
+#define POWER_SORT_MAX_STACK 96  // Pilha de corridas (altura <= log2(n) + 1)
+
+/**
+ * Corrida pendente na pilha do PowerSort
+ */
+typedef struct {
+    size_t base;  // Início da corrida
+    size_t len;   // Tamanho da corrida
+    int power;    // Potência da fronteira com a corrida seguinte
+} PowerRun;
+
+/**
+ * Estado das intercalações do PowerSort
+ */
+typedef struct {
+    int *temp;              // Cópia da menor corrida da intercalação
+    size_t min_gallop;      // Limiar adaptativo do modo galope
+    SortCounters *counters;
+} PowerMerge;
+
+/**
+ * Inverte arr[low .. high)
+ */
+static void reverse_range(int *arr, size_t low, size_t high,
+                          SortCounters *counters) {
+    while (low + 1 < high) {
+        high--;
+        swap_elements(arr, (ptrdiff_t)low, (ptrdiff_t)high, counters);
+        low++;
+    }
+}
+
+/**
+ * Tamanho da corrida que começa em arr[low] (não decrescente, ou
+ * estritamente decrescente, que é invertida para manter a estabilidade)
+ */
+static size_t count_run(int *arr, size_t low, size_t high,
+                        SortCounters *counters) {
+    size_t end = low + 1;
+
+    if (end < high && less_than(arr[end], arr[low], counters)) {
+        while (end + 1 < high && less_than(arr[end + 1], arr[end], counters)) {
+            end++;
+        }
+        end++;
+        reverse_range(arr, low, end, counters);
+    } else {
+        while (end < high && !less_than(arr[end], arr[end - 1], counters)) {
+            end++;
+        }
+    }
+    return end - low;
+}
+
+/**
+ * Ordenação por inserção binária (estável) de arr[low .. high), com
+ * arr[low .. start) já ordenado
+ */
+static void binary_insertion_sort(int *arr, size_t low, size_t high,
+                                  size_t start, SortCounters *counters) {
+    size_t i;
+
+    for (i = start; i < high; i++) {
+        int key = arr[i];
+        size_t left = low, right = i;
+
+        // Primeira posição com valor maior que key (após os iguais)
+        while (left < right) {
+            size_t mid = left + (right - left) / 2;
+            if (less_than(key, arr[mid], counters)) {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+
+        if (left != i) {
+            memmove(arr + left + 1, arr + left, (i - left) * sizeof(int));
+            arr[left] = key;
+            COUNT_MOVEMENTS(counters, i - left + 1);
+        }
+    }
+}
+
+/**
+ * Menor tamanho de corrida: entre 32 e 64, tal que n / minrun fique igual
+ * ou um pouco abaixo de uma potência de 2
+ */
+static size_t power_sort_minrun(size_t n) {
+    size_t extra = 0;
+
+    while (n >= 64) {
+        extra |= n & 1;
+        n >>= 1;
+    }
+    return n + extra;
+}
+
+/**
+ * Potência da fronteira entre as corridas [s1, s1 + n1) e [s1 + n1,
+ * s1 + n1 + n2): profundidade do nó que as separa na árvore de intercalação
+ * quase ótima (primeiro bit em que os pontos médios das corridas, divididos
+ * por n, diferem)
+ */
+static int power_sort_node_power(size_t s1, size_t n1, size_t n2, size_t n) {
+    size_t a = 2 * s1 + n1;  // 2 x ponto médio da primeira corrida
+    size_t b = a + n1 + n2;  // 2 x ponto médio da segunda
+    int power = 0;
+
+    for (;;) {
+        power++;
+        if (a >= n) {
+            a -= n;
+            b -= n;
+        } else if (b >= n) {
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+/**
+ * Galope à esquerda: posição k em arr[0 .. n) tal que arr[k - 1] < key <=
+ * arr[k], buscando exponencialmente a partir de hint e depois em binário
+ */
+static size_t gallop_left(int key, const int *arr, size_t n, size_t hint,
+                          SortCounters *counters) {
+    size_t last = 0, offset = 1, max_offset;
+
+    if (less_than(arr[hint], key, counters)) {
+        // arr[hint] < key: avançar para a direita
+        max_offset = n - hint;
+        while (offset < max_offset &&
+               less_than(arr[hint + offset], key, counters)) {
+            last = offset;
+            offset = 2 * offset + 1;
+        }
+        if (offset > max_offset) {
+            offset = max_offset;
+        }
+        last += hint + 1;
+        offset += hint;
+    } else {
+        // key <= arr[hint]: recuar para a esquerda
+        max_offset = hint + 1;
+        while (offset < max_offset &&
+               !less_than(arr[hint - offset], key, counters)) {
+            last = offset;
+            offset = 2 * offset + 1;
+        }
+        if (offset > max_offset) {
+            offset = max_offset;
+        }
+        size_t low = hint + 1 - offset;
+        offset = hint - last;
+        last = low;
+    }
+
+    // arr[last - 1] < key <= arr[offset]
+    while (last < offset) {
+        size_t mid = last + (offset - last) / 2;
+        if (less_than(arr[mid], key, counters)) {
+            last = mid + 1;
+        } else {
+            offset = mid;
+        }
+    }
+    return offset;
+}
+
+/**
+ * Galope à direita: posição k em arr[0 .. n) tal que arr[k - 1] <= key <
+ * arr[k]
+ */
+static size_t gallop_right(int key, const int *arr, size_t n, size_t hint,
+                           SortCounters *counters) {
+    size_t last = 0, offset = 1, max_offset;
+
+    if (less_than(key, arr[hint], counters)) {
+        // key < arr[hint]: recuar para a esquerda
+        max_offset = hint + 1;
+        while (offset < max_offset &&
+               less_than(key, arr[hint - offset], counters)) {
+            last = offset;
+            offset = 2 * offset + 1;
+        }
+        if (offset > max_offset) {
+            offset = max_offset;
+        }
+        size_t low = hint + 1 - offset;
+        offset = hint - last;
+        last = low;
+    } else {
+        // arr[hint] <= key: avançar para a direita
+        max_offset = n - hint;
+        while (offset < max_offset &&
+               !less_than(key, arr[hint + offset], counters)) {
+            last = offset;
+            offset = 2 * offset + 1;
+        }
+        if (offset > max_offset) {
+            offset = max_offset;
+        }
+        last += hint + 1;
+        offset += hint;
+    }
+
+    // arr[last - 1] <= key < arr[offset]
+    while (last < offset) {
+        size_t mid = last + (offset - last) / 2;
+        if (less_than(key, arr[mid], counters)) {
+            offset = mid;
+        } else {
+            last = mid + 1;
+        }
+    }
+    return offset;
+}
+
+/**
+ * Intercala A = pa[0 .. na) e B = pb[0 .. nb) (contíguas, na <= nb) da
+ * esquerda para a direita, com A copiada para a área temporária. Exige
+ * B[0] < A[0] e A[na - 1] > B[nb - 1]
+ */
+static void merge_low(PowerMerge *ms, int *pa, size_t na, int *pb,
+                      size_t nb) {
+    SortCounters *counters = ms->counters;
+    size_t min_gallop = ms->min_gallop;
+    int *a = ms->temp;
+    int *dest = pa;
+
+    memcpy(a, pa, na * sizeof(int));
+    COUNT_MOVEMENTS(counters, na);
+    *dest++ = *pb++;
+    nb--;
+    COUNT_MOVEMENT(counters);
+
+    // O último de A é maior que todo B: A nunca se esgota antes de B
+    while (na > 1 && nb > 0) {
+        size_t a_wins = 0, b_wins = 0;
+
+        // Um a um, até um lado vencer min_gallop vezes seguidas
+        while (na > 1 && nb > 0 && a_wins < min_gallop &&
+               b_wins < min_gallop) {
+            if (less_than(*pb, *a, counters)) {
+                *dest++ = *pb++;
+                nb--;
+                b_wins++;
+                a_wins = 0;
+            } else {
+                *dest++ = *a++;
+                na--;
+                a_wins++;
+                b_wins = 0;
+            }
+            COUNT_MOVEMENT(counters);
+        }
+
+        // Galope: blocos inteiros achados por busca exponencial
+        min_gallop++;
+        while (na > 1 && nb > 0) {
+            min_gallop -= min_gallop > 1;
+
+            a_wins = gallop_right(*pb, a, na, 0, counters);
+            memcpy(dest, a, a_wins * sizeof(int));
+            dest += a_wins;
+            a += a_wins;
+            na -= a_wins;
+            COUNT_MOVEMENTS(counters, a_wins);
+            if (na <= 1) {
+                break;
+            }
+            *dest++ = *pb++;
+            nb--;
+            COUNT_MOVEMENT(counters);
+            if (nb == 0) {
+                break;
+            }
+
+            b_wins = gallop_left(*a, pb, nb, 0, counters);
+            memmove(dest, pb, b_wins * sizeof(int));
+            dest += b_wins;
+            pb += b_wins;
+            nb -= b_wins;
+            COUNT_MOVEMENTS(counters, b_wins);
+            if (nb == 0) {
+                break;
+            }
+            *dest++ = *a++;
+            na--;
+            COUNT_MOVEMENT(counters);
+
+            if (a_wins < POWER_SORT_MIN_GALLOP &&
+                b_wins < POWER_SORT_MIN_GALLOP) {
+                break;
+            }
+        }
+        min_gallop++;
+    }
+    ms->min_gallop = min_gallop;
+
+    // Sobram o resto de B (se A tem um só elemento, o maior) e depois A
+    memmove(dest, pb, nb * sizeof(int));
+    memcpy(dest + nb, a, na * sizeof(int));
+    COUNT_MOVEMENTS(counters, na + nb);
+}
+
+/**
+ * Intercala A = pa[0 .. na) e B = pb[0 .. nb) (contíguas, na > nb) da
+ * direita para a esquerda, com B copiada para a área temporária. Mesmas
+ * exigências de merge_low
+ */
+static void merge_high(PowerMerge *ms, int *pa, size_t na, int *pb,
+                       size_t nb) {
+    SortCounters *counters = ms->counters;
+    size_t min_gallop = ms->min_gallop;
+    int *b = ms->temp;
+    int *dest = pb + nb;
+    size_t k;
+
+    memcpy(b, pb, nb * sizeof(int));
+    COUNT_MOVEMENTS(counters, nb);
+    *--dest = pa[--na];
+    COUNT_MOVEMENT(counters);
+
+    // O primeiro de B é menor que todo A: B nunca se esgota antes de A
+    while (nb > 1 && na > 0) {
+        size_t a_wins = 0, b_wins = 0;
+
+        while (nb > 1 && na > 0 && a_wins < min_gallop &&
+               b_wins < min_gallop) {
+            if (less_than(b[nb - 1], pa[na - 1], counters)) {
+                *--dest = pa[--na];
+                a_wins++;
+                b_wins = 0;
+            } else {
+                *--dest = b[--nb];
+                b_wins++;
+                a_wins = 0;
+            }
+            COUNT_MOVEMENT(counters);
+        }
+
+        min_gallop++;
+        while (nb > 1 && na > 0) {
+            min_gallop -= min_gallop > 1;
+
+            // Elementos de A maiores que o último de B
+            k = na - gallop_right(b[nb - 1], pa, na, na - 1, counters);
+            dest -= k;
+            na -= k;
+            memmove(dest, pa + na, k * sizeof(int));
+            COUNT_MOVEMENTS(counters, k);
+            a_wins = k;
+            if (na == 0) {
+                break;
+            }
+            *--dest = b[--nb];
+            COUNT_MOVEMENT(counters);
+            if (nb <= 1) {
+                break;
+            }
+
+            // Elementos de B maiores ou iguais ao último de A
+            k = nb - gallop_left(pa[na - 1], b, nb, nb - 1, counters);
+            dest -= k;
+            nb -= k;
+            memcpy(dest, b + nb, k * sizeof(int));
+            COUNT_MOVEMENTS(counters, k);
+            b_wins = k;
+            if (nb <= 1) {
+                break;
+            }
+            *--dest = pa[--na];
+            COUNT_MOVEMENT(counters);
+            if (na == 0) {
+                break;
+            }
+
+            if (a_wins < POWER_SORT_MIN_GALLOP &&
+                b_wins < POWER_SORT_MIN_GALLOP) {
+                break;
+            }
+        }
+        min_gallop++;
+    }
+    ms->min_gallop = min_gallop;
+
+    // Sobram o resto de B (um só, o menor, se A não acabou) e depois A
+    memmove(pa + nb, pa, na * sizeof(int));
+    memcpy(pa, b, nb * sizeof(int));
+    COUNT_MOVEMENTS(counters, na + nb);
+}
+
+/**
+ * Intercala as corridas vizinhas left e right (estável)
+ */
+static void power_sort_merge(PowerMerge *ms, int *arr, const PowerRun *left,
+                             const PowerRun *right) {
+    int *pa = arr + left->base;
+    int *pb = arr + right->base;
+    size_t na = left->len, nb = right->len;
+
+    // Prefixo de A menor ou igual a B[0] e sufixo de B maior ou igual ao
+    // último de A já estão no lugar
+    size_t k = gallop_right(pb[0], pa, na, 0, ms->counters);
+    pa += k;
+    na -= k;
+    if (na == 0) {
+        return;
+    }
+    nb = gallop_left(pa[na - 1], pb, nb, nb - 1, ms->counters);
+    if (nb == 0) {
+        return;
+    }
+
+    if (na <= nb) {
+        merge_low(ms, pa, na, pb, nb);
+    } else {
+        merge_high(ms, pa, na, pb, nb);
+    }
+}
+
+/**
+ * PowerSort
+ */
+SortResult SORT_KERNEL(power_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    PowerRun runs[POWER_SORT_MAX_STACK];
+    PowerMerge ms;
+    size_t top = 0;
+    size_t low = 0;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    size_t minrun = power_sort_minrun(n);
+    ms.temp = n > minrun
+                  ? (int *)sort_scratch(SCRATCH_DATA, n / 2 * sizeof(int))
+                  : NULL;
+    ms.min_gallop = POWER_SORT_MIN_GALLOP;
+    ms.counters = &counters;
+
+    while (low < n) {
+        // Corrida natural, estendida até minrun por inserção binária
+        size_t len = count_run(arr, low, n, &counters);
+        if (len < minrun) {
+            size_t forced = n - low < minrun ? n - low : minrun;
+            binary_insertion_sort(arr, low, low + forced, low + len,
+                                  &counters);
+            len = forced;
+        }
+
+        // Intercalar enquanto a fronteira anterior for mais profunda
+        if (top > 0) {
+            int power = power_sort_node_power(runs[top - 1].base,
+                                              runs[top - 1].len, len, n);
+            while (top > 1 && runs[top - 2].power > power) {
+                power_sort_merge(&ms, arr, &runs[top - 2], &runs[top - 1]);
+                runs[top - 2].len += runs[top - 1].len;
+                top--;
+            }
+            runs[top - 1].power = power;
+        }
+
+        runs[top].base = low;
+        runs[top].len = len;
+        runs[top].power = 0;
+        top++;
+        low += len;
+    }
+
+    while (top > 1) {
+        power_sort_merge(&ms, arr, &runs[top - 2], &runs[top - 1]);
+        runs[top - 2].len += runs[top - 1].len;
+        top--;
+    }
+    sort_scratch_done(ms.temp);
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+// O AutoSort usa o valor das chaves (contagem, radix) e não é alvo do
+// antiqsort
+#if !SORT_ADVERSARY
+
+/**
+ * Parâmetros do AutoSort
+ */
+#define AUTO_SORT_SMALL 32               // Abaixo disso, inserção direto
+#define AUTO_SORT_SAMPLE 128             // Elementos da amostra
+#define AUTO_SORT_MIN_RUN 64             // Tamanho médio mínimo das corridas
+#define AUTO_SORT_INSERTION_BUDGET 4     // Movimentações por elemento
+#define AUTO_SORT_RANGE_FACTOR 2         // Contagem se max - min < 2n
+#define AUTO_SORT_MAX_RANGE (1 << 22)    // Maior tabela de contagem
+#define AUTO_SORT_RADIX_MIN 4096         // A partir disso, radix
+
+/**
+ * Divide o array em corridas não decrescentes, invertendo as estritamente
+ * decrescentes
+ *
+ * @param bounds Início de cada corrida e n no final (max_runs + 1 posições)
+ * @param max_runs Interrompe a varredura ao passar deste número de corridas
+ * @return Número de corridas, ou max_runs + 1 se a varredura parou
+ */
+static size_t find_runs(int *arr, size_t n, size_t *bounds, size_t max_runs,
+                        SortCounters *counters) {
+    size_t runs = 0;
+    size_t start = 0;
+
+    while (start < n) {
+        if (runs == max_runs) {
+            return max_runs + 1;
+        }
+        size_t end = start + count_run(arr, start, n, counters);
+
+        // Corridas vizinhas que já continuam em ordem são uma só
+        if (runs > 0 &&
+            !less_than(arr[start], arr[start - 1], counters)) {
+            start = end;
+            continue;
+        }
+        bounds[runs++] = start;
+        start = end;
+    }
+
+    bounds[runs] = n;
+    return runs;
+}
+
+/**
+ * Intercalação natural: junta corridas vizinhas aos pares até sobrar uma,
+ * alternando entre arr e aux
+ */
+static void merge_runs(int *arr, int *aux, size_t *bounds, size_t runs,
+                       SortCounters *counters) {
+    int *src = arr;
+    int *dst = aux;
+
+    while (runs > 1) {
+        size_t r, merged = 0;
+
+        for (r = 0; r + 1 < runs; r += 2) {
+            size_t i = bounds[r], mid = bounds[r + 1], end = bounds[r + 2];
+            size_t j = mid, k = i;
+
+            while (i < mid && j < end) {
+                if (less_than(src[j], src[i], counters)) {
+                    dst[k++] = src[j++];
+                } else {
+                    dst[k++] = src[i++];
+                }
+            }
+            memcpy(dst + k, src + i, (mid - i) * sizeof(int));
+            memcpy(dst + k + (mid - i), src + j, (end - j) * sizeof(int));
+            COUNT_MOVEMENTS(counters, end - bounds[r]);
+            bounds[merged++] = bounds[r];
+        }
+
+        // Corrida ímpar no final: apenas copiada
+        if (r < runs) {
+            memcpy(dst + bounds[r], src + bounds[r],
+                   (bounds[r + 1] - bounds[r]) * sizeof(int));
+            COUNT_MOVEMENTS(counters, bounds[r + 1] - bounds[r]);
+            bounds[merged++] = bounds[r];
+        }
+        bounds[merged] = bounds[runs];
+        runs = merged;
+
+        int *swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != arr) {
+        memcpy(arr, src, bounds[1] * sizeof(int));
+        COUNT_MOVEMENTS(counters, bounds[1]);
+    }
+}
+
+/**
+ * Ordenação por inserção que desiste após budget movimentações
+ *
+ * @return 1 se ordenou o array, 0 se desistiu (o array fica permutado)
+ */
+static int bounded_insertion_sort(int *arr, size_t n, size_t budget,
+                                  SortCounters *counters) {
+    size_t moves = 0;
+    size_t i, j;
+
+    for (i = 1; i < n; i++) {
+        int key = arr[i];
+
+        for (j = i; j > 0 && less_than(key, arr[j - 1], counters); j--) {
+            arr[j] = arr[j - 1];
+            COUNT_MOVEMENT(counters);
+        }
+        if (j != i) {
+            arr[j] = key;
+            COUNT_MOVEMENT(counters);
+            moves += i - j;
+            if (moves > budget) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * Ordenação por contagem de valores em [min, min + range)
+ */
+static void counting_sort_range(int *arr, size_t n, int min, size_t range,
+                                SortCounters *counters) {
+    size_t *counts = (size_t *)sort_scratch(SCRATCH_AUX,
+                                            range * sizeof(size_t));
+    size_t i, v, k = 0;
+
+    memset(counts, 0, range * sizeof(size_t));
+    for (i = 0; i < n; i++) {
+        counts[(size_t)((long long)arr[i] - min)]++;
+    }
+    for (v = 0; v < range; v++) {
+        int value = (int)((long long)min + (long long)v);
+        for (i = 0; i < counts[v]; i++) {
+            arr[k++] = value;
+        }
+    }
+    COUNT_MOVEMENTS(counters, n);
+    sort_scratch_done(counts);
+}
+
+/**
+ * Escolhe e executa a estratégia do AutoSort
+ *
+ * @return Nome do caminho escolhido
+ */
+static const char *auto_sort_dispatch(int *arr, size_t n,
+                                      SortCounters *counters) {
+    int sample[AUTO_SORT_SAMPLE];
+    size_t count, stride, i;
+    size_t descents = 0, distinct = 1;
+
+    if (n < AUTO_SORT_SMALL) {
+        insertion_sort_range(arr, 0, (ptrdiff_t)n - 1, counters);
+        return "insertion";
+    }
+
+    // Amostra espaçada: ordem relativa, repetições e faixa de valores
+    count = n < AUTO_SORT_SAMPLE ? n : AUTO_SORT_SAMPLE;
+    stride = n / count;
+    for (i = 0; i < count; i++) {
+        sample[i] = arr[i * stride];
+        if (i > 0 && less_than(sample[i], sample[i - 1], counters)) {
+            descents++;
+        }
+    }
+    insertion_sort_range(sample, 0, (ptrdiff_t)count - 1, counters);
+    for (i = 1; i < count; i++) {
+        if (less_than(sample[i - 1], sample[i], counters)) {
+            distinct++;
+        }
+    }
+
+    // Amostra quase monótona: corridas longas ou poucas inversões
+    if (descents <= count / 16 || descents >= count - count / 16) {
+        size_t max_runs = n / AUTO_SORT_MIN_RUN > 2 ? n / AUTO_SORT_MIN_RUN
+                                                    : 2;
+        size_t *bounds = (size_t *)malloc((max_runs + 2) * sizeof(size_t));
+
+        if (bounds != NULL) {
+            size_t runs = find_runs(arr, n, bounds, max_runs, counters);
+            if (runs <= 1) {
+                free(bounds);
+                return "presorted";
+            }
+            if (runs <= max_runs) {
+                int *aux = (int *)sort_scratch(SCRATCH_DATA,
+                                               n * sizeof(int));
+                merge_runs(arr, aux, bounds, runs, counters);
+                sort_scratch_done(aux);
+                free(bounds);
+                return "run_merge";
+            }
+            free(bounds);
+        }
+        if (bounded_insertion_sort(arr, n, AUTO_SORT_INSERTION_BUDGET * n,
+                                   counters)) {
+            return "insertion";
+        }
+    }
+
+    // Faixa de valores pequena: contagem (a faixa real é conferida antes)
+    long long sample_range = (long long)sample[count - 1] - sample[0] + 1;
+    if (sample_range <= (long long)(AUTO_SORT_RANGE_FACTOR * n) &&
+        sample_range <= AUTO_SORT_MAX_RANGE) {
+        int min = arr[0], max = arr[0];
+        for (i = 1; i < n; i++) {
+            if (arr[i] < min) {
+                min = arr[i];
+            } else if (arr[i] > max) {
+                max = arr[i];
+            }
+        }
+        COUNT_COMPARISONS(counters, 2 * (n - 1));
+        long long range = (long long)max - min + 1;
+        if (range <= (long long)(AUTO_SORT_RANGE_FACTOR * n) &&
+            range <= AUTO_SORT_MAX_RANGE) {
+            counting_sort_range(arr, n, min, (size_t)range, counters);
+            return "counting";
+        }
+    }
+
+    // Muitas repetições: partição em três vias do IntroSort
+    int depth_limit = 0;
+    size_t m;
+    for (m = n; m > 1; m >>= 1) {
+        depth_limit += 2;
+    }
+    if (distinct <= count / 2) {
+        introsort_loop(arr, 0, (ptrdiff_t)n - 1, depth_limit, counters);
+        return "three_way";
+    }
+
+    // Chaves distintas em faixa larga: radix para entradas grandes
+    if (n >= AUTO_SORT_RADIX_MIN) {
+        SortResult radix = SORT_KERNEL(lsd_radix_sort_11)(arr, n);
+        COUNT_COMPARISONS(counters, radix.comparisons);
+        COUNT_MOVEMENTS(counters, radix.movements);
+        return "radix";
+    }
+
+    introsort_loop(arr, 0, (ptrdiff_t)n - 1, depth_limit, counters);
+    return "intro";
+}
+
+/**
+ * AutoSort
+ */
+SortResult SORT_KERNEL(auto_sort)(int *arr, size_t n) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    result.variant = n > 1 ? auto_sort_dispatch(arr, n, &counters)
+                           : "presorted";
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+#endif /* !SORT_ADVERSARY */
+
+#if SORT_COUNTED
+
+/**
+ * Registro de algoritmos (variante instrumentada e variante limpa)
+ */
+const SortAlgorithm sort_algorithms[] = {
+    {"selection_sort", selection_sort, selection_sort_fast, 0},
+    {"insertion_sort", insertion_sort, insertion_sort_fast, 0},
+    {"bubble_sort", bubble_sort, bubble_sort_fast, 0},
+    {"quick_sort", quick_sort, quick_sort_fast, 0},
+    {"block_quick_sort", block_quick_sort, block_quick_sort_fast, 0},
+    {"intro_sort", intro_sort, intro_sort_fast, 0},
+    {"auto_sort", auto_sort, auto_sort_fast, 0},
+    {"power_sort", power_sort, power_sort_fast, 0},
+    {"parallel_quick_sort", parallel_quick_sort, parallel_quick_sort_fast, 1},
+    {"sample_sort", sample_sort, sample_sort_fast, 1},
+    {"parallel_merge_sort", parallel_merge_sort, parallel_merge_sort_fast, 1},
+    {"simd_quick_sort", simd_quick_sort, simd_quick_sort_fast, 0},
+    {"simd_merge_sort", simd_merge_sort, simd_merge_sort_fast, 0},
+    {"lsd_radix_sort_8", lsd_radix_sort_8, lsd_radix_sort_8_fast, 0},
+    {"lsd_radix_sort_11", lsd_radix_sort_11, lsd_radix_sort_11_fast, 0},
+    {"lsd_radix_sort_11_wc", lsd_radix_sort_11_wc, lsd_radix_sort_11_wc_fast,
+     0},
+    {"parallel_radix_sort", parallel_radix_sort, parallel_radix_sort_fast, 1},
+    {"american_flag_sort", american_flag_sort, american_flag_sort_fast, 0},
+    {"libc_qsort", libc_qsort, libc_qsort_fast, 0},
+    {"std_sort", std_sort, std_sort_fast, 0},
+    {"std_stable_sort", std_stable_sort, std_stable_sort_fast, 0},
+    {"std_sort_par_unseq", std_sort_par_unseq, std_sort_par_unseq_fast, 1},
+    {"pdq_sort", pdq_sort, pdq_sort_fast, 0},
+};
+
+const int num_sort_algorithms =
+    (int)(sizeof(sort_algorithms) / sizeof(sort_algorithms[0]));
+
+/**
+ * Procura um algoritmo pelo nome no registro
+ */
+const SortAlgorithm *find_sort_algorithm(const char *name) {
+    int i;
+    for (i = 0; i < num_sort_algorithms; i++) {
+        if (strcmp(sort_algorithms[i].name, name) == 0) {
+            return &sort_algorithms[i];
+        }
+    }
+    return NULL;
+}
+
+#endif /* SORT_COUNTED */
@@ -1,57 +1,188 @@
-/**
- * sorting_algorithms.h
- * Declarações de algoritmos de ordenação com contadores de comparações e
- * movimentações
- */
-
-#ifndef SORTING_ALGORITHMS_H
-#define SORTING_ALGORITHMS_H
-
-#include <stdlib.h>
-
-/**
- * Estrutura para armazenar resultados dos algoritmos de ordenação
- */
-typedef struct {
-    unsigned long long comparisons;  // Número de comparações
-    unsigned long long movements;    // Número de movimentações
-    double execution_time;           // Tempo de execução em segundos
-} SortResult;
-
-/**
- * Selection Sort (Ordenação por Seleção)
- *
- * @param arr Array a ser ordenado
- * @param n Tamanho do array
- * @return Estrutura com os resultados (comparações, movimentações, tempo)
- */
-SortResult selection_sort(int *arr, int n);
-
-/**
- * Insertion Sort (Ordenação por Inserção)
- *
- * @param arr Array a ser ordenado
- * @param n Tamanho do array
- * @return Estrutura com os resultados (comparações, movimentações, tempo)
- */
-SortResult insertion_sort(int *arr, int n);
-
-/**
- * Bubble Sort (Ordenação por Bolha)
- *
- * @param arr Array a ser ordenado
- * @param n Tamanho do array
- * @return Estrutura com os resultados (comparações, movimentações, tempo)
- */
-SortResult bubble_sort(int *arr, int n);
-
-/**
- * Quick Sort (Ordenação Rápida)
- *
- * @param arr Array a ser ordenado
- * @param n Tamanho do array
- * @return Estrutura com os resultados (comparações, movimentações, tempo)
- */
-SortResult quick_sort(int *arr, int n);
-
+/**
+ * sorting_algorithms.h
+ * Declarações de algoritmos de ordenação com contadores de comparações e
+ * movimentações
+ */
+
+#ifndef SORTING_ALGORITHMS_H
+#define SORTING_ALGORITHMS_H
+
+#include <stdlib.h>
+
+/**
+ * Estrutura para armazenar resultados dos algoritmos de ordenação
+ */
+typedef struct {
+    unsigned long long comparisons;  // Número de comparações
+    unsigned long long movements;    // Número de movimentações
+    double execution_time;           // Tempo de execução em segundos
+
+    // Estatísticas das repetições (preenchidas por run_algorithm)
+    double median_time;              // Mediana dos tempos em segundos
+    double p95_time;                 // Percentil 95 dos tempos em segundos
+    double stddev_time;              // Desvio padrão dos tempos em segundos
+    double ci_low_time;              // Limite inferior do IC 95% da mediana
+    double ci_high_time;             // Limite superior do IC 95% da mediana
+    int repetitions;                 // Repetições medidas
+    int inner_loops;                 // Ordenações por repetição (lote)
+    double *samples;                 // Tempo por ordenação de cada repetição
+                                     // (alocado por run_algorithm; liberar
+                                     // com free)
+    double cv_time;                  // Coeficiente de variação dos tempos
+    int reruns;                      // Remedições por excesso de ruído
+    int unstable;                    // 1 se o CV ficou acima do limite
+    int invalid;                     // 1 se a saída não é a entrada
+                                     // ordenada (fora do histórico)
+
+    // Contadores de desempenho de uma execução (perf_event_open)
+    unsigned long long cycles;         // Ciclos do processador
+    unsigned long long instructions;   // Instruções executadas
+    unsigned long long branch_misses;  // Desvios mal previstos
+    unsigned long long l1d_misses;     // Faltas de leitura na L1d
+    unsigned long long llc_misses;     // Faltas de leitura na LLC
+    unsigned long long dtlb_misses;    // Faltas de leitura na dTLB
+    unsigned long long task_clock_ns;  // Tempo de CPU (evento de software)
+    unsigned long long page_faults;    // Faltas de página
+    unsigned int counters_valid;       // Bit PerfEvent ligado se válido
+
+    // Paralelismo
+    int threads;                     // Threads usadas (1 se sequencial)
+    double cpu_time;                 // Tempo de CPU do processo (s)
+    double serial_time;              // Mediana com 1 thread (paralelos)
+    double speedup;                  // serial_time / median_time
+    double parallel_efficiency;      // speedup / threads
+
+    // Memória da execução instrumentada (memory_tracker)
+    unsigned long long peak_rss_delta;    // Pico de RSS acima do início
+    unsigned long long bytes_allocated;   // Bytes pedidos ao alocador
+    unsigned long long allocations;       // Número de alocações
+    unsigned long long peak_extra_bytes;  // Pico de memória extra viva
+
+    // Caminho escolhido em tempo de execução (ex.: "avx512"), ou NULL
+    const char *variant;
+} SortResult;
+
+/**
+ * Selection Sort (Ordenação por Seleção)
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult selection_sort(int *arr, size_t n);
+
+/**
+ * Insertion Sort (Ordenação por Inserção)
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult insertion_sort(int *arr, size_t n);
+
+/**
+ * Bubble Sort (Ordenação por Bolha)
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult bubble_sort(int *arr, size_t n);
+
+/**
+ * Quick Sort (Ordenação Rápida)
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult quick_sort(int *arr, size_t n);
+
+/**
+ * BlockQuickSort (partição em blocos de Edelkamp e Weiss: offsets dos
+ * elementos fora do lugar gravados sem desvios condicionais e trocados em
+ * lote; pivô e controle de profundidade do IntroSort)
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult block_quick_sort(int *arr, size_t n);
+
+/**
+ * IntroSort (QuickSort com pivô ninther, partição em três vias, recursão no
+ * lado menor, inserção abaixo do corte e HeapSort ao atingir 2·log2(n) níveis)
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult intro_sort(int *arr, size_t n);
+
+/**
+ * AutoSort: examina uma amostra da entrada e escolhe a estratégia — nada
+ * (já ordenado), intercalação natural das corridas, inserção para desordem
+ * local, contagem para faixa de valores pequena, partição em três vias para
+ * muitas repetições, radix ou IntroSort. O caminho escolhido fica em
+ * result.variant
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult auto_sort(int *arr, size_t n);
+
+/**
+ * PowerSort (ordenação estável adaptativa às corridas: corridas naturais
+ * estendidas até minrun por inserção binária, política de intercalação
+ * powersort e modo galope do TimSort)
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult power_sort(int *arr, size_t n);
+
+/**
+ * Variantes sem instrumentação (mesmo código, compilado com SORT_COUNTED=0):
+ * não contam comparações nem movimentações e servem para medir o tempo
+ */
+SortResult selection_sort_fast(int *arr, size_t n);
+SortResult insertion_sort_fast(int *arr, size_t n);
+SortResult bubble_sort_fast(int *arr, size_t n);
+SortResult quick_sort_fast(int *arr, size_t n);
+SortResult block_quick_sort_fast(int *arr, size_t n);
+SortResult intro_sort_fast(int *arr, size_t n);
+SortResult auto_sort_fast(int *arr, size_t n);
+SortResult power_sort_fast(int *arr, size_t n);
+
+/**
+ * Assinatura comum dos algoritmos de ordenação
+ */
+typedef SortResult (*SortFunction)(int *arr, size_t n);
+
+/**
+ * Entrada do registro de algoritmos
+ */
+typedef struct {
+    const char *name;       // Nome usado na linha de comando e nos CSVs
+    SortFunction function;  // Variante instrumentada (contadores)
+    SortFunction fast;      // Variante limpa (tempo e contadores de hardware)
+    int parallel;           // 1 se usa várias threads (mede o speedup)
+} SortAlgorithm;
+
+/**
+ * Registro com todos os algoritmos disponíveis, na ordem padrão de execução
+ */
+extern const SortAlgorithm sort_algorithms[];
+extern const int num_sort_algorithms;
+
+/**
+ * Procura um algoritmo pelo nome no registro
+ *
+ * @param name Nome do algoritmo
+ * @return Entrada do registro ou NULL se não existir
+ */
+const SortAlgorithm *find_sort_algorithm(const char *name);
+
 #endif /* SORTING_ALGORITHMS_H */
\ No newline at end of file
@@ -0,0 +1,345 @@
+/**
+ * std_sorts.cpp
+ * Referências da biblioteca padrão do C++ com ligação C (baseline_sorts.h)
+ *
+ * Único arquivo C++ do projeto. As duas variantes de cada algoritmo ficam
+ * aqui mesmo: a instrumentada conta as comparações por um comparador e a
+ * limpa chama o algoritmo com o operator< padrão, como o código de produção.
+ * Os alvos do antiqsort trocam a comparação pelo adversário.
+ *
+ * Também substitui o operator new/delete global: a libstdc++ aloca pelo
+ * próprio operator new (buffer do std::stable_sort, tarefas do TBB), que
+ * chama o malloc de dentro da biblioteca, fora do -Wl,--wrap. As versões
+ * abaixo chamam malloc/posix_memalign/free deste arquivo, interceptados pelo
+ * memory_tracker.
+ */
+
+#include "baseline_sorts.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+#include "antiqsort.h"
+#include "benchmark.h"
+
+extern "C" {
+#include "thread_pool.h"
+}
+
+// std::execution disponível (C++17 com a biblioteca paralela)
+#if defined(__cpp_lib_execution) && __cpp_lib_execution >= 201603L
+#define STD_SORTS_EXECUTION 1
+#else
+#define STD_SORTS_EXECUTION 0
+#endif
+
+// Backend TBB: o número de threads é limitado por tbb::global_control
+#if STD_SORTS_EXECUTION && defined(_PSTL_PAR_BACKEND_TBB) && \
+    __has_include(<tbb/global_control.h>)
+#include <tbb/global_control.h>
+#define STD_SORTS_TBB_CONTROL 1
+#else
+#define STD_SORTS_TBB_CONTROL 0
+#endif
+
+namespace {
+
+/**
+ * Mede o tempo de uma ordenação
+ */
+template <typename Sort>
+SortResult timed_sort(Sort sort) {
+    SortResult result = SortResult();
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    sort();
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    return result;
+}
+
+/**
+ * Backend das políticas de execução da libstdc++
+ */
+const char *execution_backend() {
+#if !STD_SORTS_EXECUTION
+    return "sequential";
+#elif defined(_PSTL_PAR_BACKEND_TBB)
+    return "tbb";
+#else
+    return "serial";
+#endif
+}
+
+/**
+ * Threads das políticas de execução: as de --threads (parallel_get_threads)
+ * quando o backend é o TBB, que é limitado a elas; 1 nos demais
+ */
+int execution_threads() {
+#if STD_SORTS_TBB_CONTROL
+    return parallel_get_threads();
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Alocação do operator new: repete enquanto houver new_handler, como exige
+ * o padrão
+ *
+ * @param size Bytes pedidos
+ * @param alignment Alinhamento (0 = o do malloc)
+ * @return Memória ou nullptr se não houver new_handler
+ */
+void *tracked_new(std::size_t size, std::size_t alignment) {
+    if (size == 0) {
+        size = 1;
+    }
+    if (alignment != 0 && alignment < sizeof(void *)) {
+        alignment = sizeof(void *);
+    }
+    for (;;) {
+        void *ptr = nullptr;
+        if (alignment == 0) {
+            ptr = std::malloc(size);
+        } else if (posix_memalign(&ptr, alignment, size) != 0) {
+            ptr = nullptr;
+        }
+        if (ptr != nullptr) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            return nullptr;
+        }
+        handler();
+    }
+}
+
+/**
+ * Versão que lança std::bad_alloc
+ */
+void *tracked_new_or_throw(std::size_t size, std::size_t alignment) {
+    void *ptr = tracked_new(size, alignment);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+/**
+ * Versão nothrow: a exceção do new_handler vira nullptr
+ */
+void *tracked_new_nothrow(std::size_t size, std::size_t alignment) noexcept {
+    try {
+        return tracked_new(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+}  // namespace
+
+/**
+ * operator new/delete globais contados pelo memory_tracker
+ */
+void *operator new(std::size_t size) {
+    return tracked_new_or_throw(size, 0);
+}
+
+void *operator new[](std::size_t size) {
+    return tracked_new_or_throw(size, 0);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return tracked_new_nothrow(size, 0);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return tracked_new_nothrow(size, 0);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return tracked_new_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return tracked_new_or_throw(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept {
+    return tracked_new_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept {
+    return tracked_new_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t,
+                     const std::nothrow_t &) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+    std::free(ptr);
+}
+
+/**
+ * std::sort
+ */
+SortResult std_sort(int *arr, size_t n) {
+    unsigned long long comparisons = 0;
+    SortResult result = timed_sort([&] {
+        std::sort(arr, arr + n, [&](int a, int b) {
+            comparisons++;
+            return a < b;
+        });
+    });
+    result.comparisons = comparisons;
+    return result;
+}
+
+SortResult std_sort_fast(int *arr, size_t n) {
+    return timed_sort([&] { std::sort(arr, arr + n); });
+}
+
+SortResult std_sort_adversary(int *arr, size_t n) {
+    unsigned long long comparisons = 0;
+    SortResult result = timed_sort([&] {
+        std::sort(arr, arr + n, [&](int a, int b) {
+            comparisons++;
+            return antiqsort_less(a, b) != 0;
+        });
+    });
+    result.comparisons = comparisons;
+    return result;
+}
+
+/**
+ * std::stable_sort
+ */
+SortResult std_stable_sort(int *arr, size_t n) {
+    unsigned long long comparisons = 0;
+    SortResult result = timed_sort([&] {
+        std::stable_sort(arr, arr + n, [&](int a, int b) {
+            comparisons++;
+            return a < b;
+        });
+    });
+    result.comparisons = comparisons;
+    return result;
+}
+
+SortResult std_stable_sort_fast(int *arr, size_t n) {
+    return timed_sort([&] { std::stable_sort(arr, arr + n); });
+}
+
+SortResult std_stable_sort_adversary(int *arr, size_t n) {
+    unsigned long long comparisons = 0;
+    SortResult result = timed_sort([&] {
+        std::stable_sort(arr, arr + n, [&](int a, int b) {
+            comparisons++;
+            return antiqsort_less(a, b) != 0;
+        });
+    });
+    result.comparisons = comparisons;
+    return result;
+}
+
+/**
+ * std::sort(std::execution::par_unseq)
+ */
+SortResult std_sort_par_unseq(int *arr, size_t n) {
+    std::atomic<unsigned long long> comparisons(0);
+    int threads = execution_threads();
+#if STD_SORTS_TBB_CONTROL
+    tbb::global_control limit(tbb::global_control::max_allowed_parallelism,
+                              static_cast<std::size_t>(threads));
+#endif
+    SortResult result = timed_sort([&] {
+        auto less = [&](int a, int b) {
+            comparisons.fetch_add(1, std::memory_order_relaxed);
+            return a < b;
+        };
+#if STD_SORTS_EXECUTION
+        std::sort(std::execution::par, arr, arr + n, less);
+#else
+        std::sort(arr, arr + n, less);
+#endif
+    });
+    result.comparisons = comparisons.load();
+    result.variant = execution_backend();
+    result.threads = threads;
+    return result;
+}
+
+SortResult std_sort_par_unseq_fast(int *arr, size_t n) {
+    int threads = execution_threads();
+#if STD_SORTS_TBB_CONTROL
+    tbb::global_control limit(tbb::global_control::max_allowed_parallelism,
+                              static_cast<std::size_t>(threads));
+#endif
+    SortResult result = timed_sort([&] {
+#if STD_SORTS_EXECUTION
+        std::sort(std::execution::par_unseq, arr, arr + n);
+#else
+        std::sort(arr, arr + n);
+#endif
+    });
+    result.variant = execution_backend();
+    result.threads = threads;
+    return result;
+}
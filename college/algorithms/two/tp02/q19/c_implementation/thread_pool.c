@@ -0,0 +1,484 @@
+/**
+ * thread_pool.c
+ * Implementação do pool de threads com roubo de tarefas
+ *
+ * Cada thread tem uma deque protegida por mutex: a dona empilha e desempilha
+ * no fim (LIFO, boa localidade para divisão e conquista) e as threads
+ * ociosas roubam do início (FIFO, tarefas maiores). A deque 0 pertence às
+ * threads externas ao pool, como a thread principal do programa.
+ */
+
+#define _GNU_SOURCE
+
+#include "thread_pool.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define INITIAL_DEQUE_CAPACITY 64
+
+/**
+ * Tarefa enfileirada
+ */
+typedef struct {
+    TaskFunction function;
+    void *arg;
+    TaskGroup *group;
+} Task;
+
+/**
+ * Deque circular de tarefas
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    Task *tasks;
+    int capacity;
+    int head;   // Próxima tarefa a ser roubada
+    int count;  // Tarefas na deque
+} WorkDeque;
+
+struct ThreadPool {
+    int num_threads;   // Total, incluindo a thread que aguarda
+    int num_workers;   // Threads criadas pelo pool
+    pthread_t *workers;
+    WorkDeque *deques;  // num_workers + 1 (a 0 é a externa)
+
+    pthread_mutex_t sleep_lock;
+    pthread_cond_t wake;
+    long queued;  // Tarefas em todas as deques (atômico)
+    int stop;
+    int pinned;   // Cada thread fixada em uma CPU (sched_setaffinity)
+};
+
+/**
+ * Identidade da thread atual: índice da deque e pool a que pertence
+ */
+static __thread int current_deque = 0;
+static __thread ThreadPool *current_pool = NULL;
+
+/**
+ * CPUs permitidas ao processo antes de qualquer fixação
+ */
+static cpu_set_t allowed_cpus;
+static int allowed_cpus_known = 0;
+
+/**
+ * Registra as CPUs permitidas ao processo na primeira chamada
+ *
+ * @return Número de CPUs permitidas (0 se desconhecido)
+ */
+static int capture_allowed_cpus(void) {
+    if (!allowed_cpus_known) {
+        if (sched_getaffinity(0, sizeof(allowed_cpus), &allowed_cpus) != 0) {
+            return 0;
+        }
+        allowed_cpus_known = 1;
+    }
+    return CPU_COUNT(&allowed_cpus);
+}
+
+/**
+ * Fixa a thread atual na slot-ésima CPU permitida
+ */
+int thread_pin_current(int slot) {
+    int count = capture_allowed_cpus();
+    int cpu, seen = 0;
+    cpu_set_t target;
+
+    if (count == 0) {
+        return -1;
+    }
+
+    slot = slot < 0 ? count - 1 : slot % count;
+    for (cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &allowed_cpus) && seen++ == slot) {
+            break;
+        }
+    }
+    CPU_ZERO(&target);
+    CPU_SET(cpu, &target);
+    return sched_setaffinity(0, sizeof(target), &target) == 0 ? cpu : -1;
+}
+
+/**
+ * Devolve à thread atual todas as CPUs permitidas ao processo
+ */
+void thread_unpin_current(void) {
+    if (allowed_cpus_known) {
+        sched_setaffinity(0, sizeof(allowed_cpus), &allowed_cpus);
+    }
+}
+
+/**
+ * Contexto inicial de cada worker
+ */
+typedef struct {
+    ThreadPool *pool;
+    int index;
+} WorkerStart;
+
+static int deque_init(WorkDeque *deque) {
+    deque->tasks = (Task *)malloc(INITIAL_DEQUE_CAPACITY * sizeof(Task));
+    if (deque->tasks == NULL) {
+        return 0;
+    }
+    deque->capacity = INITIAL_DEQUE_CAPACITY;
+    deque->head = 0;
+    deque->count = 0;
+    pthread_mutex_init(&deque->lock, NULL);
+    return 1;
+}
+
+static void deque_free(WorkDeque *deque) {
+    pthread_mutex_destroy(&deque->lock);
+    free(deque->tasks);
+}
+
+/**
+ * Empilha no fim da deque (dobrando a capacidade quando cheia)
+ */
+static void deque_push(WorkDeque *deque, const Task *task) {
+    pthread_mutex_lock(&deque->lock);
+
+    if (deque->count == deque->capacity) {
+        int capacity = deque->capacity * 2;
+        Task *tasks = (Task *)malloc(capacity * sizeof(Task));
+        int i;
+        if (tasks == NULL) {
+            fprintf(stderr, "Erro na alocação de memória\n");
+            exit(EXIT_FAILURE);
+        }
+        for (i = 0; i < deque->count; i++) {
+            tasks[i] = deque->tasks[(deque->head + i) % deque->capacity];
+        }
+        free(deque->tasks);
+        deque->tasks = tasks;
+        deque->capacity = capacity;
+        deque->head = 0;
+    }
+
+    deque->tasks[(deque->head + deque->count) % deque->capacity] = *task;
+    deque->count++;
+
+    pthread_mutex_unlock(&deque->lock);
+}
+
+/**
+ * Desempilha do fim (dona) ou do início (ladrão)
+ */
+static int deque_take(WorkDeque *deque, Task *task, int steal) {
+    int found = 0;
+
+    pthread_mutex_lock(&deque->lock);
+    if (deque->count > 0) {
+        if (steal) {
+            *task = deque->tasks[deque->head];
+            deque->head = (deque->head + 1) % deque->capacity;
+        } else {
+            *task = deque->tasks[(deque->head + deque->count - 1) %
+                                 deque->capacity];
+        }
+        deque->count--;
+        found = 1;
+    }
+    pthread_mutex_unlock(&deque->lock);
+
+    return found;
+}
+
+/**
+ * Procura uma tarefa: primeiro na própria deque, depois roubando das
+ * outras a partir de uma posição que varia entre as tentativas
+ */
+static int find_task(ThreadPool *pool, int self, Task *task,
+                     unsigned *victim_seed) {
+    int num_deques = pool->num_workers + 1;
+    int i;
+
+    if (__atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0) {
+        return 0;
+    }
+
+    if (deque_take(&pool->deques[self], task, 0)) {
+        __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+        return 1;
+    }
+
+    *victim_seed = *victim_seed * 1103515245u + 12345u;
+    int start = (int)((*victim_seed >> 16) % (unsigned)num_deques);
+    for (i = 0; i < num_deques; i++) {
+        int victim = (start + i) % num_deques;
+        if (victim != self && deque_take(&pool->deques[victim], task, 1)) {
+            __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Executa uma tarefa e a marca como concluída no grupo
+ */
+static void run_task(const Task *task) {
+    task->function(task->arg);
+    __atomic_sub_fetch(&task->group->pending, 1, __ATOMIC_ACQ_REL);
+}
+
+/**
+ * Laço de cada worker: executa tarefas ou dorme até haver trabalho
+ */
+static void *worker_main(void *arg) {
+    WorkerStart start = *(WorkerStart *)arg;
+    ThreadPool *pool = start.pool;
+    unsigned victim_seed = (unsigned)start.index * 2654435761u;
+    Task task;
+
+    free(arg);
+    current_pool = pool;
+    current_deque = start.index;
+    if (pool->pinned) {
+        thread_pin_current(start.index);
+    } else {
+        // Não herdar a CPU da thread de medição, se ela estiver fixada
+        thread_unpin_current();
+    }
+
+    for (;;) {
+        if (find_task(pool, start.index, &task, &victim_seed)) {
+            run_task(&task);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->sleep_lock);
+        while (__atomic_load_n(&pool->queued, __ATOMIC_ACQUIRE) == 0 &&
+               !pool->stop) {
+            pthread_cond_wait(&pool->wake, &pool->sleep_lock);
+        }
+        int stop = pool->stop;
+        pthread_mutex_unlock(&pool->sleep_lock);
+
+        if (stop) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Cria um pool para `threads` threads de trabalho no total
+ */
+ThreadPool *thread_pool_create(int threads) {
+    return thread_pool_create_pinned(threads, 0);
+}
+
+/**
+ * Cria um pool, opcionalmente com cada thread fixada em uma CPU
+ */
+ThreadPool *thread_pool_create_pinned(int threads, int pin) {
+    ThreadPool *pool = (ThreadPool *)calloc(1, sizeof(ThreadPool));
+    int i;
+
+    if (pool == NULL) {
+        return NULL;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    pool->num_threads = threads;
+    pool->num_workers = 0;
+    pool->pinned = pin != 0;
+    pool->workers = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    pool->deques = (WorkDeque *)calloc(threads, sizeof(WorkDeque));
+    if (pool->workers == NULL || pool->deques == NULL) {
+        free(pool->workers);
+        free(pool->deques);
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->sleep_lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+
+    for (i = 0; i < threads; i++) {
+        if (!deque_init(&pool->deques[i])) {
+            fprintf(stderr, "Erro na alocação de memória\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Deques 1..threads-1 pertencem às threads criadas
+    for (i = 1; i < threads; i++) {
+        WorkerStart *start = (WorkerStart *)malloc(sizeof(WorkerStart));
+        if (start == NULL) {
+            break;
+        }
+        start->pool = pool;
+        start->index = i;
+        if (pthread_create(&pool->workers[i - 1], NULL, worker_main, start) !=
+            0) {
+            free(start);
+            break;
+        }
+        pool->num_workers++;
+    }
+
+    return pool;
+}
+
+/**
+ * Encerra as threads e libera o pool
+ */
+void thread_pool_destroy(ThreadPool *pool) {
+    int i;
+
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->sleep_lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->sleep_lock);
+
+    for (i = 0; i < pool->num_workers; i++) {
+        pthread_join(pool->workers[i], NULL);
+    }
+    for (i = 0; i < pool->num_threads; i++) {
+        deque_free(&pool->deques[i]);
+    }
+
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->sleep_lock);
+    free(pool->workers);
+    free(pool->deques);
+    free(pool);
+}
+
+/**
+ * Número total de threads do pool
+ */
+int thread_pool_size(const ThreadPool *pool) {
+    return pool->num_workers + 1;
+}
+
+/**
+ * Inicializa um grupo de tarefas vazio
+ */
+void task_group_init(TaskGroup *group) {
+    group->pending = 0;
+}
+
+/**
+ * Índice da deque da thread atual neste pool
+ */
+static int self_deque(const ThreadPool *pool) {
+    return current_pool == pool ? current_deque : 0;
+}
+
+/**
+ * Submete uma tarefa
+ */
+void thread_pool_submit(ThreadPool *pool, TaskGroup *group,
+                        TaskFunction function, void *arg) {
+    Task task;
+
+    task.function = function;
+    task.arg = arg;
+    task.group = group;
+
+    __atomic_add_fetch(&group->pending, 1, __ATOMIC_ACQ_REL);
+    deque_push(&pool->deques[self_deque(pool)], &task);
+    __atomic_add_fetch(&pool->queued, 1, __ATOMIC_ACQ_REL);
+
+    // Acordar um worker; o mutex evita perder o sinal
+    if (pool->num_workers > 0) {
+        pthread_mutex_lock(&pool->sleep_lock);
+        pthread_cond_signal(&pool->wake);
+        pthread_mutex_unlock(&pool->sleep_lock);
+    }
+}
+
+/**
+ * Aguarda todas as tarefas do grupo, executando tarefas enquanto espera
+ */
+void thread_pool_wait(ThreadPool *pool, TaskGroup *group) {
+    int self = self_deque(pool);
+    unsigned victim_seed = 0x9E3779B9u + (unsigned)self;
+    Task task;
+
+    while (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0) {
+        if (find_task(pool, self, &task, &victim_seed)) {
+            run_task(&task);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+/**
+ * Configuração compartilhada dos algoritmos paralelos
+ */
+static int parallel_threads = 0;
+static int parallel_pin = 0;
+static ThreadPool *shared_pool = NULL;
+
+/**
+ * Define o número de threads usado pelos algoritmos paralelos
+ */
+void parallel_set_threads(int threads) {
+    parallel_threads = threads > 0 ? threads : 0;
+}
+
+/**
+ * Liga ou desliga a fixação das threads do pool compartilhado
+ */
+void parallel_set_affinity(int pin) {
+    parallel_pin = pin != 0;
+    if (!parallel_pin) {
+        // A thread principal volta a poder usar todas as CPUs
+        thread_unpin_current();
+    }
+}
+
+/**
+ * Número de threads usado pelos algoritmos paralelos
+ */
+int parallel_get_threads(void) {
+    if (parallel_threads > 0) {
+        return parallel_threads;
+    }
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
+
+/**
+ * Pool compartilhado pelos algoritmos paralelos
+ */
+ThreadPool *parallel_shared_pool(void) {
+    int threads = parallel_get_threads();
+
+    if (shared_pool != NULL && (shared_pool->num_threads != threads ||
+                                shared_pool->pinned != parallel_pin)) {
+        thread_pool_destroy(shared_pool);
+        shared_pool = NULL;
+    }
+    if (shared_pool == NULL) {
+        if (parallel_pin) {
+            // A thread que aguarda os grupos usa a deque 0 e a CPU 0
+            thread_pin_current(0);
+        }
+        shared_pool = thread_pool_create_pinned(threads, parallel_pin);
+        if (shared_pool == NULL) {
+            fprintf(stderr, "Erro ao criar o pool de threads\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return shared_pool;
+}
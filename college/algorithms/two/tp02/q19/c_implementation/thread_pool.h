@@ -0,0 +1,135 @@
+/**
+ * thread_pool.h
+ * Pool de threads com roubo de tarefas (pthreads, uma deque por worker)
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+/**
+ * Função executada por uma tarefa
+ */
+typedef void (*TaskFunction)(void *arg);
+
+/**
+ * Grupo de tarefas aguardadas em conjunto (fork-join)
+ */
+typedef struct {
+    long pending;  // Tarefas submetidas e ainda não concluídas (atômico)
+} TaskGroup;
+
+/**
+ * Pool de threads (estrutura opaca)
+ */
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * Cria um pool para `threads` threads de trabalho no total: são criadas
+ * threads - 1 threads e a thread que aguarda um grupo executa tarefas também
+ *
+ * @param threads Número total de threads (>= 1)
+ * @return Pool criado ou NULL em caso de erro
+ */
+ThreadPool *thread_pool_create(int threads);
+
+/**
+ * Como thread_pool_create; com pin, a thread i do pool é fixada com
+ * sched_setaffinity na i-ésima CPU permitida ao processo (circularmente)
+ *
+ * @param threads Número total de threads (>= 1)
+ * @param pin 1 para fixar as threads
+ * @return Pool criado ou NULL em caso de erro
+ */
+ThreadPool *thread_pool_create_pinned(int threads, int pin);
+
+/**
+ * Encerra as threads e libera o pool (não deve haver tarefas pendentes)
+ *
+ * @param pool Pool de threads
+ */
+void thread_pool_destroy(ThreadPool *pool);
+
+/**
+ * Número total de threads do pool (incluindo a que aguarda)
+ *
+ * @param pool Pool de threads
+ * @return Número de threads
+ */
+int thread_pool_size(const ThreadPool *pool);
+
+/**
+ * Inicializa um grupo de tarefas vazio
+ *
+ * @param group Grupo a inicializar
+ */
+void task_group_init(TaskGroup *group);
+
+/**
+ * Submete uma tarefa: vai para o fim da deque da thread atual (ou da deque
+ * externa) e pode ser roubada do início por outra thread ociosa
+ *
+ * @param pool Pool de threads
+ * @param group Grupo ao qual a tarefa pertence
+ * @param function Função a executar
+ * @param arg Argumento da função
+ */
+void thread_pool_submit(ThreadPool *pool, TaskGroup *group,
+                        TaskFunction function, void *arg);
+
+/**
+ * Aguarda todas as tarefas do grupo, executando tarefas enquanto espera
+ * (permite fork-join aninhado dentro das próprias tarefas)
+ *
+ * @param pool Pool de threads
+ * @param group Grupo a aguardar
+ */
+void thread_pool_wait(ThreadPool *pool, TaskGroup *group);
+
+/**
+ * Fixa a thread atual com sched_setaffinity na slot-ésima CPU permitida ao
+ * processo (circularmente; slot negativo escolhe a última, em geral a mais
+ * distante das interrupções atendidas pela CPU 0)
+ *
+ * @param slot Índice entre as CPUs permitidas
+ * @return CPU escolhida ou -1 em caso de erro
+ */
+int thread_pin_current(int slot);
+
+/**
+ * Devolve à thread atual todas as CPUs permitidas ao processo antes da
+ * primeira fixação
+ */
+void thread_unpin_current(void);
+
+/**
+ * Define o número de threads usado pelos algoritmos paralelos
+ *
+ * @param threads Número de threads (0 = todas as CPUs)
+ */
+void parallel_set_threads(int threads);
+
+/**
+ * Liga ou desliga a fixação das threads do pool compartilhado em CPUs
+ * distintas (a thread que chama fica na primeira); o pool é recriado na
+ * próxima chamada de parallel_shared_pool
+ *
+ * @param pin 1 para fixar, 0 para liberar
+ */
+void parallel_set_affinity(int pin);
+
+/**
+ * Número de threads usado pelos algoritmos paralelos
+ *
+ * @return Número de threads (>= 1)
+ */
+int parallel_get_threads(void);
+
+/**
+ * Pool compartilhado pelos algoritmos paralelos, criado sob demanda com
+ * parallel_get_threads() threads e recriado quando esse número muda
+ *
+ * @return Pool compartilhado
+ */
+ThreadPool *parallel_shared_pool(void);
+
+#endif /* THREAD_POOL_H */
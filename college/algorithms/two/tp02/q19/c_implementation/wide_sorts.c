@@ -0,0 +1,84 @@
+/**
+ * wide_sorts.c
+ * Implementação dos algoritmos para chaves de 64 bits
+ *
+ * Compilado duas vezes, como sorting_algorithms.c (ver
+ * sort_instrumentation.h). O corpo dos algoritmos está em
+ * wide_sorts_template.h, incluído uma vez para int64_t e outra para uint64_t.
+ */
+
+#include "wide_sorts.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "benchmark.h"
+#include "large_memory.h"
+#include "sort_instrumentation.h"
+
+// Parâmetros do IntroSort (os mesmos de sorting_algorithms.c)
+#define WIDE_INSERTION_CUTOFF 24
+#define WIDE_NINTHER_THRESHOLD 128
+
+// Radix Sort LSD: 6 dígitos de 11 bits cobrem os 64 bits
+#define WIDE_RADIX_BITS 11
+#define WIDE_RADIX_PASSES 6
+
+// Nomes gerados pelo modelo: base + sufixo da chave + sufixo da variante
+#define WIDE_CONCAT_(base, key, variant) base##key##variant
+#define WIDE_CONCAT(base, key, variant) WIDE_CONCAT_(base, key, variant)
+
+#if SORT_COUNTED
+#define WIDE_VARIANT
+#else
+#define WIDE_VARIANT _fast
+#endif
+
+// int64_t: inverter o bit de sinal ordena os negativos antes dos positivos
+#define KEY_T int64_t
+#define KEY_SUFFIX _i64
+#define KEY_ORDER(x) ((uint64_t)(x) ^ ((uint64_t)1 << 63))
+#include "wide_sorts_template.h"
+#undef KEY_T
+#undef KEY_SUFFIX
+#undef KEY_ORDER
+
+#define KEY_T uint64_t
+#define KEY_SUFFIX _u64
+#define KEY_ORDER(x) (x)
+#include "wide_sorts_template.h"
+#undef KEY_T
+#undef KEY_SUFFIX
+#undef KEY_ORDER
+
+#if SORT_COUNTED
+
+/**
+ * Registro dos algoritmos com chaves de 64 bits
+ */
+const WideSortAlgorithm wide_sort_algorithms[] = {
+    {"intro_sort", intro_sort_i64, intro_sort_i64_fast, intro_sort_u64,
+     intro_sort_u64_fast},
+    {"lsd_radix_sort_11", lsd_radix_sort_11_i64, lsd_radix_sort_11_i64_fast,
+     lsd_radix_sort_11_u64, lsd_radix_sort_11_u64_fast},
+};
+
+const int num_wide_sort_algorithms =
+    (int)(sizeof(wide_sort_algorithms) / sizeof(wide_sort_algorithms[0]));
+
+/**
+ * Procura um algoritmo com chaves de 64 bits pelo nome
+ */
+const WideSortAlgorithm *find_wide_sort_algorithm(const char *name) {
+    int i;
+    for (i = 0; i < num_wide_sort_algorithms; i++) {
+        if (strcmp(wide_sort_algorithms[i].name, name) == 0) {
+            return &wide_sort_algorithms[i];
+        }
+    }
+    return NULL;
+}
+
+#endif /* SORT_COUNTED */
@@ -0,0 +1,77 @@
+/**
+ * wide_sorts.h
+ * Algoritmos de ordenação para chaves de 64 bits (int64_t e uint64_t), usados
+ * no modo de dados grandes (--key-type)
+ */
+
+#ifndef WIDE_SORTS_H
+#define WIDE_SORTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sorting_algorithms.h"
+
+/**
+ * IntroSort para chaves de 64 bits (pivô ninther, partição em três vias,
+ * inserção abaixo do corte e HeapSort ao atingir 2·log2(n) níveis)
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult intro_sort_i64(int64_t *arr, size_t n);
+SortResult intro_sort_u64(uint64_t *arr, size_t n);
+
+/**
+ * Radix Sort LSD com dígitos de 11 bits para chaves de 64 bits (até 6
+ * passes; passes em que todos os elementos têm o mesmo dígito são pulados)
+ *
+ * @param arr Array a ser ordenado
+ * @param n Tamanho do array
+ * @return Estrutura com os resultados (comparações, movimentações, tempo)
+ */
+SortResult lsd_radix_sort_11_i64(int64_t *arr, size_t n);
+SortResult lsd_radix_sort_11_u64(uint64_t *arr, size_t n);
+
+/**
+ * Variantes sem instrumentação
+ */
+SortResult intro_sort_i64_fast(int64_t *arr, size_t n);
+SortResult intro_sort_u64_fast(uint64_t *arr, size_t n);
+SortResult lsd_radix_sort_11_i64_fast(int64_t *arr, size_t n);
+SortResult lsd_radix_sort_11_u64_fast(uint64_t *arr, size_t n);
+
+/**
+ * Assinaturas dos algoritmos para chaves de 64 bits
+ */
+typedef SortResult (*SortFunctionI64)(int64_t *arr, size_t n);
+typedef SortResult (*SortFunctionU64)(uint64_t *arr, size_t n);
+
+/**
+ * Entrada do registro de algoritmos com chaves de 64 bits; o nome é o mesmo
+ * do algoritmo equivalente em sort_algorithms
+ */
+typedef struct {
+    const char *name;
+    SortFunctionI64 function_i64;  // Variante instrumentada (int64_t)
+    SortFunctionI64 fast_i64;      // Variante limpa (int64_t)
+    SortFunctionU64 function_u64;  // Variante instrumentada (uint64_t)
+    SortFunctionU64 fast_u64;      // Variante limpa (uint64_t)
+} WideSortAlgorithm;
+
+/**
+ * Registro dos algoritmos com chaves de 64 bits
+ */
+extern const WideSortAlgorithm wide_sort_algorithms[];
+extern const int num_wide_sort_algorithms;
+
+/**
+ * Procura um algoritmo com chaves de 64 bits pelo nome
+ *
+ * @param name Nome do algoritmo
+ * @return Entrada do registro ou NULL se não existir
+ */
+const WideSortAlgorithm *find_wide_sort_algorithm(const char *name);
+
+#endif /* WIDE_SORTS_H */
@@ -0,0 +1,384 @@
+/**
+ * wide_sorts_template.h
+ * Corpo dos algoritmos para chaves de 64 bits, incluído por wide_sorts.c uma
+ * vez por tipo de chave. Antes de incluir, defina:
+ *
+ *   KEY_T          Tipo do elemento (int64_t, uint64_t ou um registro)
+ *   KEY_SUFFIX     Sufixo dos nomes (_i64 ou _u64)
+ *   KEY_ORDER(x)   Chave do elemento convertida em uint64_t com a mesma ordem
+ *
+ * Opcionais (para elementos que não são a própria chave):
+ *
+ *   KEY_LESS(a, b)   Comparação entre elementos (padrão: a < b)
+ *   KEY_LINKAGE      Ligação dos algoritmos gerados (padrão: externa)
+ *   KEY_CONTEXT      Tipo de um contexto recebido pelos algoritmos como
+ *                    último argumento (const KEY_CONTEXT *ctx), visível em
+ *                    KEY_LESS e KEY_ORDER (padrão: sem contexto)
+ *
+ * Sem proteção contra inclusão múltipla (de propósito).
+ */
+
+#define WIDE_NAME(base) WIDE_CONCAT(base, KEY_SUFFIX, )
+#define WIDE_KERNEL(base) WIDE_CONCAT(base, KEY_SUFFIX, WIDE_VARIANT)
+
+#ifdef KEY_LESS
+#define WIDE_LESS(a, b) KEY_LESS(a, b)
+#else
+#define WIDE_LESS(a, b) ((a) < (b))
+#endif
+
+#ifdef KEY_LINKAGE
+#define WIDE_LINKAGE KEY_LINKAGE
+#else
+#define WIDE_LINKAGE
+#endif
+
+#ifdef KEY_CONTEXT
+#define WIDE_CTX_PARAM , const KEY_CONTEXT *ctx
+#define WIDE_CTX_ARG , ctx
+#else
+#define WIDE_CTX_PARAM
+#define WIDE_CTX_ARG
+#endif
+
+/**
+ * Compara duas chaves contando a comparação
+ */
+static int WIDE_NAME(key_less)(KEY_T a, KEY_T b,
+                               SortCounters *counters WIDE_CTX_PARAM) {
+    COUNT_COMPARISON(counters);
+    return WIDE_LESS(a, b);
+}
+
+/**
+ * Troca duas chaves contando uma movimentação
+ */
+static void WIDE_NAME(key_swap)(KEY_T *arr, ptrdiff_t a, ptrdiff_t b,
+                                SortCounters *counters) {
+    KEY_T temp = arr[a];
+    arr[a] = arr[b];
+    arr[b] = temp;
+    COUNT_MOVEMENT(counters);
+}
+
+/**
+ * Índice da mediana entre arr[a], arr[b] e arr[c]
+ */
+static ptrdiff_t WIDE_NAME(key_median)(const KEY_T *arr, ptrdiff_t a,
+                                       ptrdiff_t b, ptrdiff_t c,
+                                       SortCounters *counters WIDE_CTX_PARAM) {
+    if (WIDE_NAME(key_less)(arr[a], arr[b], counters WIDE_CTX_ARG)) {
+        if (WIDE_NAME(key_less)(arr[b], arr[c], counters WIDE_CTX_ARG)) {
+            return b;
+        }
+        return WIDE_NAME(key_less)(arr[a], arr[c], counters WIDE_CTX_ARG)
+                   ? c
+                   : a;
+    }
+    if (WIDE_NAME(key_less)(arr[a], arr[c], counters WIDE_CTX_ARG)) {
+        return a;
+    }
+    return WIDE_NAME(key_less)(arr[b], arr[c], counters WIDE_CTX_ARG) ? c : b;
+}
+
+/**
+ * Pivô: mediana de três ou ninther de Tukey nas partições grandes
+ */
+static ptrdiff_t WIDE_NAME(key_pivot)(const KEY_T *arr, ptrdiff_t low,
+                                      ptrdiff_t high,
+                                      SortCounters *counters WIDE_CTX_PARAM) {
+    ptrdiff_t n = high - low + 1;
+    ptrdiff_t mid = low + n / 2;
+
+    if (n < WIDE_NINTHER_THRESHOLD) {
+        return WIDE_NAME(key_median)(arr, low, mid, high,
+                                     counters WIDE_CTX_ARG);
+    }
+
+    ptrdiff_t step = n / 8;
+    ptrdiff_t m1 = WIDE_NAME(key_median)(arr, low, low + step, low + 2 * step,
+                                         counters WIDE_CTX_ARG);
+    ptrdiff_t m2 = WIDE_NAME(key_median)(arr, mid - step, mid, mid + step,
+                                         counters WIDE_CTX_ARG);
+    ptrdiff_t m3 = WIDE_NAME(key_median)(arr, high - 2 * step, high - step,
+                                         high, counters WIDE_CTX_ARG);
+    return WIDE_NAME(key_median)(arr, m1, m2, m3, counters WIDE_CTX_ARG);
+}
+
+/**
+ * Ordenação por inserção no intervalo [low, high]
+ */
+static void WIDE_NAME(key_insertion)(KEY_T *arr, ptrdiff_t low,
+                                     ptrdiff_t high,
+                                     SortCounters *counters WIDE_CTX_PARAM) {
+    ptrdiff_t i, j;
+    for (i = low + 1; i <= high; i++) {
+        KEY_T key = arr[i];
+        j = i - 1;
+
+        while (j >= low &&
+               WIDE_NAME(key_less)(key, arr[j], counters WIDE_CTX_ARG)) {
+            arr[j + 1] = arr[j];
+            COUNT_MOVEMENT(counters);
+            j--;
+        }
+
+        if (j + 1 != i) {
+            arr[j + 1] = key;
+            COUNT_MOVEMENT(counters);
+        }
+    }
+}
+
+/**
+ * Desce o elemento root no heap máximo arr[base .. base + size - 1]
+ */
+static void WIDE_NAME(key_sift_down)(KEY_T *arr, ptrdiff_t base,
+                                     ptrdiff_t root, ptrdiff_t size,
+                                     SortCounters *counters WIDE_CTX_PARAM) {
+    KEY_T value = arr[base + root];
+
+    while (2 * root + 1 < size) {
+        ptrdiff_t child = 2 * root + 1;
+        if (child + 1 < size &&
+            WIDE_NAME(key_less)(arr[base + child], arr[base + child + 1],
+                                counters WIDE_CTX_ARG)) {
+            child++;
+        }
+        if (!WIDE_NAME(key_less)(value, arr[base + child],
+                                 counters WIDE_CTX_ARG)) {
+            break;
+        }
+        arr[base + root] = arr[base + child];
+        COUNT_MOVEMENT(counters);
+        root = child;
+    }
+
+    arr[base + root] = value;
+}
+
+/**
+ * HeapSort no intervalo [low, high]
+ */
+static void WIDE_NAME(key_heap_sort)(KEY_T *arr, ptrdiff_t low,
+                                     ptrdiff_t high,
+                                     SortCounters *counters WIDE_CTX_PARAM) {
+    ptrdiff_t size = high - low + 1;
+    ptrdiff_t i;
+
+    for (i = size / 2 - 1; i >= 0; i--) {
+        WIDE_NAME(key_sift_down)(arr, low, i, size, counters WIDE_CTX_ARG);
+    }
+    for (i = size - 1; i > 0; i--) {
+        WIDE_NAME(key_swap)(arr, low, low + i, counters);
+        WIDE_NAME(key_sift_down)(arr, low, 0, i, counters WIDE_CTX_ARG);
+    }
+}
+
+/**
+ * Partição em três vias de Bentley-McIlroy com pivô em arr[low] (mesmo
+ * contrato de partition_three_way em sorting_algorithms.c)
+ */
+static void WIDE_NAME(key_partition)(KEY_T *arr, ptrdiff_t low,
+                                     ptrdiff_t high, ptrdiff_t *lt_end,
+                                     ptrdiff_t *gt_begin,
+                                     SortCounters *counters WIDE_CTX_PARAM) {
+    KEY_T pivot = arr[low];
+    ptrdiff_t i = low, j = high + 1;
+    ptrdiff_t p = low, q = high + 1;
+    ptrdiff_t k;
+
+    for (;;) {
+        while (WIDE_NAME(key_less)(arr[++i], pivot, counters WIDE_CTX_ARG)) {
+            if (i == high) {
+                break;
+            }
+        }
+        while (WIDE_NAME(key_less)(pivot, arr[--j], counters WIDE_CTX_ARG)) {
+            if (j == low) {
+                break;
+            }
+        }
+
+        // Os índices se cruzaram sobre um elemento igual ao pivô
+        if (i == j &&
+            !WIDE_NAME(key_less)(arr[i], pivot, counters WIDE_CTX_ARG)) {
+            WIDE_NAME(key_swap)(arr, ++p, i, counters);
+        }
+        if (i >= j) {
+            break;
+        }
+
+        WIDE_NAME(key_swap)(arr, i, j, counters);
+
+        // Guardar os iguais ao pivô nas extremidades
+        if (!WIDE_NAME(key_less)(arr[i], pivot, counters WIDE_CTX_ARG)) {
+            WIDE_NAME(key_swap)(arr, ++p, i, counters);
+        }
+        if (!WIDE_NAME(key_less)(pivot, arr[j], counters WIDE_CTX_ARG)) {
+            WIDE_NAME(key_swap)(arr, --q, j, counters);
+        }
+    }
+
+    // Trazer os iguais das extremidades para o meio
+    i = j + 1;
+    for (k = low; k <= p; k++) {
+        WIDE_NAME(key_swap)(arr, k, j--, counters);
+    }
+    for (k = high; k >= q; k--) {
+        WIDE_NAME(key_swap)(arr, k, i++, counters);
+    }
+
+    *lt_end = j;
+    *gt_begin = i;
+}
+
+/**
+ * Laço principal do IntroSort
+ */
+static void WIDE_NAME(key_introsort_loop)(KEY_T *arr, ptrdiff_t low,
+                                          ptrdiff_t high, int depth_limit,
+                                          SortCounters *counters
+                                              WIDE_CTX_PARAM) {
+    while (high - low + 1 > WIDE_INSERTION_CUTOFF) {
+        if (depth_limit == 0) {
+            WIDE_NAME(key_heap_sort)(arr, low, high, counters WIDE_CTX_ARG);
+            return;
+        }
+        depth_limit--;
+
+        ptrdiff_t pivot_idx =
+            WIDE_NAME(key_pivot)(arr, low, high, counters WIDE_CTX_ARG);
+        WIDE_NAME(key_swap)(arr, low, pivot_idx, counters);
+
+        ptrdiff_t lt_end, gt_begin;
+        WIDE_NAME(key_partition)(arr, low, high, &lt_end, &gt_begin,
+                                 counters WIDE_CTX_ARG);
+
+        if (lt_end - low < high - gt_begin) {
+            WIDE_NAME(key_introsort_loop)(arr, low, lt_end, depth_limit,
+                                          counters WIDE_CTX_ARG);
+            low = gt_begin;
+        } else {
+            WIDE_NAME(key_introsort_loop)(arr, gt_begin, high, depth_limit,
+                                          counters WIDE_CTX_ARG);
+            high = lt_end;
+        }
+    }
+
+    WIDE_NAME(key_insertion)(arr, low, high, counters WIDE_CTX_ARG);
+}
+
+/**
+ * IntroSort
+ */
+WIDE_LINKAGE SortResult WIDE_KERNEL(intro_sort)(KEY_T *arr,
+                                                size_t n WIDE_CTX_PARAM) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    // Limite de profundidade: 2 * floor(log2(n))
+    int depth_limit = 0;
+    size_t m;
+    for (m = n; m > 1; m >>= 1) {
+        depth_limit += 2;
+    }
+
+    if (n > 1) {
+        WIDE_NAME(key_introsort_loop)(arr, 0, (ptrdiff_t)n - 1, depth_limit,
+                                      &counters WIDE_CTX_ARG);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+/**
+ * Radix Sort LSD com dígitos de WIDE_RADIX_BITS bits
+ */
+WIDE_LINKAGE SortResult WIDE_KERNEL(lsd_radix_sort_11)(
+    KEY_T *arr, size_t n WIDE_CTX_PARAM) {
+    SortResult result = {0};
+    SortCounters counters = {0, 0};
+    size_t buckets = (size_t)1 << WIDE_RADIX_BITS;
+    uint64_t mask = buckets - 1;
+    size_t i, b;
+    int p;
+
+    // Medir tempo de início
+    uint64_t start_time = bench_now_ns();
+
+    if (n > 1) {
+        size_t *hist = (size_t *)calloc(WIDE_RADIX_PASSES * buckets,
+                                        sizeof(size_t));
+        size_t *pos = (size_t *)malloc(buckets * sizeof(size_t));
+        KEY_T *buffer = (KEY_T *)sort_scratch(SCRATCH_DATA,
+                                              n * sizeof(KEY_T));
+        KEY_T *src = arr, *dst = buffer;
+        if (hist == NULL || pos == NULL) {
+            fprintf(stderr, "Erro na alocação de memória\n");
+            exit(EXIT_FAILURE);
+        }
+
+        // Histogramas de todos os dígitos em uma única leitura
+        for (i = 0; i < n; i++) {
+            uint64_t key = KEY_ORDER(arr[i]);
+            for (p = 0; p < WIDE_RADIX_PASSES; p++) {
+                hist[p * buckets + ((key >> (p * WIDE_RADIX_BITS)) & mask)]++;
+            }
+        }
+
+        for (p = 0; p < WIDE_RADIX_PASSES; p++) {
+            const size_t *h = hist + p * buckets;
+            int shift = p * WIDE_RADIX_BITS;
+            size_t sum = 0;
+
+            // Passe trivial: todos os elementos no mesmo balde
+            if (h[(KEY_ORDER(src[0]) >> shift) & mask] == n) {
+                continue;
+            }
+
+            for (b = 0; b < buckets; b++) {
+                pos[b] = sum;
+                sum += h[b];
+            }
+            for (i = 0; i < n; i++) {
+                KEY_T value = src[i];
+                dst[pos[(KEY_ORDER(value) >> shift) & mask]++] = value;
+            }
+            COUNT_MOVEMENTS(&counters, n);
+
+            KEY_T *temp = src;
+            src = dst;
+            dst = temp;
+        }
+
+        if (src != arr) {
+            memcpy(arr, src, n * sizeof(KEY_T));
+            COUNT_MOVEMENTS(&counters, n);
+        }
+
+        sort_scratch_done(buffer);
+        free(pos);
+        free(hist);
+    }
+
+    // Calcular tempo de execução em segundos
+    result.execution_time = bench_elapsed_s(start_time, bench_now_ns());
+    SORT_STORE_COUNTERS(result, &counters);
+
+    return result;
+}
+
+#undef WIDE_NAME
+#undef WIDE_KERNEL
+#undef WIDE_LESS
+#undef WIDE_LINKAGE
+#undef WIDE_CTX_PARAM
+#undef WIDE_CTX_ARG